@@ -2,4 +2,19 @@
 -- 06/07/25
 -- PlayerBinds.lua
 
-Binds = {}
+-- Each bind triggers its action while the key is in the given status,
+-- several keys may share one action
+Binds = {
+	{ key = Keys.W, status = KeyStatus.Down, action = "MovePositiveY" },
+	{ key = Keys.S, status = KeyStatus.Down, action = "MoveNegativeY" },
+	{ key = Keys.D, status = KeyStatus.Down, action = "MovePositiveX" },
+	{ key = Keys.A, status = KeyStatus.Down, action = "MoveNegativeX" },
+	{ key = Keys.I, status = KeyStatus.Down, action = "MovePositiveZ" },
+	{ key = Keys.K, status = KeyStatus.Down, action = "MoveNegativeZ" },
+	{ key = Keys.U, status = KeyStatus.Down, action = "RotatePositiveX" },
+	{ key = Keys.O, status = KeyStatus.Down, action = "RotateNegativeX" },
+	{ key = Keys.J, status = KeyStatus.Down, action = "RotatePositiveY" },
+	{ key = Keys.L, status = KeyStatus.Down, action = "RotateNegativeY" },
+	{ key = Keys.Q, status = KeyStatus.Down, action = "RotatePositiveZ" },
+	{ key = Keys.E, status = KeyStatus.Down, action = "RotateNegativeZ" },
+}
@@ -0,0 +1,20 @@
+-- Manoel McCadden
+-- 10/19/26
+-- DriftSystem.lua
+--
+-- An example of a scripted system. Add it to the engine with:
+--   ecsManager.AddSystem<LuaSystem>("Drift_System"
+--                                  , "../clapp_scripts/systems/DriftSystem.lua");
+--
+-- update is called once per frame with every entity holding a transform
+-- and physics component. Loop over the batch here rather than calling back
+-- into the engine per entity.
+
+function update(dt, batch)
+	local posX, velX = batch.posX, batch.velX
+	local posY, velY = batch.posY, batch.velY
+	for i = 1, batch.count do
+		posX[i] = posX[i] + velX[i] * dt
+		posY[i] = posY[i] + velY[i] * dt
+	end
+end
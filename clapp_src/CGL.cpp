@@ -119,11 +119,7 @@ bool CGL::TerminateEngine()
 {
   if(engineGraphics->CheckWindowClose())
   {
-    EventManager::GetInstance().AddEvent(
-      EventManager::Event(EventManager::SYSTEM
-                          , EventManager::ENGINE
-                          , "TerminateEngine")
-    );
+    EventManager::GetInstance().SendEvent(TerminateEngineEvent());
     return true;
   }
 
@@ -19,7 +19,10 @@
 #include "clapp_includes/Clarity_IO.h"
 #include "clapp_includes/Clarity_Library.h"
 #include "clapp_includes/Clarity_EventManager.h"
-#include "clapp_includes/Clarity_LUA.h"
+#include "clapp_includes/Clarity_LuaConfig.h"
+#include "clapp_includes/Clarity_Archive.h"
+#include "clapp_includes/Clarity_FileWatcher.h"
+#include "clapp_includes/Clarity_ThreadPool.h"
 
 // NOTE: This is a temp include for the graphics system to make sure the
 // shaders and mesh work
@@ -54,180 +57,194 @@ Mesh::Mesh(const Mesh::MeshType &type, const std::string &name) {
 }
 
 Mesh::MeshData *Mesh::AddMeshDataToLibrary(const std::string &filePath) {
-  MeshData *meshData = new MeshData;
-
-  LuaState &instance = LuaState::GetInstance();
+  MeshData *meshData = LoadMeshData(filePath);
+  if (meshData == nullptr) {
+    return nullptr;
+  }
 
-  LuaState::LUA_ERR err;
+  return RegisterMeshData(filePath, meshData);
+}
 
-  // Open the lua file
-  err = instance.ExecuteFile(filePath);
+std::vector<Mesh::MeshData *>
+Mesh::AddMeshesToLibrary(const std::vector<std::string> &filePaths) {
+  std::vector<MeshData *> meshes(filePaths.size(), nullptr);
+
+  // Reading and running the scripts happens on every thread, each with its
+  // own lua state. GL objects and the library are only touched below on
+  // the thread owning the context
+  ThreadPool::GetInstance().ParallelFor(
+      filePaths.size(),
+      [&filePaths, &meshes](const size_t &begin, const size_t &end,
+                            const size_t &) {
+        for (size_t i = begin; i < end; ++i) {
+          meshes[i] = LoadMeshData(filePaths[i]);
+        }
+      });
+
+  // Register in the given order so duplicate names resolve the same way
+  // every run
+  for (size_t i = 0; i < filePaths.size(); ++i) {
+    if (meshes[i] != nullptr) {
+      meshes[i] = RegisterMeshData(filePaths[i], meshes[i]);
+    }
+  }
 
-  // Get the mesh data
-  err = instance.GetGlobal("Mesh");
+  return meshes;
+}
 
-  // Get the mesh type
-  err = instance.GetField("type");
+Mesh::MeshData *Mesh::LoadMeshData(const std::string &filePath) {
+  std::string luaSource;
+  if (LoadAssetToString(filePath, luaSource) != FILE_NO_ERR) {
+    ErrMessage("Failed to load mesh file: " + filePath, EC_GRAPHICS);
+    return nullptr;
+  }
 
-  // Default state is a square mesh
-  string type = "SquareMesh";
-  // TODO: Add a clear operation to the lua state
-  err = instance.GetString(type);
+  MeshData *meshData = new MeshData;
 
-  meshData->name = type;
+  if (!ParseMeshData(filePath, luaSource, *meshData)) {
+    delete meshData;
+    return nullptr;
+  }
 
-  // Get the mesh data instance of the library
-  Library<Mesh> &library = Library<Mesh>::GetInstance();
+  return meshData;
+}
 
-  if (library.GetItem(meshData->name) != nullptr) {
+Mesh::MeshData *Mesh::RegisterMeshData(const std::string &filePath,
+                                       MeshData *meshData) {
+  if (Library<MeshData>::GetInstance().GetItem(meshData->name) != nullptr) {
     ErrMessage("Attempting to create duplicate mesh with name: " +
                    meshData->name, EC_GRAPHICS);
+    delete meshData;
     return nullptr;
   }
 
-  if (meshData->name == "TriangleMesh") 
+  // Create the mesh with the new data!
+  CreateMeshData(*meshData);
+
+  Library<MeshData>::GetInstance().AddItem(meshData->name, meshData);
+
+  // Reload the mesh in place whenever its script is edited
+  FileWatcher::GetInstance().Watch(filePath, FileWatcher::WATCH_MESH);
+
+  return meshData;
+}
+
+bool Mesh::ReloadMeshData(const std::string &filePath, MeshData &reloaded) {
+  MeshData *meshData = Library<MeshData>::GetInstance().GetItem(reloaded.name);
+  if (meshData == nullptr) {
+    ErrMessage("Cannot reload mesh with unknown name: " + reloaded.name +
+                   " from: " + filePath, EC_GRAPHICS);
+    return false;
+  }
+
+  // Swap in the new geometry but keep the existing buffers so every mesh
+  // component pointing at this data keeps working
+  meshData->vertices.swap(reloaded.vertices);
+  meshData->indices.swap(reloaded.indices);
+  meshData->bounds = reloaded.bounds;
+  UpdateMeshData(*meshData);
+
+  return true;
+}
+
+bool Mesh::ParseMeshData(const std::string &filePath,
+                         const std::string &luaSource, MeshData &meshData) {
+  // The config owns a copy of the script's data so a bad mesh can never
+  // leave the lua stack unbalanced
+  LuaConfig config;
+  if (config.LoadBuffer(luaSource, filePath)) {
+    return false;
+  }
+
+  // Default state is a square mesh
+  string type = "SquareMesh";
+  if (config.Has("Mesh.type.1") && config.GetString("Mesh.type.1", type)) {
+    return false;
+  }
+
+  meshData.name = type;
+
+  if (meshData.name == "TriangleMesh") 
   {
-    meshData->meshType = MESH_TRIANGLE;
+    meshData.meshType = MESH_TRIANGLE;
   } 
-  else if (meshData->name == "SquareMesh") 
+  else if (meshData.name == "SquareMesh") 
   {
-    meshData->meshType = MESH_SQUARE;
+    meshData.meshType = MESH_SQUARE;
   } 
-  else if(meshData->name == "PrismMesh") 
+  else if(meshData.name == "PrismMesh") 
   {
-    meshData->meshType = MESH_PRISM;
+    meshData.meshType = MESH_PRISM;
   } 
-  else if (meshData->name == "CubeMesh")
+  else if (meshData.name == "CubeMesh")
   {
-    meshData->meshType = MESH_CUBE;
+    meshData.meshType = MESH_CUBE;
   }
   else 
 {
-    meshData->meshType = MESH_CUSTOM;
+    meshData.meshType = MESH_CUSTOM;
   }
 
-  // Leave type field
-  err = instance.Pop();
-
-  // Get the color information
-  err = instance.GetField("color");
   // Color will always have 3 values but we will get it anyway and check
   // to ensure there are only 3
-  int length;
-  err = instance.GetFieldLength(length);
-  if (length != 3) {
-    ErrMessage("Invalid amount of color values in mesh", EC_GRAPHICS);
-    return nullptr;
+  vector<float> color;
+  if (config.GetNumberArray("Mesh.color", color)) {
+    return false;
   }
-
-  // save the colors in a vec3 for vertices
-  glm::vec3 color;
-
-  for (int i = 0; i < length; ++i) {
-    err = instance.GetNumber(color[i], i);
+  if (color.size() != 3) {
+    ErrMessage("Invalid amount of color values in mesh", EC_GRAPHICS);
+    return false;
   }
-  // Leave the color field
-  err = instance.Pop();
 
-  // Save them into this position vector
-  glm::vec3 position;
+  // Each table is read whole in one bulk call
   vector<glm::vec3> positions;
-  glm::vec2 textureCoord;
   vector<glm::vec2> textureCoords;
 
-  // Get the vertices
-  err = instance.GetField("vertices");
-  err = instance.GetFieldLength(length);
-
-  for (int i = 0; i < length;)  
-  {
-    // If there isn't enough verticies for another
-    // point then break out of the look
-    if(length - i < 3)
-    {
-      break;
-    }
-
-    err = instance.GetNumber(position.x, i++);
-    err = instance.GetNumber(position.y, i++);
-    err = instance.GetNumber(position.z, i++);
-    // Fill both positions
-    positions.push_back(position);
-  }
-
-  // Leave the vertices field
-  err = instance.Pop();
-
-  // Get the uv coords 
-  err = instance.GetField("uv");
-  err = instance.GetFieldLength(length);
-
-  for (int i = 0; i < length;)  
-  {
-    // If there isn't enough texture coords for another
-    // point then break out of the look
-    if(length - i < 2)
-    {
-      break;
-    }
-
-    err = instance.GetNumber(textureCoord.x, i++);
-    err = instance.GetNumber(textureCoord.y, i++);
-    // Fill both texture coords
-    textureCoords.push_back(textureCoord);
+  if (config.GetVec3Array("Mesh.vertices", positions) ||
+      config.GetVec2Array("Mesh.uv", textureCoords)) {
+    return false;
   }
 
-  // Leave the uv field
-  err = instance.Pop();
-
   // Set the length to the positions size as it should be the number
   // of vertices in the mesh
-  length = positions.size();
+  size_t length = positions.size();
 
   // Validate that the sizes are the number of indices are teh same for 
   // the positions and texture coords
   if(positions.size() != textureCoords.size())
   {
     ErrMessage("Invalid number of texture coords to positions for: "
-               + meshData->name, EC_GRAPHICS);
+               + meshData.name, EC_GRAPHICS);
 
     // Make sure that the smaller of the two sizes is used to avoid
     // indexing outside of the bounds of the vertex
-    positions.size() > textureCoords.size() 
-      ? length = positions.size() : length = textureCoords.size();
+    length = min(positions.size(), textureCoords.size());
   }
 
   // Push back the vertices of the mesh
-  for(int i = 0; i < length; ++i)
+  const glm::vec3 vertexColor(color[0], color[1], color[2]);
+  meshData.vertices.reserve(length);
+  for(size_t i = 0; i < length; ++i)
   {
-    meshData->vertices.push_back({positions[i], textureCoords[i], color});
+    meshData.vertices.push_back({positions[i], textureCoords[i], vertexColor});
   }
 
-  // Finally get the index information
-  err = instance.GetField("indices");
-  err = instance.GetFieldLength(length);
-
-  // Save each piece into a unsigned int to be added to the vector
-  unsigned int index;
-
-  for (int i = 0; i < length; ++i) {
-    err = instance.GetNumber(index, i);
-    meshData->indices.push_back(index);
+  if (length > 0) {
+    meshData.bounds = {positions.front(), positions.front()};
+    for (size_t i = 1; i < length; ++i) {
+      meshData.bounds.min = glm::min(meshData.bounds.min, positions[i]);
+      meshData.bounds.max = glm::max(meshData.bounds.max, positions[i]);
+    }
   }
 
-  // Pop the indices
-  err = instance.Pop();
-  // Pop the mesh global
-  err = instance.Pop();
-  // Pop and clear the filepath :)
-  err = instance.Pop();
-
-  // Create the mesh with the new data!
-  CreateMeshData(*meshData);
+  // Finally get the index information
+  if (config.GetNumberArray("Mesh.indices", meshData.indices)) {
+    return false;
+  }
 
-  Library<MeshData>::GetInstance().AddItem(meshData->name, meshData);
+  meshData.filePath = filePath;
 
-  return meshData;
+  return true;
 }
 
 Mesh::~Mesh() {
@@ -277,3 +294,29 @@ void Mesh::CreateMeshData(MeshData &meshData) {
 
   Message("Mesh Created", SEVERITY_INFO);
 }
+
+void Mesh::UpdateMeshData(MeshData &meshData) {
+  if (meshData.vertices.empty() || meshData.indices.empty()) {
+    ErrMessage("Empty list of vertices or indices given", EC_GRAPHICS);
+    return;
+  }
+
+  // The element buffer binding is part of the vertex array's state so
+  // binding the vertex array rebinds it for us
+  glBindVertexArray(meshData.vao);
+  CGL_System::CheckGLError();
+  glBindBuffer(GL_ARRAY_BUFFER, meshData.vbo);
+  CGL_System::CheckGLError();
+  glBufferData(GL_ARRAY_BUFFER, meshData.vertices.size() * sizeof(Vertex),
+               meshData.vertices.data(), GL_STATIC_DRAW);
+  CGL_System::CheckGLError();
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER,
+               meshData.indices.size() * sizeof(unsigned int),
+               meshData.indices.data(), GL_STATIC_DRAW);
+  CGL_System::CheckGLError();
+
+  glBindVertexArray(0);
+  CGL_System::CheckGLError();
+
+  Message("Mesh Reloaded: " + meshData.name, SEVERITY_INFO);
+}
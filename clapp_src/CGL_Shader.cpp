@@ -14,6 +14,7 @@
 #include "clapp_includes/CGL_Shader.h"
 #include "clapp_includes/CGL_System.h"
 #include "clapp_includes/Clarity_IO.h"
+#include "clapp_includes/Clarity_Archive.h"
 
 #include "clapp_includes/g_pch.h"
 
@@ -78,30 +79,41 @@ void CGL_Shader::DeleteShader()
 
 bool CGL_Shader::CompileShader() 
 {
-  GLenum err;
-
-  // Create a shader based on the given type
-  if (shaderType == VERTEX) 
-  {
-    shaderID = glCreateShader(GL_VERTEX_SHADER);
-  } else if (shaderType == FRAGMENT) 
-  {
-    shaderID = glCreateShader(GL_FRAGMENT_SHADER);
-  } else 
+  // Load the shader source from the mounted archive or the loose file
+  std::string shaderData;
+  if(LoadAssetToString(shaderPath, shaderData) != FILE_NO_ERR)
   {
-    ErrMessage("Attempting to compile unknown shader type", EC_GENERICSHADER);
+    ErrMessage("Failed to load shader from path: " + shaderPath
+               , EC_GENERICSHADER);
     return false;
   }
-  CGL_System::CheckGLError();
 
-  // Open the file and convert its data to a string to be read
-  std::fstream shaderFile;
-  OpenFile(shaderFile, shaderPath);
-  std::string shaderData;
-  ConvertFileToString(shaderFile, shaderData);
+  return CompileShaderSource(shaderData);
+}
+
+bool CGL_Shader::CompileShaderSource(const std::string &shaderSource)
+{
+  // Create a shader based on the given type, reusing the existing shader
+  // object when recompiling so any program it is attached to keeps it
+  if(!shaderID)
+  {
+    if (shaderType == VERTEX) 
+    {
+      shaderID = glCreateShader(GL_VERTEX_SHADER);
+    } else if (shaderType == FRAGMENT) 
+    {
+      shaderID = glCreateShader(GL_FRAGMENT_SHADER);
+    } else 
+    {
+      ErrMessage("Attempting to compile unknown shader type"
+                 , EC_GENERICSHADER);
+      return false;
+    }
+    CGL_System::CheckGLError();
+  }
 
   // Read the shader data into a c style string and compile the shader
-  const char *shaderCharString = shaderData.c_str();
+  const char *shaderCharString = shaderSource.c_str();
   glShaderSource(shaderID, 1, &shaderCharString, NULL);
   CGL_System::CheckGLError();
   glCompileShader(shaderID);
@@ -128,6 +140,11 @@ const unsigned int &CGL_Shader::GetShaderID()
   return shaderID; 
 }
 
+const std::string &CGL_Shader::GetShaderPath()
+{
+  return shaderPath;
+}
+
 CGL_Program::CGL_Program(const CGL_Shader &vertexShader
                          , const CGL_Shader &fragmentShader)
 : vertex(vertexShader), fragment(fragmentShader), programID(0) 
@@ -177,6 +194,60 @@ bool CGL_Program::LinkProgram()
   CGL_System::CheckGLError();
   glAttachShader(programID, fragment.GetShaderID());
   CGL_System::CheckGLError();
+
+  return LinkAttachedShaders();
+}
+
+bool CGL_Program::ReloadShader(const CGL_Shader::SHADERTYPE &type
+                               , const std::string &shaderSource)
+{
+  CGL_Shader &shader = type == CGL_Shader::VERTEX ? vertex : fragment;
+
+  // A failed compile leaves the last linked program binary untouched so
+  // rendering continues with the old shader until the error is fixed
+  if(!shader.CompileShaderSource(shaderSource))
+  {
+    ErrMessage("Keeping previous program after failed reload of: "
+               + shader.GetShaderPath(), EC_SHADERPROGRAM);
+    return false;
+  }
+
+  // Link into a fresh program so a bad edit that compiles but fails to
+  // link leaves the last working program untouched and in use
+  const unsigned int previousID = programID;
+  programID = glCreateProgram();
+  CGL_System::CheckGLError();
+  glAttachShader(programID, vertex.GetShaderID());
+  CGL_System::CheckGLError();
+  glAttachShader(programID, fragment.GetShaderID());
+  CGL_System::CheckGLError();
+
+  if(!LinkAttachedShaders())
+  {
+    glDeleteProgram(programID);
+    CGL_System::CheckGLError();
+    programID = previousID;
+    ErrMessage("Keeping previous program after failed relink of: "
+               + shader.GetShaderPath(), EC_SHADERPROGRAM);
+    return false;
+  }
+
+  glDeleteProgram(previousID);
+  CGL_System::CheckGLError();
+
+  return true;
+}
+
+bool CGL_Program::LinkAttachedShaders()
+{
+  // Pinned before every link so a relinked program keeps the locations
+  // the mesh vertex arrays were set up with, whatever order an edited
+  // shader declares its inputs in
+  glBindAttribLocation(programID, COLOR_LOCATION, "inColor");
+  glBindAttribLocation(programID, POSITION_LOCATION, "inPos");
+  glBindAttribLocation(programID, TEXTURE_LOCATION, "inTex");
+  CGL_System::CheckGLError();
+
   glLinkProgram(programID);
   CGL_System::CheckGLError();
   int status;
@@ -190,24 +261,20 @@ bool CGL_Program::LinkProgram()
   }
   CGL_System::CheckGLError();
 
-  inColor = static_cast<unsigned int>(glGetAttribLocation(programID, "inColor"));
-  CGL_System::CheckGLError();
-  if(inColor == -1)
+  // The locations are fixed, only check each input is still used
+  if(glGetAttribLocation(programID, "inColor") == -1)
   {
     ErrMessage("Failed to find inColor in shader", EC_SHADERPROGRAM);
   }
-  inPos = static_cast<unsigned int>(glGetAttribLocation(programID, "inPos"));
-  CGL_System::CheckGLError();
-  if(inPos == -1)
+  if(glGetAttribLocation(programID, "inPos") == -1)
   {
     ErrMessage("Failed to find inPos in shader", EC_SHADERPROGRAM);
   }
-  inTex = static_cast<unsigned int>(glGetAttribLocation(programID, "inTex"));
-  CGL_System::CheckGLError();
-  if(inTex == -1)
+  if(glGetAttribLocation(programID, "inTex") == -1)
   {
     ErrMessage("Failed to find inTex in shader", EC_SHADERPROGRAM);
   }
+  CGL_System::CheckGLError();
 
   objMatrix = static_cast<unsigned int>(
     glGetUniformLocation(programID, "obj"));
@@ -230,6 +297,13 @@ bool CGL_Program::LinkProgram()
   {
     ErrMessage("Failed to find perspective in shader", EC_SHADERPROGRAM);
   }
+  textureLayer = static_cast<unsigned int>(
+    glGetUniformLocation(programID, "textureLayer"));
+  CGL_System::CheckGLError();
+  if(textureLayer == -1)
+  {
+    ErrMessage("Failed to find textureLayer in shader", EC_SHADERPROGRAM);
+  }
 
   Message("Compiled Program", SEVERITY_INFO);
 
@@ -266,7 +340,22 @@ const unsigned int &CGL_Program::GetPerspectiveMatrixLocation()
   return perspectiveMatrix;
 }
 
+const unsigned int &CGL_Program::GetTextureLayerLocation()
+{
+  return textureLayer;
+}
+
 const unsigned int &CGL_Program::GetProgramID() 
 { 
   return programID; 
 }
+
+const std::string &CGL_Program::GetVertexPath()
+{
+  return vertex.GetShaderPath();
+}
+
+const std::string &CGL_Program::GetFragmentPath()
+{
+  return fragment.GetShaderPath();
+}
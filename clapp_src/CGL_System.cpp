@@ -26,8 +26,10 @@
 #include "clapp_includes/CGL_Mesh.h"
 #include "clapp_includes/CGL_Texture.h"
 #include "clapp_includes/CPL_Transform.h"
+#include "clapp_includes/CPL_Bounds.h"
 
 #include "clapp_includes/Clarity_ECS.h"
+#include "clapp_includes/Clarity_FileWatcher.h"
 
 #include "clapp_includes/g_pch.h"
 #include <string>
@@ -67,7 +69,8 @@ struct ClaPP::CGL_System::WindowContainer
 
 CGL_System::CGL_System(const std::string &_sysName, uint32_t _windowSettings) 
 : Clarity_System(_sysName), windowData(new WindowContainer) 
-, windowSettings(_windowSettings), defaultShader(nullptr)
+, windowSettings(_windowSettings), defaultShader(nullptr), textureArrays()
+, cullingTree(), cullingProxies(cullingTree)
 {
   // Set component signature
   systemSignature.set(static_cast<size_t>(Component::C_MESH));
@@ -122,18 +125,32 @@ CGL_System::SYS_ERR CGL_System::Initialize()
   // Setup 3D depth
   glEnable(GL_DEPTH_TEST);
 
+  // Start watching assets for hot reloading before any are loaded so they
+  // can register themselves as they load
+  FileWatcher::GetInstance().Start();
+
   // Setup shaders
   defaultShader = new CGL_Program((CGL_Shader) {CGL_Shader::VERTEX
                                   , "../clapp_shaders/vertShader.txt"}
                                   , (CGL_Shader) {CGL_Shader::FRAGMENT
                                   , "../clapp_shaders/fragShader.txt"});
+  FileWatcher::GetInstance().Watch(defaultShader->GetVertexPath()
+                                   , FileWatcher::WATCH_SHADER);
+  FileWatcher::GetInstance().Watch(defaultShader->GetFragmentPath()
+                                   , FileWatcher::WATCH_SHADER);
 
   // Change this to bind all meshes in scripts
-  Mesh::MeshData *meshData = Mesh::AddMeshDataToLibrary(
-    "../clapp_scripts/meshes/TriangleMesh.lua");
+  // The mesh scripts are run in parallel, each thread with its own lua state
+  vector<Mesh::MeshData *> meshes = Mesh::AddMeshesToLibrary(
+    {"../clapp_scripts/meshes/TriangleMesh.lua"
+     , "../clapp_scripts/meshes/CubeMesh.lua"});
   // WARN: Currently only cube is being bound to shader
-  meshData = Mesh::AddMeshDataToLibrary(
-    "../clapp_scripts/meshes/CubeMesh.lua");
+  Mesh::MeshData *meshData = meshes.back();
+  if(!meshData)
+  {
+    ErrMessage(GetSysName() + "Failed to load the cube mesh", EC_GRAPHICS);
+    return SYS_FAILED_TO_INITIALIZE;
+  }
 
   // Get the shader's locations
   unsigned int inColor = defaultShader->GetColorLocation();
@@ -170,12 +187,11 @@ CGL_System::SYS_ERR CGL_System::Load()
 
 CGL_System::SYS_ERR CGL_System::Update(float dt)
 {
+  ApplyHotReloads();
+
   if(glfwWindowShouldClose(windowData->window))
   {
-    EventManager::GetInstance().AddEvent(
-      EventManager::Event(EventManager::SYSTEM
-                          , EventManager::ENGINE
-                          , "TerminateEngine"));
+    EventManager::GetInstance().SendEvent(TerminateEngineEvent());
   }
   //Message("Entity Count: " + std::to_string(systemEntites.size()));
 
@@ -197,10 +213,28 @@ CGL_System::SYS_ERR CGL_System::Render()
   glUseProgram(defaultShader->GetProgramID());
   CheckGLError();
 
+  // Repack whenever a texture was loaded or reloaded since the last frame
+  if(textureArrays.IsStale())
+  {
+    textureArrays.Build();
+  }
+
   // Use the ecs system to get the needed componennts
   ECS *ecs = GetECSPtr();
 
-  // render all entites that are held by the graphics system
+  // Order the draws by texture array then mesh so each is only bound
+  // when it changes rather than once per entity
+  struct DrawItem
+  {
+    unsigned int arrayID;
+    unsigned int vao;
+    int layer;
+    GLsizei indexCount;
+    const glm::mat4 *worldMatrix;
+  };
+  vector<DrawItem> entityItems;
+  entityItems.reserve(systemEntites.size());
+
   for(const ENTITY_ID &entity : systemEntites)
   {
     Mesh *mesh = ecs->GetComponent<Mesh>(entity, Component::C_MESH);
@@ -212,47 +246,95 @@ CGL_System::SYS_ERR CGL_System::Render()
     Transform *transform = ecs->GetComponent
       <Transform>(entity, Component::C_TRANSFORM);
 
-    unsigned int objMatrix = defaultShader->GetObjMatrixLocation();
-    glUniformMatrix4fv(objMatrix, 1, GL_FALSE
-                       , glm::value_ptr(
-                       transform->GetTransformData().worldMatrix));
-    CheckGLError();
-
-    // Temporarly bind the perspectice and view matrices with each entity
-    glm::mat4 view = glm::mat4(1.f);
-    view = glm::translate(view, glm::vec3(0.f, 0.f, -3.f));
-    glm::mat4 perspective;
-    perspective = glm::perspective(glm::radians(70.f), 1200.f/720.f
-                                   , 0.1f, 100.f);
-
-    unsigned int viewMatrix = defaultShader->GetViewMatrixLocation();
-    unsigned int perspectiveMatrix = 
-      defaultShader->GetPerspectiveMatrixLocation();
+    const Texture::TextureData &textureData = texture->GetTextureData();
+    const glm::mat4 &worldMatrix = transform->GetTransformData().worldMatrix;
+
+    // The mesh's box taken into the world, the scale of the matrix is
+    // left in the box's axes which finds its bounds all the same
+    const AABB &meshBounds = mesh->GetMeshData().bounds;
+    const OrientedBox worldBox = {
+      glm::vec3(worldMatrix * glm::vec4((meshBounds.min + meshBounds.max)
+                                        * 0.5f, 1.f))
+      , glm::mat3(worldMatrix), (meshBounds.max - meshBounds.min) * 0.5f};
+    cullingProxies.Update(entity, worldBox.GetBounds(), {0.f, 0.f, 0.f}
+                          , static_cast<uint32_t>(entityItems.size()));
+
+    entityItems.push_back({textureData.arrayID, mesh->GetMeshData().vao
+                           , textureData.layer
+                           , static_cast<GLsizei>(
+                             mesh->GetMeshData().indices.size())
+                           , &worldMatrix});
+  }
+  cullingProxies.EndFrame();
+
+  // Temporarly use a fixed camera, bound once per frame below
+  glm::mat4 view = glm::mat4(1.f);
+  view = glm::translate(view, glm::vec3(0.f, 0.f, -3.f));
+  glm::mat4 perspective;
+  perspective = glm::perspective(glm::radians(70.f), 1200.f/720.f
+                                 , 0.1f, 100.f);
+
+  // Only entities the camera may see are drawn
+  vector<DrawItem> drawItems;
+  drawItems.reserve(entityItems.size());
+  cullingTree.QueryFrustum(Frustum::FromMatrix(perspective * view)
+                           , [&](const int32_t &proxy)
+                           {
+                             drawItems.push_back(entityItems[
+                               cullingTree.GetUserData(proxy)]);
+                             return true;
+                           });
+
+  sort(drawItems.begin(), drawItems.end()
+       , [](const DrawItem &lhs, const DrawItem &rhs)
+       {
+         return lhs.arrayID != rhs.arrayID ? lhs.arrayID < rhs.arrayID
+                                           : lhs.vao < rhs.vao;
+       });
+
+  glUniformMatrix4fv(defaultShader->GetViewMatrixLocation(), 1, GL_FALSE
+                     , glm::value_ptr(view));
+  CheckGLError();
+  glUniformMatrix4fv(defaultShader->GetPerspectiveMatrixLocation(), 1
+                     , GL_FALSE, glm::value_ptr(perspective));
+  CheckGLError();
 
-    glUniformMatrix4fv(viewMatrix, 1, GL_FALSE
-                       , glm::value_ptr(view));
-    CheckGLError();
-    glUniformMatrix4fv(perspectiveMatrix, 1, GL_FALSE
-                       , glm::value_ptr(perspective));
-    CheckGLError();
+  const unsigned int objMatrix = defaultShader->GetObjMatrixLocation();
+  const unsigned int textureLayer = defaultShader->GetTextureLayerLocation();
+  // Start with ids that are never generated so the first draw binds
+  unsigned int boundArray = ~0u;
+  unsigned int boundVAO = ~0u;
 
-    // Bind texture for rendering
-    glBindTexture(GL_TEXTURE_2D, texture->GetTextureData().textureID);
+  // render all entites that are held by the graphics system
+  for(const DrawItem &item : drawItems)
+  {
+    glUniformMatrix4fv(objMatrix, 1, GL_FALSE
+                       , glm::value_ptr(*item.worldMatrix));
     CheckGLError();
 
-    glBindVertexArray(mesh->GetMeshData().vao);
+    if(item.arrayID != boundArray)
+    {
+      glBindTexture(GL_TEXTURE_2D_ARRAY, item.arrayID);
+      CheckGLError();
+      boundArray = item.arrayID;
+    }
+    glUniform1i(textureLayer, item.layer);
     CheckGLError();
 
-    glDrawElements(GL_TRIANGLES
-                  , mesh->GetMeshData().indices.size()
-                  , GL_UNSIGNED_INT, 0);
-    CheckGLError();
+    if(item.vao != boundVAO)
+    {
+      glBindVertexArray(item.vao);
+      CheckGLError();
+      boundVAO = item.vao;
+    }
 
-    glBindVertexArray(0);
+    glDrawElements(GL_TRIANGLES, item.indexCount, GL_UNSIGNED_INT, 0);
     CheckGLError();
-    
   }
 
+  glBindVertexArray(0);
+  CheckGLError();
+
   glfwSwapBuffers(windowData->window);
 
   return SYS_NO_ERR;
@@ -265,6 +347,10 @@ CGL_System::SYS_ERR CGL_System::Unload()
 
 CGL_System::SYS_ERR CGL_System::Terminate()
 {
+  FileWatcher::GetInstance().Stop();
+
+  cullingProxies.Clear();
+  textureArrays.Clear();
   delete defaultShader;
 
   glfwDestroyWindow(windowData->window);
@@ -307,6 +393,44 @@ CGL_System::SYS_ERR CGL_System::ProcessWindowHints()
   return SYS_NO_ERR;
 }
 
+void CGL_System::ApplyHotReloads()
+{
+  vector<FileWatcher::Reload> reloads;
+  FileWatcher::GetInstance().TakeReloads(reloads);
+
+  if(reloads.empty())
+  {
+    return;
+  }
+
+  glfwMakeContextCurrent(windowData->window);
+
+  for(FileWatcher::Reload &reload : reloads)
+  {
+    switch(reload.type)
+    {
+    case FileWatcher::WATCH_SHADER:
+      if(reload.filePath == defaultShader->GetVertexPath())
+      {
+        defaultShader->ReloadShader(CGL_Shader::VERTEX, reload.source);
+      }
+      else if(reload.filePath == defaultShader->GetFragmentPath())
+      {
+        defaultShader->ReloadShader(CGL_Shader::FRAGMENT, reload.source);
+      }
+      break;
+    case FileWatcher::WATCH_MESH:
+      Mesh::ReloadMeshData(reload.filePath, reload.mesh);
+      break;
+    case FileWatcher::WATCH_TEXTURE:
+      Texture::ReloadTextureData(reload.filePath, reload.levels
+                                 , reload.width, reload.height
+                                 , reload.channels);
+      break;
+    }
+  }
+}
+
 void CGL_System::GraphicsError(int error, const char *details)
 {
   // Append graphics error info onto string to make more clear 
@@ -17,8 +17,11 @@
 #include "clapp_includes/g_pch.h"
 
 #include "clapp_includes/CGL_System.h"
+#include "clapp_includes/CGL_TextureCook.h"
 #include "clapp_includes/Clarity_IO.h"
 #include "clapp_includes/Clarity_Library.h"
+#include "clapp_includes/Clarity_Archive.h"
+#include "clapp_includes/Clarity_FileWatcher.h"
 
 using namespace std;
 using namespace ClaPP;
@@ -74,54 +77,58 @@ bool Texture::CheckTextureExists(const string &_filePath)
 
 void Texture::BindTexture(const string &_filePath)
 {
-  // Generate a new texture
-  glGenTextures(1, &textureData->textureID);
-  CGL_System::CheckGLError();
-  glBindTexture(GL_TEXTURE_2D, textureData->textureID);
-  CGL_System::CheckGLError();
-  // Set the wrapping and filtering options
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-  CGL_System::CheckGLError();
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-  CGL_System::CheckGLError();
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-  CGL_System::CheckGLError();
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-  CGL_System::CheckGLError();
-
-  // Load and generate the texture
-  int width, height, channels;
-  unsigned char *imageData = stbi_load(_filePath.c_str(), &width, &height
-                                       , &channels, 0);
-  // Check if the image is loaded properly and generate accordanly
-  if (imageData)
+  // No texture object is made here, the TextureArrayBuilder fills the
+  // texture's layer of an array from the levels kept on the texture data
+
+  // Cooked textures already hold every mip level in their upload format
+  // so they skip decoding and mipmap generation entirely
+  if(TextureCooker::IsCookedTexturePath(_filePath))
   {
-    // PNG uses RGBA as it has an alpha
-    if (channels == 4)
+    std::string cookedData;
+    if(LoadAssetToString(_filePath, cookedData) == FILE_NO_ERR
+       && LoadCookedTexture(_filePath, cookedData, *textureData))
     {
-      glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA 
-                   , GL_UNSIGNED_BYTE, imageData);
-      CGL_System::CheckGLError();
+      textureData->filePath = _filePath;
+      ++textureData->revision;
+      ++textureRevision;
     }
-    // JPG uses RGB as it doesn't have an alpha
-    else if (channels == 3)
+    else
     {
-      glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB
-                   , GL_UNSIGNED_BYTE, imageData);
-      CGL_System::CheckGLError();
+      ErrMessage("Failed to obtain given cooked texture from file path"
+                 , EC_GRAPHICS);
     }
-    else
+
+    Library<TextureData>::GetInstance().AddItem(_filePath, textureData);
+    return;
+  }
+
+  // Load and generate the texture, the encoded image is pulled from the
+  // mounted archive if it is packed and decoded from memory
+  int width, height, channels;
+  unsigned char *imageData = nullptr;
+  std::string encodedImage;
+  if(LoadAssetToString(_filePath, encodedImage) == FILE_NO_ERR)
+  {
+    imageData = stbi_load_from_memory(
+      reinterpret_cast<const stbi_uc *>(encodedImage.data())
+      , static_cast<int>(encodedImage.size()), &width, &height, &channels, 0);
+  }
+  // Check if the image is loaded properly and generate accordanly
+  if (imageData)
+  {
+    if (!LoadDecodedImage(imageData, width, height, channels, *textureData))
     {
-      ErrMessage("Invalid number of channels gotten from image", EC_GRAPHICS);
       // Free data before returning 
       stbi_image_free(imageData);
       return;
     }
 
-    glGenerateMipmap(GL_TEXTURE_2D);
-    CGL_System::CheckGLError();
-
     textureData->filePath = _filePath;
+    ++textureData->revision;
+    ++textureRevision;
+
+    // Reload the texture whenever the image is edited
+    FileWatcher::GetInstance().Watch(_filePath, FileWatcher::WATCH_TEXTURE);
   }
   else
   {
@@ -139,3 +146,110 @@ void Texture::UnbindTexture()
 {
 
 }
+
+bool Texture::ReloadTextureData(const std::string &_filePath
+                                , vector<vector<unsigned char>> &levels
+                                , const int &width, const int &height
+                                , const int &channels)
+{
+  TextureData *data = Library<TextureData>::GetInstance().GetItem(_filePath);
+  if(!data)
+  {
+    ErrMessage("Cannot reload texture that was never loaded: " + _filePath
+               , EC_GRAPHICS);
+    return false;
+  }
+
+  if(channels != 3 && channels != 4)
+  {
+    ErrMessage("Invalid number of channels gotten from image", EC_GRAPHICS);
+    return false;
+  }
+
+  // Entities keep pointing at the same texture data, only its layer is
+  // refilled when the arrays are next built
+  data->format = channels == 4 ? TextureCooker::COOKED_RGBA8
+                               : TextureCooker::COOKED_RGB8;
+  data->levels = std::move(levels);
+  data->width = width;
+  data->height = height;
+  ++data->revision;
+  ++textureRevision;
+
+  Message("Texture Reloaded: " + _filePath, SEVERITY_INFO);
+  return true;
+}
+
+uint32_t Texture::GetTextureRevision()
+{
+  return textureRevision;
+}
+
+bool Texture::LoadDecodedImage(const unsigned char *imageData
+                               , const int &width, const int &height
+                               , const int &channels, TextureData &data)
+{
+  // PNG uses RGBA as it has an alpha
+  if (channels == 4)
+  {
+    data.format = TextureCooker::COOKED_RGBA8;
+  }
+  // JPG uses RGB as it doesn't have an alpha
+  else if (channels == 3)
+  {
+    data.format = TextureCooker::COOKED_RGB8;
+  }
+  else
+  {
+    ErrMessage("Invalid number of channels gotten from image", EC_GRAPHICS);
+    return false;
+  }
+
+  TextureCooker::BuildMipChain(imageData, static_cast<uint32_t>(width)
+                               , static_cast<uint32_t>(height)
+                               , static_cast<uint32_t>(channels)
+                               , data.levels);
+  data.width = width;
+  data.height = height;
+
+  return true;
+}
+
+bool Texture::LoadCookedTexture(const std::string &_filePath
+                                , const std::string &cookedData
+                                , TextureData &data)
+{
+  TextureCooker::CookedTexture cooked;
+  if(TextureCooker::ParseCookedTexture(cookedData, cooked)
+     != TextureCooker::COOK_NO_ERR)
+  {
+    ErrMessage("Invalid cooked texture: " + _filePath, EC_GRAPHICS);
+    return false;
+  }
+
+  const uint32_t format = cooked.header.format;
+  const bool isCompressed = format == TextureCooker::COOKED_BC1
+                            || format == TextureCooker::COOKED_BC3;
+  if(isCompressed
+     && !glfwExtensionSupported("GL_EXT_texture_compression_s3tc"))
+  {
+    ErrMessage("Block compressed textures are not supported by the driver, "
+               "recook without compression: " + _filePath, EC_GRAPHICS);
+    return false;
+  }
+
+  // Levels are kept as cooked so block compressed ones stay compressed
+  data.levels.resize(cooked.levels.size());
+  for(size_t i = 0; i < cooked.levels.size(); ++i)
+  {
+    const TextureCooker::CookedMipLevel &level = cooked.levels[i];
+    const unsigned char *levelData = cooked.data + level.dataOffset;
+    data.levels[i].assign(levelData, levelData + level.dataSize);
+  }
+
+  data.format = format;
+  data.width = static_cast<int>(cooked.header.width);
+  data.height = static_cast<int>(cooked.header.height);
+
+  return true;
+}
@@ -0,0 +1,330 @@
+/*!
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    CGL_TextureArray.cpp
+ *
+ *  \brief
+ *    The implementation file for packing the loaded textures into texture
+ *    arrays so differently textured entities can be drawn without rebinding
+ */
+#include "clapp_includes/pch.h"
+
+#include "clapp_includes/CGL_TextureArray.h"
+
+#include "clapp_includes/g_pch.h"
+
+#include "clapp_includes/CGL_System.h"
+#include "clapp_includes/CGL_Texture.h"
+#include "clapp_includes/CGL_TextureCook.h"
+#include "clapp_includes/Clarity_IO.h"
+#include "clapp_includes/Clarity_Library.h"
+
+#include <algorithm>
+#include <tuple>
+
+using namespace std;
+using namespace ClaPP;
+
+// glad is generated without the S3TC extension so the formats are defined
+// here, cooked textures using them are refused at load when the extension
+// is not supported
+static const GLenum COMPRESSED_RGB_S3TC_DXT1 = 0x83F0;
+static const GLenum COMPRESSED_RGBA_S3TC_DXT5 = 0x83F3;
+
+static bool IsCompressed(const uint32_t &format)
+{
+  return format == TextureCooker::COOKED_BC1
+         || format == TextureCooker::COOKED_BC3;
+}
+
+static GLenum GetInternalFormat(const uint32_t &format)
+{
+  switch(format)
+  {
+    case TextureCooker::COOKED_RGB8:
+      return GL_RGB8;
+    case TextureCooker::COOKED_BC1:
+      return COMPRESSED_RGB_S3TC_DXT1;
+    case TextureCooker::COOKED_BC3:
+      return COMPRESSED_RGBA_S3TC_DXT5;
+    default:
+      return GL_RGBA8;
+  }
+}
+
+static GLenum GetPixelFormat(const uint32_t &format)
+{
+  return format == TextureCooker::COOKED_RGB8 ? GL_RGB : GL_RGBA;
+}
+
+//=================//
+//= CTOR and DTOR =//
+//=================//
+
+TextureArrayBuilder::TextureArrayBuilder()
+: groups(), maxLayers(0), builtRevision(0u), isBuilt(false)
+{
+
+}
+
+TextureArrayBuilder::~TextureArrayBuilder()
+{
+
+}
+
+//==================//
+//= Public Methods =//
+//==================//
+
+bool TextureArrayBuilder::IsStale() const
+{
+  return !isBuilt || builtRevision != Texture::GetTextureRevision();
+}
+
+void TextureArrayBuilder::Build()
+{
+  if(maxLayers == 0)
+  {
+    glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &maxLayers);
+    CGL_System::CheckGLError();
+    maxLayers = max(maxLayers, 1);
+  }
+
+  // Arrays need every layer to be the same size and format so group first
+  map<ArrayKey, vector<Texture::TextureData *>> loaded;
+  Library<Texture::TextureData>::GetInstance().ForEachItem(
+    [&loaded](const string &, Texture::TextureData *data)
+    {
+      if(!data->levels.empty() && data->width > 0 && data->height > 0)
+      {
+        loaded[{data->width, data->height, data->format
+                , data->levels.size()}].push_back(data);
+      }
+    });
+
+  // Drop the arrays of any size and format no texture has anymore
+  for(auto it = groups.begin(); it != groups.end();)
+  {
+    if(loaded.find(it->first) == loaded.end())
+    {
+      DeleteArrays(it->second);
+      it = groups.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+
+  size_t rebuiltGroups = 0, refilledLayers = 0;
+  for(pair<const ArrayKey, vector<Texture::TextureData *>> &textures : loaded)
+  {
+    ArrayGroup &group = groups[textures.first];
+
+    bool isSameTextures = group.textures.size() == textures.second.size();
+    for(size_t i = 0; isSameTextures && i < textures.second.size(); ++i)
+    {
+      isSameTextures = find(group.textures.begin(), group.textures.end()
+                            , textures.second[i]) != group.textures.end();
+    }
+
+    // A texture joining or leaving moves the layers so the whole group is
+    // packed again, otherwise only the layers of replaced images are
+    if(!isSameTextures)
+    {
+      group.textures = std::move(textures.second);
+      RebuildGroup(textures.first, group);
+      ++rebuiltGroups;
+      continue;
+    }
+
+    for(size_t slot = 0; slot < group.textures.size(); ++slot)
+    {
+      const Texture::TextureData &data = *group.textures[slot];
+      if(group.revisions[slot] == data.revision)
+      {
+        continue;
+      }
+
+      glBindTexture(GL_TEXTURE_2D_ARRAY, data.arrayID);
+      CGL_System::CheckGLError();
+      FillLayer(textures.first, data, data.layer);
+      group.revisions[slot] = data.revision;
+      ++refilledLayers;
+    }
+  }
+
+  glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+  builtRevision = Texture::GetTextureRevision();
+  isBuilt = true;
+
+  Message("Packed textures into " + to_string(GetArrayCount())
+          + " texture arrays, rebuilt " + to_string(rebuiltGroups)
+          + " groups and refilled " + to_string(refilledLayers) + " layers"
+          , SEVERITY_INFO);
+}
+
+void TextureArrayBuilder::Clear()
+{
+  for(pair<const ArrayKey, ArrayGroup> &group : groups)
+  {
+    DeleteArrays(group.second);
+  }
+  groups.clear();
+
+  Library<Texture::TextureData>::GetInstance().ForEachItem(
+    [](const string &, Texture::TextureData *data)
+    {
+      data->arrayID = 0;
+      data->layer = 0;
+    });
+
+  isBuilt = false;
+}
+
+size_t TextureArrayBuilder::GetArrayCount() const
+{
+  size_t count = 0;
+  for(const pair<const ArrayKey, ArrayGroup> &group : groups)
+  {
+    count += group.second.arrayIDs.size();
+  }
+  return count;
+}
+
+//===================//
+//= Private Methods =//
+//===================//
+
+bool TextureArrayBuilder::ArrayKey::operator<(const ArrayKey &other) const
+{
+  return tie(width, height, format, levelCount)
+         < tie(other.width, other.height, other.format, other.levelCount);
+}
+
+void TextureArrayBuilder::RebuildGroup(const ArrayKey &key
+                                       , ArrayGroup &group)
+{
+  DeleteArrays(group);
+  group.revisions.resize(group.textures.size());
+
+  for(size_t first = 0; first < group.textures.size()
+      ; first += static_cast<size_t>(maxLayers))
+  {
+    const size_t layerCount = min(group.textures.size() - first
+                                  , static_cast<size_t>(maxLayers));
+    const unsigned int arrayID = AllocateArray(key, layerCount);
+
+    for(size_t layer = 0; layer < layerCount; ++layer)
+    {
+      Texture::TextureData *data = group.textures[first + layer];
+      FillLayer(key, *data, static_cast<int>(layer));
+      data->arrayID = arrayID;
+      data->layer = static_cast<int>(layer);
+      group.revisions[first + layer] = data->revision;
+    }
+
+    group.arrayIDs.push_back(arrayID);
+  }
+}
+
+void TextureArrayBuilder::DeleteArrays(ArrayGroup &group)
+{
+  if(!group.arrayIDs.empty())
+  {
+    glDeleteTextures(static_cast<GLsizei>(group.arrayIDs.size())
+                     , group.arrayIDs.data());
+    CGL_System::CheckGLError();
+    group.arrayIDs.clear();
+  }
+}
+
+unsigned int TextureArrayBuilder::AllocateArray(const ArrayKey &key
+                                                , const size_t &layerCount)
+{
+  unsigned int arrayID = 0;
+  glGenTextures(1, &arrayID);
+  CGL_System::CheckGLError();
+  glBindTexture(GL_TEXTURE_2D_ARRAY, arrayID);
+  CGL_System::CheckGLError();
+
+  // Matches the sampling the individual textures used to have
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_BASE_LEVEL, 0);
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL
+                  , static_cast<GLint>(key.levelCount) - 1);
+  CGL_System::CheckGLError();
+
+  const GLenum internalFormat = GetInternalFormat(key.format);
+  const GLsizei layers = static_cast<GLsizei>(layerCount);
+  uint32_t levelWidth = static_cast<uint32_t>(key.width);
+  uint32_t levelHeight = static_cast<uint32_t>(key.height);
+  for(size_t level = 0; level < key.levelCount; ++level)
+  {
+    const GLint mip = static_cast<GLint>(level);
+    if(IsCompressed(key.format))
+    {
+      const uint64_t levelSize = TextureCooker::GetLevelDataSize(
+        key.format, levelWidth, levelHeight);
+      glCompressedTexImage3D(GL_TEXTURE_2D_ARRAY, mip, internalFormat
+                             , levelWidth, levelHeight, layers, 0
+                             , static_cast<GLsizei>(levelSize * layerCount)
+                             , nullptr);
+    }
+    else
+    {
+      glTexImage3D(GL_TEXTURE_2D_ARRAY, mip, internalFormat, levelWidth
+                   , levelHeight, layers, 0, GetPixelFormat(key.format)
+                   , GL_UNSIGNED_BYTE, nullptr);
+    }
+    CGL_System::CheckGLError();
+    levelWidth = max(1u, levelWidth / 2);
+    levelHeight = max(1u, levelHeight / 2);
+  }
+
+  return arrayID;
+}
+
+void TextureArrayBuilder::FillLayer(const ArrayKey &key
+                                    , const Texture::TextureData &data
+                                    , const int &layer)
+{
+  // Raw RGB rows are tightly packed and may not be 4 byte aligned
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  CGL_System::CheckGLError();
+
+  const GLenum internalFormat = GetInternalFormat(key.format);
+  uint32_t levelWidth = static_cast<uint32_t>(key.width);
+  uint32_t levelHeight = static_cast<uint32_t>(key.height);
+  for(size_t level = 0; level < key.levelCount; ++level)
+  {
+    const vector<unsigned char> &levelData = data.levels[level];
+    const GLint mip = static_cast<GLint>(level);
+    if(IsCompressed(key.format))
+    {
+      glCompressedTexSubImage3D(GL_TEXTURE_2D_ARRAY, mip, 0, 0, layer
+                                , levelWidth, levelHeight, 1, internalFormat
+                                , static_cast<GLsizei>(levelData.size())
+                                , levelData.data());
+    }
+    else
+    {
+      glTexSubImage3D(GL_TEXTURE_2D_ARRAY, mip, 0, 0, layer, levelWidth
+                      , levelHeight, 1, GetPixelFormat(key.format)
+                      , GL_UNSIGNED_BYTE, levelData.data());
+    }
+    CGL_System::CheckGLError();
+    levelWidth = max(1u, levelWidth / 2);
+    levelHeight = max(1u, levelHeight / 2);
+  }
+
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+  CGL_System::CheckGLError();
+}
@@ -0,0 +1,452 @@
+/*!
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    CGL_TextureCook.cpp
+ *
+ *  \brief
+ *    The implementation file for cooking textures offline into a GPU ready
+ *    format with every mip level precomputed
+ */
+#include "clapp_includes/pch.h"
+
+#include "clapp_includes/CGL_TextureCook.h"
+
+#include "clapp_includes/Clarity_IO.h"
+
+#include "../external/includes/stb_image.h"
+
+using namespace std;
+using namespace ClaPP;
+
+//=================//
+//= Local Helpers =//
+//=================//
+
+static uint32_t AlignUp4(const uint32_t &value)
+{
+  return (value + 3u) & ~3u;
+}
+
+static uint16_t PackColor565(const int &r, const int &g, const int &b)
+{
+  return static_cast<uint16_t>(((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3));
+}
+
+static void UnpackColor565(const uint16_t &color, int rgb[3])
+{
+  // Replicate the high bits into the low bits so 0x1F maps to 255
+  const int r = (color >> 11) & 0x1F;
+  const int g = (color >> 5) & 0x3F;
+  const int b = color & 0x1F;
+  rgb[0] = (r << 3) | (r >> 2);
+  rgb[1] = (g << 2) | (g >> 4);
+  rgb[2] = (b << 3) | (b >> 2);
+}
+
+static void WriteLE16(vector<unsigned char> &out, const uint16_t &value)
+{
+  out.push_back(static_cast<unsigned char>(value & 0xFF));
+  out.push_back(static_cast<unsigned char>(value >> 8));
+}
+
+/*
+ * Encodes the 8 byte color part of a block by fitting a line through the
+ * bounding box of the block's colors. BC3 color blocks are always decoded
+ * in 4 color mode so c0 > c1 is enforced for both formats.
+ */
+static void EncodeColorBlock(const unsigned char block[16][4]
+                             , vector<unsigned char> &out)
+{
+  int minColor[3] = {255, 255, 255};
+  int maxColor[3] = {0, 0, 0};
+  for(int i = 0; i < 16; ++i)
+  {
+    for(int c = 0; c < 3; ++c)
+    {
+      minColor[c] = min(minColor[c], static_cast<int>(block[i][c]));
+      maxColor[c] = max(maxColor[c], static_cast<int>(block[i][c]));
+    }
+  }
+
+  // Inset the box slightly which lowers the error of the two
+  // interpolated colors
+  for(int c = 0; c < 3; ++c)
+  {
+    const int inset = (maxColor[c] - minColor[c]) >> 4;
+    minColor[c] = min(255, minColor[c] + inset);
+    maxColor[c] = max(0, maxColor[c] - inset);
+  }
+
+  uint16_t color0 = PackColor565(maxColor[0], maxColor[1], maxColor[2]);
+  uint16_t color1 = PackColor565(minColor[0], minColor[1], minColor[2]);
+  if(color0 < color1)
+  {
+    swap(color0, color1);
+  }
+
+  uint32_t indices = 0u;
+  if(color0 != color1)
+  {
+    int palette[4][3];
+    UnpackColor565(color0, palette[0]);
+    UnpackColor565(color1, palette[1]);
+    for(int c = 0; c < 3; ++c)
+    {
+      palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+      palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+    }
+
+    for(int i = 0; i < 16; ++i)
+    {
+      int bestIndex = 0;
+      int bestError = numeric_limits<int>::max();
+      for(int p = 0; p < 4; ++p)
+      {
+        int error = 0;
+        for(int c = 0; c < 3; ++c)
+        {
+          const int diff = static_cast<int>(block[i][c]) - palette[p][c];
+          error += diff * diff;
+        }
+        if(error < bestError)
+        {
+          bestError = error;
+          bestIndex = p;
+        }
+      }
+      indices |= static_cast<uint32_t>(bestIndex) << (2 * i);
+    }
+  }
+
+  WriteLE16(out, color0);
+  WriteLE16(out, color1);
+  for(int i = 0; i < 4; ++i)
+  {
+    out.push_back(static_cast<unsigned char>((indices >> (8 * i)) & 0xFF));
+  }
+}
+
+/*
+ * Encodes the 8 byte alpha part of a BC3 block using the block's alpha
+ * range as the two endpoints and 6 interpolated values between them
+ */
+static void EncodeAlphaBlock(const unsigned char block[16][4]
+                             , vector<unsigned char> &out)
+{
+  int alpha0 = 0;
+  int alpha1 = 255;
+  for(int i = 0; i < 16; ++i)
+  {
+    alpha0 = max(alpha0, static_cast<int>(block[i][3]));
+    alpha1 = min(alpha1, static_cast<int>(block[i][3]));
+  }
+
+  uint64_t indices = 0u;
+  if(alpha0 != alpha1)
+  {
+    int palette[8];
+    palette[0] = alpha0;
+    palette[1] = alpha1;
+    for(int p = 1; p < 7; ++p)
+    {
+      palette[p + 1] = ((7 - p) * alpha0 + p * alpha1) / 7;
+    }
+
+    for(int i = 0; i < 16; ++i)
+    {
+      int bestIndex = 0;
+      int bestError = numeric_limits<int>::max();
+      for(int p = 0; p < 8; ++p)
+      {
+        const int error = abs(static_cast<int>(block[i][3]) - palette[p]);
+        if(error < bestError)
+        {
+          bestError = error;
+          bestIndex = p;
+        }
+      }
+      indices |= static_cast<uint64_t>(bestIndex) << (3 * i);
+    }
+  }
+
+  out.push_back(static_cast<unsigned char>(alpha0));
+  out.push_back(static_cast<unsigned char>(alpha1));
+  for(int i = 0; i < 6; ++i)
+  {
+    out.push_back(static_cast<unsigned char>((indices >> (8 * i)) & 0xFF));
+  }
+}
+
+//==================//
+//= Public Methods =//
+//==================//
+
+TextureCooker::COOK_ERR TextureCooker::CookTexture(const string &sourcePath
+                                                   , const string &cookedPath
+                                                   , const bool &blockCompress)
+{
+  int width, height, channels;
+  unsigned char *imageData = stbi_load(sourcePath.c_str(), &width, &height
+                                       , &channels, 0);
+  if(!imageData)
+  {
+    ErrMessage("Failed to decode texture for cooking: " + sourcePath
+               , EC_GRAPHICS);
+    return COOK_FAILED_TO_DECODE;
+  }
+  if(channels != 3 && channels != 4)
+  {
+    ErrMessage("Invalid number of channels gotten from image: " + sourcePath
+               , EC_GRAPHICS);
+    stbi_image_free(imageData);
+    return COOK_UNSUPPORTED_CHANNELS;
+  }
+
+  vector<vector<unsigned char>> levels;
+  BuildMipChain(imageData, width, height, channels, levels);
+  stbi_image_free(imageData);
+
+  CookedTextureHeader header{};
+  memcpy(header.magic, COOKED_MAGIC, sizeof(COOKED_MAGIC));
+  header.version = COOKED_VERSION;
+  header.width = static_cast<uint32_t>(width);
+  header.height = static_cast<uint32_t>(height);
+  header.mipCount = static_cast<uint32_t>(levels.size());
+  if(blockCompress)
+  {
+    header.format = channels == 4 ? COOKED_BC3 : COOKED_BC1;
+  }
+  else
+  {
+    header.format = channels == 4 ? COOKED_RGBA8 : COOKED_RGB8;
+  }
+
+  vector<CookedMipLevel> levelTable(levels.size());
+  vector<unsigned char> levelData;
+  vector<unsigned char> blocks;
+  uint32_t offset = static_cast<uint32_t>(
+    sizeof(CookedTextureHeader) + levels.size() * sizeof(CookedMipLevel));
+
+  uint32_t levelWidth = header.width;
+  uint32_t levelHeight = header.height;
+  for(size_t i = 0; i < levels.size(); ++i)
+  {
+    const vector<unsigned char> *stored = &levels[i];
+    if(blockCompress)
+    {
+      CompressBlocks(levels[i].data(), levelWidth, levelHeight, channels
+                     , blocks);
+      stored = &blocks;
+    }
+
+    offset = AlignUp4(offset);
+    levelData.resize(offset - sizeof(CookedTextureHeader)
+                     - levels.size() * sizeof(CookedMipLevel));
+
+    levelTable[i] = {levelWidth, levelHeight, offset
+                     , static_cast<uint32_t>(stored->size())};
+    levelData.insert(levelData.end(), stored->begin(), stored->end());
+    offset += static_cast<uint32_t>(stored->size());
+
+    levelWidth = max(1u, levelWidth / 2);
+    levelHeight = max(1u, levelHeight / 2);
+  }
+
+  ofstream file(cookedPath, ios::binary | ios::trunc);
+  if(!file.is_open())
+  {
+    ErrMessage("Failed to open cooked texture for writing: " + cookedPath
+               , EC_GRAPHICS);
+    return COOK_FAILED_TO_WRITE;
+  }
+
+  file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  file.write(reinterpret_cast<const char *>(levelTable.data())
+             , levelTable.size() * sizeof(CookedMipLevel));
+  file.write(reinterpret_cast<const char *>(levelData.data())
+             , levelData.size());
+
+  if(!file.good())
+  {
+    return COOK_FAILED_TO_WRITE;
+  }
+
+  Message("Cooked texture: " + sourcePath + " into: " + cookedPath + " with "
+          + to_string(header.mipCount) + " mip levels", SEVERITY_INFO);
+
+  return COOK_NO_ERR;
+}
+
+void TextureCooker::BuildMipChain(const unsigned char *pixels
+                                  , const uint32_t &width
+                                  , const uint32_t &height
+                                  , const uint32_t &channels
+                                  , vector<vector<unsigned char>> &levels)
+{
+  levels.clear();
+  levels.emplace_back(pixels, pixels + width * height * channels);
+
+  uint32_t srcWidth = width;
+  uint32_t srcHeight = height;
+
+  // Halve until both dimensions reach 1 like glGenerateMipmap does
+  while(srcWidth > 1 || srcHeight > 1)
+  {
+    const uint32_t dstWidth = max(1u, srcWidth / 2);
+    const uint32_t dstHeight = max(1u, srcHeight / 2);
+    const vector<unsigned char> &src = levels.back();
+    vector<unsigned char> dst(dstWidth * dstHeight * channels);
+
+    for(uint32_t y = 0; y < dstHeight; ++y)
+    {
+      // Clamp so a dimension of 1 samples the same row/column twice
+      const uint32_t y0 = min(y * 2, srcHeight - 1);
+      const uint32_t y1 = min(y * 2 + 1, srcHeight - 1);
+      for(uint32_t x = 0; x < dstWidth; ++x)
+      {
+        const uint32_t x0 = min(x * 2, srcWidth - 1);
+        const uint32_t x1 = min(x * 2 + 1, srcWidth - 1);
+        for(uint32_t c = 0; c < channels; ++c)
+        {
+          const uint32_t sum = src[(y0 * srcWidth + x0) * channels + c]
+                               + src[(y0 * srcWidth + x1) * channels + c]
+                               + src[(y1 * srcWidth + x0) * channels + c]
+                               + src[(y1 * srcWidth + x1) * channels + c];
+          // Round to nearest instead of truncating so levels don't darken
+          dst[(y * dstWidth + x) * channels + c]
+            = static_cast<unsigned char>((sum + 2) / 4);
+        }
+      }
+    }
+
+    // src is not used past here as push_back may reallocate the levels
+    levels.push_back(std::move(dst));
+    srcWidth = dstWidth;
+    srcHeight = dstHeight;
+  }
+}
+
+void TextureCooker::CompressBlocks(const unsigned char *pixels
+                                   , const uint32_t &width
+                                   , const uint32_t &height
+                                   , const uint32_t &channels
+                                   , vector<unsigned char> &blocks)
+{
+  const uint32_t blocksX = (width + 3) / 4;
+  const uint32_t blocksY = (height + 3) / 4;
+  const uint32_t blockSize = channels == 4 ? 16u : 8u;
+
+  blocks.clear();
+  blocks.reserve(blocksX * blocksY * blockSize);
+
+  unsigned char block[16][4];
+  for(uint32_t by = 0; by < blocksY; ++by)
+  {
+    for(uint32_t bx = 0; bx < blocksX; ++bx)
+    {
+      // Gather the 4x4 block clamping at the image edges
+      for(uint32_t py = 0; py < 4; ++py)
+      {
+        const uint32_t y = min(by * 4 + py, height - 1);
+        for(uint32_t px = 0; px < 4; ++px)
+        {
+          const uint32_t x = min(bx * 4 + px, width - 1);
+          const unsigned char *pixel = pixels + (y * width + x) * channels;
+          unsigned char *texel = block[py * 4 + px];
+          texel[0] = pixel[0];
+          texel[1] = pixel[1];
+          texel[2] = pixel[2];
+          texel[3] = channels == 4 ? pixel[3] : 255;
+        }
+      }
+
+      // BC3 stores the alpha block before the color block
+      if(channels == 4)
+      {
+        EncodeAlphaBlock(block, blocks);
+      }
+      EncodeColorBlock(block, blocks);
+    }
+  }
+}
+
+TextureCooker::COOK_ERR TextureCooker::ParseCookedTexture(
+  const string &fileData, CookedTexture &texture)
+{
+  if(fileData.size() < sizeof(CookedTextureHeader))
+  {
+    return COOK_INVALID_FORMAT;
+  }
+
+  memcpy(&texture.header, fileData.data(), sizeof(CookedTextureHeader));
+  const CookedTextureHeader &header = texture.header;
+
+  if(memcmp(header.magic, COOKED_MAGIC, sizeof(COOKED_MAGIC)) != 0
+     || header.version != COOKED_VERSION
+     || header.format > COOKED_BC3
+     || header.mipCount == 0 || header.mipCount > 32
+     || fileData.size() < sizeof(CookedTextureHeader)
+                          + header.mipCount * sizeof(CookedMipLevel))
+  {
+    return COOK_INVALID_FORMAT;
+  }
+
+  texture.levels.resize(header.mipCount);
+  memcpy(texture.levels.data(), fileData.data() + sizeof(CookedTextureHeader)
+         , header.mipCount * sizeof(CookedMipLevel));
+
+  // Make sure every level lies within the file and holds exactly what its
+  // size says before it is uploaded, as the driver reads by the size
+  uint32_t levelWidth = header.width;
+  uint32_t levelHeight = header.height;
+  for(const CookedMipLevel &level : texture.levels)
+  {
+    if(level.width != levelWidth || level.height != levelHeight
+       || level.width == 0 || level.height == 0
+       || level.dataSize != GetLevelDataSize(header.format, level.width
+                                             , level.height)
+       || level.dataOffset > fileData.size()
+       || level.dataSize > fileData.size() - level.dataOffset)
+    {
+      return COOK_INVALID_FORMAT;
+    }
+
+    levelWidth = max(1u, levelWidth / 2);
+    levelHeight = max(1u, levelHeight / 2);
+  }
+
+  texture.data = reinterpret_cast<const unsigned char *>(fileData.data());
+
+  return COOK_NO_ERR;
+}
+
+uint64_t TextureCooker::GetLevelDataSize(const uint32_t &format
+                                         , const uint32_t &width
+                                         , const uint32_t &height)
+{
+  const uint64_t blocks = ((uint64_t(width) + 3u) / 4u)
+                          * ((uint64_t(height) + 3u) / 4u);
+  switch(format)
+  {
+    case COOKED_RGB8:
+      return uint64_t(width) * height * 3u;
+    case COOKED_RGBA8:
+      return uint64_t(width) * height * 4u;
+    case COOKED_BC1:
+      return blocks * 8u;
+    case COOKED_BC3:
+      return blocks * 16u;
+    default:
+      return 0u;
+  }
+}
+
+bool TextureCooker::IsCookedTexturePath(const string &filePath)
+{
+  return filePath.size() >= COOKED_EXTENSION.size()
+    && filePath.compare(filePath.size() - COOKED_EXTENSION.size()
+                        , COOKED_EXTENSION.size(), COOKED_EXTENSION) == 0;
+}
@@ -0,0 +1,321 @@
+/*
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    CIL_InputTrace.cpp
+ *
+ *  \brief
+ *    An implementation for recording the input of every frame to a file and
+ *    playing it back in place of the window
+*/
+
+#include "clapp_includes/pch.h"
+
+#include "clapp_includes/CIL_InputTrace.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+#include "clapp_includes/Clarity_IO.h"
+
+using namespace std;
+
+namespace ClaPP
+{
+//=================//
+//= CTOR and DTOR =//
+//=================//
+
+InputTrace &InputTrace::GetInstance()
+{
+  static InputTrace instance;
+  return instance;
+}
+
+InputTrace::InputTrace()
+: mode(TRACE_OFF), tracePath(), recordFile(), replayFile()
+  , isHeaderWritten(false), frameCount(0u), frameDelta(0.f)
+  , previousBits(0u), frameActions(), actionRemap(), replayTime(0.0)
+  , timedFrames(0u), slowestFrame(0.f)
+{
+
+}
+
+InputTrace::~InputTrace()
+{
+  Stop();
+}
+
+//==================//
+//= Public Methods =//
+//==================//
+
+InputTrace::TRACE_ERR InputTrace::StartRecording(const string &_tracePath)
+{
+  if(mode != TRACE_OFF)
+  {
+    ErrMessage("An input trace is already active: " + tracePath, EC_INPUT);
+    return TRACE_ALREADY_ACTIVE;
+  }
+
+  recordFile.open(_tracePath, ios::binary | ios::trunc);
+  if(!recordFile.is_open())
+  {
+    ErrMessage("Failed to open input trace for recording: " + _tracePath
+               , EC_INPUT);
+    return TRACE_FAILED_TO_OPEN;
+  }
+
+  mode = TRACE_RECORDING;
+  tracePath = _tracePath;
+  isHeaderWritten = false;
+  frameCount = 0u;
+  frameDelta = 0.f;
+  previousBits = 0u;
+  return TRACE_NO_ERR;
+}
+
+InputTrace::TRACE_ERR InputTrace::StartReplay(const string &_tracePath)
+{
+  if(mode != TRACE_OFF)
+  {
+    ErrMessage("An input trace is already active: " + tracePath, EC_INPUT);
+    return TRACE_ALREADY_ACTIVE;
+  }
+
+  replayFile.open(_tracePath, ios::binary);
+  if(!replayFile.is_open())
+  {
+    ErrMessage("Failed to open input trace for replay: " + _tracePath
+               , EC_INPUT);
+    return TRACE_FAILED_TO_OPEN;
+  }
+  if(!ReadHeader())
+  {
+    ErrMessage("Invalid input trace: " + _tracePath, EC_INPUT);
+    replayFile.close();
+    return TRACE_INVALID_FILE;
+  }
+
+  mode = TRACE_REPLAYING;
+  tracePath = _tracePath;
+  frameCount = 0u;
+  frameDelta = 0.f;
+  previousBits = 0u;
+  frameActions.reset();
+  replayTime = 0.0;
+  timedFrames = 0u;
+  slowestFrame = 0.f;
+  return TRACE_NO_ERR;
+}
+
+void InputTrace::Stop()
+{
+  if(mode == TRACE_RECORDING)
+  {
+    // A session too short to reach a frame still leaves a valid trace
+    if(!isHeaderWritten)
+    {
+      WriteHeader();
+    }
+    recordFile.close();
+    Message("Recorded " + to_string(frameCount) + " frames of input to: "
+            + tracePath, SEVERITY_INFO);
+  }
+  else if(mode == TRACE_REPLAYING)
+  {
+    replayFile.close();
+    const double averageFrame = timedFrames
+      ? replayTime / static_cast<double>(timedFrames) : 0.0;
+    Message("Replayed " + to_string(frameCount) + " frames of input from: "
+            + tracePath + ", average frame "
+            + to_string(averageFrame * 1000.0) + "ms, slowest frame "
+            + to_string(slowestFrame * 1000.f) + "ms", SEVERITY_INFO);
+  }
+
+  mode = TRACE_OFF;
+}
+
+bool InputTrace::BeginFrame(float &deltaTime)
+{
+  if(mode == TRACE_RECORDING)
+  {
+    frameDelta = deltaTime;
+    return true;
+  }
+  if(mode != TRACE_REPLAYING)
+  {
+    return true;
+  }
+
+  // The measured delta is how long the last replayed frame really took,
+  // the first frame measures startup instead
+  if(frameCount > 0u)
+  {
+    replayTime += deltaTime;
+    ++timedFrames;
+    slowestFrame = max(slowestFrame, deltaTime);
+  }
+
+  uint8_t flags = 0u;
+  if(!replayFile.read(reinterpret_cast<char *>(&flags), sizeof(flags))
+     || !replayFile.read(reinterpret_cast<char *>(&frameDelta)
+                         , sizeof(frameDelta)))
+  {
+    return false;
+  }
+  if(flags & FRAME_ACTIONS_CHANGED)
+  {
+    if(!replayFile.read(reinterpret_cast<char *>(&previousBits)
+                        , sizeof(previousBits)))
+    {
+      ErrMessage("Input trace ended within a frame: " + tracePath, EC_INPUT);
+      return false;
+    }
+    frameActions = RemapActions(previousBits);
+  }
+
+  deltaTime = frameDelta;
+  ++frameCount;
+  return true;
+}
+
+void InputTrace::RecordFrame(const KeyBindContainer::ActionState &actions)
+{
+  if(mode != TRACE_RECORDING)
+  {
+    return;
+  }
+  if(!isHeaderWritten)
+  {
+    WriteHeader();
+  }
+
+  const uint64_t bits = actions.to_ullong();
+  const uint8_t flags = bits != previousBits
+                        ? static_cast<uint8_t>(FRAME_ACTIONS_CHANGED)
+                        : static_cast<uint8_t>(0u);
+  recordFile.write(reinterpret_cast<const char *>(&flags), sizeof(flags));
+  recordFile.write(reinterpret_cast<const char *>(&frameDelta)
+                   , sizeof(frameDelta));
+  if(flags & FRAME_ACTIONS_CHANGED)
+  {
+    recordFile.write(reinterpret_cast<const char *>(&bits), sizeof(bits));
+    previousBits = bits;
+  }
+  ++frameCount;
+}
+
+const KeyBindContainer::ActionState &InputTrace::GetFrameActions() const
+{
+  return frameActions;
+}
+
+const InputTrace::TRACE_MODE &InputTrace::GetMode() const
+{
+  return mode;
+}
+
+bool InputTrace::IsRecording() const
+{
+  return mode == TRACE_RECORDING;
+}
+
+bool InputTrace::IsReplaying() const
+{
+  return mode == TRACE_REPLAYING;
+}
+
+uint64_t InputTrace::GetFrameCount() const
+{
+  return frameCount;
+}
+
+//===================//
+//= Private Methods =//
+//===================//
+
+void InputTrace::WriteHeader()
+{
+  const KeyBindContainer *container = KeyBindContainer::GetInstance();
+
+  TraceHeader header;
+  memcpy(header.magic, TRACE_MAGIC, sizeof(TRACE_MAGIC));
+  header.version = TRACE_VERSION;
+  header.actionCount = container->GetActionCount();
+  header.padding = 0u;
+  recordFile.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+  for(uint32_t i = 0; i < header.actionCount; ++i)
+  {
+    const string &name = container->GetActionName(i);
+    const uint8_t length
+      = static_cast<uint8_t>(min<size_t>(name.size(), UINT8_MAX));
+    recordFile.write(reinterpret_cast<const char *>(&length)
+                     , sizeof(length));
+    recordFile.write(name.data(), length);
+  }
+
+  isHeaderWritten = true;
+}
+
+bool InputTrace::ReadHeader()
+{
+  TraceHeader header;
+  if(!replayFile.read(reinterpret_cast<char *>(&header), sizeof(header))
+     || memcmp(header.magic, TRACE_MAGIC, sizeof(TRACE_MAGIC)) != 0
+     || header.version != TRACE_VERSION
+     || header.actionCount > KeyBindContainer::MAX_ACTIONS)
+  {
+    return false;
+  }
+
+  // Registering the recorded names gives actions this build has not yet
+  // registered the ids its systems will resolve them to later
+  KeyBindContainer *container = KeyBindContainer::GetInstance();
+  actionRemap.assign(header.actionCount, KeyBindContainer::INVALID_ACTION);
+  string name;
+  for(uint32_t i = 0; i < header.actionCount; ++i)
+  {
+    uint8_t length = 0u;
+    if(!replayFile.read(reinterpret_cast<char *>(&length), sizeof(length)))
+    {
+      return false;
+    }
+    name.resize(length);
+    if(!replayFile.read(name.data(), length))
+    {
+      return false;
+    }
+    actionRemap[i] = container->RegisterAction(name);
+  }
+
+  return true;
+}
+
+KeyBindContainer::ActionState InputTrace::RemapActions(
+  const uint64_t &bits) const
+{
+  KeyBindContainer::ActionState actions;
+  uint64_t remaining = bits;
+  while(remaining)
+  {
+    const uint32_t recorded = static_cast<uint32_t>(countr_zero(remaining));
+    remaining &= remaining - 1;
+    // Bits past the name table came from actions registered after the
+    // first frame and can not be resolved
+    if(recorded < actionRemap.size())
+    {
+      const KeyBindContainer::ACTION_ID actionID = actionRemap[recorded];
+      if(actionID < KeyBindContainer::MAX_ACTIONS)
+      {
+        actions.set(actionID);
+      }
+    }
+  }
+  return actions;
+}
+}
@@ -40,6 +40,34 @@ PlayerControllerSystem::~PlayerControllerSystem()
 
 PlayerControllerSystem::SYS_ERR PlayerControllerSystem::Initialize()
 {
+  // Registering is the same as looking up an action that is already bound
+  // so the order systems initialize in does not matter
+  KeyBindContainer *container = KeyBindContainer::GetInstance();
+  auto addAction = [this, container](const KeyBindContainer::KEY_EVENT &event
+                                     , const glm::vec3 &appliedForce
+                                     , const glm::vec3 &rotationForce)
+  {
+    actionForces.push_back({container->RegisterAction(event), appliedForce
+                            , rotationForce});
+  };
+
+  // Movement accelerates against the physics system's drag of 3 to a top
+  // speed of 1.8 units a second, turning is 60 degrees a second
+  const glm::vec3 none = {0.f, 0.f, 0.f};
+  actionForces.clear();
+  addAction("MovePositiveX", {5.4f, 0.f, 0.f}, none);
+  addAction("MoveNegativeX", {-5.4f, 0.f, 0.f}, none);
+  addAction("MovePositiveY", {0.f, 5.4f, 0.f}, none);
+  addAction("MoveNegativeY", {0.f, -5.4f, 0.f}, none);
+  addAction("MovePositiveZ", {0.f, 0.f, 5.4f}, none);
+  addAction("MoveNegativeZ", {0.f, 0.f, -5.4f}, none);
+  addAction("RotatePositiveX", none, {60.f, 0.f, 0.f});
+  addAction("RotateNegativeX", none, {-60.f, 0.f, 0.f});
+  addAction("RotatePositiveY", none, {0.f, 60.f, 0.f});
+  addAction("RotateNegativeY", none, {0.f, -60.f, 0.f});
+  addAction("RotatePositiveZ", none, {0.f, 0.f, 60.f});
+  addAction("RotateNegativeZ", none, {0.f, 0.f, -60.f});
+
   return SYS_NO_ERR;
 }
 
@@ -79,53 +107,21 @@ PlayerControllerSystem::SYS_ERR PlayerControllerSystem::Update(float deltaTime)
   physicsData.appliedForce = {0.f, 0.f, 0.f};
   physicsData.rotationForce = {0.f, 0.f, 0.f};
 
-  if(container->CheckEvent("MovePositiveX"))
-  {
-    physicsData.appliedForce += glm::vec3{0.03f, 0.f, 0.f};
-  }
-  if(container->CheckEvent("MoveNegativeX"))
-  {
-    physicsData.appliedForce += glm::vec3{-0.03f, 0.f, 0.f};
-  }
-  if(container->CheckEvent("MovePositiveY"))
-  {
-    physicsData.appliedForce += glm::vec3{0.f, 0.03f, 0.f};
-  }
-  if(container->CheckEvent("MoveNegativeY"))
-  {
-    physicsData.appliedForce += glm::vec3{0.f, -0.03f, 0.f};
-  }
-  if(container->CheckEvent("MovePositiveZ"))
-  {
-    physicsData.appliedForce += glm::vec3{0.f, 0.f, 0.03f};
-  }
-  if(container->CheckEvent("MoveNegativeZ"))
+  // Nothing is pressed on most frames so skip the whole table at once
+  const KeyBindContainer::ActionState &actionState 
+    = container->GetActionState();
+  if(actionState.none())
   {
-    physicsData.appliedForce += glm::vec3{0.f, 0.f, -0.03f};
+    return SYS_NO_ERR;
   }
-  if(container->CheckEvent("RotatePositiveX"))
-  {
-    physicsData.rotationForce += glm::vec3{1.f, 0.f, 0.f};
-  }
-  if(container->CheckEvent("RotateNegativeX"))
-  {
-    physicsData.rotationForce += glm::vec3{-1.f, 0.f, 0.f};
-  }
-  if(container->CheckEvent("RotatePositiveY"))
-  {
-    physicsData.rotationForce += glm::vec3{0.f, 1.f, 0.f};
-  }
-  if(container->CheckEvent("RotateNegativeY"))
-  {
-    physicsData.rotationForce += glm::vec3{0.f, -1.f, 0.f};
-  }
-  if(container->CheckEvent("RotatePositiveZ"))
-  {
-    physicsData.rotationForce += glm::vec3{0.f, 0.f, 1.f};
-  }
-  if(container->CheckEvent("RotateNegativeZ"))
+
+  for(const ActionForce &actionForce : actionForces)
   {
-    physicsData.rotationForce += glm::vec3{0.f, 0.f, -1.f};
+    if(container->CheckAction(actionForce.actionID))
+    {
+      physicsData.appliedForce += actionForce.appliedForce;
+      physicsData.rotationForce += actionForce.rotationForce;
+    }
   }
 
   // Update all entities with new force values
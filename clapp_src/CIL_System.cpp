@@ -12,6 +12,7 @@
 #include "clapp_includes/pch.h"
 #include "clapp_includes/g_pch.h"
 #include "clapp_includes/CIL_System.h"
+#include "clapp_includes/CIL_InputTrace.h"
 
 #include "clapp_includes/Clarity_Entity.h"
 #include "clapp_includes/Clarity_IO.h"
@@ -21,6 +22,8 @@
 #include "clapp_includes/Clarity_ECS.h"
 #include <GLFW/glfw3.h>
 
+#include <bit>
+
 using namespace ClaPP;
 using namespace std;
 
@@ -79,9 +82,28 @@ Input_System::SYS_ERR Input_System::Initialize()
   keyPairs.push_back({"X", KeyBindContainer::KEY_X});
   keyPairs.push_back({"Y", KeyBindContainer::KEY_Y});
   keyPairs.push_back({"Z", KeyBindContainer::KEY_Z});
+  keyPairs.push_back({"Space", KeyBindContainer::KEY_SPACE});
+  keyPairs.push_back({"MouseLeft", KeyBindContainer::KEY_MOUSE_LEFT});
+  keyPairs.push_back({"MouseRight", KeyBindContainer::KEY_MOUSE_RIGHT});
+  keyPairs.push_back({"MouseMiddle", KeyBindContainer::KEY_MOUSE_MIDDLE});
   // Create table for keys
   LuaState::GetInstance().CreateEnum("Keys", keyPairs);
 
+  // Binds name the keys and statuses so they are loaded once both exist,
+  // a missing bind file is reported but leaves the game running unbound
+  KeyBindContainer::GetInstance()->LoadBinds(PLAYER_BINDS_PATH);
+
+  // Keys are reported by the window as they change instead of every bound
+  // key being polled each frame
+  GLFWwindow *window = glfwGetCurrentContext();
+  if(!window)
+  {
+    ErrMessage("No window to capture input from", EC_INPUT);
+    return SYS_FAILED_TO_INITIALIZE;
+  }
+  glfwSetKeyCallback(window, KeyCallback);
+  glfwSetMouseButtonCallback(window, MouseButtonCallback);
+
   return SYS_NO_ERR;
 }
 
@@ -93,8 +115,7 @@ Input_System::SYS_ERR Input_System::Load()
 Input_System::SYS_ERR Input_System::Update(float deltaTime)
 {
   ECS *ecs = GetECSPtr();
-  GLFWwindow *window = glfwGetCurrentContext();
-  
+
   // Single only the worl will ever have the keybind container we only
   // need to update it
   KeyBindContainer *container =
@@ -109,48 +130,92 @@ Input_System::SYS_ERR Input_System::Update(float deltaTime)
 
   // Clear the event queue
   container->ClearTriggeredEvents();
-  // For every key input the 
-  for(std::map<KeyBindContainer::KEYS
-      , KeyBindContainer::KeyBind>::iterator it 
-      = container->GetKeyBindBegin(); it != container->GetKeyBindEnd(); ++it)
+  container->ApplyKeyTransitions();
+
+  // A replay feeds back the recorded actions, keys pressed meanwhile are
+  // drained above but never reach the game
+  InputTrace &trace = InputTrace::GetInstance();
+  if(trace.IsReplaying())
   {
-    // TODO: Figure out a good way to override keys
-    switch(glfwGetKey(window, KeyBindContainer::ConvertToGLFWKey(it->first)))
+    container->SetActionState(trace.GetFrameActions());
+    return SYS_NO_ERR;
+  }
+
+  const KeyBindContainer::KeyState &downKeys = container->GetDownKeys();
+  const KeyBindContainer::KeyState &pressedKeys = container->GetPressedKeys();
+  const KeyBindContainer::KeyState &releasedKeys 
+    = container->GetReleasedKeys();
+
+  // Only keys that are down or changed can trigger, along with keys that
+  // were active last frame so their status returns to none
+  const KeyBindContainer::KeyState activeKeys 
+    = downKeys | pressedKeys | releasedKeys;
+  uint64_t keyBits = (activeKeys | previousActiveKeys).to_ullong();
+  previousActiveKeys = activeKeys;
+
+  while(keyBits)
+  {
+    const KeyBindContainer::KEYS key 
+      = static_cast<KeyBindContainer::KEYS>(countr_zero(keyBits));
+    // Clear the lowest set bit
+    keyBits &= keyBits - 1;
+
+    KeyBindContainer::KeyBind *bind = container->GetKeyBind(key);
+    if(!bind)
+    {
+      continue;
+    }
+
+    const bool isPressed = pressedKeys.test(key);
+    const bool isReleased = releasedKeys.test(key);
+    const bool isDown = downKeys.test(key);
+
+    // A release is reported over a press so a tap still ends released
+    if(isReleased)
+    {
+      bind->currentStatus = KeyBindContainer::KEY_STATUS_RELEASED;
+    }
+    else if(isPressed)
     {
-    // If the key is currently pressed then either set it to held or set it
-    // as triggered
-    case GLFW_PRESS:
-      it->second.currentStatus = it->second.currentStatus 
-          == KeyBindContainer::KEY_STATUS_TRIGGERED 
-          ? KeyBindContainer::KEY_STATUS_HELD 
-          : KeyBindContainer::KEY_STATUS_TRIGGERED;
+      bind->currentStatus = KeyBindContainer::KEY_STATUS_TRIGGERED;
+    }
+    else if(isDown)
+    {
+      bind->currentStatus = KeyBindContainer::KEY_STATUS_HELD;
+    }
+    else
+    {
+      bind->currentStatus = KeyBindContainer::KEY_STATUS_NONE;
+    }
+
+    // Queue any events that can be triggered, a press and release within
+    // one frame triggers both
+    bool isTriggered = false;
+    switch(bind->triggerStatus)
+    {
+    case KeyBindContainer::KEY_STATUS_TRIGGERED:
+      isTriggered = isPressed;
+      break;
+    case KeyBindContainer::KEY_STATUS_HELD:
+      isTriggered = isDown && !isPressed;
       break;
-    case GLFW_REPEAT:
-      it->second.currentStatus = KeyBindContainer::KEY_STATUS_HELD;
+    case KeyBindContainer::KEY_STATUS_DOWN:
+      isTriggered = isDown || isPressed;
       break;
-    // Set the status to released if glfw notates release 
-    case GLFW_RELEASE:
-      it->second.currentStatus = KeyBindContainer::KEY_STATUS_RELEASED;
+    case KeyBindContainer::KEY_STATUS_RELEASED:
+      isTriggered = isReleased;
       break;
     default:
-        it->second.currentStatus = KeyBindContainer::KEY_STATUS_NONE;
-    }
-    // Queue any events that can be triggered
-    if(it->second.currentStatus == it->second.triggerStatus)
-    {
-      container->TriggerEvent(it->second.keyEvent);
+      break;
     }
-    // TODO: Make a better way of detecting down status
-    else if(it->second.triggerStatus == KeyBindContainer::KEY_STATUS_DOWN
-        && ((it->second.currentStatus 
-        == KeyBindContainer::KEY_STATUS_TRIGGERED)
-        || (it->second.currentStatus
-        == KeyBindContainer::KEY_STATUS_HELD)))
+    if(isTriggered)
     {
-      container->TriggerEvent(it->second.keyEvent);
+      container->TriggerAction(bind->actionID);
     }
   }
 
+  trace.RecordFrame(container->GetActionState());
+
   return SYS_NO_ERR;
 }
 
@@ -168,3 +233,23 @@ Input_System::SYS_ERR Input_System::Terminate()
 {
   return SYS_NO_ERR;
 }
+
+void Input_System::KeyCallback(GLFWwindow *, int key, int, int action
+                               , int)
+{
+  // Repeats are covered by the key staying down
+  if(action == GLFW_REPEAT)
+  {
+    return;
+  }
+  KeyBindContainer::GetInstance()->QueueKeyTransition(
+    KeyBindContainer::ConvertFromGLFWKey(key), action == GLFW_PRESS);
+}
+
+void Input_System::MouseButtonCallback(GLFWwindow *, int button
+                                       , int action, int)
+{
+  KeyBindContainer::GetInstance()->QueueKeyTransition(
+    KeyBindContainer::ConvertFromGLFWMouseButton(button)
+    , action == GLFW_PRESS);
+}
@@ -0,0 +1,564 @@
+/*
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    CPL_AABBTree.cpp
+ *
+ *  \brief
+ *    An implementation for a bounding volume hierarchy that is kept up to
+ *    date as bodies move, used for collision pairs, queries, and culling
+*/
+
+#include "clapp_includes/pch.h"
+
+#include "clapp_includes/CPL_AABBTree.h"
+
+#include <algorithm>
+
+#include "clapp_includes/Clarity_IO.h"
+
+using namespace std;
+
+namespace ClaPP
+{
+//=================//
+//= CTOR and DTOR =//
+//=================//
+
+AABBTree::AABBTree(const float &_margin)
+: margin(_margin), nodes(), root(NULL_NODE), freeList(NULL_NODE)
+  , proxyCount(0u)
+{
+
+}
+
+AABBTree::~AABBTree()
+{
+
+}
+
+TreeBroadphase::TreeBroadphase(const AABBTree &_tree)
+: tree(_tree), pairs()
+{
+
+}
+
+TreeBroadphase::~TreeBroadphase()
+{
+
+}
+
+EntityProxies::EntityProxies(AABBTree &_tree)
+: tree(_tree), proxies(), frame(0u), updatedCount(0u)
+{
+
+}
+
+EntityProxies::~EntityProxies()
+{
+
+}
+
+//==================//
+//= Public Methods =//
+//==================//
+
+int32_t AABBTree::CreateProxy(const AABB &bounds, const uint32_t &userData)
+{
+  const int32_t proxy = AllocateNode();
+  Node &node = nodes[proxy];
+  node.bounds = {bounds.min - margin, bounds.max + margin};
+  node.userData = userData;
+  node.height = 0;
+
+  InsertLeaf(proxy);
+  ++proxyCount;
+
+  return proxy;
+}
+
+void AABBTree::DestroyProxy(const int32_t &proxy)
+{
+  if(proxy < 0 || static_cast<size_t>(proxy) >= nodes.size()
+     || !nodes[proxy].IsLeaf() || nodes[proxy].height != 0)
+  {
+    ErrMessage("Attempting to destroy invalid tree proxy: "
+               + to_string(proxy), EC_PHYSICS);
+    return;
+  }
+
+  RemoveLeaf(proxy);
+  FreeNode(proxy);
+  --proxyCount;
+}
+
+bool AABBTree::MoveProxy(const int32_t &proxy, const AABB &bounds
+                         , const glm::vec3 &displacement)
+{
+  AABB fatBounds = {bounds.min - margin, bounds.max + margin};
+  const glm::vec3 stretch = displacement * DISPLACEMENT_MULTIPLIER;
+  for(int axis = 0; axis < 3; ++axis)
+  {
+    if(stretch[axis] < 0.f)
+    {
+      fatBounds.min[axis] += stretch[axis];
+    }
+    else
+    {
+      fatBounds.max[axis] += stretch[axis];
+    }
+  }
+
+  const AABB &treeBounds = nodes[proxy].bounds;
+  if(treeBounds.Contains(bounds))
+  {
+    // A box left far larger than it needs to be, by a body that has since
+    // slowed down, is shrunk so it stops turning up in queries
+    const AABB largestBounds = {fatBounds.min - 4.f * margin
+                                , fatBounds.max + 4.f * margin};
+    if(largestBounds.Contains(treeBounds))
+    {
+      return false;
+    }
+  }
+
+  RemoveLeaf(proxy);
+  nodes[proxy].bounds = fatBounds;
+  InsertLeaf(proxy);
+
+  return true;
+}
+
+void AABBTree::Clear()
+{
+  nodes.clear();
+  root = NULL_NODE;
+  freeList = NULL_NODE;
+  proxyCount = 0u;
+}
+
+const AABB &AABBTree::GetFatBounds(const int32_t &proxy) const
+{
+  return nodes[proxy].bounds;
+}
+
+const uint32_t &AABBTree::GetUserData(const int32_t &proxy) const
+{
+  return nodes[proxy].userData;
+}
+
+void AABBTree::SetUserData(const int32_t &proxy, const uint32_t &userData)
+{
+  nodes[proxy].userData = userData;
+}
+
+const size_t &AABBTree::GetProxyCount() const
+{
+  return proxyCount;
+}
+
+int32_t AABBTree::GetHeight() const
+{
+  return root == NULL_NODE ? 0 : nodes[root].height;
+}
+
+bool AABBTree::Validate() const
+{
+  if(root == NULL_NODE)
+  {
+    return proxyCount == 0u;
+  }
+  if(nodes[root].parent != NULL_NODE)
+  {
+    return false;
+  }
+
+  size_t leafCount = 0u;
+  if(!ValidateNode(root, leafCount) || leafCount != proxyCount)
+  {
+    return false;
+  }
+
+  // Every node is either in the tree or the free list
+  size_t freeCount = 0u;
+  for(int32_t node = freeList; node != NULL_NODE; node = nodes[node].parent)
+  {
+    ++freeCount;
+  }
+  return freeCount + 2u * proxyCount - 1u == nodes.size();
+}
+
+void AABBTree::FindPairs(const vector<AABB> &bounds
+                         , vector<CollisionPair> &pairs) const
+{
+  pairs.clear();
+  FindPairs(bounds, 0u, static_cast<uint32_t>(bounds.size()), pairs);
+}
+
+void AABBTree::FindPairs(const vector<AABB> &bounds, const uint32_t &begin
+                         , const uint32_t &end
+                         , vector<CollisionPair> &pairs) const
+{
+  for(uint32_t first = begin; first < end; ++first)
+  {
+    Query(bounds[first], [&](const int32_t &proxy)
+    {
+      // Each pair is found from both bodies so only the lower one keeps it,
+      // and the fat boxes only found it may overlap
+      const uint32_t second = nodes[proxy].userData;
+      if(second > first && bounds[first].Overlaps(bounds[second]))
+      {
+        pairs.push_back({first, second});
+      }
+      return true;
+    });
+  }
+}
+
+void TreeBroadphase::Update(const vector<AABB> &bounds)
+{
+  pairs.clear();
+  FindPairsInRanges(bounds.size()
+    , [&](const size_t &begin, const size_t &end
+          , vector<CollisionPair> &rangePairs)
+    {
+      tree.FindPairs(bounds, static_cast<uint32_t>(begin)
+                     , static_cast<uint32_t>(end), rangePairs);
+    }, pairs);
+}
+
+const vector<CollisionPair> &TreeBroadphase::GetPairs() const
+{
+  return pairs;
+}
+
+const char *TreeBroadphase::GetName() const
+{
+  return "AABB tree";
+}
+
+int32_t EntityProxies::Update(const ENTITY_ID &entity, const AABB &bounds
+                              , const glm::vec3 &displacement
+                              , const uint32_t &userData)
+{
+  const auto [found, isNew] = proxies.try_emplace(
+    entity, EntityProxy{AABBTree::NULL_NODE, frame});
+  EntityProxy &entityProxy = found->second;
+
+  if(isNew || entityProxy.frame != frame)
+  {
+    ++updatedCount;
+  }
+  entityProxy.frame = frame;
+
+  if(isNew)
+  {
+    entityProxy.proxy = tree.CreateProxy(bounds, userData);
+  }
+  else
+  {
+    tree.MoveProxy(entityProxy.proxy, bounds, displacement);
+    tree.SetUserData(entityProxy.proxy, userData);
+  }
+
+  return entityProxy.proxy;
+}
+
+bool EntityProxies::Keep(const ENTITY_ID &entity, const uint32_t &userData)
+{
+  const auto found = proxies.find(entity);
+  if(found == proxies.end())
+  {
+    return false;
+  }
+
+  EntityProxy &entityProxy = found->second;
+  if(entityProxy.frame != frame)
+  {
+    ++updatedCount;
+  }
+  entityProxy.frame = frame;
+  tree.SetUserData(entityProxy.proxy, userData);
+
+  return true;
+}
+
+void EntityProxies::EndFrame()
+{
+  // Only look for stale entities when some were not updated
+  if(updatedCount < proxies.size())
+  {
+    for(auto proxy = proxies.begin(); proxy != proxies.end();)
+    {
+      if(proxy->second.frame != frame)
+      {
+        tree.DestroyProxy(proxy->second.proxy);
+        proxy = proxies.erase(proxy);
+      }
+      else
+      {
+        ++proxy;
+      }
+    }
+  }
+
+  ++frame;
+  updatedCount = 0u;
+}
+
+void EntityProxies::Clear()
+{
+  for(const auto &[entity, entityProxy] : proxies)
+  {
+    tree.DestroyProxy(entityProxy.proxy);
+  }
+  proxies.clear();
+  updatedCount = 0u;
+}
+
+//===================//
+//= Private Methods =//
+//===================//
+
+int32_t AABBTree::AllocateNode()
+{
+  int32_t node = freeList;
+  if(node == NULL_NODE)
+  {
+    node = static_cast<int32_t>(nodes.size());
+    nodes.emplace_back();
+  }
+  else
+  {
+    freeList = nodes[node].parent;
+  }
+
+  nodes[node].parent = NULL_NODE;
+  nodes[node].left = NULL_NODE;
+  nodes[node].right = NULL_NODE;
+  nodes[node].height = 0;
+  nodes[node].userData = 0u;
+
+  return node;
+}
+
+void AABBTree::FreeNode(const int32_t &node)
+{
+  nodes[node].parent = freeList;
+  nodes[node].left = NULL_NODE;
+  nodes[node].height = -1;
+  freeList = node;
+}
+
+void AABBTree::InsertLeaf(const int32_t &leaf)
+{
+  if(root == NULL_NODE)
+  {
+    root = leaf;
+    nodes[root].parent = NULL_NODE;
+    return;
+  }
+
+  // Walk down to the sibling that grows the tree's surface area the least,
+  // every node passed on the way down grows to hold the leaf
+  const AABB leafBounds = nodes[leaf].bounds;
+  int32_t sibling = root;
+  while(!nodes[sibling].IsLeaf())
+  {
+    const Node &node = nodes[sibling];
+    const float area = node.bounds.GetSurfaceArea();
+    const float combinedArea
+      = AABB::Merge(node.bounds, leafBounds).GetSurfaceArea();
+
+    // Making a new parent for this node and the leaf
+    const float cost = 2.f * combinedArea;
+    // What every node above a lower sibling grows by
+    const float inheritedCost = 2.f * (combinedArea - area);
+
+    float childCosts[2];
+    const int32_t children[2] = {node.left, node.right};
+    for(int child = 0; child < 2; ++child)
+    {
+      const AABB &childBounds = nodes[children[child]].bounds;
+      const float mergedArea
+        = AABB::Merge(childBounds, leafBounds).GetSurfaceArea();
+      childCosts[child] = inheritedCost
+        + (nodes[children[child]].IsLeaf()
+           ? mergedArea : mergedArea - childBounds.GetSurfaceArea());
+    }
+
+    if(cost < childCosts[0] && cost < childCosts[1])
+    {
+      break;
+    }
+    sibling = childCosts[0] < childCosts[1] ? children[0] : children[1];
+  }
+
+  // Allocating may move the nodes so only indices are held across it
+  const int32_t oldParent = nodes[sibling].parent;
+  const int32_t newParent = AllocateNode();
+  nodes[newParent].parent = oldParent;
+  nodes[newParent].bounds = AABB::Merge(leafBounds, nodes[sibling].bounds);
+  nodes[newParent].height = nodes[sibling].height + 1;
+  nodes[newParent].left = sibling;
+  nodes[newParent].right = leaf;
+  nodes[sibling].parent = newParent;
+  nodes[leaf].parent = newParent;
+
+  if(oldParent == NULL_NODE)
+  {
+    root = newParent;
+  }
+  else if(nodes[oldParent].left == sibling)
+  {
+    nodes[oldParent].left = newParent;
+  }
+  else
+  {
+    nodes[oldParent].right = newParent;
+  }
+
+  RefitAncestors(newParent);
+}
+
+void AABBTree::RemoveLeaf(const int32_t &leaf)
+{
+  if(leaf == root)
+  {
+    root = NULL_NODE;
+    return;
+  }
+
+  // The leaf's sibling takes the place of their parent
+  const int32_t parent = nodes[leaf].parent;
+  const int32_t grandParent = nodes[parent].parent;
+  const int32_t sibling = nodes[parent].left == leaf ? nodes[parent].right
+                                                     : nodes[parent].left;
+
+  nodes[sibling].parent = grandParent;
+  FreeNode(parent);
+
+  if(grandParent == NULL_NODE)
+  {
+    root = sibling;
+    return;
+  }
+
+  if(nodes[grandParent].left == parent)
+  {
+    nodes[grandParent].left = sibling;
+  }
+  else
+  {
+    nodes[grandParent].right = sibling;
+  }
+  RefitAncestors(grandParent);
+}
+
+int32_t AABBTree::Balance(const int32_t &a)
+{
+  Node &nodeA = nodes[a];
+  if(nodeA.IsLeaf() || nodeA.height < 2)
+  {
+    return a;
+  }
+
+  const int32_t b = nodeA.left;
+  const int32_t c = nodeA.right;
+  Node &nodeB = nodes[b];
+  Node &nodeC = nodes[c];
+  const int32_t balance = nodeC.height - nodeB.height;
+
+  if(balance >= -1 && balance <= 1)
+  {
+    return a;
+  }
+
+  // The taller child is rotated up into A's place, and A keeps the
+  // shorter of that child's children
+  const int32_t up = balance > 1 ? c : b;
+  const int32_t kept = balance > 1 ? b : c;
+  Node &nodeUp = nodes[up];
+  Node &nodeKept = nodes[kept];
+  const int32_t f = nodeUp.left;
+  const int32_t g = nodeUp.right;
+  const int32_t taller = nodes[f].height > nodes[g].height ? f : g;
+  const int32_t shorter = taller == f ? g : f;
+
+  nodeUp.left = a;
+  nodeUp.parent = nodeA.parent;
+  nodeA.parent = up;
+
+  if(nodeUp.parent == NULL_NODE)
+  {
+    root = up;
+  }
+  else if(nodes[nodeUp.parent].left == a)
+  {
+    nodes[nodeUp.parent].left = up;
+  }
+  else
+  {
+    nodes[nodeUp.parent].right = up;
+  }
+
+  nodeUp.right = taller;
+  if(balance > 1)
+  {
+    nodeA.right = shorter;
+  }
+  else
+  {
+    nodeA.left = shorter;
+  }
+  nodes[shorter].parent = a;
+
+  nodeA.bounds = AABB::Merge(nodeKept.bounds, nodes[shorter].bounds);
+  nodeA.height = 1 + max(nodeKept.height, nodes[shorter].height);
+  nodeUp.bounds = AABB::Merge(nodeA.bounds, nodes[taller].bounds);
+  nodeUp.height = 1 + max(nodeA.height, nodes[taller].height);
+
+  return up;
+}
+
+void AABBTree::RefitAncestors(int32_t node)
+{
+  while(node != NULL_NODE)
+  {
+    node = Balance(node);
+
+    Node &parent = nodes[node];
+    const Node &left = nodes[parent.left];
+    const Node &right = nodes[parent.right];
+    parent.bounds = AABB::Merge(left.bounds, right.bounds);
+    parent.height = 1 + max(left.height, right.height);
+
+    node = parent.parent;
+  }
+}
+
+bool AABBTree::ValidateNode(const int32_t &node, size_t &leafCount) const
+{
+  const Node &current = nodes[node];
+  if(current.IsLeaf())
+  {
+    ++leafCount;
+    return current.height == 0 && current.right == NULL_NODE;
+  }
+
+  const Node &left = nodes[current.left];
+  const Node &right = nodes[current.right];
+  if(left.parent != node || right.parent != node
+     || current.height != 1 + max(left.height, right.height)
+     || !current.bounds.Contains(left.bounds)
+     || !current.bounds.Contains(right.bounds))
+  {
+    return false;
+  }
+
+  return ValidateNode(current.left, leafCount)
+         && ValidateNode(current.right, leafCount);
+}
+}
@@ -0,0 +1,173 @@
+/*
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    CPL_Bounds.cpp
+ *
+ *  \brief
+ *    The implementation of the ray and frustum tests run against bounding
+ *    volumes
+*/
+
+#include "clapp_includes/pch.h"
+
+#include "clapp_includes/CPL_Bounds.h"
+
+#include <cmath>
+
+#include "../external/glm/geometric.hpp"
+#include "../external/glm/matrix.hpp"
+
+using namespace std;
+
+namespace ClaPP
+{
+// Rays closer to parallel with a slab than this never cross it
+static const float PARALLEL_EPSILON = 1e-8f;
+
+/*
+ * The slab test, clipping the ray to where it is between each pair of
+ * faces in turn
+ */
+static bool RaycastSlabs(const glm::vec3 &low, const glm::vec3 &high
+                         , const glm::vec3 &origin
+                         , const glm::vec3 &direction
+                         , const float &maxDistance, float &distance)
+{
+  float enter = 0.f;
+  float exit = maxDistance;
+
+  for(int axis = 0; axis < 3; ++axis)
+  {
+    if(fabs(direction[axis]) < PARALLEL_EPSILON)
+    {
+      // Parallel rays only hit if they start between the faces
+      if(origin[axis] < low[axis] || origin[axis] > high[axis])
+      {
+        return false;
+      }
+      continue;
+    }
+
+    const float inverse = 1.f / direction[axis];
+    float nearFace = (low[axis] - origin[axis]) * inverse;
+    float farFace = (high[axis] - origin[axis]) * inverse;
+    if(nearFace > farFace)
+    {
+      swap(nearFace, farFace);
+    }
+
+    enter = max(enter, nearFace);
+    exit = min(exit, farFace);
+    if(enter > exit)
+    {
+      return false;
+    }
+  }
+
+  distance = enter;
+  return true;
+}
+
+AABB OrientedBox::GetBounds() const
+{
+  // The turned box reaches along each world axis as far as each of its
+  // axes does along it
+  const glm::vec3 reach = glm::abs(axes[0]) * halfExtents.x
+                          + glm::abs(axes[1]) * halfExtents.y
+                          + glm::abs(axes[2]) * halfExtents.z;
+  return {center - reach, center + reach};
+}
+
+Frustum Frustum::FromMatrix(const glm::mat4 &viewProjection)
+{
+  // Each plane is the last row of the matrix plus or minus one of the
+  // others, glm matrices are indexed by column first
+  const glm::mat4 rows = glm::transpose(viewProjection);
+
+  Frustum frustum;
+  frustum.planes[0] = rows[3] + rows[0];
+  frustum.planes[1] = rows[3] - rows[0];
+  frustum.planes[2] = rows[3] + rows[1];
+  frustum.planes[3] = rows[3] - rows[1];
+  frustum.planes[4] = rows[3] + rows[2];
+  frustum.planes[5] = rows[3] - rows[2];
+
+  for(glm::vec4 &plane : frustum.planes)
+  {
+    plane /= glm::length(glm::vec3(plane));
+  }
+
+  return frustum;
+}
+
+bool Frustum::Intersects(const AABB &bounds) const
+{
+  for(const glm::vec4 &plane : planes)
+  {
+    // The corner furthest along the plane's normal, if it is outside then
+    // the whole box is
+    const glm::vec3 corner = {plane.x >= 0.f ? bounds.max.x : bounds.min.x
+                              , plane.y >= 0.f ? bounds.max.y : bounds.min.y
+                              , plane.z >= 0.f ? bounds.max.z : bounds.min.z};
+    if(glm::dot(glm::vec3(plane), corner) + plane.w < 0.f)
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool RaycastAABB(const AABB &bounds, const glm::vec3 &origin
+                 , const glm::vec3 &direction, const float &maxDistance
+                 , float &distance)
+{
+  return RaycastSlabs(bounds.min, bounds.max, origin, direction
+                      , maxDistance, distance);
+}
+
+bool RaycastBox(const OrientedBox &box, const glm::vec3 &origin
+                , const glm::vec3 &direction, const float &maxDistance
+                , float &distance)
+{
+  // The box's axes are orthonormal so the transpose takes the ray into
+  // the box's space, where it is an AABB about the origin
+  const glm::mat3 toLocal = glm::transpose(box.axes);
+  return RaycastSlabs(-box.halfExtents, box.halfExtents
+                      , toLocal * (origin - box.center)
+                      , toLocal * direction, maxDistance, distance);
+}
+
+bool RaycastSphere(const Sphere &sphere, const glm::vec3 &origin
+                   , const glm::vec3 &direction, const float &maxDistance
+                   , float &distance)
+{
+  // Solves |origin + direction * t - center| = radius for the nearest t,
+  // the quadratic's first term is 1 as direction is normalized
+  const glm::vec3 offset = origin - sphere.center;
+  const float halfB = glm::dot(offset, direction);
+  const float c = glm::dot(offset, offset) - sphere.radius * sphere.radius;
+  if(c <= 0.f)
+  {
+    distance = 0.f;
+    return true;
+  }
+
+  const float discriminant = halfB * halfB - c;
+  if(halfB > 0.f || discriminant < 0.f)
+  {
+    return false;
+  }
+
+  const float enter = -halfB - sqrt(discriminant);
+  if(enter > maxDistance)
+  {
+    return false;
+  }
+  distance = enter;
+  return true;
+}
+}
@@ -0,0 +1,86 @@
+/*
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    CPL_Broadphase.cpp
+ *
+ *  \brief
+ *    An implementation of the parts shared by every broadphase
+ */
+
+#include "clapp_includes/pch.h"
+
+#include "clapp_includes/CPL_Broadphase.h"
+
+#include <algorithm>
+
+#include "clapp_includes/Clarity_ThreadPool.h"
+
+using namespace std;
+
+namespace ClaPP
+{
+//=================//
+//= CTOR and DTOR =//
+//=================//
+
+Broadphase::Broadphase()
+: threadPool(&ThreadPool::GetInstance()), rangePairs()
+{
+
+}
+
+Broadphase::~Broadphase()
+{
+
+}
+
+//==================//
+//= Public Methods =//
+//==================//
+
+void Broadphase::SetThreadPool(ThreadPool &_threadPool)
+{
+  threadPool = &_threadPool;
+}
+
+ThreadPool &Broadphase::GetThreadPool() const
+{
+  return *threadPool;
+}
+
+//=====================//
+//= Protected Methods =//
+//=====================//
+
+void Broadphase::FindPairsInRanges(const size_t &count
+                                   , const PairRangeFunction &function
+                                   , vector<CollisionPair> &pairs)
+{
+  const size_t rangeCount = (count + PAIR_RANGE_SIZE - 1u) / PAIR_RANGE_SIZE;
+  if(rangePairs.size() < rangeCount)
+  {
+    rangePairs.resize(rangeCount);
+  }
+
+  threadPool->ParallelFor(rangeCount
+    , [&](const size_t &begin, const size_t &end, const size_t &)
+    {
+      for(size_t range = begin; range < end; ++range)
+      {
+        rangePairs[range].clear();
+        function(range * PAIR_RANGE_SIZE
+                 , min(count, (range + 1u) * PAIR_RANGE_SIZE)
+                 , rangePairs[range]);
+      }
+    });
+
+  for(size_t range = 0; range < rangeCount; ++range)
+  {
+    pairs.insert(pairs.end(), rangePairs[range].begin()
+                 , rangePairs[range].end());
+  }
+}
+}
@@ -0,0 +1,336 @@
+/*
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    CPL_ContactSolver.cpp
+ *
+ *  \brief
+ *    An implementation for pushing touching bodies apart by changing their
+ *    velocities and positions
+*/
+
+#include "clapp_includes/pch.h"
+
+#include "clapp_includes/CPL_ContactSolver.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+#include "../external/glm/geometric.hpp"
+
+using namespace std;
+
+namespace ClaPP
+{
+/*
+ * Reads a body's value out of an array per axis
+ */
+static glm::vec3 GatherAxes(const array<float *, 3> &axes
+                            , const uint32_t &body)
+{
+  return {axes[0][body], axes[1][body], axes[2][body]};
+}
+
+/*
+ * Finds two directions at right angles to each other and to a normalized
+ * normal without branching on which axis the normal is closest to
+ */
+static void FindTangents(const glm::vec3 &normal, glm::vec3 &tangent
+                         , glm::vec3 &bitangent)
+{
+  const float sign = copysign(1.f, normal.z);
+  const float a = -1.f / (sign + normal.z);
+  const float b = normal.x * normal.y * a;
+  tangent = {1.f + sign * normal.x * normal.x * a, sign * b
+             , -sign * normal.x};
+  bitangent = {b, sign + normal.y * normal.y * a, -normal.y};
+}
+
+//=================//
+//= CTOR and DTOR =//
+//=================//
+
+ContactSolver::ContactSolver()
+: constraints(), unsorted(), colors(), bodyColors(), batchStarts()
+  , velocities({nullptr, nullptr, nullptr})
+  , positions({nullptr, nullptr, nullptr}), constraintCount(0u)
+  , hasOverflowBatch(false)
+{
+
+}
+
+ContactSolver::~ContactSolver()
+{
+
+}
+
+//==================//
+//= Public Methods =//
+//==================//
+
+void ContactSolver::Prepare(const ContactBuffer &contacts
+                            , const Bodies &bodies)
+{
+  velocities = bodies.velocities;
+  positions = bodies.positions;
+  constraintCount = 0u;
+  hasOverflowBatch = false;
+
+  unsorted.resize(contacts.GetCount());
+  colors.resize(contacts.GetCount());
+  bodyColors.assign(bodies.bodyCount, 0u);
+
+  uint32_t colorCount = 0u;
+  for(size_t i = 0; i < contacts.GetCount(); ++i)
+  {
+    const ContactManifold &manifold = contacts[i];
+    const float inverseMassFirst = bodies.inverseMasses[manifold.first];
+    const float inverseMassSecond = bodies.inverseMasses[manifold.second];
+    // Nothing can move so there is nothing to solve
+    if(inverseMassFirst + inverseMassSecond <= 0.f)
+    {
+      continue;
+    }
+
+    Constraint &constraint = unsorted[constraintCount];
+    constraint.first = bodies.indices[manifold.first];
+    constraint.second = bodies.indices[manifold.second];
+    constraint.inverseMassFirst = inverseMassFirst;
+    constraint.inverseMassSecond = inverseMassSecond;
+    constraint.effectiveMass = 1.f / (inverseMassFirst + inverseMassSecond);
+    constraint.normal = manifold.normal;
+    FindTangents(manifold.normal, constraint.tangent, constraint.bitangent);
+    constraint.friction = sqrt(bodies.frictions[manifold.first]
+                               * bodies.frictions[manifold.second]);
+    constraint.normalImpulse = 0.f;
+    constraint.tangentImpulse = 0.f;
+    constraint.bitangentImpulse = 0.f;
+
+    // Bodies meeting fast enough part at the speed they met times
+    // restitution
+    const float approach 
+      = glm::dot(GatherAxes(velocities, constraint.second)
+                 - GatherAxes(velocities, constraint.first)
+                 , constraint.normal);
+    constraint.bias = 0.f;
+    if(approach < -RESTITUTION_THRESHOLD)
+    {
+      constraint.bias = -approach 
+                        * max(bodies.restitutions[manifold.first]
+                              , bodies.restitutions[manifold.second]);
+    }
+    constraint.separation 
+      = -manifold.GetMaxPenetration()
+        - glm::dot(GatherAxes(positions, constraint.second)
+                   - GatherAxes(positions, constraint.first)
+                   , constraint.normal);
+
+    // The lowest color neither moving body has used yet
+    uint64_t used = 0u;
+    if(inverseMassFirst > 0.f)
+    {
+      used |= bodyColors[constraint.first];
+    }
+    if(inverseMassSecond > 0.f)
+    {
+      used |= bodyColors[constraint.second];
+    }
+    uint32_t color = MAX_COLORS;
+    if(~used != 0u)
+    {
+      color = static_cast<uint32_t>(countr_zero(~used));
+      const uint64_t bit = uint64_t(1u) << color;
+      if(inverseMassFirst > 0.f)
+      {
+        bodyColors[constraint.first] |= bit;
+      }
+      if(inverseMassSecond > 0.f)
+      {
+        bodyColors[constraint.second] |= bit;
+      }
+    }
+    else
+    {
+      hasOverflowBatch = true;
+    }
+    colors[constraintCount] = color;
+    colorCount = max(colorCount, color + 1u);
+    ++constraintCount;
+  }
+
+  // Counting sort by color, walking backwards so each start is found by
+  // counting down from the end of its batch
+  batchStarts.assign(colorCount + 1u, 0u);
+  for(size_t i = 0; i < constraintCount; ++i)
+  {
+    ++batchStarts[colors[i]];
+  }
+  size_t batchEnd = 0u;
+  for(uint32_t color = 0; color < colorCount; ++color)
+  {
+    batchEnd += batchStarts[color];
+    batchStarts[color] = batchEnd;
+  }
+  batchStarts[colorCount] = constraintCount;
+
+  constraints.resize(constraintCount);
+  for(size_t i = constraintCount; i > 0u; --i)
+  {
+    constraints[--batchStarts[colors[i - 1u]]] = unsorted[i - 1u];
+  }
+}
+
+void ContactSolver::Solve(const int &iterations)
+{
+  for(int iteration = 0; iteration < iterations; ++iteration)
+  {
+    for(size_t batch = 0; batch < GetBatchCount(); ++batch)
+    {
+      SolveRange(batchStarts[batch], batchStarts[batch + 1u]);
+    }
+  }
+}
+
+void ContactSolver::CorrectPositions(const int &iterations)
+{
+  for(int iteration = 0; iteration < iterations; ++iteration)
+  {
+    for(size_t batch = 0; batch < GetBatchCount(); ++batch)
+    {
+      CorrectRange(batchStarts[batch], batchStarts[batch + 1u]);
+    }
+  }
+}
+
+void ContactSolver::SolveRange(const size_t &begin, const size_t &end)
+{
+  for(size_t i = begin; i < end; ++i)
+  {
+    SolveConstraint(constraints[i]);
+  }
+}
+
+void ContactSolver::CorrectRange(const size_t &begin, const size_t &end)
+{
+  for(size_t i = begin; i < end; ++i)
+  {
+    CorrectConstraint(constraints[i]);
+  }
+}
+
+const size_t &ContactSolver::GetConstraintCount() const
+{
+  return constraintCount;
+}
+
+size_t ContactSolver::GetBatchCount() const
+{
+  return batchStarts.empty() ? 0u : batchStarts.size() - 1u;
+}
+
+void ContactSolver::GetBatch(const size_t &batch, size_t &begin
+                             , size_t &end) const
+{
+  begin = batchStarts[batch];
+  end = batchStarts[batch + 1u];
+}
+
+const bool &ContactSolver::HasOverflowBatch() const
+{
+  return hasOverflowBatch;
+}
+
+//===================//
+//= Private Methods =//
+//===================//
+
+void ContactSolver::SolveConstraint(Constraint &constraint)
+{
+  glm::vec3 first = GatherAxes(velocities, constraint.first);
+  glm::vec3 second = GatherAxes(velocities, constraint.second);
+
+  // Friction is held to what the normal impulse so far allows, it comes
+  // first so the normal constraint has the last say each iteration
+  const float maxFriction = constraint.friction * constraint.normalImpulse;
+  const glm::vec3 *directions[2] = {&constraint.tangent
+                                    , &constraint.bitangent};
+  float *impulses[2] = {&constraint.tangentImpulse
+                        , &constraint.bitangentImpulse};
+  for(int i = 0; i < 2; ++i)
+  {
+    const glm::vec3 &direction = *directions[i];
+    const float speed = glm::dot(second - first, direction);
+    const float total = glm::clamp(*impulses[i]
+                                   - speed * constraint.effectiveMass
+                                   , -maxFriction, maxFriction);
+    const glm::vec3 impulse = direction * (total - *impulses[i]);
+    *impulses[i] = total;
+
+    first -= impulse * constraint.inverseMassFirst;
+    second += impulse * constraint.inverseMassSecond;
+  }
+
+  // The bodies may part as fast as they like but never meet
+  const float speed = glm::dot(second - first, constraint.normal);
+  const float change = (constraint.bias - speed) * constraint.effectiveMass;
+  const float total = max(constraint.normalImpulse + change, 0.f);
+  const glm::vec3 impulse = constraint.normal
+                            * (total - constraint.normalImpulse);
+  constraint.normalImpulse = total;
+
+  first -= impulse * constraint.inverseMassFirst;
+  second += impulse * constraint.inverseMassSecond;
+
+  // Bodies that never move are shared between constraints of a batch so
+  // they are never written
+  for(int axis = 0; axis < 3; ++axis)
+  {
+    if(constraint.inverseMassFirst > 0.f)
+    {
+      velocities[axis][constraint.first] = first[axis];
+    }
+    if(constraint.inverseMassSecond > 0.f)
+    {
+      velocities[axis][constraint.second] = second[axis];
+    }
+  }
+}
+
+void ContactSolver::CorrectConstraint(const Constraint &constraint)
+{
+  glm::vec3 first = GatherAxes(positions, constraint.first);
+  glm::vec3 second = GatherAxes(positions, constraint.second);
+
+  // The overlap now, from how far the bodies have moved along the normal
+  // since they were prepared
+  const float separation = constraint.separation 
+                           + glm::dot(second - first, constraint.normal);
+  const float correction = glm::clamp(BAUMGARTE * (separation 
+                                                   + PENETRATION_SLOP)
+                                      , -MAX_CORRECTION, 0.f);
+  if(correction >= 0.f)
+  {
+    return;
+  }
+
+  const glm::vec3 offset = constraint.normal 
+                           * (-correction * constraint.effectiveMass);
+  first -= offset * constraint.inverseMassFirst;
+  second += offset * constraint.inverseMassSecond;
+
+  for(int axis = 0; axis < 3; ++axis)
+  {
+    if(constraint.inverseMassFirst > 0.f)
+    {
+      positions[axis][constraint.first] = first[axis];
+    }
+    if(constraint.inverseMassSecond > 0.f)
+    {
+      positions[axis][constraint.second] = second[axis];
+    }
+  }
+}
+}
@@ -0,0 +1,359 @@
+/*
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    CPL_Integrator.cpp
+ *
+ *  \brief
+ *    An implementation for moving batches of bodies through time by their
+ *    velocity and acceleration
+*/
+
+#include "clapp_includes/pch.h"
+
+#include "clapp_includes/CPL_Integrator.h"
+
+#include <cmath>
+
+using namespace std;
+
+namespace ClaPP
+{
+/*
+ * How many active bodies of a batch are from begin up to end
+ */
+static size_t ActiveRangeCount(const BodyBatch &batch, const size_t &begin
+                               , const size_t &end)
+{
+  const size_t last = min(end, batch.GetActiveCount());
+  return begin < last ? last - begin : 0u;
+}
+
+/*
+ * One axis of semi-implicit Euler. Every array is read and written at the
+ * same index only, so the loop vectorizes.
+ */
+static void SemiImplicitEulerAxis(float *position, float *previous
+                                  , float *velocity
+                                  , const float *acceleration
+                                  , const size_t &count, const float drag
+                                  , const float timeStep)
+{
+  for(size_t i = 0; i < count; ++i)
+  {
+    previous[i] = position[i];
+    velocity[i] += (acceleration[i] - drag * velocity[i]) * timeStep;
+    position[i] += velocity[i] * timeStep;
+  }
+}
+
+/*
+ * One axis of position Verlet, with drag taken off the distance moved last
+ * step and velocity found from the distance moved this step
+ */
+static void VerletAxis(float *position, float *previous, float *velocity
+                       , const float *acceleration, const size_t &count
+                       , const float drag, const float timeStep)
+{
+  const float damping = 1.f - drag * timeStep;
+  const float stepSquared = timeStep * timeStep;
+  const float inverseStep = 1.f / timeStep;
+
+  for(size_t i = 0; i < count; ++i)
+  {
+    const float current = position[i];
+    const float next = current + (current - previous[i]) * damping
+                       + acceleration[i] * stepSquared;
+    previous[i] = current;
+    position[i] = next;
+    velocity[i] = (next - current) * inverseStep;
+  }
+}
+
+/*
+ * Adds half the step times (0, w) * q to each orientation and normalizes
+ * it again, only a few multiply adds and one square root per body
+ */
+static void OrientationKernel(float *x, float *y, float *z, float *w
+                              , float *previousX, float *previousY
+                              , float *previousZ, float *previousW
+                              , const float *angularX
+                              , const float *angularY
+                              , const float *angularZ, const size_t &count
+                              , const float timeStep)
+{
+  const float halfStep = 0.5f * timeStep;
+
+  for(size_t i = 0; i < count; ++i)
+  {
+    const float qx = x[i];
+    const float qy = y[i];
+    const float qz = z[i];
+    const float qw = w[i];
+    const float ax = angularX[i] * halfStep;
+    const float ay = angularY[i] * halfStep;
+    const float az = angularZ[i] * halfStep;
+
+    previousX[i] = qx;
+    previousY[i] = qy;
+    previousZ[i] = qz;
+    previousW[i] = qw;
+
+    const float nx = qx + ax * qw + ay * qz - az * qy;
+    const float ny = qy + ay * qw + az * qx - ax * qz;
+    const float nz = qz + az * qw + ax * qy - ay * qx;
+    const float nw = qw - ax * qx - ay * qy - az * qz;
+    const float inverseLength = 1.f / sqrt(nx * nx + ny * ny + nz * nz
+                                           + nw * nw);
+
+    x[i] = nx * inverseLength;
+    y[i] = ny * inverseLength;
+    z[i] = nz * inverseLength;
+    w[i] = nw * inverseLength;
+  }
+}
+
+//=================//
+//= CTOR and DTOR =//
+//=================//
+
+BodyBatch::BodyBatch()
+: positions(), previousPositions(), velocities(), accelerations()
+  , orientations(), previousOrientations(), angularVelocities(), count(0u)
+  , activeCount(0u)
+{
+
+}
+
+BodyBatch::~BodyBatch()
+{
+
+}
+
+//==================//
+//= Public Methods =//
+//==================//
+
+void BodyBatch::Resize(const size_t &_count)
+{
+  count = _count;
+  activeCount = _count;
+  for(size_t axis = 0; axis < AXIS_COUNT; ++axis)
+  {
+    positions[axis].resize(count);
+    previousPositions[axis].resize(count);
+    velocities[axis].resize(count);
+    accelerations[axis].resize(count);
+    angularVelocities[axis].resize(count);
+  }
+  for(size_t component = 0; component < QUAT_COUNT; ++component)
+  {
+    orientations[component].resize(count);
+    previousOrientations[component].resize(count);
+  }
+}
+
+const size_t &BodyBatch::GetCount() const
+{
+  return count;
+}
+
+void BodyBatch::SetActiveCount(const size_t &_activeCount)
+{
+  activeCount = min(_activeCount, count);
+}
+
+const size_t &BodyBatch::GetActiveCount() const
+{
+  return activeCount;
+}
+
+void BodyBatch::SetBody(const size_t &index, const glm::vec3 &position
+                        , const glm::vec3 &previousPosition
+                        , const glm::vec3 &velocity
+                        , const glm::vec3 &acceleration)
+{
+  for(size_t axis = 0; axis < AXIS_COUNT; ++axis)
+  {
+    const glm::length_t component = static_cast<glm::length_t>(axis);
+    positions[axis][index] = position[component];
+    previousPositions[axis][index] = previousPosition[component];
+    velocities[axis][index] = velocity[component];
+    accelerations[axis][index] = acceleration[component];
+  }
+}
+
+void BodyBatch::SetOrientation(const size_t &index
+                               , const glm::quat &orientation
+                               , const glm::vec3 &angularVelocity)
+{
+  for(size_t component = 0; component < QUAT_COUNT; ++component)
+  {
+    const glm::length_t element = static_cast<glm::length_t>(component);
+    orientations[component][index] = orientation[element];
+    previousOrientations[component][index] = orientation[element];
+  }
+  for(size_t axis = 0; axis < AXIS_COUNT; ++axis)
+  {
+    angularVelocities[axis][index] 
+      = angularVelocity[static_cast<glm::length_t>(axis)];
+  }
+}
+
+glm::vec3 BodyBatch::GetPosition(const size_t &index) const
+{
+  return {positions[AXIS_X][index], positions[AXIS_Y][index]
+          , positions[AXIS_Z][index]};
+}
+
+glm::vec3 BodyBatch::GetPreviousPosition(const size_t &index) const
+{
+  return {previousPositions[AXIS_X][index]
+          , previousPositions[AXIS_Y][index]
+          , previousPositions[AXIS_Z][index]};
+}
+
+glm::vec3 BodyBatch::GetVelocity(const size_t &index) const
+{
+  return {velocities[AXIS_X][index], velocities[AXIS_Y][index]
+          , velocities[AXIS_Z][index]};
+}
+
+glm::quat BodyBatch::GetOrientation(const size_t &index) const
+{
+  return glm::quat::wxyz(orientations[QUAT_W][index]
+                         , orientations[QUAT_X][index]
+                         , orientations[QUAT_Y][index]
+                         , orientations[QUAT_Z][index]);
+}
+
+glm::quat BodyBatch::GetPreviousOrientation(const size_t &index) const
+{
+  return glm::quat::wxyz(previousOrientations[QUAT_W][index]
+                         , previousOrientations[QUAT_X][index]
+                         , previousOrientations[QUAT_Y][index]
+                         , previousOrientations[QUAT_Z][index]);
+}
+
+float *BodyBatch::GetPositions(const AXIS &axis)
+{
+  return positions[axis].data();
+}
+
+float *BodyBatch::GetPreviousPositions(const AXIS &axis)
+{
+  return previousPositions[axis].data();
+}
+
+float *BodyBatch::GetVelocities(const AXIS &axis)
+{
+  return velocities[axis].data();
+}
+
+float *BodyBatch::GetAccelerations(const AXIS &axis)
+{
+  return accelerations[axis].data();
+}
+
+float *BodyBatch::GetOrientations(const QUAT_COMPONENT &component)
+{
+  return orientations[component].data();
+}
+
+float *BodyBatch::GetPreviousOrientations(const QUAT_COMPONENT &component)
+{
+  return previousOrientations[component].data();
+}
+
+float *BodyBatch::GetAngularVelocities(const AXIS &axis)
+{
+  return angularVelocities[axis].data();
+}
+
+void Integrator::Integrate(BodyBatch &batch, const INTEGRATOR &integrator
+                           , const glm::vec3 &drag, const float &timeStep
+                           , const size_t &begin, const size_t &end)
+{
+  switch(integrator)
+  {
+  case INTEGRATOR_VERLET:
+    Verlet(batch, drag, timeStep, begin, end);
+    break;
+  case INTEGRATOR_SEMI_IMPLICIT_EULER:
+  default:
+    SemiImplicitEuler(batch, drag, timeStep, begin, end);
+    break;
+  }
+
+  IntegrateOrientations(batch, timeStep, begin, end);
+}
+
+void Integrator::SemiImplicitEuler(BodyBatch &batch, const glm::vec3 &drag
+                                   , const float &timeStep
+                                   , const size_t &begin, const size_t &end)
+{
+  const size_t count = ActiveRangeCount(batch, begin, end);
+  if(count == 0u)
+  {
+    return;
+  }
+
+  for(int axis = 0; axis < BodyBatch::AXIS_COUNT; ++axis)
+  {
+    const BodyBatch::AXIS batchAxis = static_cast<BodyBatch::AXIS>(axis);
+    SemiImplicitEulerAxis(batch.GetPositions(batchAxis) + begin
+                          , batch.GetPreviousPositions(batchAxis) + begin
+                          , batch.GetVelocities(batchAxis) + begin
+                          , batch.GetAccelerations(batchAxis) + begin
+                          , count, drag[axis], timeStep);
+  }
+}
+
+void Integrator::Verlet(BodyBatch &batch, const glm::vec3 &drag
+                        , const float &timeStep, const size_t &begin
+                        , const size_t &end)
+{
+  const size_t count = ActiveRangeCount(batch, begin, end);
+  if(timeStep <= 0.f || count == 0u)
+  {
+    return;
+  }
+
+  for(int axis = 0; axis < BodyBatch::AXIS_COUNT; ++axis)
+  {
+    const BodyBatch::AXIS batchAxis = static_cast<BodyBatch::AXIS>(axis);
+    VerletAxis(batch.GetPositions(batchAxis) + begin
+               , batch.GetPreviousPositions(batchAxis) + begin
+               , batch.GetVelocities(batchAxis) + begin
+               , batch.GetAccelerations(batchAxis) + begin
+               , count, drag[axis], timeStep);
+  }
+}
+
+void Integrator::IntegrateOrientations(BodyBatch &batch
+                                       , const float &timeStep
+                                       , const size_t &begin
+                                       , const size_t &end)
+{
+  const size_t count = ActiveRangeCount(batch, begin, end);
+  if(count == 0u)
+  {
+    return;
+  }
+
+  OrientationKernel(batch.GetOrientations(BodyBatch::QUAT_X) + begin
+                    , batch.GetOrientations(BodyBatch::QUAT_Y) + begin
+                    , batch.GetOrientations(BodyBatch::QUAT_Z) + begin
+                    , batch.GetOrientations(BodyBatch::QUAT_W) + begin
+                    , batch.GetPreviousOrientations(BodyBatch::QUAT_X) + begin
+                    , batch.GetPreviousOrientations(BodyBatch::QUAT_Y) + begin
+                    , batch.GetPreviousOrientations(BodyBatch::QUAT_Z) + begin
+                    , batch.GetPreviousOrientations(BodyBatch::QUAT_W) + begin
+                    , batch.GetAngularVelocities(BodyBatch::AXIS_X) + begin
+                    , batch.GetAngularVelocities(BodyBatch::AXIS_Y) + begin
+                    , batch.GetAngularVelocities(BodyBatch::AXIS_Z) + begin
+                    , count, timeStep);
+}
+}
@@ -0,0 +1,111 @@
+/*
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    CPL_Islands.cpp
+ *
+ *  \brief
+ *    An implementation for grouping bodies that touch, directly or through
+ *    other bodies, into islands
+*/
+
+#include "clapp_includes/pch.h"
+
+#include "clapp_includes/CPL_Islands.h"
+
+#include <numeric>
+#include <utility>
+
+using namespace std;
+
+namespace ClaPP
+{
+//=================//
+//= CTOR and DTOR =//
+//=================//
+
+Islands::Islands()
+: parents(), sizes(), rootIslands(), islands(), islandCount(0u)
+{
+
+}
+
+Islands::~Islands()
+{
+
+}
+
+//==================//
+//= Public Methods =//
+//==================//
+
+void Islands::Reset(const size_t &bodyCount)
+{
+  parents.resize(bodyCount);
+  iota(parents.begin(), parents.end(), 0u);
+  sizes.assign(bodyCount, 1u);
+  islands.assign(bodyCount, 0u);
+  islandCount = 0u;
+}
+
+void Islands::Link(const uint32_t &first, const uint32_t &second)
+{
+  uint32_t firstRoot = FindRoot(first);
+  uint32_t secondRoot = FindRoot(second);
+  if(firstRoot == secondRoot)
+  {
+    return;
+  }
+
+  if(sizes[firstRoot] < sizes[secondRoot])
+  {
+    swap(firstRoot, secondRoot);
+  }
+  parents[secondRoot] = firstRoot;
+  sizes[firstRoot] += sizes[secondRoot];
+}
+
+uint32_t Islands::FindRoot(const uint32_t &body)
+{
+  uint32_t current = body;
+  while(parents[current] != current)
+  {
+    parents[current] = parents[parents[current]];
+    current = parents[current];
+  }
+  return current;
+}
+
+size_t Islands::Label()
+{
+  // A root is always reached from its lowest body first, which gives its
+  // island the next number before any higher body can
+  constexpr uint32_t UNLABELED = ~0u;
+  rootIslands.assign(parents.size(), UNLABELED);
+
+  islandCount = 0u;
+  for(uint32_t body = 0; body < parents.size(); ++body)
+  {
+    uint32_t &island = rootIslands[FindRoot(body)];
+    if(island == UNLABELED)
+    {
+      island = static_cast<uint32_t>(islandCount++);
+    }
+    islands[body] = island;
+  }
+
+  return islandCount;
+}
+
+const uint32_t &Islands::GetIsland(const uint32_t &body) const
+{
+  return islands[body];
+}
+
+const size_t &Islands::GetIslandCount() const
+{
+  return islandCount;
+}
+}
@@ -0,0 +1,605 @@
+/*
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    CPL_Narrowphase.cpp
+ *
+ *  \brief
+ *    An implementation for finding where the pairs of bodies the
+ *    broadphase found actually touch
+*/
+
+#include "clapp_includes/pch.h"
+
+#include "clapp_includes/CPL_Narrowphase.h"
+
+#include <cmath>
+#include <limits>
+
+#include "../external/glm/geometric.hpp"
+#include "../external/glm/matrix.hpp"
+
+using namespace std;
+
+namespace ClaPP
+{
+// Below this squared length the cross of two edges is taken as parallel
+static const float PARALLEL_EPSILON = 1e-6f;
+// Another axis is only picked over the first box's faces when it overlaps
+// less by this much, so boxes resting on each other keep the same face
+// from step to step
+static const float RELATIVE_TOLERANCE = 0.95f;
+static const float ABSOLUTE_TOLERANCE = 0.01f;
+// A quad clipped by 4 planes gains at most one point per plane
+static const size_t MAX_CLIPPED_POINTS = 8u;
+
+/*
+ * How far a box reaches from its center along a normalized axis
+ */
+static float ProjectBox(const OrientedBox &box, const glm::vec3 &axis)
+{
+  return box.halfExtents.x * fabs(glm::dot(box.axes[0], axis))
+         + box.halfExtents.y * fabs(glm::dot(box.axes[1], axis))
+         + box.halfExtents.z * fabs(glm::dot(box.axes[2], axis));
+}
+
+/*
+ * Clips a polygon to the side of a plane where dot(normal, point) is at
+ * most offset
+ */
+static size_t ClipPolygon(const glm::vec3 *input, const size_t &inputCount
+                          , const glm::vec3 &normal, const float &offset
+                          , glm::vec3 *output)
+{
+  size_t outputCount = 0u;
+  for(size_t i = 0; i < inputCount; ++i)
+  {
+    const glm::vec3 &start = input[i];
+    const glm::vec3 &end = input[(i + 1u) % inputCount];
+    const float startDistance = glm::dot(normal, start) - offset;
+    const float endDistance = glm::dot(normal, end) - offset;
+
+    if(startDistance <= 0.f)
+    {
+      output[outputCount++] = start;
+    }
+    if((startDistance <= 0.f) != (endDistance <= 0.f))
+    {
+      const float t = startDistance / (startDistance - endDistance);
+      output[outputCount++] = start + (end - start) * t;
+    }
+  }
+  return outputCount;
+}
+
+/*
+ * Keeps at most MAX_POINTS of the points found, the deepest, the furthest
+ * from it, and the two furthest to either side of the line between them,
+ * which keeps the most area for the points to hold a body up with
+ */
+static void ReducePoints(const glm::vec3 *points, const float *penetrations
+                         , const size_t &count, const glm::vec3 &normal
+                         , ContactManifold &manifold)
+{
+  if(count <= ContactManifold::MAX_POINTS)
+  {
+    manifold.pointCount = static_cast<uint32_t>(count);
+    for(size_t i = 0; i < count; ++i)
+    {
+      manifold.points[i] = points[i];
+      manifold.penetrations[i] = penetrations[i];
+    }
+    return;
+  }
+
+  size_t chosen[ContactManifold::MAX_POINTS] = {0u, 0u, 0u, 0u};
+  float furthest = -1.f;
+  float mostLeft = 0.f;
+  float mostRight = 0.f;
+  for(size_t i = 1; i < count; ++i)
+  {
+    if(penetrations[i] > penetrations[chosen[0]])
+    {
+      chosen[0] = i;
+    }
+  }
+  for(size_t i = 0; i < count; ++i)
+  {
+    const glm::vec3 offset = points[i] - points[chosen[0]];
+    const float distance = glm::dot(offset, offset);
+    if(distance > furthest)
+    {
+      furthest = distance;
+      chosen[1] = i;
+    }
+  }
+  const glm::vec3 line = points[chosen[1]] - points[chosen[0]];
+  chosen[2] = chosen[0];
+  chosen[3] = chosen[1];
+  for(size_t i = 0; i < count; ++i)
+  {
+    const float side = glm::dot(glm::cross(line, points[i]
+                                           - points[chosen[0]]), normal);
+    if(side > mostLeft)
+    {
+      mostLeft = side;
+      chosen[2] = i;
+    }
+    else if(side < mostRight)
+    {
+      mostRight = side;
+      chosen[3] = i;
+    }
+  }
+
+  manifold.pointCount = ContactManifold::MAX_POINTS;
+  for(size_t i = 0; i < ContactManifold::MAX_POINTS; ++i)
+  {
+    manifold.points[i] = points[chosen[i]];
+    manifold.penetrations[i] = penetrations[chosen[i]];
+  }
+}
+
+/*
+ * Finds the points where a face of the reference box touches the face of
+ * the incident box facing it most
+ *
+ * normal is the reference face's outward normal, overlap is how far the
+ * boxes overlap along it and is used if clipping leaves no points
+ */
+static void FaceContact(const OrientedBox &reference
+                        , const OrientedBox &incident, const int &face
+                        , const glm::vec3 &normal, const float &overlap
+                        , ContactManifold &manifold)
+{
+  int incidentFace = 0;
+  float facing = 0.f;
+  for(int axis = 0; axis < 3; ++axis)
+  {
+    const float alignment = glm::dot(incident.axes[axis], normal);
+    if(fabs(alignment) > fabs(facing))
+    {
+      facing = alignment;
+      incidentFace = axis;
+    }
+  }
+
+  // The incident face points back against the normal
+  const float faceSign = facing > 0.f ? -1.f : 1.f;
+  const glm::vec3 faceCenter = incident.center + incident.axes[incidentFace]
+                               * (faceSign
+                                  * incident.halfExtents[incidentFace]);
+  const int uAxis = (incidentFace + 1) % 3;
+  const int vAxis = (incidentFace + 2) % 3;
+  const glm::vec3 u = incident.axes[uAxis] * incident.halfExtents[uAxis];
+  const glm::vec3 v = incident.axes[vAxis] * incident.halfExtents[vAxis];
+
+  glm::vec3 clipped[2][MAX_CLIPPED_POINTS];
+  clipped[0][0] = faceCenter + u + v;
+  clipped[0][1] = faceCenter - u + v;
+  clipped[0][2] = faceCenter - u - v;
+  clipped[0][3] = faceCenter + u - v;
+  size_t count = 4u;
+  int current = 0;
+
+  // Clip to the 4 sides of the reference face
+  for(int side = 1; side < 3 && count > 0u; ++side)
+  {
+    const int axis = (face + side) % 3;
+    const glm::vec3 &sideNormal = reference.axes[axis];
+    const float centerDistance = glm::dot(sideNormal, reference.center);
+    const float extent = reference.halfExtents[axis];
+
+    count = ClipPolygon(clipped[current], count, sideNormal
+                        , centerDistance + extent, clipped[1 - current]);
+    current = 1 - current;
+    count = ClipPolygon(clipped[current], count, -sideNormal
+                        , extent - centerDistance, clipped[1 - current]);
+    current = 1 - current;
+  }
+
+  // Only points below the reference face touch it
+  const float faceOffset = glm::dot(normal, reference.center)
+                           + reference.halfExtents[face];
+  glm::vec3 points[MAX_CLIPPED_POINTS];
+  float penetrations[MAX_CLIPPED_POINTS];
+  size_t pointCount = 0u;
+  for(size_t i = 0; i < count; ++i)
+  {
+    const float penetration = faceOffset
+                              - glm::dot(normal, clipped[current][i]);
+    if(penetration >= 0.f)
+    {
+      points[pointCount] = clipped[current][i]
+                           + normal * (penetration * 0.5f);
+      penetrations[pointCount] = penetration;
+      ++pointCount;
+    }
+  }
+
+  if(pointCount == 0u)
+  {
+    // Only when the boxes barely touch past the face's edge, the deepest
+    // corner of the incident face stands in
+    glm::vec3 corners[4] = {faceCenter + u + v, faceCenter - u + v
+                            , faceCenter - u - v, faceCenter + u - v};
+    glm::vec3 deepest = corners[0];
+    for(const glm::vec3 &corner : corners)
+    {
+      if(glm::dot(normal, corner) < glm::dot(normal, deepest))
+      {
+        deepest = corner;
+      }
+    }
+    points[0] = deepest + normal * (overlap * 0.5f);
+    penetrations[0] = overlap;
+    pointCount = 1u;
+  }
+
+  ReducePoints(points, penetrations, pointCount, normal, manifold);
+}
+
+/*
+ * Finds the point between the closest points of an edge of each box, the
+ * edges running along the given axis of each box
+ */
+static void EdgeContact(const OrientedBox &first, const OrientedBox &second
+                        , const int &firstAxis, const int &secondAxis
+                        , const glm::vec3 &normal, const float &overlap
+                        , ContactManifold &manifold)
+{
+  // The edge of each box reaching furthest toward the other
+  glm::vec3 firstPoint = first.center;
+  glm::vec3 secondPoint = second.center;
+  for(int axis = 0; axis < 3; ++axis)
+  {
+    if(axis != firstAxis)
+    {
+      const float sign = glm::dot(first.axes[axis], normal) < 0.f ? -1.f
+                                                                  : 1.f;
+      firstPoint += first.axes[axis] * (sign * first.halfExtents[axis]);
+    }
+    if(axis != secondAxis)
+    {
+      const float sign = glm::dot(second.axes[axis], normal) < 0.f ? 1.f
+                                                                   : -1.f;
+      secondPoint += second.axes[axis] * (sign * second.halfExtents[axis]);
+    }
+  }
+
+  // The closest points of the two lines, kept on each edge
+  const glm::vec3 &firstDirection = first.axes[firstAxis];
+  const glm::vec3 &secondDirection = second.axes[secondAxis];
+  const glm::vec3 between = firstPoint - secondPoint;
+  const float alignment = glm::dot(firstDirection, secondDirection);
+  const float firstDistance = glm::dot(firstDirection, between);
+  const float secondDistance = glm::dot(secondDirection, between);
+  const float denominator = max(1.f - alignment * alignment
+                                , PARALLEL_EPSILON);
+
+  const float firstExtent = first.halfExtents[firstAxis];
+  const float secondExtent = second.halfExtents[secondAxis];
+  const float firstAlong = glm::clamp((alignment * secondDistance
+                                       - firstDistance) / denominator
+                                      , -firstExtent, firstExtent);
+  const float secondAlong = glm::clamp(alignment * firstAlong
+                                       + secondDistance
+                                       , -secondExtent, secondExtent);
+
+  manifold.pointCount = 1u;
+  manifold.points[0] = (firstPoint + firstDirection * firstAlong
+                        + secondPoint + secondDirection * secondAlong)
+                       * 0.5f;
+  manifold.penetrations[0] = overlap;
+}
+
+//=================//
+//= CTOR and DTOR =//
+//=================//
+
+ContactBuffer::ContactBuffer(const size_t &capacity)
+: manifolds(capacity), count(0u), droppedCount(0u)
+{
+
+}
+
+ContactBuffer::~ContactBuffer()
+{
+
+}
+
+//==================//
+//= Public Methods =//
+//==================//
+
+float ContactManifold::GetMaxPenetration() const
+{
+  float deepest = 0.f;
+  for(uint32_t i = 0; i < pointCount; ++i)
+  {
+    deepest = max(deepest, penetrations[i]);
+  }
+  return deepest;
+}
+
+void ContactBuffer::Reserve(const size_t &capacity)
+{
+  if(capacity > manifolds.size())
+  {
+    manifolds.resize(capacity);
+  }
+}
+
+void ContactBuffer::Clear()
+{
+  count = 0u;
+  droppedCount = 0u;
+}
+
+bool ContactBuffer::Push(const ContactManifold &manifold)
+{
+  if(count == manifolds.size())
+  {
+    ++droppedCount;
+    return false;
+  }
+
+  manifolds[count] = manifold;
+  ++count;
+  return true;
+}
+
+const ContactManifold &ContactBuffer::operator[](const size_t &index) const
+{
+  return manifolds[index];
+}
+
+const size_t &ContactBuffer::GetCount() const
+{
+  return count;
+}
+
+size_t ContactBuffer::GetCapacity() const
+{
+  return manifolds.size();
+}
+
+const size_t &ContactBuffer::GetDroppedCount() const
+{
+  return droppedCount;
+}
+
+void Narrowphase::Collide(const Shapes &shapes
+                          , const vector<CollisionPair> &pairs
+                          , ContactBuffer &contacts)
+{
+  contacts.Clear();
+
+  ContactManifold manifold;
+  for(const CollisionPair &pair : pairs)
+  {
+    if(CollidePair(shapes, pair, manifold))
+    {
+      contacts.Push(manifold);
+    }
+  }
+}
+
+bool Narrowphase::CollidePair(const Shapes &shapes, const CollisionPair &pair
+                              , ContactManifold &manifold)
+{
+  const bool isFirstSphere
+    = shapes.types[pair.first] == Collider::SHAPE_SPHERE;
+  const bool isSecondSphere
+    = shapes.types[pair.second] == Collider::SHAPE_SPHERE;
+
+  bool isTouching = false;
+  if(isFirstSphere && isSecondSphere)
+  {
+    isTouching = SphereSphere(shapes.spheres[pair.first]
+                              , shapes.spheres[pair.second], manifold);
+  }
+  else if(isFirstSphere)
+  {
+    isTouching = SphereBox(shapes.spheres[pair.first]
+                           , shapes.boxes[pair.second], manifold);
+  }
+  else if(isSecondSphere)
+  {
+    // The test's normal points from the sphere so it is turned around
+    isTouching = SphereBox(shapes.spheres[pair.second]
+                           , shapes.boxes[pair.first], manifold);
+    manifold.normal = -manifold.normal;
+  }
+  else
+  {
+    isTouching = BoxBox(shapes.boxes[pair.first]
+                        , shapes.boxes[pair.second], manifold);
+  }
+
+  if(isTouching)
+  {
+    manifold.first = pair.first;
+    manifold.second = pair.second;
+  }
+  return isTouching;
+}
+
+bool Narrowphase::SphereSphere(const Sphere &first, const Sphere &second
+                               , ContactManifold &manifold)
+{
+  const glm::vec3 offset = second.center - first.center;
+  const float distanceSquared = glm::dot(offset, offset);
+  const float radii = first.radius + second.radius;
+  if(distanceSquared > radii * radii)
+  {
+    return false;
+  }
+
+  // Spheres at the same center are pushed apart along any axis
+  const float distance = sqrt(distanceSquared);
+  const glm::vec3 normal = distance > 0.f ? offset / distance
+                                          : glm::vec3(0.f, 1.f, 0.f);
+  const float penetration = radii - distance;
+
+  manifold.normal = normal;
+  manifold.pointCount = 1u;
+  manifold.points[0] = first.center
+                       + normal * (first.radius - penetration * 0.5f);
+  manifold.penetrations[0] = penetration;
+  return true;
+}
+
+bool Narrowphase::SphereBox(const Sphere &sphere, const OrientedBox &box
+                            , ContactManifold &manifold)
+{
+  // The box's axes are orthonormal so the transpose takes the sphere into
+  // the box's space, where it is an AABB about the origin
+  const glm::vec3 local = glm::transpose(box.axes)
+                          * (sphere.center - box.center);
+  const glm::vec3 closest = glm::clamp(local, -box.halfExtents
+                                       , box.halfExtents);
+  const glm::vec3 outside = local - closest;
+  const float distanceSquared = glm::dot(outside, outside);
+
+  glm::vec3 surface = closest;
+  glm::vec3 localNormal = {0.f, 0.f, 0.f};
+  float penetration = 0.f;
+  if(distanceSquared > 0.f)
+  {
+    if(distanceSquared > sphere.radius * sphere.radius)
+    {
+      return false;
+    }
+    const float distance = sqrt(distanceSquared);
+    localNormal = -outside / distance;
+    penetration = sphere.radius - distance;
+  }
+  else
+  {
+    // The center is inside the box so it is pushed out the nearest face
+    int nearest = 0;
+    float nearestDistance = numeric_limits<float>::max();
+    for(int axis = 0; axis < 3; ++axis)
+    {
+      const float distance = box.halfExtents[axis] - fabs(local[axis]);
+      if(distance < nearestDistance)
+      {
+        nearestDistance = distance;
+        nearest = axis;
+      }
+    }
+    const float sign = local[nearest] < 0.f ? -1.f : 1.f;
+    surface[nearest] = box.halfExtents[nearest] * sign;
+    localNormal[nearest] = -sign;
+    penetration = sphere.radius + nearestDistance;
+  }
+
+  manifold.normal = box.axes * localNormal;
+  manifold.pointCount = 1u;
+  manifold.points[0] = (box.center + box.axes * surface + sphere.center
+                        + manifold.normal * sphere.radius) * 0.5f;
+  manifold.penetrations[0] = penetration;
+  return true;
+}
+
+bool Narrowphase::BoxBox(const OrientedBox &first, const OrientedBox &second
+                         , ContactManifold &manifold)
+{
+  const glm::vec3 offset = second.center - first.center;
+
+  // The face axes of each box
+  float faceOverlaps[2] = {numeric_limits<float>::max()
+                           , numeric_limits<float>::max()};
+  int faces[2] = {0, 0};
+  const OrientedBox *boxes[2] = {&first, &second};
+  for(int box = 0; box < 2; ++box)
+  {
+    for(int axis = 0; axis < 3; ++axis)
+    {
+      const glm::vec3 &normal = boxes[box]->axes[axis];
+      const float overlap = ProjectBox(first, normal)
+                            + ProjectBox(second, normal)
+                            - fabs(glm::dot(offset, normal));
+      if(overlap < 0.f)
+      {
+        return false;
+      }
+      if(overlap < faceOverlaps[box])
+      {
+        faceOverlaps[box] = overlap;
+        faces[box] = axis;
+      }
+    }
+  }
+
+  // The cross of each pair of edges, skipping edges that are parallel as
+  // the face axes already cover them
+  float edgeOverlap = numeric_limits<float>::max();
+  glm::vec3 edgeNormal = {0.f, 0.f, 0.f};
+  int edges[2] = {0, 0};
+  for(int firstAxis = 0; firstAxis < 3; ++firstAxis)
+  {
+    for(int secondAxis = 0; secondAxis < 3; ++secondAxis)
+    {
+      const glm::vec3 cross = glm::cross(first.axes[firstAxis]
+                                         , second.axes[secondAxis]);
+      const float lengthSquared = glm::dot(cross, cross);
+      if(lengthSquared < PARALLEL_EPSILON)
+      {
+        continue;
+      }
+
+      const glm::vec3 normal = cross / sqrt(lengthSquared);
+      const float overlap = ProjectBox(first, normal)
+                            + ProjectBox(second, normal)
+                            - fabs(glm::dot(offset, normal));
+      if(overlap < 0.f)
+      {
+        return false;
+      }
+      if(overlap < edgeOverlap)
+      {
+        edgeOverlap = overlap;
+        edgeNormal = normal;
+        edges[0] = firstAxis;
+        edges[1] = secondAxis;
+      }
+    }
+  }
+
+  int reference = 0;
+  if(faceOverlaps[1] < RELATIVE_TOLERANCE * faceOverlaps[0]
+                       - ABSOLUTE_TOLERANCE)
+  {
+    reference = 1;
+  }
+  const float faceOverlap = faceOverlaps[reference];
+
+  if(edgeOverlap < RELATIVE_TOLERANCE * faceOverlap - ABSOLUTE_TOLERANCE)
+  {
+    manifold.normal = glm::dot(offset, edgeNormal) < 0.f ? -edgeNormal
+                                                         : edgeNormal;
+    EdgeContact(first, second, edges[0], edges[1], manifold.normal
+                , edgeOverlap, manifold);
+    return true;
+  }
+
+  const glm::vec3 &axis = boxes[reference]->axes[faces[reference]];
+  manifold.normal = glm::dot(offset, axis) < 0.f ? -axis : axis;
+  if(reference == 0)
+  {
+    FaceContact(first, second, faces[0], manifold.normal, faceOverlap
+                , manifold);
+  }
+  else
+  {
+    // The second box's face points back toward the first
+    FaceContact(second, first, faces[1], -manifold.normal, faceOverlap
+                , manifold);
+  }
+  return true;
+}
+}
@@ -0,0 +1,326 @@
+/*
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    CPL_SpatialHash.cpp
+ *
+ *  \brief
+ *    An implementation for finding which bodies may be touching by dropping
+ *    their bounds into a uniform grid
+*/
+
+#include "clapp_includes/pch.h"
+
+#include "clapp_includes/CPL_SpatialHash.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+
+#include "clapp_includes/Clarity_IO.h"
+
+#include "../external/glm/common.hpp"
+
+using namespace std;
+
+namespace ClaPP
+{
+// Far enough out that no real body reaches it, keeps huge or broken
+// coordinates from overflowing when turned into cells
+static const float CELL_LIMIT = 1e9f;
+
+/*
+ * The cell of the whole world a coordinate is in
+ */
+static int64_t WorldCell(const float &value, const float &inverseCellSize)
+{
+  float scaled = floor(value * inverseCellSize);
+  // Written so NaN ends up at the limit as well
+  if(!(scaled >= -CELL_LIMIT))
+  {
+    scaled = -CELL_LIMIT;
+  }
+  else if(scaled > CELL_LIMIT)
+  {
+    scaled = CELL_LIMIT;
+  }
+  return static_cast<int64_t>(scaled);
+}
+
+//=================//
+//= CTOR and DTOR =//
+//=================//
+
+SpatialHash::SpatialHash(const float &_cellSize)
+: cellSize(1.f), inverseCellSize(1.f), gridCorner(), axisShift(), entries()
+  , sortScratch(), digitCounts(), oversizedBodies(), pairs()
+{
+  SetCellSize(_cellSize);
+}
+
+SpatialHash::~SpatialHash()
+{
+
+}
+
+//==================//
+//= Public Methods =//
+//==================//
+
+void SpatialHash::SetCellSize(const float &_cellSize)
+{
+  if(!(_cellSize > 0.f))
+  {
+    ErrMessage("Spatial hash cell size must be above 0, given "
+               + to_string(_cellSize), EC_PHYSICS);
+    return;
+  }
+
+  cellSize = _cellSize;
+  inverseCellSize = 1.f / cellSize;
+}
+
+const float &SpatialHash::GetCellSize() const
+{
+  return cellSize;
+}
+
+void SpatialHash::Update(const vector<AABB> &bounds)
+{
+  entries.clear();
+  oversizedBodies.clear();
+  pairs.clear();
+
+  if(bounds.empty())
+  {
+    return;
+  }
+
+  const unsigned keyBits = FitGrid(bounds);
+
+  for(uint32_t body = 0; body < bounds.size(); ++body)
+  {
+    const AABB &bound = bounds[body];
+    array<uint32_t, 3> low;
+    array<uint32_t, 3> high;
+    uint64_t cellCount = 1u;
+    for(int axis = 0; axis < 3; ++axis)
+    {
+      low[axis] = ToCell(bound.min[axis], axis);
+      high[axis] = max(low[axis], ToCell(bound.max[axis], axis));
+      cellCount *= high[axis] - low[axis] + 1u;
+    }
+
+    if(cellCount > MAX_CELLS_PER_BODY)
+    {
+      oversizedBodies.push_back(body);
+      continue;
+    }
+
+    for(uint32_t z = low[2]; z <= high[2]; ++z)
+    {
+      for(uint32_t y = low[1]; y <= high[1]; ++y)
+      {
+        for(uint32_t x = low[0]; x <= high[0]; ++x)
+        {
+          entries.push_back({PackCell(x, y, z), body});
+        }
+      }
+    }
+  }
+
+  SortEntries(keyBits);
+  FindGridPairs(bounds);
+  FindOversizedPairs(bounds);
+}
+
+const vector<CollisionPair> &SpatialHash::GetPairs() const
+{
+  return pairs;
+}
+
+const char *SpatialHash::GetName() const
+{
+  return "Spatial hash";
+}
+
+//===================//
+//= Private Methods =//
+//===================//
+
+unsigned SpatialHash::FitGrid(const vector<AABB> &bounds)
+{
+  glm::vec3 lowest = bounds.front().min;
+  glm::vec3 highest = bounds.front().max;
+  for(const AABB &bound : bounds)
+  {
+    lowest = glm::min(lowest, bound.min);
+    highest = glm::max(highest, bound.max);
+  }
+
+  unsigned keyBits = 0u;
+  for(int axis = 0; axis < 3; ++axis)
+  {
+    gridCorner[axis] = WorldCell(lowest[axis], inverseCellSize);
+    const int64_t span = min(WorldCell(highest[axis], inverseCellSize)
+                             - gridCorner[axis], MAX_AXIS_CELLS - 1);
+
+    axisShift[axis] = keyBits;
+    keyBits += static_cast<unsigned>(bit_width(static_cast<uint64_t>(
+      max(span, int64_t(0)))));
+  }
+
+  return keyBits;
+}
+
+uint32_t SpatialHash::ToCell(const float &value, const int &axis) const
+{
+  const int64_t cell = WorldCell(value, inverseCellSize) - gridCorner[axis];
+  return static_cast<uint32_t>(clamp(cell, int64_t(0), MAX_AXIS_CELLS - 1));
+}
+
+uint64_t SpatialHash::PackCell(const uint32_t &x, const uint32_t &y
+                               , const uint32_t &z) const
+{
+  return (static_cast<uint64_t>(x) << axisShift[0])
+         | (static_cast<uint64_t>(y) << axisShift[1])
+         | (static_cast<uint64_t>(z) << axisShift[2]);
+}
+
+uint64_t SpatialHash::SharedCellKey(const AABB &first
+                                    , const AABB &second) const
+{
+  const glm::vec3 corner = glm::max(first.min, second.min);
+  return PackCell(ToCell(corner.x, 0), ToCell(corner.y, 1)
+                  , ToCell(corner.z, 2));
+}
+
+void SpatialHash::SortEntries(const unsigned &keyBits)
+{
+  const unsigned passCount = (keyBits + RADIX_BITS - 1u) / RADIX_BITS;
+  if(passCount == 0u || entries.size() < 2u)
+  {
+    return;
+  }
+
+  // Every pass is counted in one read of the entries
+  digitCounts.assign(passCount * RADIX_SIZE, 0u);
+  for(const CellEntry &entry : entries)
+  {
+    for(unsigned pass = 0; pass < passCount; ++pass)
+    {
+      ++digitCounts[pass * RADIX_SIZE 
+                    + ((entry.key >> (pass * RADIX_BITS)) & RADIX_MASK)];
+    }
+  }
+
+  sortScratch.resize(entries.size());
+  for(unsigned pass = 0; pass < passCount; ++pass)
+  {
+    const unsigned shift = pass * RADIX_BITS;
+    uint32_t *counts = digitCounts.data() + pass * RADIX_SIZE;
+
+    // A digit every key shares would not move anything
+    if(counts[(entries.front().key >> shift) & RADIX_MASK] == entries.size())
+    {
+      continue;
+    }
+
+    uint32_t offset = 0u;
+    for(uint32_t digit = 0; digit < RADIX_SIZE; ++digit)
+    {
+      const uint32_t digitCount = counts[digit];
+      counts[digit] = offset;
+      offset += digitCount;
+    }
+    for(const CellEntry &entry : entries)
+    {
+      sortScratch[counts[(entry.key >> shift) & RADIX_MASK]++] = entry;
+    }
+    entries.swap(sortScratch);
+  }
+}
+
+void SpatialHash::FindGridPairs(const vector<AABB> &bounds)
+{
+  FindPairsInRanges(entries.size()
+    , [&](const size_t &begin, const size_t &end
+          , vector<CollisionPair> &rangePairs)
+    {
+      FindRunPairs(bounds, begin, end, rangePairs);
+    }, pairs);
+}
+
+void SpatialHash::FindRunPairs(const vector<AABB> &bounds
+                               , const size_t &begin, const size_t &end
+                               , vector<CollisionPair> &rangePairs) const
+{
+  // A run that started before the range is found by the range before
+  size_t runStart = begin;
+  while(runStart > 0u && runStart < end
+        && entries[runStart - 1u].key == entries[runStart].key)
+  {
+    ++runStart;
+  }
+
+  while(runStart < end)
+  {
+    const uint64_t key = entries[runStart].key;
+    size_t runEnd = runStart + 1u;
+    while(runEnd < entries.size() && entries[runEnd].key == key)
+    {
+      ++runEnd;
+    }
+
+    // The sort is stable so each run is in body order and the first body
+    // of a pair is always the lower index
+    for(size_t i = runStart; i < runEnd; ++i)
+    {
+      const uint32_t first = entries[i].body;
+      for(size_t j = i + 1u; j < runEnd; ++j)
+      {
+        const uint32_t second = entries[j].body;
+        if(!bounds[first].Overlaps(bounds[second])
+           || SharedCellKey(bounds[first], bounds[second]) != key)
+        {
+          continue;
+        }
+        rangePairs.push_back({first, second});
+      }
+    }
+
+    runStart = runEnd;
+  }
+}
+
+void SpatialHash::FindOversizedPairs(const vector<AABB> &bounds)
+{
+  // Oversized bodies were found in body order so they can be searched
+  FindPairsInRanges(oversizedBodies.size()
+    , [&](const size_t &begin, const size_t &end
+          , vector<CollisionPair> &rangePairs)
+    {
+      for(size_t i = begin; i < end; ++i)
+      {
+        const uint32_t body = oversizedBodies[i];
+        for(uint32_t other = 0; other < bounds.size(); ++other)
+        {
+          if(other == body || !bounds[body].Overlaps(bounds[other]))
+          {
+            continue;
+          }
+          // Two oversized bodies are only reported by the lower of the two
+          if(other < body && binary_search(oversizedBodies.begin()
+                                           , oversizedBodies.end(), other))
+          {
+            continue;
+          }
+          rangePairs.push_back({min(body, other), max(body, other)});
+        }
+      }
+    }, pairs);
+}
+}
@@ -0,0 +1,227 @@
+/*
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    CPL_SweepAndPrune.cpp
+ *
+ *  \brief
+ *    An implementation for finding which bodies may be touching from the
+ *    order of their bounds along each axis, kept sorted between updates
+*/
+
+#include "clapp_includes/pch.h"
+
+#include "clapp_includes/CPL_SweepAndPrune.h"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace ClaPP
+{
+//=================//
+//= CTOR and DTOR =//
+//=================//
+
+SweepAndPrune::SweepAndPrune()
+: axes(), pairs(), pairIndices(), addedPairs(), removedPairs()
+  , bodyCount(0u), swapCount(0u)
+{
+
+}
+
+SweepAndPrune::~SweepAndPrune()
+{
+
+}
+
+//==================//
+//= Public Methods =//
+//==================//
+
+void SweepAndPrune::Update(const vector<AABB> &bounds)
+{
+  addedPairs.clear();
+  removedPairs.clear();
+  swapCount = 0u;
+
+  if(bounds.size() != bodyCount)
+  {
+    Rebuild(bounds);
+    return;
+  }
+
+  for(int axis = 0; axis < 3; ++axis)
+  {
+    SortAxis(axis, bounds);
+  }
+}
+
+const vector<CollisionPair> &SweepAndPrune::GetPairs() const
+{
+  return pairs;
+}
+
+const char *SweepAndPrune::GetName() const
+{
+  return "Sweep and prune";
+}
+
+const vector<CollisionPair> &SweepAndPrune::GetAddedPairs() const
+{
+  return addedPairs;
+}
+
+const vector<CollisionPair> &SweepAndPrune::GetRemovedPairs() const
+{
+  return removedPairs;
+}
+
+const size_t &SweepAndPrune::GetSwapCount() const
+{
+  return swapCount;
+}
+
+//===================//
+//= Private Methods =//
+//===================//
+
+bool SweepAndPrune::IsBefore(const Endpoint &first, const Endpoint &second)
+{
+  return first.value < second.value
+         || (first.value == second.value && !first.IsMax()
+             && second.IsMax());
+}
+
+uint64_t SweepAndPrune::PairKey(const uint32_t &first
+                                , const uint32_t &second)
+{
+  return (static_cast<uint64_t>(first) << 32u) | second;
+}
+
+void SweepAndPrune::Rebuild(const vector<AABB> &bounds)
+{
+  // The old indices may now be other bodies so every old pair is gone
+  removedPairs.swap(pairs);
+  pairs.clear();
+  pairIndices.clear();
+  bodyCount = bounds.size();
+
+  for(int axis = 0; axis < 3; ++axis)
+  {
+    vector<Endpoint> &endpoints = axes[axis];
+    endpoints.resize(bodyCount * 2u);
+    for(uint32_t body = 0; body < bodyCount; ++body)
+    {
+      endpoints[body * 2u] = {bounds[body].min[axis], body << 1u};
+      endpoints[body * 2u + 1u] = {bounds[body].max[axis]
+                                   , (body << 1u) | 1u};
+    }
+    sort(endpoints.begin(), endpoints.end(), IsBefore);
+  }
+
+  // Sweep along x, every body started and not yet ended overlaps the next
+  // body to start along x
+  vector<uint32_t> active;
+  for(const Endpoint &endpoint : axes[0])
+  {
+    const uint32_t body = endpoint.GetBody();
+    if(endpoint.IsMax())
+    {
+      active.erase(find(active.begin(), active.end(), body));
+      continue;
+    }
+
+    for(const uint32_t &other : active)
+    {
+      if(bounds[body].Overlaps(bounds[other]))
+      {
+        AddPair(body, other);
+      }
+    }
+    active.push_back(body);
+  }
+}
+
+void SweepAndPrune::SortAxis(const int &axis, const vector<AABB> &bounds)
+{
+  vector<Endpoint> &endpoints = axes[axis];
+  for(Endpoint &endpoint : endpoints)
+  {
+    const AABB &bound = bounds[endpoint.GetBody()];
+    endpoint.value = endpoint.IsMax() ? bound.max[axis] : bound.min[axis];
+  }
+
+  for(size_t i = 1; i < endpoints.size(); ++i)
+  {
+    const Endpoint moving = endpoints[i];
+    const uint32_t body = moving.GetBody();
+    size_t slot = i;
+
+    while(slot > 0u && IsBefore(moving, endpoints[slot - 1u]))
+    {
+      const Endpoint &passed = endpoints[slot - 1u];
+      const uint32_t other = passed.GetBody();
+
+      // A start moving back past an end begins an overlap along this axis,
+      // which is a pair if the bodies overlap along the others as well. An
+      // end moving back past a start ends one.
+      if(!moving.IsMax() && passed.IsMax())
+      {
+        if(bounds[body].Overlaps(bounds[other]))
+        {
+          AddPair(body, other);
+        }
+      }
+      else if(moving.IsMax() && !passed.IsMax())
+      {
+        RemovePair(body, other);
+      }
+
+      endpoints[slot] = passed;
+      --slot;
+      ++swapCount;
+    }
+    endpoints[slot] = moving;
+  }
+}
+
+void SweepAndPrune::AddPair(const uint32_t &first, const uint32_t &second)
+{
+  const CollisionPair pair = {min(first, second), max(first, second)};
+  const auto [found, isNew] = pairIndices.try_emplace(
+    PairKey(pair.first, pair.second), static_cast<uint32_t>(pairs.size()));
+  if(!isNew)
+  {
+    return;
+  }
+
+  pairs.push_back(pair);
+  addedPairs.push_back(pair);
+}
+
+void SweepAndPrune::RemovePair(const uint32_t &first, const uint32_t &second)
+{
+  const CollisionPair pair = {min(first, second), max(first, second)};
+  const auto found = pairIndices.find(PairKey(pair.first, pair.second));
+  if(found == pairIndices.end())
+  {
+    return;
+  }
+
+  // The last pair is moved into the removed pair's place
+  const uint32_t index = found->second;
+  pairIndices.erase(found);
+  if(index + 1u != pairs.size())
+  {
+    const CollisionPair &last = pairs.back();
+    pairs[index] = last;
+    pairIndices[PairKey(last.first, last.second)] = index;
+  }
+  pairs.pop_back();
+
+  removedPairs.push_back(pair);
+}
+}
@@ -15,25 +15,43 @@
 
 #include "clapp_includes/CPL_System.h"
 
+#include <algorithm>
+#include <cmath>
 #include <cstdlib>
 
 #include "clapp_includes/CPL_Transform.h"
 #include "clapp_includes/CPL_Physics.h"
+#include "clapp_includes/CPL_TransformKernel.h"
 #include "clapp_includes/CIL_Inputs.h"
 
 #include "clapp_includes/Clarity_ECS.h"
 #include "clapp_includes/Clarity_IO.h"
+#include "clapp_includes/Clarity_ThreadPool.h"
 
 #include "clapp_includes/g_pch.h"
 
 using namespace ClaPP;
 using namespace std;
 
-// NOTE: Temp constant drag;
+// NOTE: Temp constant drag, the share of velocity lost each second
 static const glm::vec3 DRAG = {3.f, 3.f, 3.f};
 
 CPL_System::CPL_System(const std::string &_sysName)
 : Clarity_System(_sysName), gravityVec(defaultGravityVec)
+  , integrator(Integrator::INTEGRATOR_SEMI_IMPLICIT_EULER)
+  , broadphase(BROADPHASE_SPATIAL_HASH)
+  , solverIterations(ContactSolver::DEFAULT_ITERATIONS)
+  , threadPool(&ThreadPool::GetInstance())
+  , timeAccumulator(0.f), bodies(), bodyBatch(), batchBodies()
+  , colliderBodies()
+  , colliderEntities(), colliderShapes(), colliderBoxes(), colliderSpheres()
+  , colliderBounds(), colliderInverseMasses(), colliderFrictions()
+  , colliderRestitutions(), colliderTree(), colliderProxies(colliderTree)
+  , spatialHash(), treeBroadphase(colliderTree), sweepAndPrune()
+  , broadphases({&spatialHash, &treeBroadphase, &sweepAndPrune})
+  , candidatePairs(), stepPairs(), pairManifolds(), pairTouching()
+  , contacts(), contactSolver(), islands()
+  , islandRestTimes(), wakeAll(false), matrixInputs(), worldMatrices()
 {
   systemSignature.set(Component::C_TRANSFORM);
   systemSignature.set(Component::C_PHYSICS);
@@ -54,13 +72,233 @@ CPL_System::SYS_ERR CPL_System::Load()
   return SYS_NO_ERR;
 }
 
-CPL_System::SYS_ERR CPL_System::Update(float deltaTIme)
+CPL_System::SYS_ERR CPL_System::Update(float deltaTime)
+{
+  GatherBodies();
+
+  timeAccumulator += max(deltaTime, 0.f);
+
+  int substeps = 0;
+  while(timeAccumulator >= FIXED_TIME_STEP && substeps < MAX_SUBSTEPS)
+  {
+    Step(FIXED_TIME_STEP);
+    timeAccumulator -= FIXED_TIME_STEP;
+    ++substeps;
+  }
+  // Time that could not be caught up on is dropped so the simulation slows
+  // down instead of falling further behind every frame
+  if(timeAccumulator >= FIXED_TIME_STEP)
+  {
+    timeAccumulator = fmod(timeAccumulator, FIXED_TIME_STEP);
+  }
+  // A frame without a step leaves every body where it was
+  if(substeps)
+  {
+    UpdateSleep(substeps * FIXED_TIME_STEP);
+    ScatterBodies();
+
+    candidatePairs.clear();
+    for(const CollisionPair &pair : broadphases[broadphase]->GetPairs())
+    {
+      candidatePairs.push_back({colliderEntities[pair.first]
+                                , colliderEntities[pair.second]});
+    }
+  }
+
+  UpdateWorldMatrices(GetInterpolationAlpha());
+
+  // Forces are applied again each frame by whatever is pushing the entity
+  for(const Body &body : bodies)
+  {
+    Physics::PhysicsData &physicsData = body.physics->GetPhysicsData();
+    physicsData.appliedForce = {0.f, 0.f, 0.f};
+    physicsData.rotationForce = {0.f, 0.f, 0.f};
+  }
+
+  return SYS_NO_ERR;
+}
+
+CPL_System::SYS_ERR CPL_System::Render()
+{
+  return SYS_NO_ERR;
+}
+
+CPL_System::SYS_ERR CPL_System::Unload()
+{
+  return SYS_NO_ERR;
+}
+
+CPL_System::SYS_ERR CPL_System::Terminate()
+{
+  colliderProxies.Clear();
+  return SYS_NO_ERR;
+}
+
+void CPL_System::SetGravityVec(const glm::vec3 &_gravityVec)
+{
+  gravityVec = _gravityVec;
+  wakeAll = true;
+}
+
+const glm::vec3 &CPL_System::GetGravityVec()
+{
+  return gravityVec;
+}
+
+void CPL_System::ResetGravityVec()
+{
+  gravityVec = defaultGravityVec;
+  wakeAll = true;
+}
+
+void CPL_System::SetIntegrator(const Integrator::INTEGRATOR &_integrator)
+{
+  integrator = _integrator;
+}
+
+const Integrator::INTEGRATOR &CPL_System::GetIntegrator() const
+{
+  return integrator;
+}
+
+float CPL_System::GetInterpolationAlpha() const
+{
+  return timeAccumulator / FIXED_TIME_STEP;
+}
+
+const vector<pair<ENTITY_ID, ENTITY_ID>> &
+  CPL_System::GetCandidatePairs() const
+{
+  return candidatePairs;
+}
+
+const ContactBuffer &CPL_System::GetContacts() const
+{
+  return contacts;
+}
+
+const ENTITY_ID &CPL_System::GetColliderEntity(const uint32_t &collider) const
+{
+  return colliderEntities[collider];
+}
+
+void CPL_System::SetSolverIterations(const int &_solverIterations)
+{
+  if(_solverIterations < 0)
+  {
+    ErrMessage("Invalid solver iteration count given: "
+               + std::to_string(_solverIterations), EC_PHYSICS);
+    return;
+  }
+  solverIterations = _solverIterations;
+}
+
+const int &CPL_System::GetSolverIterations() const
+{
+  return solverIterations;
+}
+
+SpatialHash &CPL_System::GetSpatialHash()
+{
+  return spatialHash;
+}
+
+SweepAndPrune &CPL_System::GetSweepAndPrune()
+{
+  return sweepAndPrune;
+}
+
+void CPL_System::SetBroadphase(const BROADPHASE &_broadphase)
+{
+  if(_broadphase < 0 || _broadphase >= BROADPHASE_COUNT)
+  {
+    ErrMessage("Invalid broadphase given: " + std::to_string(_broadphase)
+               , EC_PHYSICS);
+    return;
+  }
+  broadphase = _broadphase;
+}
+
+const CPL_System::BROADPHASE &CPL_System::GetBroadphase() const
+{
+  return broadphase;
+}
+
+void CPL_System::SetThreadPool(ThreadPool &_threadPool)
+{
+  threadPool = &_threadPool;
+  for(Broadphase *&each : broadphases)
+  {
+    each->SetThreadPool(_threadPool);
+  }
+}
+
+ThreadPool &CPL_System::GetThreadPool() const
+{
+  return *threadPool;
+}
+
+bool CPL_System::Raycast(const glm::vec3 &origin
+                         , const glm::vec3 &direction
+                         , const float &maxDistance, RaycastHit &hit) const
+{
+  const float length = glm::length(direction);
+  if(length <= 0.f)
+  {
+    return false;
+  }
+  const glm::vec3 unitDirection = direction / length;
+
+  bool isHit = false;
+  colliderTree.Raycast(origin, unitDirection, maxDistance
+    , [&](const int32_t &proxy, const float &closest)
+    {
+      const uint32_t collider = colliderTree.GetUserData(proxy);
+      float distance = 0.f;
+      const bool isColliderHit 
+        = colliderShapes[collider] == Collider::SHAPE_SPHERE
+          ? RaycastSphere(colliderSpheres[collider], origin, unitDirection
+                          , closest, distance)
+          : RaycastBox(colliderBoxes[collider], origin, unitDirection
+                       , closest, distance);
+      if(!isColliderHit)
+      {
+        return -1.f;
+      }
+
+      isHit = true;
+      hit = {colliderEntities[collider], distance
+             , origin + unitDirection * distance};
+      return distance;
+    });
+
+  return isHit;
+}
+
+void CPL_System::QueryOverlaps(const AABB &bounds
+                               , vector<ENTITY_ID> &entities) const
+{
+  entities.clear();
+  colliderTree.Query(bounds, [&](const int32_t &proxy)
+  {
+    const uint32_t collider = colliderTree.GetUserData(proxy);
+    if(colliderBounds[collider].Overlaps(bounds))
+    {
+      entities.push_back(colliderEntities[collider]);
+    }
+    return true;
+  });
+}
+
+//===================//
+//= Private Methods =//
+//===================//
+
+void CPL_System::GatherBodies()
 {
-  // TODO: Make it so that the system reflects the changes in force
-  // done/inputs made to the player
   ECS *ecs = GetECSPtr();
-  glm::mat4 identity = glm::identity<glm::mat4>();
 
+  bodies.clear();
   for(const ENTITY_ID &entity : systemEntites)
   {
     // Retrieve the transform and physics components to modify them
@@ -78,54 +316,492 @@ CPL_System::SYS_ERR CPL_System::Update(float deltaTIme)
       continue;
     }
 
-    // Get the proper data types
-    Physics::PhysicsData &physicsData = physics->GetPhysicsData();
-    Transform::TransformData &transformData = transform->GetTransformData();
-
-    transformData.worldPos += physicsData.appliedForce;
-    transformData.rotation += physicsData.rotationForce;
-    
-    glm::mat4 translate = glm::translate(identity, transformData.worldPos);
-    glm::mat4 scale = glm::scale(identity, transformData.scale);
-    // Rotate on all axis's
-    // NOTE: Added some temp rotations on all axis
-    glm::mat4 rotateX = glm::rotate(identity
-                                    , glm::radians(
-                                    transformData.rotation.x)
-                                    , {1.f, 0.f, 0.f});
-    glm::mat4 rotateY = glm::rotate(identity
-                                    , glm::radians(
-                                    transformData.rotation.y)
-                                    , {0.f, 1.f, 0.f});
-    glm::mat4 rotateZ = glm::rotate(identity
-                                    , glm::radians(
-                                    transformData.rotation.z)
-                                    , {0.f, 0.f, 1.f});
-
-    // Create a correspongding world-based matrix
-    transformData.worldMatrix = translate * rotateZ * rotateY * rotateX * scale;
-
-    // Reset applied force
-    physicsData.appliedForce = {0.f, 0.f, 0.f};
-    physicsData.rotationForce = {0.f, 0.f, 0.f};
+    // Colliders are optional so they are only looked up once known to be
+    // there
+    Collider *collider = nullptr;
+    if(physics->GetPhysicsData().collisionOn
+       && ecs->HasComponent(entity, Component::C_COLLIDER))
+    {
+      collider = ecs->GetComponent<Collider>(entity, Component::C_COLLIDER);
+    }
+
+    bodies.push_back({entity, transform, physics, collider});
   }
 
-  return SYS_NO_ERR;
+  // Anything that would move a sleeping body wakes it
+  size_t awakeCount = 0u;
+  for(const Body &body : bodies)
+  {
+    Physics::PhysicsData &physicsData = body.physics->GetPhysicsData();
+    const Transform::TransformData &transformData
+      = body.transform->GetTransformData();
+    if(physicsData.isAsleep
+       && (wakeAll || !physicsData.sleepOn
+           || physicsData.appliedForce != glm::vec3(0.f)
+           || physicsData.rotationForce != glm::vec3(0.f)
+           || physicsData.veclotiy != glm::vec3(0.f)
+           || transformData.worldPos != transformData.previousPos
+           || transformData.orientation 
+              != transformData.previousOrientation))
+    {
+      physicsData.isAsleep = false;
+      physicsData.restTime = 0.f;
+    }
+    if(!physicsData.isAsleep)
+    {
+      ++awakeCount;
+    }
+  }
+  wakeAll = false;
+
+  // Awake bodies are placed first so the steps only run over the front of
+  // the batch, both halves keep the order of bodies
+  batchBodies.resize(bodies.size());
+  size_t awakeSlot = 0u;
+  size_t asleepSlot = awakeCount;
+  colliderBodies.clear();
+  colliderShapes.clear();
+  colliderInverseMasses.clear();
+  colliderFrictions.clear();
+  colliderRestitutions.clear();
+  for(uint32_t i = 0; i < bodies.size(); ++i)
+  {
+    const Physics::PhysicsData &physicsData 
+      = bodies[i].physics->GetPhysicsData();
+    const uint32_t slot = static_cast<uint32_t>(physicsData.isAsleep 
+                                                ? asleepSlot++ 
+                                                : awakeSlot++);
+    batchBodies[slot] = i;
+    if(bodies[i].collider == nullptr)
+    {
+      continue;
+    }
+
+    // Sleeping bodies are not moved by what runs into them until they wake
+    colliderBodies.push_back(slot);
+    colliderShapes.push_back(bodies[i].collider->GetColliderData().shape);
+    colliderInverseMasses.push_back(
+      physicsData.mass > 0.f && !physicsData.isAsleep 
+      ? 1.f / physicsData.mass : 0.f);
+    colliderFrictions.push_back(physicsData.friction);
+    colliderRestitutions.push_back(physicsData.restitution);
+  }
+
+  bodyBatch.Resize(bodies.size());
+  bodyBatch.SetActiveCount(awakeCount);
+  for(size_t slot = 0; slot < batchBodies.size(); ++slot)
+  {
+    const Body &body = bodies[batchBodies[slot]];
+    const Physics::PhysicsData &physicsData = body.physics->GetPhysicsData();
+    const Transform::TransformData &transformData
+      = body.transform->GetTransformData();
+
+    // Bodies have no mass yet so applied forces are accelerations, and
+    // gravity is folded in here so the steps never branch on it
+    glm::vec3 acceleration = physicsData.acceleration
+                             + physicsData.appliedForce;
+    if(physicsData.gravityOn)
+    {
+      acceleration += gravityVec;
+    }
+
+    // Verlet moves by the distance moved a step ago, found from velocity
+    // so a velocity set on the component is kept
+    bodyBatch.SetBody(slot, transformData.worldPos
+                      , transformData.worldPos 
+                        - physicsData.veclotiy * FIXED_TIME_STEP
+                      , physicsData.veclotiy, acceleration);
+    // Rotation forces are turn rates in degrees a second
+    bodyBatch.SetOrientation(slot, transformData.orientation
+                             , glm::radians(physicsData.rotationForce));
+  }
+
+  // Sleeping colliders do not move through the frame so their shapes are
+  // only found here
+  colliderEntities.resize(colliderBodies.size());
+  colliderBoxes.resize(colliderBodies.size());
+  colliderSpheres.resize(colliderBodies.size());
+  colliderBounds.resize(colliderBodies.size());
+  for(size_t i = 0; i < colliderBodies.size(); ++i)
+  {
+    colliderEntities[i] = bodies[batchBodies[colliderBodies[i]]].entity;
+    if(colliderBodies[i] >= awakeCount)
+    {
+      UpdateCollider(i);
+    }
+  }
 }
 
-CPL_System::SYS_ERR CPL_System::Render()
+void CPL_System::UpdateCollider(const size_t &collider)
 {
-  return SYS_NO_ERR;
+  const uint32_t slot = colliderBodies[collider];
+  const Body &body = bodies[batchBodies[slot]];
+  const Collider::ColliderData &colliderData 
+    = body.collider->GetColliderData();
+  const glm::vec3 &scale = body.transform->GetTransformData().scale;
+
+  OrientedBox &box = colliderBoxes[collider];
+  box.axes = glm::mat3_cast(bodyBatch.GetOrientation(slot));
+  box.center = bodyBatch.GetPosition(slot)
+               + box.axes * (colliderData.offset * scale);
+  box.halfExtents = colliderData.halfExtents * glm::abs(scale);
+
+  if(colliderShapes[collider] == Collider::SHAPE_SPHERE)
+  {
+    Sphere &sphere = colliderSpheres[collider];
+    sphere.center = box.center;
+    sphere.radius = colliderData.radius 
+                    * glm::max(glm::max(fabs(scale.x), fabs(scale.y))
+                               , fabs(scale.z));
+    colliderBounds[collider] = sphere.GetBounds();
+  }
+  else
+  {
+    colliderBounds[collider] = box.GetBounds();
+  }
 }
 
-CPL_System::SYS_ERR CPL_System::Unload()
+void CPL_System::Step(const float &timeStep)
 {
-  return SYS_NO_ERR;
+  threadPool->ParallelFor(bodyBatch.GetActiveCount()
+    , [&](const size_t &begin, const size_t &end, const size_t &)
+    {
+      Integrator::Integrate(bodyBatch, integrator, DRAG, timeStep, begin
+                            , end);
+    }, BODY_BATCH_SIZE);
+
+  UpdateBounds();
+  UpdateBroadphase();
+  UpdateContacts(timeStep);
 }
 
-CPL_System::SYS_ERR CPL_System::Terminate()
+void CPL_System::UpdateBounds()
 {
-  return SYS_NO_ERR;
+  threadPool->ParallelFor(colliderBodies.size()
+    , [&](const size_t &begin, const size_t &end, const size_t &)
+    {
+      for(size_t i = begin; i < end; ++i)
+      {
+        if(colliderBodies[i] < bodyBatch.GetActiveCount())
+        {
+          UpdateCollider(i);
+        }
+      }
+    }, BODY_BATCH_SIZE);
+}
+
+void CPL_System::UpdateBroadphase()
+{
+  for(uint32_t i = 0; i < colliderBodies.size(); ++i)
+  {
+    const uint32_t body = colliderBodies[i];
+    // Sleeping colliders have not moved so the tree is left as it is
+    if(body >= bodyBatch.GetActiveCount()
+       && colliderProxies.Keep(colliderEntities[i], i))
+    {
+      continue;
+    }
+    colliderProxies.Update(colliderEntities[i], colliderBounds[i]
+                           , bodyBatch.GetPosition(body) 
+                             - bodyBatch.GetPreviousPosition(body), i);
+  }
+  colliderProxies.EndFrame();
+
+  broadphases[broadphase]->Update(colliderBounds);
+}
+
+void CPL_System::UpdateContacts(const float &timeStep)
+{
+  // Pairs where neither body can move, such as two sleeping bodies, are
+  // left alone
+  stepPairs.clear();
+  for(const CollisionPair &pair : broadphases[broadphase]->GetPairs())
+  {
+    if(colliderInverseMasses[pair.first] > 0.f
+       || colliderInverseMasses[pair.second] > 0.f)
+    {
+      stepPairs.push_back(pair);
+    }
+  }
+
+  const Narrowphase::Shapes shapes = {colliderShapes.data()
+                                      , colliderBoxes.data()
+                                      , colliderSpheres.data()};
+  pairManifolds.resize(stepPairs.size());
+  pairTouching.resize(stepPairs.size());
+  threadPool->ParallelFor(stepPairs.size()
+    , [&](const size_t &begin, const size_t &end, const size_t &)
+    {
+      for(size_t i = begin; i < end; ++i)
+      {
+        pairTouching[i] = Narrowphase::CollidePair(shapes, stepPairs[i]
+                                                   , pairManifolds[i]);
+      }
+    }, CONTACT_BATCH_SIZE);
+
+  // Touching pairs are added in pair order so the contacts, and so the
+  // solve, are the same on any number of threads. Each pair touches at
+  // most once so the buffer only grows with the pairs.
+  contacts.Clear();
+  contacts.Reserve(stepPairs.size());
+  for(size_t i = 0; i < stepPairs.size(); ++i)
+  {
+    if(pairTouching[i])
+    {
+      contacts.Push(pairManifolds[i]);
+    }
+  }
+
+  // An awake body running into a sleeping one wakes it, the sleeping body
+  // acts as one that never moves until the next frame
+  const size_t awakeCount = bodyBatch.GetActiveCount();
+  for(size_t i = 0; i < contacts.GetCount(); ++i)
+  {
+    const uint32_t first = colliderBodies[contacts[i].first];
+    const uint32_t second = colliderBodies[contacts[i].second];
+    if((first < awakeCount) == (second < awakeCount))
+    {
+      continue;
+    }
+
+    const uint32_t awake = first < awakeCount ? first : second;
+    const uint32_t asleep = first < awakeCount ? second : first;
+    Physics::PhysicsData &physicsData 
+      = bodies[batchBodies[asleep]].physics->GetPhysicsData();
+    if(physicsData.mass > 0.f
+       && glm::length(bodyBatch.GetVelocity(awake)) > SLEEP_SPEED)
+    {
+      physicsData.isAsleep = false;
+      physicsData.restTime = 0.f;
+    }
+  }
+
+  const ContactSolver::Bodies solverBodies =
+  {
+    colliderBodies.data(), colliderInverseMasses.data()
+    , colliderFrictions.data(), colliderRestitutions.data()
+    , {bodyBatch.GetVelocities(BodyBatch::AXIS_X)
+       , bodyBatch.GetVelocities(BodyBatch::AXIS_Y)
+       , bodyBatch.GetVelocities(BodyBatch::AXIS_Z)}
+    , {bodyBatch.GetPositions(BodyBatch::AXIS_X)
+       , bodyBatch.GetPositions(BodyBatch::AXIS_Y)
+       , bodyBatch.GetPositions(BodyBatch::AXIS_Z)}
+    , bodyBatch.GetCount()
+  };
+  contactSolver.Prepare(contacts, solverBodies);
+  SolveContacts(solverIterations, false);
+  SolveContacts(ContactSolver::DEFAULT_POSITION_ITERATIONS, true);
+
+  // Verlet moves by the distance moved last step rather than by velocity,
+  // so the solved velocity is turned back into that distance. Positions
+  // moved apart are kept out of it so they do not become speed.
+  if(integrator == Integrator::INTEGRATOR_VERLET)
+  {
+    threadPool->ParallelFor(colliderBodies.size()
+      , [&](const size_t &begin, const size_t &end, const size_t &)
+      {
+        for(size_t i = begin; i < end; ++i)
+        {
+          const uint32_t body = colliderBodies[i];
+          for(int axis = 0; axis < BodyBatch::AXIS_COUNT; ++axis)
+          {
+            const BodyBatch::AXIS batchAxis 
+              = static_cast<BodyBatch::AXIS>(axis);
+            bodyBatch.GetPreviousPositions(batchAxis)[body] 
+              = bodyBatch.GetPositions(batchAxis)[body]
+                - bodyBatch.GetVelocities(batchAxis)[body] * timeStep;
+          }
+        }
+      }, BODY_BATCH_SIZE);
+  }
+}
+
+void CPL_System::SolveContacts(const int &iterations
+                               , const bool &isCorrecting)
+{
+  const size_t batchCount = contactSolver.GetBatchCount();
+  for(int iteration = 0; iteration < iterations; ++iteration)
+  {
+    // Batches run one after another as later batches read what earlier
+    // ones wrote
+    for(size_t batch = 0; batch < batchCount; ++batch)
+    {
+      size_t batchBegin = 0u;
+      size_t batchEnd = 0u;
+      contactSolver.GetBatch(batch, batchBegin, batchEnd);
+
+      // Constraints that could not be colored share bodies, so they are
+      // solved in order on this thread
+      const bool isOverflow = contactSolver.HasOverflowBatch()
+                              && batch + 1u == batchCount;
+      const size_t rangeSize = isOverflow ? batchEnd - batchBegin 
+                                          : CONTACT_BATCH_SIZE;
+      threadPool->ParallelFor(batchEnd - batchBegin
+        , [&](const size_t &begin, const size_t &end, const size_t &)
+        {
+          if(isCorrecting)
+          {
+            contactSolver.CorrectRange(batchBegin + begin, batchBegin + end);
+          }
+          else
+          {
+            contactSolver.SolveRange(batchBegin + begin, batchBegin + end);
+          }
+        }, rangeSize);
+    }
+  }
+}
+
+void CPL_System::UpdateSleep(const float &frameTime)
+{
+  const size_t awakeCount = bodyBatch.GetActiveCount();
+
+  // Bodies that never move are not linked, or every body resting on the
+  // ground would be one island
+  islands.Reset(bodyBatch.GetCount());
+  for(size_t i = 0; i < contacts.GetCount(); ++i)
+  {
+    const uint32_t first = colliderBodies[contacts[i].first];
+    const uint32_t second = colliderBodies[contacts[i].second];
+    if(bodies[batchBodies[first]].physics->GetPhysicsData().mass > 0.f
+       && bodies[batchBodies[second]].physics->GetPhysicsData().mass > 0.f)
+    {
+      islands.Link(first, second);
+    }
+  }
+  islands.Label();
+
+  // Sleeping bodies keep their rest time, or have it cleared when woken
+  islandRestTimes.assign(islands.GetIslandCount(), SLEEP_TIME);
+  for(uint32_t i = 0; i < bodyBatch.GetCount(); ++i)
+  {
+    Physics::PhysicsData &physicsData 
+      = bodies[batchBodies[i]].physics->GetPhysicsData();
+    if(i < awakeCount)
+    {
+      const bool isResting 
+        = physicsData.sleepOn
+          && physicsData.appliedForce == glm::vec3(0.f)
+          && physicsData.rotationForce == glm::vec3(0.f)
+          && glm::length(bodyBatch.GetVelocity(i)) < SLEEP_SPEED;
+      physicsData.restTime = isResting ? physicsData.restTime + frameTime 
+                                       : 0.f;
+    }
+
+    float &islandRestTime = islandRestTimes[islands.GetIsland(i)];
+    islandRestTime = min(islandRestTime, physicsData.restTime);
+  }
+
+  for(uint32_t i = 0; i < awakeCount; ++i)
+  {
+    if(islandRestTimes[islands.GetIsland(i)] < SLEEP_TIME)
+    {
+      continue;
+    }
+
+    // Stopped where it is so the last world matrix built is exactly where
+    // it sleeps
+    bodies[batchBodies[i]].physics->GetPhysicsData().isAsleep = true;
+    for(int axis = 0; axis < BodyBatch::AXIS_COUNT; ++axis)
+    {
+      const BodyBatch::AXIS batchAxis = static_cast<BodyBatch::AXIS>(axis);
+      bodyBatch.GetVelocities(batchAxis)[i] = 0.f;
+      bodyBatch.GetPreviousPositions(batchAxis)[i] 
+        = bodyBatch.GetPositions(batchAxis)[i];
+    }
+    for(int component = 0; component < BodyBatch::QUAT_COUNT; ++component)
+    {
+      const BodyBatch::QUAT_COMPONENT batchComponent 
+        = static_cast<BodyBatch::QUAT_COMPONENT>(component);
+      bodyBatch.GetPreviousOrientations(batchComponent)[i] 
+        = bodyBatch.GetOrientations(batchComponent)[i];
+    }
+  }
 }
 
+void CPL_System::ScatterBodies()
+{
+  threadPool->ParallelFor(bodyBatch.GetActiveCount()
+    , [&](const size_t &begin, const size_t &end, const size_t &)
+    {
+      for(size_t i = begin; i < end; ++i)
+      {
+        const Body &body = bodies[batchBodies[i]];
+        Physics::PhysicsData &physicsData = body.physics->GetPhysicsData();
+        Transform::TransformData &transformData
+          = body.transform->GetTransformData();
+
+        transformData.previousPos = bodyBatch.GetPreviousPosition(i);
+        transformData.worldPos = bodyBatch.GetPosition(i);
+        transformData.previousOrientation 
+          = bodyBatch.GetPreviousOrientation(i);
+        transformData.orientation = bodyBatch.GetOrientation(i);
+        physicsData.veclotiy = bodyBatch.GetVelocity(i);
+      }
+    }, BODY_BATCH_SIZE);
+}
 
+void CPL_System::UpdateWorldMatrices(const float &alpha)
+{
+  // Sleeping bodies keep the matrix built the frame they fell asleep
+  const size_t count = bodyBatch.GetActiveCount();
+  for(vector<float> &inputs : matrixInputs)
+  {
+    inputs.resize(count);
+  }
+  worldMatrices.resize(count);
+
+  // Each range blends, builds, and writes back its own matrices
+  threadPool->ParallelFor(count
+    , [&](const size_t &begin, const size_t &end, const size_t &)
+    {
+      for(size_t i = begin; i < end; ++i)
+      {
+        const Transform::TransformData &transformData
+          = bodies[batchBodies[i]].transform->GetTransformData();
+
+        const glm::vec3 worldPos = glm::mix(transformData.previousPos
+                                            , transformData.worldPos, alpha);
+        // A step turns very little so a normalized lerp is as good as a
+        // slerp, taking the short way around when the signs disagree
+        glm::quat previous = transformData.previousOrientation;
+        if(glm::dot(previous, transformData.orientation) < 0.f)
+        {
+          previous = -previous;
+        }
+        const glm::quat orientation = glm::normalize(
+          previous * (1.f - alpha) + transformData.orientation * alpha);
+
+        for(int axis = 0; axis < 3; ++axis)
+        {
+          matrixInputs[axis][i] = worldPos[axis];
+          matrixInputs[3 + axis][i] = transformData.scale[axis];
+        }
+        for(int component = 0; component < 4; ++component)
+        {
+          matrixInputs[6 + component][i] = orientation[component];
+        }
+      }
+
+      // Every matrix of the range is built at once rather than from a
+      // matrix per part
+      const TransformKernel::QuaternionTransforms transforms =
+      {
+        {matrixInputs[0].data() + begin, matrixInputs[1].data() + begin
+         , matrixInputs[2].data() + begin}
+        , {matrixInputs[6].data() + begin, matrixInputs[7].data() + begin
+           , matrixInputs[8].data() + begin, matrixInputs[9].data() + begin}
+        , {matrixInputs[3].data() + begin, matrixInputs[4].data() + begin
+           , matrixInputs[5].data() + begin}
+        , end - begin
+      };
+      TransformKernel::ComposeQuaternion(transforms
+                                         , worldMatrices.data() + begin);
+
+      for(size_t i = begin; i < end; ++i)
+      {
+        bodies[batchBodies[i]].transform->GetTransformData().worldMatrix 
+          = worldMatrices[i];
+      }
+    }, BODY_BATCH_SIZE);
+}
@@ -0,0 +1,328 @@
+/*
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    CPL_TransformKernel.cpp
+ *
+ *  \brief
+ *    An implementation for building the world matrices of many transforms
+ *    at once with SIMD
+*/
+
+#include "clapp_includes/pch.h"
+
+#include "clapp_includes/CPL_TransformKernel.h"
+
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) \
+    || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CLAPP_TRANSFORM_SSE
+#include <emmintrin.h>
+#endif
+
+using namespace std;
+
+namespace ClaPP
+{
+/*
+ * Writes a matrix from its rotation, already scaled per column, and its
+ * translation
+ */
+static void StoreMatrix(glm::mat4 &matrix, const float rotation[3][3]
+                        , const float translation[3])
+{
+  for(int column = 0; column < 3; ++column)
+  {
+    matrix[column] = glm::vec4(rotation[0][column], rotation[1][column]
+                               , rotation[2][column], 0.f);
+  }
+  matrix[3] = glm::vec4(translation[0], translation[1], translation[2], 1.f);
+}
+
+#ifdef CLAPP_TRANSFORM_SSE
+/*
+ * Finds the sine and cosine of 4 angles at once. The angles are brought
+ * into [-pi/4, pi/4] by taking off the nearest multiple of pi/2 in 3 parts
+ * so large angles keep their precision, then the quadrant picks which
+ * polynomial and sign give each result. Accurate to a few units in the
+ * last place for angles within thousands of radians.
+ */
+static inline void SinCos4(const __m128 angles, __m128 &sines
+                           , __m128 &cosines)
+{
+  const __m128 twoOverPi = _mm_set1_ps(0.63661977236758134f);
+  const __m128 halfPi1 = _mm_set1_ps(1.5703125f);
+  const __m128 halfPi2 = _mm_set1_ps(4.837512969970703125e-4f);
+  const __m128 halfPi3 = _mm_set1_ps(7.54978995489188216e-8f);
+  const __m128 signMask = _mm_set1_ps(-0.f);
+
+  // Rounded to the nearest quadrant by the default rounding mode
+  const __m128i quadrant = _mm_cvtps_epi32(_mm_mul_ps(angles, twoOverPi));
+  const __m128 quadrantF = _mm_cvtepi32_ps(quadrant);
+
+  __m128 reduced = _mm_sub_ps(angles, _mm_mul_ps(quadrantF, halfPi1));
+  reduced = _mm_sub_ps(reduced, _mm_mul_ps(quadrantF, halfPi2));
+  reduced = _mm_sub_ps(reduced, _mm_mul_ps(quadrantF, halfPi3));
+  const __m128 squared = _mm_mul_ps(reduced, reduced);
+
+  // Minimax polynomials for sine and cosine on [-pi/4, pi/4]
+  __m128 sinPoly = _mm_set1_ps(-1.9515295891e-4f);
+  sinPoly = _mm_add_ps(_mm_mul_ps(sinPoly, squared)
+                       , _mm_set1_ps(8.3321608736e-3f));
+  sinPoly = _mm_add_ps(_mm_mul_ps(sinPoly, squared)
+                       , _mm_set1_ps(-1.6666654611e-1f));
+  sinPoly = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(sinPoly, squared), reduced)
+                       , reduced);
+
+  __m128 cosPoly = _mm_set1_ps(2.443315711809948e-5f);
+  cosPoly = _mm_add_ps(_mm_mul_ps(cosPoly, squared)
+                       , _mm_set1_ps(-1.388731625493765e-3f));
+  cosPoly = _mm_add_ps(_mm_mul_ps(cosPoly, squared)
+                       , _mm_set1_ps(4.166664568298827e-2f));
+  cosPoly = _mm_mul_ps(_mm_mul_ps(cosPoly, squared), squared);
+  cosPoly = _mm_add_ps(_mm_sub_ps(cosPoly
+                                  , _mm_mul_ps(squared
+                                               , _mm_set1_ps(0.5f)))
+                       , _mm_set1_ps(1.f));
+
+  // Odd quadrants swap sine and cosine
+  const __m128i one = _mm_set1_epi32(1);
+  const __m128i two = _mm_set1_epi32(2);
+  const __m128 swap = _mm_castsi128_ps(
+    _mm_cmpeq_epi32(_mm_and_si128(quadrant, one), one));
+  const __m128 sine = _mm_or_ps(_mm_and_ps(swap, cosPoly)
+                                , _mm_andnot_ps(swap, sinPoly));
+  const __m128 cosine = _mm_or_ps(_mm_and_ps(swap, sinPoly)
+                                  , _mm_andnot_ps(swap, cosPoly));
+
+  // Sine is negative in quadrants 2 and 3, cosine in quadrants 1 and 2
+  const __m128 sineSign = _mm_and_ps(
+    _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(quadrant, two), two))
+    , signMask);
+  const __m128i nextQuadrant = _mm_add_epi32(quadrant, one);
+  const __m128 cosineSign = _mm_and_ps(
+    _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(nextQuadrant, two)
+                                     , two))
+    , signMask);
+
+  sines = _mm_xor_ps(sine, sineSign);
+  cosines = _mm_xor_ps(cosine, cosineSign);
+}
+
+/*
+ * Stores the 4 matrices held as one vector per element, where each lane
+ * is a different transform's matrix
+ */
+static inline void StoreMatrices4(glm::mat4 *matrices, __m128 rotation[3][3]
+                                  , __m128 translation[3])
+{
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 one = _mm_set1_ps(1.f);
+  float *output = &matrices[0][0][0];
+
+  // Transposing the rows of a column gives each transform's column
+  for(int column = 0; column < 4; ++column)
+  {
+    __m128 x = column < 3 ? rotation[0][column] : translation[0];
+    __m128 y = column < 3 ? rotation[1][column] : translation[1];
+    __m128 z = column < 3 ? rotation[2][column] : translation[2];
+    __m128 w = column < 3 ? zero : one;
+    _MM_TRANSPOSE4_PS(x, y, z, w);
+
+    _mm_storeu_ps(output + 0 * 16 + column * 4, x);
+    _mm_storeu_ps(output + 1 * 16 + column * 4, y);
+    _mm_storeu_ps(output + 2 * 16 + column * 4, z);
+    _mm_storeu_ps(output + 3 * 16 + column * 4, w);
+  }
+}
+#endif
+
+//==================//
+//= Public Methods =//
+//==================//
+
+void TransformKernel::ComposeEuler(const EulerTransforms &transforms
+                                   , glm::mat4 *matrices)
+{
+  size_t i = 0;
+#ifdef CLAPP_TRANSFORM_SSE
+  for(; i + 4 <= transforms.count; i += 4)
+  {
+    __m128 sines[3];
+    __m128 cosines[3];
+    __m128 scale[3];
+    __m128 translation[3];
+    for(int axis = 0; axis < 3; ++axis)
+    {
+      SinCos4(_mm_loadu_ps(transforms.rotation[axis] + i), sines[axis]
+              , cosines[axis]);
+      scale[axis] = _mm_loadu_ps(transforms.scale[axis] + i);
+      translation[axis] = _mm_loadu_ps(transforms.position[axis] + i);
+    }
+
+    const __m128 &sx = sines[0];
+    const __m128 &sy = sines[1];
+    const __m128 &sz = sines[2];
+    const __m128 &cx = cosines[0];
+    const __m128 &cy = cosines[1];
+    const __m128 &cz = cosines[2];
+    const __m128 szsy = _mm_mul_ps(sz, sy);
+    const __m128 czsy = _mm_mul_ps(cz, sy);
+
+    // Rz * Ry * Rx with each column scaled
+    __m128 rotation[3][3];
+    rotation[0][0] = _mm_mul_ps(cz, cy);
+    rotation[1][0] = _mm_mul_ps(sz, cy);
+    rotation[2][0] = _mm_sub_ps(_mm_setzero_ps(), sy);
+    rotation[0][1] = _mm_sub_ps(_mm_mul_ps(czsy, sx), _mm_mul_ps(sz, cx));
+    rotation[1][1] = _mm_add_ps(_mm_mul_ps(szsy, sx), _mm_mul_ps(cz, cx));
+    rotation[2][1] = _mm_mul_ps(cy, sx);
+    rotation[0][2] = _mm_add_ps(_mm_mul_ps(czsy, cx), _mm_mul_ps(sz, sx));
+    rotation[1][2] = _mm_sub_ps(_mm_mul_ps(szsy, cx), _mm_mul_ps(cz, sx));
+    rotation[2][2] = _mm_mul_ps(cy, cx);
+    for(int row = 0; row < 3; ++row)
+    {
+      for(int column = 0; column < 3; ++column)
+      {
+        rotation[row][column] = _mm_mul_ps(rotation[row][column]
+                                           , scale[column]);
+      }
+    }
+
+    StoreMatrices4(matrices + i, rotation, translation);
+  }
+#endif
+  ComposeEulerScalar(transforms, matrices, i);
+}
+
+void TransformKernel::ComposeQuaternion(
+  const QuaternionTransforms &transforms, glm::mat4 *matrices)
+{
+  size_t i = 0;
+#ifdef CLAPP_TRANSFORM_SSE
+  const __m128 one = _mm_set1_ps(1.f);
+  const __m128 two = _mm_set1_ps(2.f);
+  for(; i + 4 <= transforms.count; i += 4)
+  {
+    __m128 scale[3];
+    __m128 translation[3];
+    for(int axis = 0; axis < 3; ++axis)
+    {
+      scale[axis] = _mm_loadu_ps(transforms.scale[axis] + i);
+      translation[axis] = _mm_loadu_ps(transforms.position[axis] + i);
+    }
+    const __m128 x = _mm_loadu_ps(transforms.rotation[0] + i);
+    const __m128 y = _mm_loadu_ps(transforms.rotation[1] + i);
+    const __m128 z = _mm_loadu_ps(transforms.rotation[2] + i);
+    const __m128 w = _mm_loadu_ps(transforms.rotation[3] + i);
+
+    const __m128 xx = _mm_mul_ps(x, x);
+    const __m128 yy = _mm_mul_ps(y, y);
+    const __m128 zz = _mm_mul_ps(z, z);
+    const __m128 xy = _mm_mul_ps(x, y);
+    const __m128 xz = _mm_mul_ps(x, z);
+    const __m128 yz = _mm_mul_ps(y, z);
+    const __m128 wx = _mm_mul_ps(w, x);
+    const __m128 wy = _mm_mul_ps(w, y);
+    const __m128 wz = _mm_mul_ps(w, z);
+
+    __m128 rotation[3][3];
+    rotation[0][0] = _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz)));
+    rotation[1][1] = _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz)));
+    rotation[2][2] = _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy)));
+    rotation[0][1] = _mm_mul_ps(two, _mm_sub_ps(xy, wz));
+    rotation[1][0] = _mm_mul_ps(two, _mm_add_ps(xy, wz));
+    rotation[0][2] = _mm_mul_ps(two, _mm_add_ps(xz, wy));
+    rotation[2][0] = _mm_mul_ps(two, _mm_sub_ps(xz, wy));
+    rotation[1][2] = _mm_mul_ps(two, _mm_sub_ps(yz, wx));
+    rotation[2][1] = _mm_mul_ps(two, _mm_add_ps(yz, wx));
+    for(int row = 0; row < 3; ++row)
+    {
+      for(int column = 0; column < 3; ++column)
+      {
+        rotation[row][column] = _mm_mul_ps(rotation[row][column]
+                                           , scale[column]);
+      }
+    }
+
+    StoreMatrices4(matrices + i, rotation, translation);
+  }
+#endif
+  ComposeQuaternionScalar(transforms, matrices, i);
+}
+
+void TransformKernel::ComposeEulerScalar(const EulerTransforms &transforms
+                                         , glm::mat4 *matrices
+                                         , const size_t &first)
+{
+  for(size_t i = first; i < transforms.count; ++i)
+  {
+    const float sx = sin(transforms.rotation[0][i]);
+    const float cx = cos(transforms.rotation[0][i]);
+    const float sy = sin(transforms.rotation[1][i]);
+    const float cy = cos(transforms.rotation[1][i]);
+    const float sz = sin(transforms.rotation[2][i]);
+    const float cz = cos(transforms.rotation[2][i]);
+    const float scale[3] = {transforms.scale[0][i], transforms.scale[1][i]
+                            , transforms.scale[2][i]};
+    const float translation[3] = {transforms.position[0][i]
+                                  , transforms.position[1][i]
+                                  , transforms.position[2][i]};
+
+    // Rz * Ry * Rx with each column scaled
+    const float rotation[3][3] =
+    {
+      {cz * cy * scale[0], (cz * sy * sx - sz * cx) * scale[1]
+       , (cz * sy * cx + sz * sx) * scale[2]}
+      , {sz * cy * scale[0], (sz * sy * sx + cz * cx) * scale[1]
+         , (sz * sy * cx - cz * sx) * scale[2]}
+      , {-sy * scale[0], cy * sx * scale[1], cy * cx * scale[2]}
+    };
+
+    StoreMatrix(matrices[i], rotation, translation);
+  }
+}
+
+void TransformKernel::ComposeQuaternionScalar(
+  const QuaternionTransforms &transforms, glm::mat4 *matrices
+  , const size_t &first)
+{
+  for(size_t i = first; i < transforms.count; ++i)
+  {
+    const float x = transforms.rotation[0][i];
+    const float y = transforms.rotation[1][i];
+    const float z = transforms.rotation[2][i];
+    const float w = transforms.rotation[3][i];
+    const float scale[3] = {transforms.scale[0][i], transforms.scale[1][i]
+                            , transforms.scale[2][i]};
+    const float translation[3] = {transforms.position[0][i]
+                                  , transforms.position[1][i]
+                                  , transforms.position[2][i]};
+
+    const float rotation[3][3] =
+    {
+      {(1.f - 2.f * (y * y + z * z)) * scale[0]
+       , 2.f * (x * y - w * z) * scale[1], 2.f * (x * z + w * y) * scale[2]}
+      , {2.f * (x * y + w * z) * scale[0]
+         , (1.f - 2.f * (x * x + z * z)) * scale[1]
+         , 2.f * (y * z - w * x) * scale[2]}
+      , {2.f * (x * z - w * y) * scale[0], 2.f * (y * z + w * x) * scale[1]
+         , (1.f - 2.f * (x * x + y * y)) * scale[2]}
+    };
+
+    StoreMatrix(matrices[i], rotation, translation);
+  }
+}
+
+bool TransformKernel::IsVectorized()
+{
+#ifdef CLAPP_TRANSFORM_SSE
+  return true;
+#else
+  return false;
+#endif
+}
+}
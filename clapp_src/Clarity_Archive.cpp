@@ -0,0 +1,520 @@
+/*
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    Clarity_Archive.cpp
+ *
+ *  \brief
+ *    An implementation for packing shaders, meshes, textures, and scripts
+ *    into a single memory mapped archive with a hashed table of contents
+*/
+
+#include "clapp_includes/pch.h"
+
+#include "clapp_includes/Clarity_Archive.h"
+
+#include "clapp_includes/Clarity_IO.h"
+#include "clapp_includes/Clarity_Compression.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace ClaPP
+{
+//=================//
+//= Local Helpers =//
+//=================//
+
+static uint64_t AlignUp(const uint64_t &value, const uint64_t &alignment)
+{
+  return (value + alignment - 1) & ~(alignment - 1);
+}
+
+static bool ReadWholeFile(const string &filePath, vector<uint8_t> &data)
+{
+  ifstream file(filePath, ios::binary | ios::ate);
+  if(!file.is_open())
+  {
+    return false;
+  }
+  const streamsize size = file.tellg();
+  if(size < 0)
+  {
+    return false;
+  }
+  file.seekg(0, ios::beg);
+  data.resize(static_cast<size_t>(size));
+  return size == 0 || file.read(reinterpret_cast<char *>(data.data()), size);
+}
+
+//=================//
+//= CTOR and DTOR =//
+//=================//
+
+AssetArchive &AssetArchive::GetInstance()
+{
+  static AssetArchive instance;
+  return instance;
+}
+
+AssetArchive::AssetArchive()
+: mappedData(nullptr), mappedSize(0), header(nullptr), table(nullptr)
+  , fallbackBuffer()
+{
+
+}
+
+AssetArchive::~AssetArchive()
+{
+  Unmount();
+}
+
+//==================//
+//= Public Methods =//
+//==================//
+
+AssetArchive::ARCHIVE_ERR AssetArchive::Mount(const string &archivePath)
+{
+  if(mappedData)
+  {
+    ErrMessage("Attempting to mount archive: " + archivePath
+               + " when another is already mounted", EC_ASSET);
+    return ARCHIVE_ALREADY_MOUNTED;
+  }
+
+#ifndef _WIN32
+  int fd = open(archivePath.c_str(), O_RDONLY);
+  if(fd < 0)
+  {
+    return ARCHIVE_FILE_NOT_FOUND;
+  }
+
+  struct stat fileStat;
+  if(fstat(fd, &fileStat) != 0 || fileStat.st_size <= 0)
+  {
+    close(fd);
+    return ARCHIVE_INVALID_FORMAT;
+  }
+
+  int mapFlags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+  // Fault the whole archive in up front with a single sequential read
+  // instead of page faulting on each asset during startup
+  mapFlags |= MAP_POPULATE;
+#endif
+  void *mapping = mmap(nullptr, static_cast<size_t>(fileStat.st_size)
+                       , PROT_READ, mapFlags, fd, 0);
+  // The mapping holds its own reference to the file
+  close(fd);
+
+  if(mapping == MAP_FAILED)
+  {
+    ErrMessage("Failed to memory map archive: " + archivePath, EC_ASSET);
+    return ARCHIVE_FAILED_TO_MAP;
+  }
+  madvise(mapping, static_cast<size_t>(fileStat.st_size), MADV_WILLNEED);
+
+  mappedData = static_cast<const uint8_t *>(mapping);
+  mappedSize = static_cast<size_t>(fileStat.st_size);
+#else
+  if(!ReadWholeFile(archivePath, fallbackBuffer))
+  {
+    return ARCHIVE_FILE_NOT_FOUND;
+  }
+  mappedData = fallbackBuffer.data();
+  mappedSize = fallbackBuffer.size();
+#endif
+
+  // Validate the header and that the table fits inside the file before
+  // trusting any offsets from it
+  header = reinterpret_cast<const ArchiveHeader *>(mappedData);
+  bool valid = mappedSize >= sizeof(ArchiveHeader)
+    && memcmp(header->magic, ARCHIVE_MAGIC, sizeof(ARCHIVE_MAGIC)) == 0
+    && header->version == ARCHIVE_VERSION
+    && header->tableSize != 0
+    && (header->tableSize & (header->tableSize - 1)) == 0
+    && header->entryCount < header->tableSize
+    && header->tableOffset % alignof(ArchiveEntry) == 0
+    && header->tableOffset <= mappedSize
+    && (mappedSize - header->tableOffset) / sizeof(ArchiveEntry)
+       >= header->tableSize
+    && header->namesOffset <= header->tableOffset;
+
+  if(valid)
+  {
+    // Probing stops at the first empty slot, so a table claiming to have
+    // room but with none would never end a failed lookup
+    table = reinterpret_cast<const ArchiveEntry *>(
+      mappedData + header->tableOffset);
+    valid = false;
+    for(uint32_t slot = 0; slot < header->tableSize && !valid; ++slot)
+    {
+      valid = table[slot].pathHash == 0u;
+    }
+  }
+
+  if(!valid)
+  {
+    ErrMessage("Invalid archive format: " + archivePath, EC_ASSET);
+    Unmount();
+    return ARCHIVE_INVALID_FORMAT;
+  }
+
+  Message("Mounted archive: " + archivePath + " with "
+          + to_string(header->entryCount) + " entries", SEVERITY_INFO);
+
+  return ARCHIVE_NO_ERR;
+}
+
+AssetArchive::ARCHIVE_ERR AssetArchive::Unmount()
+{
+  if(!mappedData)
+  {
+    return ARCHIVE_NOT_MOUNTED;
+  }
+
+#ifndef _WIN32
+  munmap(const_cast<uint8_t *>(mappedData), mappedSize);
+#endif
+  fallbackBuffer.clear();
+  fallbackBuffer.shrink_to_fit();
+
+  mappedData = nullptr;
+  mappedSize = 0;
+  header = nullptr;
+  table = nullptr;
+
+  return ARCHIVE_NO_ERR;
+}
+
+bool AssetArchive::IsMounted() const
+{
+  return mappedData != nullptr;
+}
+
+bool AssetArchive::Contains(const string &assetPath) const
+{
+  return LocateEntry(assetPath) != nullptr;
+}
+
+AssetArchive::ARCHIVE_ERR AssetArchive::FindEntry(const string &assetPath
+                                                  , string_view &view) const
+{
+  if(!mappedData)
+  {
+    return ARCHIVE_NOT_MOUNTED;
+  }
+
+  const ArchiveEntry *entry = LocateEntry(assetPath);
+  if(!entry)
+  {
+    return ARCHIVE_ENTRY_NOT_FOUND;
+  }
+  if(entry->flags & ENTRY_FLAG_COMPRESSED)
+  {
+    return ARCHIVE_CORRUPT_ENTRY;
+  }
+
+  view = string_view(reinterpret_cast<const char *>(
+                     mappedData + entry->dataOffset), entry->rawSize);
+  return ARCHIVE_NO_ERR;
+}
+
+AssetArchive::ARCHIVE_ERR AssetArchive::ReadEntry(const string &assetPath
+                                                  , string &data) const
+{
+  if(!mappedData)
+  {
+    return ARCHIVE_NOT_MOUNTED;
+  }
+
+  const ArchiveEntry *entry = LocateEntry(assetPath);
+  if(!entry)
+  {
+    return ARCHIVE_ENTRY_NOT_FOUND;
+  }
+
+  const uint8_t *stored = mappedData + entry->dataOffset;
+
+  if(!(entry->flags & ENTRY_FLAG_COMPRESSED))
+  {
+    data.assign(reinterpret_cast<const char *>(stored), entry->rawSize);
+    return ARCHIVE_NO_ERR;
+  }
+
+  data.resize(entry->rawSize);
+  if(DecompressBlock(stored, entry->storedSize
+                     , reinterpret_cast<uint8_t *>(data.data())
+                     , entry->rawSize) != COMPRESSION_NO_ERR)
+  {
+    ErrMessage("Failed to decompress archive entry: " + assetPath, EC_ASSET);
+    data.clear();
+    return ARCHIVE_CORRUPT_ENTRY;
+  }
+
+  return ARCHIVE_NO_ERR;
+}
+
+AssetArchive::ARCHIVE_ERR AssetArchive::Build(const string &archivePath
+                                              , const string &rootDir
+                                              , const vector<string> &files
+                                              , const bool &compress)
+{
+  // Keep the table at most half full so probe chains stay short
+  uint32_t tableSize = 16u;
+  while(tableSize < files.size() * 2u)
+  {
+    tableSize <<= 1;
+  }
+
+  vector<ArchiveEntry> entries(tableSize, ArchiveEntry{});
+  vector<uint8_t> blob;
+  string names;
+  uint32_t entryCount = 0u;
+
+  vector<uint8_t> rawData;
+  vector<uint8_t> compressed;
+
+  for(const string &file : files)
+  {
+    const string name = NormalizePath(file);
+    const uint64_t hash = HashPath(name);
+
+    if(!ReadWholeFile(rootDir + "/" + file, rawData))
+    {
+      ErrMessage("Failed to read file for archive: " + file, EC_ASSET);
+      return ARCHIVE_FILE_NOT_FOUND;
+    }
+
+    // Find an empty slot, rejecting duplicate names
+    uint32_t slot = static_cast<uint32_t>(hash) & (tableSize - 1);
+    bool duplicate = false;
+    while(entries[slot].pathHash != 0u)
+    {
+      if(entries[slot].pathHash == hash
+         && strcmp(names.c_str() + entries[slot].nameOffset
+                   , name.c_str()) == 0)
+      {
+        duplicate = true;
+        break;
+      }
+      slot = (slot + 1) & (tableSize - 1);
+    }
+    if(duplicate)
+    {
+      Message("Skipping duplicate archive entry: " + name, SEVERITY_WARNING);
+      continue;
+    }
+
+    ArchiveEntry &entry = entries[slot];
+    entry.pathHash = hash;
+    entry.rawSize = static_cast<uint32_t>(rawData.size());
+    entry.nameOffset = static_cast<uint32_t>(names.size());
+    entry.flags = ENTRY_FLAG_NONE;
+
+    const vector<uint8_t> *stored = &rawData;
+    if(compress && CompressBlock(rawData.data(), rawData.size(), compressed)
+       == COMPRESSION_NO_ERR)
+    {
+      stored = &compressed;
+      entry.flags |= ENTRY_FLAG_COMPRESSED;
+    }
+
+    // Data offsets are stored relative to the blob and fixed up once the
+    // header size is known
+    blob.resize(AlignUp(blob.size(), ENTRY_ALIGNMENT));
+    entry.dataOffset = blob.size();
+    entry.storedSize = static_cast<uint32_t>(stored->size());
+    blob.insert(blob.end(), stored->begin(), stored->end());
+
+    names.append(name);
+    names.push_back('\0');
+    ++entryCount;
+  }
+
+  ArchiveHeader archiveHeader{};
+  memcpy(archiveHeader.magic, ARCHIVE_MAGIC, sizeof(ARCHIVE_MAGIC));
+  archiveHeader.version = ARCHIVE_VERSION;
+  archiveHeader.entryCount = entryCount;
+  archiveHeader.tableSize = tableSize;
+
+  const uint64_t dataStart = AlignUp(sizeof(ArchiveHeader), ENTRY_ALIGNMENT);
+  archiveHeader.namesOffset = dataStart + blob.size();
+  archiveHeader.tableOffset = AlignUp(archiveHeader.namesOffset
+                                      + names.size(), ENTRY_ALIGNMENT);
+
+  for(ArchiveEntry &entry : entries)
+  {
+    if(entry.pathHash != 0u)
+    {
+      entry.dataOffset += dataStart;
+      entry.nameOffset += static_cast<uint32_t>(archiveHeader.namesOffset);
+    }
+  }
+
+  ofstream file(archivePath, ios::binary | ios::trunc);
+  if(!file.is_open())
+  {
+    ErrMessage("Failed to open archive for writing: " + archivePath
+               , EC_ASSET);
+    return ARCHIVE_FAILED_TO_WRITE;
+  }
+
+  const char padding[ENTRY_ALIGNMENT] = {};
+  file.write(reinterpret_cast<const char *>(&archiveHeader)
+             , sizeof(archiveHeader));
+  file.write(padding, dataStart - sizeof(archiveHeader));
+  file.write(reinterpret_cast<const char *>(blob.data()), blob.size());
+  file.write(names.data(), names.size());
+  file.write(padding, archiveHeader.tableOffset - archiveHeader.namesOffset
+                      - names.size());
+  file.write(reinterpret_cast<const char *>(entries.data())
+             , entries.size() * sizeof(ArchiveEntry));
+
+  if(!file.good())
+  {
+    return ARCHIVE_FAILED_TO_WRITE;
+  }
+
+  Message("Packed " + to_string(entryCount) + " entries into archive: "
+          + archivePath, SEVERITY_INFO);
+
+  return ARCHIVE_NO_ERR;
+}
+
+string AssetArchive::NormalizePath(const string &assetPath)
+{
+  string path = assetPath;
+  replace(path.begin(), path.end(), '\\', '/');
+
+  // The engine loads assets relative to the build directory so drop any
+  // leading relative segments to match the packed names
+  size_t start = 0;
+  while(true)
+  {
+    if(path.compare(start, 3, "../") == 0)
+    {
+      start += 3;
+    }
+    else if(path.compare(start, 2, "./") == 0)
+    {
+      start += 2;
+    }
+    else
+    {
+      break;
+    }
+  }
+
+  return path.substr(start);
+}
+
+uint64_t AssetArchive::HashPath(const string_view &normalizedPath)
+{
+  uint64_t hash = 14695981039346656037ull;
+  for(const char &c : normalizedPath)
+  {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 1099511628211ull;
+  }
+  // 0 is reserved for empty slots
+  return hash ? hash : 1u;
+}
+
+//===================//
+//= Private Methods =//
+//===================//
+
+const AssetArchive::ArchiveEntry *AssetArchive::LocateEntry(
+  const string &assetPath) const
+{
+  if(!mappedData)
+  {
+    return nullptr;
+  }
+
+  const string name = NormalizePath(assetPath);
+  const uint64_t hash = HashPath(name);
+  const uint32_t mask = header->tableSize - 1;
+
+  // Linear probe until an empty slot is reached, visiting each slot at
+  // most once in case the table is corrupt
+  uint32_t slot = static_cast<uint32_t>(hash) & mask;
+  for(uint32_t probe = 0; probe < header->tableSize; ++probe)
+  {
+    const ArchiveEntry &entry = table[slot];
+    slot = (slot + 1) & mask;
+    if(entry.pathHash == 0u)
+    {
+      break;
+    }
+    if(entry.pathHash != hash)
+    {
+      continue;
+    }
+
+    // Guard against corrupt offsets before touching the entry's data, an
+    // uncompressed entry is read by its raw size so it must be the stored
+    // size that was bounds checked
+    if(entry.nameOffset >= header->tableOffset
+       || entry.dataOffset > header->namesOffset
+       || entry.storedSize > header->namesOffset - entry.dataOffset
+       || (!(entry.flags & ENTRY_FLAG_COMPRESSED)
+           && entry.rawSize != entry.storedSize))
+    {
+      return nullptr;
+    }
+
+    // Compare names as well in case of a hash collision
+    const char *entryName = reinterpret_cast<const char *>(
+      mappedData + entry.nameOffset);
+    if(strncmp(entryName, name.c_str()
+               , header->tableOffset - entry.nameOffset) == 0)
+    {
+      return &entry;
+    }
+  }
+
+  return nullptr;
+}
+
+//=================//
+//= Asset Loading =//
+//=================//
+
+FILE_ERR LoadAssetToString(const string &assetPath, string &data)
+{
+  AssetArchive &archive = AssetArchive::GetInstance();
+  if(archive.IsMounted()
+     && archive.ReadEntry(assetPath, data) == AssetArchive::ARCHIVE_NO_ERR)
+  {
+    return FILE_NO_ERR;
+  }
+
+  // Fall back to the loose file when the asset is not packed
+  ifstream file(assetPath, ios::binary);
+  if(!file.is_open())
+  {
+    return FILE_CANNOT_BE_OPENED;
+  }
+
+  stringstream stream;
+  stream << file.rdbuf();
+  data = stream.str();
+
+  if(data.empty())
+  {
+    return FILE_FAILED_TO_READ;
+  }
+
+  return FILE_NO_ERR;
+}
+}
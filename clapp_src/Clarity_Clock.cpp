@@ -10,4 +10,97 @@
  *    An interface that handles time keeping mechanics of the engine/system
 */
 
+#include "clapp_includes/pch.h"
+
 #include "clapp_includes/Clairty_Clock.h"
+
+#include <algorithm>
+
+namespace ClaPP
+{
+Clock systemClock;
+
+//=================//
+//= CTOR and DTOR =//
+//=================//
+
+Clock::Clock()
+: startTime(std::chrono::steady_clock::now()), previousTime(startTime)
+{
+
+}
+
+Clock::~Clock()
+{
+
+}
+
+Timer::Timer()
+: Timer(systemClock)
+{
+
+}
+
+Timer::Timer(const Clock &clockOverride)
+: clock(clockOverride), startTime(clockOverride.GetTotalRunTime())
+  , duration(0.f)
+{
+
+}
+
+Timer::~Timer()
+{
+
+}
+
+//==================//
+//= Public Methods =//
+//==================//
+
+void Clock::Update()
+{
+  // steady_clock never jumps backwards when the system time changes
+  const std::chrono::steady_clock::time_point currentTime 
+    = std::chrono::steady_clock::now();
+
+  deltaTime = std::chrono::duration<float>(currentTime - previousTime).count();
+  gameRunTime = std::chrono::duration<float>(currentTime - startTime).count();
+  previousTime = currentTime;
+}
+
+const float &Clock::GetDeltaTime() const
+{
+  return deltaTime;
+}
+
+const float &Clock::GetTotalRunTime() const
+{
+  return gameRunTime;
+}
+
+void Timer::Start(const float &_duration)
+{
+  duration = _duration;
+  startTime = clock.GetTotalRunTime();
+}
+
+void Timer::Restart()
+{
+  startTime = clock.GetTotalRunTime();
+}
+
+float Timer::GetElapsed() const
+{
+  return clock.GetTotalRunTime() - startTime;
+}
+
+float Timer::GetRemaining() const
+{
+  return std::max(duration - GetElapsed(), 0.f);
+}
+
+bool Timer::IsFinished() const
+{
+  return GetElapsed() >= duration;
+}
+}
@@ -0,0 +1,252 @@
+/*
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    Clarity_Compression.cpp
+ *
+ *  \brief
+ *    An implementation for a small LZ4 style block compressor used by packed
+ *    asset archives
+*/
+
+#include "clapp_includes/pch.h"
+
+#include "clapp_includes/Clarity_Compression.h"
+
+namespace ClaPP
+{
+// Minimum length of a match, shorter matches cost more than the literals
+static const size_t MIN_MATCH = 4;
+// The last bytes of a block are always literals so the decoder can
+// copy the tail without checking for a trailing match
+static const size_t LAST_LITERALS = 5;
+// No match may start within this many bytes of the end of the block
+static const size_t MATCH_FIND_LIMIT = 12;
+// Offsets are stored in 2 bytes
+static const size_t MAX_OFFSET = 65535;
+static const uint32_t HASH_BITS = 12;
+
+static uint32_t Read32(const uint8_t *ptr)
+{
+  uint32_t value;
+  std::memcpy(&value, ptr, sizeof(value));
+  return value;
+}
+
+static uint32_t HashSequence(const uint32_t &sequence)
+{
+  // Knuth's multiplicative hash keeping the top bits
+  return (sequence * 2654435761u) >> (32 - HASH_BITS);
+}
+
+static void WriteLength(std::vector<uint8_t> &dst, size_t length)
+{
+  // Lengths of 15 or more spill into extra bytes of 255 until the
+  // remainder fits
+  while(length >= 255)
+  {
+    dst.push_back(255);
+    length -= 255;
+  }
+  dst.push_back(static_cast<uint8_t>(length));
+}
+
+static void WriteSequence(std::vector<uint8_t> &dst, const uint8_t *literals
+                          , const size_t &literalLength
+                          , const size_t &offset, const size_t &matchLength)
+{
+  const size_t matchCode = matchLength ? matchLength - MIN_MATCH : 0;
+
+  uint8_t token = static_cast<uint8_t>(
+    (literalLength >= 15 ? 15 : literalLength) << 4);
+  token |= static_cast<uint8_t>(matchCode >= 15 ? 15 : matchCode);
+  dst.push_back(token);
+
+  if(literalLength >= 15)
+  {
+    WriteLength(dst, literalLength - 15);
+  }
+  dst.insert(dst.end(), literals, literals + literalLength);
+
+  // The final sequence holds only literals
+  if(!matchLength)
+  {
+    return;
+  }
+
+  dst.push_back(static_cast<uint8_t>(offset & 0xFF));
+  dst.push_back(static_cast<uint8_t>((offset >> 8) & 0xFF));
+
+  if(matchCode >= 15)
+  {
+    WriteLength(dst, matchCode - 15);
+  }
+}
+
+size_t CompressBound(const size_t &srcSize)
+{
+  return srcSize + srcSize / 255 + 16;
+}
+
+COMPRESSION_ERR CompressBlock(const uint8_t *src, const size_t &srcSize
+                              , std::vector<uint8_t> &dst)
+{
+  dst.clear();
+  if(!src && srcSize)
+  {
+    return COMPRESSION_NULLPTR_PASSED;
+  }
+  dst.reserve(CompressBound(srcSize));
+
+  size_t anchor = 0;
+  size_t pos = 0;
+
+  if(srcSize > MATCH_FIND_LIMIT)
+  {
+    // Stores the last position each hashed 4 byte sequence was seen at
+    std::vector<uint32_t> hashTable(1u << HASH_BITS, 0u);
+    const size_t matchLimit = srcSize - LAST_LITERALS;
+    const size_t findLimit = srcSize - MATCH_FIND_LIMIT;
+
+    // Position 0 can never be a candidate as the table is zeroed so we
+    // start searching from the first byte after it
+    hashTable[HashSequence(Read32(src))] = 0u;
+    pos = 1;
+
+    while(pos < findLimit)
+    {
+      const uint32_t sequence = Read32(src + pos);
+      const uint32_t hash = HashSequence(sequence);
+      const size_t candidate = hashTable[hash];
+      hashTable[hash] = static_cast<uint32_t>(pos);
+
+      if(pos - candidate > MAX_OFFSET || Read32(src + candidate) != sequence)
+      {
+        ++pos;
+        continue;
+      }
+
+      // Extend the match forward as far as the last literals allow
+      size_t matchLength = MIN_MATCH;
+      while(pos + matchLength < matchLimit
+            && src[candidate + matchLength] == src[pos + matchLength])
+      {
+        ++matchLength;
+      }
+
+      WriteSequence(dst, src + anchor, pos - anchor, pos - candidate
+                    , matchLength);
+
+      pos += matchLength;
+      anchor = pos;
+    }
+  }
+
+  // Flush the remaining bytes as a literal only sequence
+  WriteSequence(dst, src + anchor, srcSize - anchor, 0, 0);
+
+  if(dst.size() >= srcSize)
+  {
+    return COMPRESSION_NOT_SMALLER;
+  }
+
+  return COMPRESSION_NO_ERR;
+}
+
+COMPRESSION_ERR DecompressBlock(const uint8_t *src, const size_t &srcSize
+                                , uint8_t *dst, const size_t &dstSize)
+{
+  if((!src && srcSize) || (!dst && dstSize))
+  {
+    return COMPRESSION_NULLPTR_PASSED;
+  }
+
+  size_t in = 0;
+  size_t out = 0;
+
+  // Reads the extra length bytes following a token nibble of 15
+  auto ReadLength = [&](size_t &length) -> bool
+  {
+    uint8_t byte;
+    do
+    {
+      if(in >= srcSize)
+      {
+        return false;
+      }
+      byte = src[in++];
+      length += byte;
+    } while(byte == 255);
+    return true;
+  };
+
+  while(in < srcSize)
+  {
+    const uint8_t token = src[in++];
+
+    size_t literalLength = token >> 4;
+    if(literalLength == 15 && !ReadLength(literalLength))
+    {
+      return COMPRESSION_CORRUPT_DATA;
+    }
+    if(literalLength > srcSize - in)
+    {
+      return COMPRESSION_CORRUPT_DATA;
+    }
+    if(literalLength > dstSize - out)
+    {
+      return COMPRESSION_OUTPUT_TOO_SMALL;
+    }
+    std::memcpy(dst + out, src + in, literalLength);
+    in += literalLength;
+    out += literalLength;
+
+    // A block always ends on a literal only sequence
+    if(in == srcSize)
+    {
+      break;
+    }
+
+    if(srcSize - in < 2)
+    {
+      return COMPRESSION_CORRUPT_DATA;
+    }
+    const size_t offset = static_cast<size_t>(src[in])
+                          | (static_cast<size_t>(src[in + 1]) << 8);
+    in += 2;
+    if(offset == 0 || offset > out)
+    {
+      return COMPRESSION_CORRUPT_DATA;
+    }
+
+    size_t matchLength = token & 0x0F;
+    if(matchLength == 15 && !ReadLength(matchLength))
+    {
+      return COMPRESSION_CORRUPT_DATA;
+    }
+    matchLength += MIN_MATCH;
+    if(matchLength > dstSize - out)
+    {
+      return COMPRESSION_OUTPUT_TOO_SMALL;
+    }
+
+    // Matches may overlap the bytes being written (offset < length) which
+    // repeats a pattern, so this must be copied byte by byte
+    const uint8_t *match = dst + out - offset;
+    for(size_t i = 0; i < matchLength; ++i)
+    {
+      dst[out + i] = match[i];
+    }
+    out += matchLength;
+  }
+
+  if(out != dstSize)
+  {
+    return COMPRESSION_CORRUPT_DATA;
+  }
+
+  return COMPRESSION_NO_ERR;
+}
+}
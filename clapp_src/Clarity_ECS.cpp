@@ -294,6 +294,16 @@ void ECS::RemoveComponent(const ENTITY_ID &id
   UpdateEntityInSystems(id);
 }
 
+bool ECS::HasComponent(const ENTITY_ID &id
+                       , const Component::COMPONENTS &componentType) const
+{
+  std::unordered_map<ENTITY_ID, COMPONENT_SIGNATURE>::const_iterator 
+    signature = entitySignatures.find(id);
+
+  return signature != entitySignatures.end()
+         && signature->second.test(static_cast<size_t>(componentType));
+}
+
 //====================//
 //= System Functions =//
 //====================//
@@ -409,32 +419,9 @@ void ECS::ClearEntities()
 
 void ECS::AddWorldSingletonComponents()
 {
+  // The binds are loaded from lua by the input system once the key enums
+  // exist
   KeyBindContainer *container = KeyBindContainer::GetInstance();
-  // TODO: Create a json file to store keybind data
-  container->BindKey(KeyBindContainer::KEY_W
-                      , KeyBindContainer::KEY_STATUS_DOWN, "MovePositiveY");
-  container->BindKey(KeyBindContainer::KEY_S
-                      , KeyBindContainer::KEY_STATUS_DOWN, "MoveNegativeY");
-  container->BindKey(KeyBindContainer::KEY_D
-                      , KeyBindContainer::KEY_STATUS_DOWN, "MovePositiveX");
-  container->BindKey(KeyBindContainer::KEY_A
-                      , KeyBindContainer::KEY_STATUS_DOWN, "MoveNegativeX");
-  container->BindKey(KeyBindContainer::KEY_I
-                      , KeyBindContainer::KEY_STATUS_DOWN, "MovePositiveZ");
-  container->BindKey(KeyBindContainer::KEY_K
-                      , KeyBindContainer::KEY_STATUS_DOWN, "MoveNegativeZ");
-  container->BindKey(KeyBindContainer::KEY_U
-                      , KeyBindContainer::KEY_STATUS_DOWN, "RotatePositiveX");
-  container->BindKey(KeyBindContainer::KEY_O
-                      , KeyBindContainer::KEY_STATUS_DOWN, "RotateNegativeX");
-  container->BindKey(KeyBindContainer::KEY_J
-                      , KeyBindContainer::KEY_STATUS_DOWN, "RotatePositiveY");
-  container->BindKey(KeyBindContainer::KEY_L
-                      , KeyBindContainer::KEY_STATUS_DOWN, "RotateNegativeY");
-  container->BindKey(KeyBindContainer::KEY_Q
-                      , KeyBindContainer::KEY_STATUS_DOWN, "RotatePositiveZ");
-  container->BindKey(KeyBindContainer::KEY_E
-                      , KeyBindContainer::KEY_STATUS_DOWN, "RotateNegativeZ");
 
   AddComponent(worldID, container);
 }
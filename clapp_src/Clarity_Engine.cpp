@@ -21,17 +21,21 @@
 #include "clapp_includes/Clarity_IO.h"
 #include "clapp_includes/Clarity_EventManager.h"
 #include "clapp_includes/Clarity_Memory.h"
+#include "clapp_includes/Clarity_Archive.h"
+#include "clapp_includes/Clairty_Clock.h"
 
 // Systems included
 #include "clapp_includes/CGL_System.h"
 #include "clapp_includes/CPL_System.h"
 #include "clapp_includes/CIL_System.h"
 #include "clapp_includes/CIL_PlayerControllerSystem.h"
+#include "clapp_includes/CIL_InputTrace.h"
 
 // Components included
 #include "clapp_includes/CGL_Mesh.h"
 #include "clapp_includes/CGL_Texture.h"
 #include "clapp_includes/CPL_Physics.h"
+#include "clapp_includes/CPL_Collider.h"
 #include "clapp_includes/CPL_Transform.h"
 #include "clapp_includes/CIL_Controller.h"
 
@@ -64,6 +68,15 @@ Engine::~Engine()
 
 bool Engine::Startup()
 {
+  // Mount the packed assets if they have been built, otherwise every asset
+  // is loaded from its loose file
+  if(AssetArchive::GetInstance().Mount(DEFAULT_ARCHIVE_PATH) 
+     != AssetArchive::ARCHIVE_NO_ERR)
+  {
+    Message("No asset archive mounted, loading loose asset files"
+            , SEVERITY_INFO);
+  }
+
   if(ecsManager.Initialize() != Clarity_System::SYS_NO_ERR)
   {
     return false;
@@ -83,7 +96,11 @@ bool Engine::Startup()
   ecsManager.AddComponent<Texture>(id, "../clapp_assets/3D_TEST.png");
   ecsManager.AddComponent<Transform>(id); 
   ecsManager.AddComponent<Controller>(id);
-  ecsManager.AddComponent<Physics>(id);
+  // The demo cube floats in place so it only moves when controlled
+  Physics::PhysicsData cubePhysics;
+  cubePhysics.gravityOn = false;
+  ecsManager.AddComponent<Physics>(id, cubePhysics);
+  ecsManager.AddComponent<Collider>(id);
 
   // TODO: Create a readable lua script that takes in a set of player
   // input events to bind that are easily adjustable
@@ -98,11 +115,22 @@ bool Engine::Startup()
 
 bool Engine::Run()
 {
+  systemClock.Update();
+  float deltaTime = systemClock.GetDeltaTime();
+
+  // A replay runs every frame with its recorded delta and ends the engine
+  // once it runs out of frames
+  if(!InputTrace::GetInstance().BeginFrame(deltaTime))
+  {
+    return false;
+  }
+
+  // Events sent last frame were drained when it ended
   if(TerminateEngine())
   {
     return false;
   }
-  if(ecsManager.Update(0.f) != Clarity_System::SYS_NO_ERR)
+  if(ecsManager.Update(deltaTime) != Clarity_System::SYS_NO_ERR)
   {
     return false;
   }
@@ -114,7 +142,7 @@ bool Engine::Run()
   // The engine manages the event manage so it will manually update it...
   // TODO: Make event manager a system so it is more integrated into the 
   // lifecycle of the engine
-  EventManager::GetInstance().Update(0.f);
+  EventManager::GetInstance().Update(deltaTime);
 
   return true;
 }
@@ -130,6 +158,9 @@ bool Engine::Exit()
     return false;
   }
 
+  AssetArchive::GetInstance().Unmount();
+  InputTrace::GetInstance().Stop();
+
   return true;
 }
 
@@ -139,7 +170,5 @@ bool Engine::Exit()
 
 bool Engine::TerminateEngine()
 {
-  return EventManager::GetInstance().CheckEvent(EventManager::SYSTEM
-                                            , EventManager::ENGINE
-                                            , "TerminateEngine");
+  return EventManager::GetInstance().HasEvent<TerminateEngineEvent>();
 }
@@ -29,6 +29,7 @@ EventManager &EventManager::GetInstance()
 }
 void EventManager::AddEvent(Event &&event)
 {
+  std::lock_guard<std::mutex> lock(eventMutex);
   events.push_back(event);
 }
 // Check all events for a specific message from a specific sender
@@ -36,6 +37,7 @@ bool EventManager::CheckEvent(const EVENT_OBJ &_desiredSender
                               , const EVENT_OBJ &_reciever
                               , const std::string &_expectedMessage)
 {
+  std::lock_guard<std::mutex> lock(eventMutex);
   for(Event &event : events)
   {
     if(_desiredSender == event.sender && _reciever == event.reciever
@@ -47,26 +49,50 @@ bool EventManager::CheckEvent(const EVENT_OBJ &_desiredSender
   }
   return false;
 }
-// Remove any events that are checked
+bool EventManager::CancelEvent(const TimerWheel::TIMER_ID &timerID)
+{
+  return timerWheel.Cancel(timerID);
+}
+
+// Remove any events that are checked, fire timed events whose delay has
+// passed, and dispatch typed events
 void EventManager::Update(float deltaTime)
 {
-  for(std::vector<Event>::iterator it = events.begin()
-  ; it != events.end(); ++it)
+  // Erasing inside the loop would invalidate the iterator so every checked
+  // event is moved to the back and removed at once
+  std::unique_lock<std::mutex> lock(eventMutex);
+  events.erase(std::remove_if(events.begin(), events.end()
+                              , [](const Event &event)
+                              { return event.eventChecked; })
+               , events.end());
+  lock.unlock();
+
+  // Timed events are sent before draining so they are read next frame like
+  // any other event sent this frame
+  timerWheel.Advance(deltaTime);
+
+  // This is the frame boundary, events sent from here on are read next
+  // frame
+  for(std::atomic<ChannelBase *> &channel : channels)
   {
-    if(it->eventChecked)
+    if(ChannelBase *drained = channel.load(std::memory_order_acquire))
     {
-      events.erase(it);
+      drained->Drain();
     }
   }
 }
 
 EventManager::EventManager()
+: eventMutex(), events(), channelMutex(), channels(), timerWheel()
 {
 
 }
 
 EventManager::~EventManager()
 {
-
+  for(std::atomic<ChannelBase *> &channel : channels)
+  {
+    delete channel.load(std::memory_order_relaxed);
+  }
 }
 }
@@ -0,0 +1,325 @@
+/*
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    Clarity_FileWatcher.cpp
+ *
+ *  \brief
+ *    An implementation for watching asset files and preparing hot reloads
+ *    on a background thread
+*/
+
+#include "clapp_includes/pch.h"
+
+#include "clapp_includes/Clarity_FileWatcher.h"
+
+#include <filesystem>
+#include <unordered_set>
+
+#include "clapp_includes/CGL_TextureCook.h"
+#include "clapp_includes/Clarity_IO.h"
+
+#include "clapp_includes/g_pch.h"
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace ClaPP
+{
+// How long the watcher waits for more events before preparing reloads.
+// Editors often write a file in several steps so this batches them
+static const int WATCH_SETTLE_MS = 50;
+
+static string GetWatchDirectory(const string &filePath)
+{
+  string directory = filesystem::path(filePath).parent_path().string();
+  return directory.empty() ? "." : directory;
+}
+
+static string GetWatchKey(const string &directory, const string &fileName)
+{
+  return directory + "/" + fileName;
+}
+
+//=================//
+//= CTOR and DTOR =//
+//=================//
+
+FileWatcher &FileWatcher::GetInstance()
+{
+  static FileWatcher instance;
+  return instance;
+}
+
+FileWatcher::FileWatcher()
+: notifyFD(-1), isRunning(false), watchThread(), watchMutex(), watchedFiles()
+  , watchedDirectories(), reloadMutex(), pendingReloads()
+{
+
+}
+
+FileWatcher::~FileWatcher()
+{
+  Stop();
+}
+
+//==================//
+//= Public Methods =//
+//==================//
+
+FileWatcher::WATCH_ERR FileWatcher::Start()
+{
+#ifdef __linux__
+  if(isRunning)
+  {
+    return WATCH_ALREADY_RUNNING;
+  }
+
+  notifyFD = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if(notifyFD < 0)
+  {
+    ErrMessage("Failed to initialize inotify for hot reloading", EC_ASSET);
+    return WATCH_FAILED_TO_START;
+  }
+
+  {
+    lock_guard<mutex> lock(watchMutex);
+    // Watch the directories of any files registered before starting
+    for(const pair<const string, WatchedFile> &file : watchedFiles)
+    {
+      AddDirectoryWatch(GetWatchDirectory(file.second.filePath));
+    }
+  }
+
+  isRunning = true;
+  watchThread = thread(&FileWatcher::WatchLoop, this);
+
+  Message("Started asset file watcher", SEVERITY_INFO);
+
+  return WATCH_NO_ERR;
+#else
+  Message("Hot reloading is not supported on this platform"
+          , SEVERITY_WARNING);
+  return WATCH_NOT_SUPPORTED;
+#endif
+}
+
+void FileWatcher::Stop()
+{
+  if(!isRunning)
+  {
+    return;
+  }
+
+  isRunning = false;
+  if(watchThread.joinable())
+  {
+    watchThread.join();
+  }
+
+#ifdef __linux__
+  close(notifyFD);
+#endif
+  notifyFD = -1;
+
+  lock_guard<mutex> lock(watchMutex);
+  watchedDirectories.clear();
+}
+
+FileWatcher::WATCH_ERR FileWatcher::Watch(const string &filePath
+                                          , const WATCH_TYPE &type)
+{
+  const string directory = GetWatchDirectory(filePath);
+  const string fileName = filesystem::path(filePath).filename().string();
+
+  lock_guard<mutex> lock(watchMutex);
+  watchedFiles[GetWatchKey(directory, fileName)] = WatchedFile{filePath, type};
+
+  if(isRunning)
+  {
+    AddDirectoryWatch(directory);
+  }
+
+  return WATCH_NO_ERR;
+}
+
+void FileWatcher::TakeReloads(vector<Reload> &reloads)
+{
+  reloads.clear();
+
+  lock_guard<mutex> lock(reloadMutex);
+  reloads.swap(pendingReloads);
+}
+
+//===================//
+//= Private Methods =//
+//===================//
+
+void FileWatcher::WatchLoop()
+{
+#ifdef __linux__
+  // Large enough for many events, aligned as the events hold ints
+  alignas(inotify_event) char buffer[4096];
+  unordered_set<string> changedFiles;
+
+  while(isRunning)
+  {
+    pollfd pollData = {notifyFD, POLLIN, 0};
+    const int ready = poll(&pollData, 1, WATCH_SETTLE_MS);
+
+    if(ready > 0)
+    {
+      ssize_t length;
+      while((length = read(notifyFD, buffer, sizeof(buffer))) > 0)
+      {
+        lock_guard<mutex> lock(watchMutex);
+        for(char *ptr = buffer; ptr < buffer + length
+            ; ptr += sizeof(inotify_event)
+              + reinterpret_cast<inotify_event *>(ptr)->len)
+        {
+          const inotify_event *event = reinterpret_cast<inotify_event *>(ptr);
+          if(!event->len)
+          {
+            continue;
+          }
+
+          unordered_map<int, string>::iterator directory
+            = watchedDirectories.find(event->wd);
+          if(directory == watchedDirectories.end())
+          {
+            continue;
+          }
+
+          const string key = GetWatchKey(directory->second, event->name);
+          if(watchedFiles.count(key))
+          {
+            changedFiles.insert(key);
+          }
+        }
+      }
+      // Keep collecting until the directory has settled
+      continue;
+    }
+
+    if(changedFiles.empty())
+    {
+      continue;
+    }
+
+    vector<WatchedFile> toPrepare;
+    {
+      lock_guard<mutex> lock(watchMutex);
+      for(const string &key : changedFiles)
+      {
+        toPrepare.push_back(watchedFiles[key]);
+      }
+    }
+    changedFiles.clear();
+
+    // Reading and decoding happens here, off of the frame
+    for(const WatchedFile &file : toPrepare)
+    {
+      PrepareReload(file);
+    }
+  }
+#endif
+}
+
+void FileWatcher::AddDirectoryWatch(const string &directory)
+{
+#ifdef __linux__
+  for(const pair<const int, string> &watched : watchedDirectories)
+  {
+    if(watched.second == directory)
+    {
+      return;
+    }
+  }
+
+  const int wd = inotify_add_watch(notifyFD, directory.c_str()
+                                   , IN_CLOSE_WRITE | IN_MOVED_TO);
+  if(wd < 0)
+  {
+    ErrMessage("Failed to watch directory: " + directory, EC_ASSET);
+    return;
+  }
+
+  watchedDirectories[wd] = directory;
+#endif
+}
+
+void FileWatcher::PrepareReload(const WatchedFile &watchedFile)
+{
+  Reload reload;
+  reload.type = watchedFile.type;
+  reload.filePath = watchedFile.filePath;
+
+  // Always read the loose file as that is what was edited, even if an
+  // archive containing an older copy is mounted
+  ifstream file(watchedFile.filePath, ios::binary);
+  if(!file.is_open())
+  {
+    ErrMessage("Failed to read changed file: " + watchedFile.filePath
+               , EC_ASSET);
+    return;
+  }
+  stringstream stream;
+  stream << file.rdbuf();
+  reload.source = stream.str();
+
+  if(reload.source.empty())
+  {
+    // Likely caught mid save, the next write will trigger another reload
+    return;
+  }
+
+  if(reload.type == WATCH_TEXTURE)
+  {
+    unsigned char *imageData = stbi_load_from_memory(
+      reinterpret_cast<const stbi_uc *>(reload.source.data())
+      , static_cast<int>(reload.source.size())
+      , &reload.width, &reload.height, &reload.channels, 0);
+
+    if(!imageData)
+    {
+      ErrMessage("Failed to decode changed texture: " + watchedFile.filePath
+                 , EC_ASSET);
+      return;
+    }
+
+    // The mips are built here too so the main thread only swaps them in
+    TextureCooker::BuildMipChain(imageData
+                                 , static_cast<uint32_t>(reload.width)
+                                 , static_cast<uint32_t>(reload.height)
+                                 , static_cast<uint32_t>(reload.channels)
+                                 , reload.levels);
+    stbi_image_free(imageData);
+    reload.source.clear();
+  }
+  else if(reload.type == WATCH_MESH)
+  {
+    // Runs on this thread's own lua state so a large script never stalls
+    // a frame, a bad edit keeps the current mesh
+    if(!Mesh::ParseMeshData(watchedFile.filePath, reload.source
+                            , reload.mesh))
+    {
+      ErrMessage("Failed to parse changed mesh: " + watchedFile.filePath
+                 , EC_ASSET);
+      return;
+    }
+    reload.source.clear();
+  }
+
+  Message("Prepared hot reload for: " + watchedFile.filePath, SEVERITY_INFO);
+
+  lock_guard<mutex> lock(reloadMutex);
+  pendingReloads.push_back(std::move(reload));
+}
+}
@@ -12,15 +12,15 @@
 
 #include "clapp_includes/Clarity_LUA.h"
 #include "clapp_includes/Clarity_IO.h"
+#include "clapp_includes/Clarity_Archive.h"
+#include "clapp_includes/Clarity_LuaCache.h"
 
 namespace ClaPP
 {
-// NOTE: Starting with a singleton but most likly should change it to be 
-// for each thread later to ensure that all threads have their own access
-// and can simultanously access lua script data
 LuaState &LuaState::GetInstance()
 {
-  static LuaState instance;
+  // One per thread, destroyed when the thread exits
+  static thread_local LuaState instance;
   return instance;
 }
 
@@ -32,20 +32,31 @@ LuaState::LUA_ERR LuaState::ExecuteFile(const std::string &luaPath)
                 , EC_LUA);
     return LUA_FILE_STILL_IN_USE;
   }
-  if(luaL_dofile(luaState, luaPath.c_str()) != LUA_OK)
+
+  if(LUA_ERR err = LoadChunk(luaPath, nullptr))
   {
-    // Lua pushes an error message to the top of its stack on 
-    // failed file opening
-    ErrMessage("Failed to open lua file: " + luaPath + ", " 
-                + lua_tostring(luaState, -1), EC_LUA);
-    // Since we need to get that message with lua_tostring we must
-    // also pop it after to clear the stack
-    lua_pop(luaState, 1);
-    return LUA_FILE_NOT_FOUND;
+    return err;
   }
-  currentFile = luaPath;
-  currentPopLayer = 0u;
-  return LUA_NO_ERR;
+
+  return RunChunk(luaPath);
+}
+
+LuaState::LUA_ERR LuaState::ExecuteBuffer(const std::string &luaSource
+                                          , const std::string &luaPath)
+{
+  if(!currentFile.empty())
+  {
+    ErrMessage("Attempting to execute a new file when another is in use"
+                , EC_LUA);
+    return LUA_FILE_STILL_IN_USE;
+  }
+
+  if(LUA_ERR err = LoadChunk(luaPath, &luaSource))
+  {
+    return err;
+  }
+
+  return RunChunk(luaPath);
 }
 
 LuaState::LUA_ERR LuaState::GetGlobal(const std::string &globalName)
@@ -162,6 +173,57 @@ LuaState::LUA_ERR LuaState::GetNumber(unsigned int &ptr, const int &index)
   return LUA_NO_ERR;
 }
 
+LuaState::LUA_ERR LuaState::GetNumberArray(std::span<float> values)
+{
+  return ReadNumberArray(values.data(), values.size());
+}
+
+LuaState::LUA_ERR LuaState::GetNumberArray(std::span<unsigned int> values)
+{
+  return ReadNumberArray(values.data(), values.size());
+}
+
+LuaState::LUA_ERR LuaState::GetVec2Array(std::vector<glm::vec2> &values)
+{
+  int length = 0;
+  if(LUA_ERR err = GetFieldLength(length))
+  {
+    return err;
+  }
+  if(length % 2 != 0)
+  {
+    ErrMessage("Values in field: " + currentField + " in global: "
+                + currentGlobal + " in file: " + currentFile
+                + " do not make whole vec2s", EC_LUA);
+    return LUA_INVALID_FIELD;
+  }
+  // glm vectors are tightly packed floats so they can be filled directly
+  static_assert(sizeof(glm::vec2) == 2 * sizeof(float));
+  values.resize(static_cast<size_t>(length) / 2);
+  return ReadNumberArray(reinterpret_cast<float *>(values.data())
+                         , values.size() * 2);
+}
+
+LuaState::LUA_ERR LuaState::GetVec3Array(std::vector<glm::vec3> &values)
+{
+  int length = 0;
+  if(LUA_ERR err = GetFieldLength(length))
+  {
+    return err;
+  }
+  if(length % 3 != 0)
+  {
+    ErrMessage("Values in field: " + currentField + " in global: "
+                + currentGlobal + " in file: " + currentFile
+                + " do not make whole vec3s", EC_LUA);
+    return LUA_INVALID_FIELD;
+  }
+  static_assert(sizeof(glm::vec3) == 3 * sizeof(float));
+  values.resize(static_cast<size_t>(length) / 3);
+  return ReadNumberArray(reinterpret_cast<float *>(values.data())
+                         , values.size() * 3);
+}
+
 LuaState::LUA_ERR LuaState::GetString(std::string &ptr, const int &index)
 {
   if(LUA_ERR err = CheckFileStatus())
@@ -215,28 +277,31 @@ LuaState::LUA_ERR LuaState::GetBool(bool &ptr, const int &index)
   lua_pop(luaState, 1);
   return LUA_NO_ERR;
 }
-struct EnumPair
-{
-  std::string luaName;
-  int enumValue;
-};
-
 LuaState::LUA_ERR LuaState::CreateEnum(std::string luaEnum
                     , const std::vector<EnumPair>  &enumPairs)
 {
-  // Create a new table
-  lua_newtable(luaState);
-  // Push all the new enums to the table
-  for(EnumPair pair : enumPairs)
   {
-    // Push a new enum with a string to access it from the table
-    lua_pushstring(luaState, pair.luaName.c_str());
-    lua_pushinteger(luaState, pair.enumValue);
-    // Set the table value then go back up the chain
-    lua_settable(luaState, -3);
+    std::lock_guard<std::mutex> lock(enumMutex);
+    // Replace an enum of the same name so every state ends up the same
+    std::vector<SharedEnum>::iterator existing = std::find_if(
+      sharedEnums.begin(), sharedEnums.end()
+      , [&luaEnum](const SharedEnum &shared)
+      {
+        return shared.luaEnum == luaEnum;
+      });
+    if(existing != sharedEnums.end())
+    {
+      existing->enumPairs = enumPairs;
+    }
+    else
+    {
+      sharedEnums.push_back({luaEnum, enumPairs});
+    }
+    ++sharedEnumRevision;
   }
-  // Set the global table name
-  lua_setglobal(luaState, luaEnum.c_str());
+
+  // Other states pick it up the next time they sync
+  SyncEnums();
   return LUA_NO_ERR;
 }
 
@@ -273,7 +338,7 @@ LuaState::LUA_ERR LuaState::Pop()
 
 LuaState::LuaState() 
 : currentFile(), currentGlobal(), currentField()
-  , currentPopLayer(0u), luaMutex()
+  , currentPopLayer(0u), enumRevision(0u)
 {
   // Create a new state
   luaState = luaL_newstate();
@@ -284,6 +349,8 @@ LuaState::LuaState()
   }
   // Open the library on creation
   luaL_openlibs(luaState);
+
+  SyncEnums();
 }
 
 LuaState::~LuaState()
@@ -296,6 +363,232 @@ LuaState::~LuaState()
   lua_close(luaState);
 }
 
+LuaState::LUA_ERR LuaState::LoadFunction(const std::string &luaPath
+                                         , const std::string &functionName
+                                         , int &functionRef)
+{
+  functionRef = LUA_NOREF;
+  if(LUA_ERR err = ExecuteFile(luaPath))
+  {
+    return err;
+  }
+
+  LUA_ERR err = LUA_NO_ERR;
+  lua_getglobal(luaState, functionName.c_str());
+  if(lua_isfunction(luaState, -1))
+  {
+    // Takes the function off the stack into the registry
+    functionRef = luaL_ref(luaState, LUA_REGISTRYINDEX);
+    lua_pushnil(luaState);
+    lua_setglobal(luaState, functionName.c_str());
+  }
+  else
+  {
+    ErrMessage("Failed to find function: " + functionName + " in file: "
+                + luaPath, EC_LUA);
+    lua_pop(luaState, 1);
+    err = LUA_INCORRECT_TYPE;
+  }
+
+  // Leave the file, the kept function stays alive in the registry
+  Pop();
+  return err;
+}
+
+LuaState::LUA_ERR LuaState::CallBatchFunction(const int &functionRef
+                                              , const float &deltaTime
+                                              , LuaBatch &batch)
+{
+  if(functionRef == LUA_NOREF || functionRef == LUA_REFNIL)
+  {
+    return LUA_NULLPTR_PASSED;
+  }
+
+  lua_rawgeti(luaState, LUA_REGISTRYINDEX, functionRef);
+  lua_pushnumber(luaState, deltaTime);
+  batch.Push(luaState);
+
+  LUA_ERR err = LUA_NO_ERR;
+  if(lua_pcall(luaState, 2, 0, 0) != LUA_OK)
+  {
+    ErrMessage(std::string("Failed to run batch function, ")
+                + lua_tostring(luaState, -1), EC_LUA);
+    lua_pop(luaState, 1);
+    err = LUA_INVALID_FILE;
+  }
+
+  // The columns may move once the caller resizes the batch
+  batch.Invalidate();
+  return err;
+}
+
+void LuaState::ReleaseFunction(int &functionRef)
+{
+  luaL_unref(luaState, LUA_REGISTRYINDEX, functionRef);
+  functionRef = LUA_NOREF;
+}
+
+LuaState::LUA_ERR LuaState::ExecuteConfig(const std::string &luaPath
+                                          , const std::string *luaSource
+                                          , LuaConfig &config)
+{
+  const int top = lua_gettop(luaState);
+  if(LUA_ERR err = LoadChunk(luaPath, luaSource))
+  {
+    return err;
+  }
+
+  // The script's globals go into a fresh table that falls back to the real
+  // globals, keeping engine enums readable without leaking the config
+  lua_newtable(luaState);
+  lua_newtable(luaState);
+  lua_pushglobaltable(luaState);
+  lua_setfield(luaState, -2, "__index");
+  lua_setmetatable(luaState, -2);
+
+  // A main chunk's only upvalue is its _ENV
+  lua_pushvalue(luaState, -1);
+  lua_setupvalue(luaState, -3, 1);
+  lua_insert(luaState, -2);
+
+  LUA_ERR err = LUA_NO_ERR;
+  if(lua_pcall(luaState, 0, 0, 0) != LUA_OK)
+  {
+    ErrMessage("Failed to run lua config: " + luaPath + ", "
+                + lua_tostring(luaState, -1), EC_LUA);
+    err = LUA_INVALID_FILE;
+  }
+  else
+  {
+    config.CopyRoot(luaState, -1);
+  }
+
+  lua_settop(luaState, top);
+  return err;
+}
+
+void LuaState::SyncEnums()
+{
+  std::lock_guard<std::mutex> lock(enumMutex);
+  if(enumRevision == sharedEnumRevision)
+  {
+    return;
+  }
+
+  // Recreating every enum is cheap and keeps replaced enums correct
+  for(const SharedEnum &shared : sharedEnums)
+  {
+    PushEnum(shared.luaEnum, shared.enumPairs);
+  }
+  enumRevision = sharedEnumRevision;
+}
+
+void LuaState::PushEnum(const std::string &luaEnum
+                        , const std::vector<EnumPair> &enumPairs)
+{
+  // Create a new table
+  lua_newtable(luaState);
+  // Push all the new enums to the table
+  for(const EnumPair &pair : enumPairs)
+  {
+    // Push a new enum with a string to access it from the table
+    lua_pushstring(luaState, pair.luaName.c_str());
+    lua_pushinteger(luaState, pair.enumValue);
+    // Set the table value then go back up the chain
+    lua_settable(luaState, -3);
+  }
+  // Set the global table name
+  lua_setglobal(luaState, luaEnum.c_str());
+}
+
+LuaState::LUA_ERR LuaState::LoadChunk(const std::string &luaPath
+                                      , const std::string *luaSource)
+{
+  SyncEnums();
+
+  LuaBytecodeCache &cache = LuaBytecodeCache::GetInstance();
+  LuaBytecodeCache::SourceStamp stamp;
+
+  if(luaSource)
+  {
+    // The source is already in memory so it is stamped by its contents
+    stamp = LuaBytecodeCache::StampSource(*luaSource);
+    if(!cache.Load(luaState, luaPath, stamp))
+    {
+      return CompileChunk(*luaSource, luaPath, stamp);
+    }
+    return LUA_NO_ERR;
+  }
+
+  std::string fileSource;
+
+  // Loose scripts are stamped by modification time so a cache hit never
+  // reads the source, packed scripts are read through the archive and
+  // stamped by their contents
+  const bool isLoose = !AssetArchive::GetInstance().Contains(luaPath)
+                       && LuaBytecodeCache::StampFile(luaPath, stamp);
+  if(!isLoose)
+  {
+    if(LoadAssetToString(luaPath, fileSource) != FILE_NO_ERR)
+    {
+      ErrMessage("Failed to open lua file: " + luaPath, EC_LUA);
+      return LUA_FILE_NOT_FOUND;
+    }
+    stamp = LuaBytecodeCache::StampSource(fileSource);
+  }
+
+  if(!cache.Load(luaState, luaPath, stamp))
+  {
+    if(isLoose && LoadAssetToString(luaPath, fileSource) != FILE_NO_ERR)
+    {
+      ErrMessage("Failed to open lua file: " + luaPath, EC_LUA);
+      return LUA_FILE_NOT_FOUND;
+    }
+    return CompileChunk(fileSource, luaPath, stamp);
+  }
+
+  return LUA_NO_ERR;
+}
+
+LuaState::LUA_ERR LuaState::CompileChunk(const std::string &luaSource
+                                         , const std::string &luaPath
+                                         , const LuaBytecodeCache::SourceStamp
+                                           &stamp)
+{
+  // The '@' prefix makes lua report errors using the file name
+  const std::string chunkName = "@" + luaPath;
+  if(luaL_loadbuffer(luaState, luaSource.data(), luaSource.size()
+                     , chunkName.c_str()) != LUA_OK)
+  {
+    ErrMessage("Failed to open lua file: " + luaPath + ", " 
+                + lua_tostring(luaState, -1), EC_LUA);
+    lua_pop(luaState, 1);
+    return LUA_INVALID_FILE;
+  }
+
+  // Cache the compiled chunk so the next run skips lexing and parsing
+  LuaBytecodeCache::GetInstance().Store(luaState, luaPath, stamp);
+  return LUA_NO_ERR;
+}
+
+LuaState::LUA_ERR LuaState::RunChunk(const std::string &luaPath)
+{
+  if(lua_pcall(luaState, 0, LUA_MULTRET, 0) != LUA_OK)
+  {
+    // Lua pushes an error message to the top of its stack on 
+    // failed file opening
+    ErrMessage("Failed to open lua file: " + luaPath + ", " 
+                + lua_tostring(luaState, -1), EC_LUA);
+    // Since we need to get that message with lua_tostring we must
+    // also pop it after to clear the stack
+    lua_pop(luaState, 1);
+    return LUA_FILE_NOT_FOUND;
+  }
+  currentFile = luaPath;
+  currentPopLayer = 0u;
+  return LUA_NO_ERR;
+}
+
 LuaState::LUA_ERR LuaState::CheckFileStatus()
 {
   if(currentFile.empty())
@@ -306,6 +599,62 @@ LuaState::LUA_ERR LuaState::CheckFileStatus()
   return LUA_NO_ERR;
 }
 
+LuaState::LUA_ERR LuaState::ArrayChecks(const size_t &count)
+{
+  if(LUA_ERR err = CheckFileStatus())
+  {
+    return err;
+  }
+  if(currentPopLayer < 2)
+  {
+    ErrMessage("Attempting to get variable when no field has been selected"
+                , EC_LUA);
+    return LUA_INVALID_FIELD;
+  }
+  if(!lua_istable(luaState, -1) || lua_rawlen(luaState, -1) < count)
+  {
+    ErrMessage("Not enough values found in field: " + currentField 
+                + " in global: " + currentGlobal + " in file: " + currentFile
+                , EC_LUA);
+    return LUA_INVALID_FIELD;
+  }
+  return LUA_NO_ERR;
+}
+
+template<typename T>
+LuaState::LUA_ERR LuaState::ReadNumberArray(T *values, const size_t &count)
+{
+  if(LUA_ERR err = ArrayChecks(count))
+  {
+    return err;
+  }
+
+  // Every value is still type checked but the flag comes from the same
+  // conversion that reads it so there is no separate isnumber call
+  int isNumber = 1;
+  for(size_t i = 0; i < count && isNumber; ++i)
+  {
+    lua_rawgeti(luaState, -1, static_cast<lua_Integer>(i + 1));
+    if constexpr(std::is_floating_point_v<T>)
+    {
+      values[i] = static_cast<T>(lua_tonumberx(luaState, -1, &isNumber));
+    }
+    else
+    {
+      values[i] = static_cast<T>(lua_tointegerx(luaState, -1, &isNumber));
+    }
+    lua_pop(luaState, 1);
+  }
+
+  if(!isNumber)
+  {
+    ErrMessage("No number found in field: " + currentField + " in global: "
+                + currentGlobal + " in file: " + currentFile, EC_LUA);
+    return LUA_INCORRECT_TYPE;
+  }
+  return LUA_NO_ERR;
+}
+
 LuaState::LUA_ERR LuaState::NumberChecks(const int &index)
 {
   if(LUA_ERR err = CheckFileStatus())
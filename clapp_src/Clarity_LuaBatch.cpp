@@ -0,0 +1,176 @@
+/*
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    Clarity_LuaBatch.cpp
+ *
+ *  \brief
+ *    An implementation for handing lua scripts contiguous arrays of
+ *    component data so a whole batch of entities is processed in one call
+*/
+
+#include "clapp_includes/pch.h"
+
+#include "clapp_includes/Clarity_LuaBatch.h"
+
+extern "C"
+{
+  #include <lauxlib.h>
+}
+
+using namespace std;
+
+namespace ClaPP
+{
+//=================//
+//= CTOR and DTOR =//
+//=================//
+
+LuaBatch::LuaBatch()
+: columnNames(), columns(), count(0u), pushedState(nullptr)
+  , pushedTableRef(LUA_NOREF), pushedArrays()
+{
+
+}
+
+LuaBatch::~LuaBatch()
+{
+  // The state may already be closed so lua is not touched here, Invalidate
+  // must be called after each call the batch is pushed for
+}
+
+//==================//
+//= Public Methods =//
+//==================//
+
+size_t LuaBatch::AddColumn(const string &columnName)
+{
+  columnNames.push_back(columnName);
+  columns.emplace_back(count, 0.f);
+  return columns.size() - 1;
+}
+
+void LuaBatch::Resize(const size_t &_count)
+{
+  count = _count;
+  for(vector<float> &column : columns)
+  {
+    column.resize(count);
+  }
+}
+
+float *LuaBatch::GetColumn(const size_t &columnIndex)
+{
+  return columns[columnIndex].data();
+}
+
+const size_t &LuaBatch::GetCount() const
+{
+  return count;
+}
+
+void LuaBatch::Push(lua_State *state)
+{
+  Invalidate();
+
+  // Only the first push in a state creates the metatable
+  if(luaL_newmetatable(state, FLOAT_ARRAY_METATABLE.c_str()))
+  {
+    lua_pushcfunction(state, FloatArrayIndex);
+    lua_setfield(state, -2, "__index");
+    lua_pushcfunction(state, FloatArrayNewIndex);
+    lua_setfield(state, -2, "__newindex");
+    lua_pushcfunction(state, FloatArrayLength);
+    lua_setfield(state, -2, "__len");
+  }
+  lua_pop(state, 1);
+
+  // One table and a userdata per column, the cost is per frame rather
+  // than per entity
+  lua_createtable(state, 0, static_cast<int>(columns.size() + 1));
+  lua_pushinteger(state, static_cast<lua_Integer>(count));
+  lua_setfield(state, -2, "count");
+
+  for(size_t i = 0; i < columns.size(); ++i)
+  {
+    FloatArray *array = static_cast<FloatArray *>(
+      lua_newuserdata(state, sizeof(FloatArray)));
+    array->data = columns[i].data();
+    array->size = static_cast<lua_Integer>(count);
+    luaL_setmetatable(state, FLOAT_ARRAY_METATABLE.c_str());
+    lua_setfield(state, -2, columnNames[i].c_str());
+
+    pushedArrays.push_back(array);
+  }
+
+  // Anchor the table so the userdata stay alive until they are invalidated
+  lua_pushvalue(state, -1);
+  pushedTableRef = luaL_ref(state, LUA_REGISTRYINDEX);
+  pushedState = state;
+}
+
+void LuaBatch::Invalidate()
+{
+  if(!pushedState)
+  {
+    return;
+  }
+
+  // The userdata are owned by lua and a script may have kept them, so
+  // only their view of the columns is cleared
+  for(FloatArray *array : pushedArrays)
+  {
+    array->data = nullptr;
+    array->size = 0;
+  }
+  pushedArrays.clear();
+
+  luaL_unref(pushedState, LUA_REGISTRYINDEX, pushedTableRef);
+  pushedTableRef = LUA_NOREF;
+  pushedState = nullptr;
+}
+
+//===================//
+//= Private Methods =//
+//===================//
+
+int LuaBatch::FloatArrayIndex(lua_State *state)
+{
+  FloatArray *array = static_cast<FloatArray *>(
+    luaL_checkudata(state, 1, FLOAT_ARRAY_METATABLE.c_str()));
+  const lua_Integer index = luaL_checkinteger(state, 2);
+  // Lua arrays start at 1
+  if(index < 1 || index > array->size)
+  {
+    return luaL_error(state, "batch index %d out of range",
+                      static_cast<int>(index));
+  }
+  lua_pushnumber(state, array->data[index - 1]);
+  return 1;
+}
+
+int LuaBatch::FloatArrayNewIndex(lua_State *state)
+{
+  FloatArray *array = static_cast<FloatArray *>(
+    luaL_checkudata(state, 1, FLOAT_ARRAY_METATABLE.c_str()));
+  const lua_Integer index = luaL_checkinteger(state, 2);
+  const lua_Number value = luaL_checknumber(state, 3);
+  if(index < 1 || index > array->size)
+  {
+    return luaL_error(state, "batch index %d out of range",
+                      static_cast<int>(index));
+  }
+  array->data[index - 1] = static_cast<float>(value);
+  return 0;
+}
+
+int LuaBatch::FloatArrayLength(lua_State *state)
+{
+  FloatArray *array = static_cast<FloatArray *>(
+    luaL_checkudata(state, 1, FLOAT_ARRAY_METATABLE.c_str()));
+  lua_pushinteger(state, array->size);
+  return 1;
+}
+}
@@ -0,0 +1,233 @@
+/*
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    Clarity_LuaCache.cpp
+ *
+ *  \brief
+ *    An implementation for caching compiled lua bytecode on disk so scripts
+ *    are only lexed and parsed when they change
+*/
+
+#include "clapp_includes/pch.h"
+
+#include "clapp_includes/Clarity_LuaCache.h"
+
+#include <filesystem>
+#include <thread>
+
+extern "C"
+{
+  #include <lauxlib.h>
+}
+
+#include "clapp_includes/Clarity_Archive.h"
+#include "clapp_includes/Clarity_IO.h"
+
+using namespace std;
+
+namespace ClaPP
+{
+/*
+ * Appends each piece of a dumped chunk to the string given as user data
+ */
+static int WriteChunk(lua_State *, const void *data, size_t size
+                      , void *userData)
+{
+  static_cast<string *>(userData)->append(static_cast<const char *>(data)
+                                          , size);
+  return 0;
+}
+
+//=================//
+//= CTOR and DTOR =//
+//=================//
+
+LuaBytecodeCache &LuaBytecodeCache::GetInstance()
+{
+  static LuaBytecodeCache instance;
+  return instance;
+}
+
+LuaBytecodeCache::LuaBytecodeCache()
+: cacheDirectory(DEFAULT_CACHE_PATH), isEnabled(true), cacheMutex()
+{
+
+}
+
+LuaBytecodeCache::~LuaBytecodeCache()
+{
+
+}
+
+//==================//
+//= Public Methods =//
+//==================//
+
+void LuaBytecodeCache::SetCacheDirectory(const string &_cacheDirectory)
+{
+  lock_guard<mutex> lock(cacheMutex);
+  cacheDirectory = _cacheDirectory;
+}
+
+void LuaBytecodeCache::SetEnabled(const bool &enabled)
+{
+  lock_guard<mutex> lock(cacheMutex);
+  isEnabled = enabled;
+}
+
+bool LuaBytecodeCache::StampFile(const string &luaPath, SourceStamp &stamp)
+{
+  error_code error;
+  const filesystem::file_time_type modified
+    = filesystem::last_write_time(luaPath, error);
+  if(error)
+  {
+    return false;
+  }
+  const uintmax_t size = filesystem::file_size(luaPath, error);
+  if(error)
+  {
+    return false;
+  }
+
+  stamp.modifiedTime = static_cast<int64_t>(
+    modified.time_since_epoch().count());
+  stamp.sourceSize = static_cast<uint64_t>(size);
+  stamp.sourceHash = 0u;
+  return true;
+}
+
+LuaBytecodeCache::SourceStamp LuaBytecodeCache::StampSource(
+  const string &luaSource)
+{
+  SourceStamp stamp;
+  stamp.sourceSize = luaSource.size();
+  // The archive's FNV-1a hash works on any bytes, not just paths
+  stamp.sourceHash = AssetArchive::HashPath(luaSource);
+  return stamp;
+}
+
+bool LuaBytecodeCache::Load(lua_State *state, const string &luaPath
+                            , const SourceStamp &stamp)
+{
+  string cachePath;
+  {
+    lock_guard<mutex> lock(cacheMutex);
+    if(!isEnabled)
+    {
+      return false;
+    }
+    cachePath = GetCachePath(luaPath);
+  }
+
+  ifstream file(cachePath, ios::binary);
+  if(!file.is_open())
+  {
+    return false;
+  }
+
+  CacheHeader header;
+  if(!file.read(reinterpret_cast<char *>(&header), sizeof(header))
+     || memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0
+     || header.version != CACHE_VERSION
+     || header.luaVersion != LUA_VERSION_NUM
+     || !(header.stamp == stamp))
+  {
+    return false;
+  }
+
+  stringstream stream;
+  stream << file.rdbuf();
+  const string bytecode = stream.str();
+
+  // Only accept binary chunks so a corrupted cache can never be run as
+  // source, lua also validates the bytecode header against this build
+  const string chunkName = "@" + luaPath;
+  if(luaL_loadbufferx(state, bytecode.data(), bytecode.size()
+                      , chunkName.c_str(), "b") != LUA_OK)
+  {
+    Message("Discarding invalid lua bytecode cache for: " + luaPath
+            , SEVERITY_WARNING);
+    lua_pop(state, 1);
+    return false;
+  }
+
+  return true;
+}
+
+void LuaBytecodeCache::Store(lua_State *state, const string &luaPath
+                             , const SourceStamp &stamp)
+{
+  string cachePath;
+  {
+    lock_guard<mutex> lock(cacheMutex);
+    if(!isEnabled)
+    {
+      return;
+    }
+    cachePath = GetCachePath(luaPath);
+  }
+
+  // Keep debug info so errors still report file names and line numbers
+  string bytecode;
+  if(lua_dump(state, WriteChunk, &bytecode, 0) != 0 || bytecode.empty())
+  {
+    ErrMessage("Failed to dump lua bytecode for: " + luaPath, EC_LUA);
+    return;
+  }
+
+  CacheHeader header{};
+  memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+  header.version = CACHE_VERSION;
+  header.luaVersion = LUA_VERSION_NUM;
+  header.stamp = stamp;
+
+  error_code error;
+  filesystem::create_directories(filesystem::path(cachePath).parent_path()
+                                 , error);
+
+  // Write beside the cache file then rename over it so a reader never
+  // sees a partially written chunk
+  const string tempPath = cachePath + ".tmp"
+    + to_string(hash<thread::id>{}(this_thread::get_id()));
+  {
+    ofstream file(tempPath, ios::binary | ios::trunc);
+    if(!file.is_open())
+    {
+      Message("Unable to write lua bytecode cache: " + cachePath
+              , SEVERITY_WARNING);
+      return;
+    }
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(bytecode.data(), bytecode.size());
+    if(!file.good())
+    {
+      file.close();
+      filesystem::remove(tempPath, error);
+      return;
+    }
+  }
+
+  filesystem::rename(tempPath, cachePath, error);
+  if(error)
+  {
+    filesystem::remove(tempPath, error);
+  }
+}
+
+//===================//
+//= Private Methods =//
+//===================//
+
+string LuaBytecodeCache::GetCachePath(const string &luaPath) const
+{
+  // Hash the normalized path so every script maps to one flat file name
+  char name[17];
+  snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(
+           AssetArchive::HashPath(AssetArchive::NormalizePath(luaPath))));
+  return cacheDirectory + "/" + name + ".luac";
+}
+}
@@ -0,0 +1,508 @@
+/*
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    Clarity_LuaConfig.cpp
+ *
+ *  \brief
+ *    An implementation for reading lua config scripts into an immutable
+ *    tree queried by path
+*/
+
+#include "clapp_includes/pch.h"
+
+#include "clapp_includes/Clarity_LuaConfig.h"
+
+#include "clapp_includes/Clarity_IO.h"
+#include "clapp_includes/Clarity_LUA.h"
+
+using namespace std;
+
+namespace ClaPP
+{
+//=================//
+//= CTOR and DTOR =//
+//=================//
+
+LuaConfig::LuaConfig()
+: nodes(1), filePath()
+{
+  nodes[0].type = VALUE_TABLE;
+}
+
+LuaConfig::~LuaConfig()
+{
+
+}
+
+//==================//
+//= Public Methods =//
+//==================//
+
+LuaConfig::CONFIG_ERR LuaConfig::LoadFile(const string &luaPath)
+{
+  nodes.assign(1, Node());
+  nodes[0].type = VALUE_TABLE;
+  filePath = luaPath;
+
+  switch(LuaState::GetInstance().ExecuteConfig(luaPath, nullptr, *this))
+  {
+    case LuaState::LUA_NO_ERR:
+      return CONFIG_NO_ERR;
+    case LuaState::LUA_FILE_NOT_FOUND:
+      return CONFIG_FILE_NOT_FOUND;
+    default:
+      return CONFIG_INVALID_FILE;
+  }
+}
+
+LuaConfig::CONFIG_ERR LuaConfig::LoadBuffer(const string &luaSource
+                                            , const string &luaPath)
+{
+  nodes.assign(1, Node());
+  nodes[0].type = VALUE_TABLE;
+  filePath = luaPath;
+
+  switch(LuaState::GetInstance().ExecuteConfig(luaPath, &luaSource, *this))
+  {
+    case LuaState::LUA_NO_ERR:
+      return CONFIG_NO_ERR;
+    case LuaState::LUA_FILE_NOT_FOUND:
+      return CONFIG_FILE_NOT_FOUND;
+    default:
+      return CONFIG_INVALID_FILE;
+  }
+}
+
+LuaConfig::VALUE_TYPE LuaConfig::GetType(const string_view &path) const
+{
+  const Lookup lookup = Find(path);
+  if(lookup.number)
+  {
+    return VALUE_NUMBER;
+  }
+  return lookup.node ? lookup.node->type : VALUE_NIL;
+}
+
+bool LuaConfig::Has(const string_view &path) const
+{
+  return GetType(path) != VALUE_NIL;
+}
+
+LuaConfig::CONFIG_ERR LuaConfig::GetNumber(const string_view &path
+                                           , double &value) const
+{
+  const Lookup lookup = Find(path);
+  if(lookup.number)
+  {
+    value = *lookup.number;
+    return CONFIG_NO_ERR;
+  }
+  if(!lookup.node || lookup.node->type == VALUE_NIL)
+  {
+    ErrMessage("No value found at: " + string(path) + " in file: "
+                + filePath, EC_LUA);
+    return CONFIG_INVALID_PATH;
+  }
+  if(lookup.node->type != VALUE_NUMBER)
+  {
+    ErrMessage("No number found at: " + string(path) + " in file: "
+                + filePath, EC_LUA);
+    return CONFIG_INCORRECT_TYPE;
+  }
+  value = lookup.node->number;
+  return CONFIG_NO_ERR;
+}
+
+LuaConfig::CONFIG_ERR LuaConfig::GetNumber(const string_view &path
+                                           , float &value) const
+{
+  double number = 0.0;
+  CONFIG_ERR err = GetNumber(path, number);
+  if(err == CONFIG_NO_ERR)
+  {
+    value = static_cast<float>(number);
+  }
+  return err;
+}
+
+LuaConfig::CONFIG_ERR LuaConfig::GetNumber(const string_view &path
+                                           , int &value) const
+{
+  double number = 0.0;
+  CONFIG_ERR err = GetNumber(path, number);
+  if(err == CONFIG_NO_ERR)
+  {
+    value = static_cast<int>(number);
+  }
+  return err;
+}
+
+LuaConfig::CONFIG_ERR LuaConfig::GetString(const string_view &path
+                                           , string &value) const
+{
+  const Lookup lookup = Find(path);
+  if(!lookup.number && (!lookup.node || lookup.node->type == VALUE_NIL))
+  {
+    ErrMessage("No value found at: " + string(path) + " in file: "
+                + filePath, EC_LUA);
+    return CONFIG_INVALID_PATH;
+  }
+  if(!lookup.node || lookup.node->type != VALUE_STRING)
+  {
+    ErrMessage("No string found at: " + string(path) + " in file: "
+                + filePath, EC_LUA);
+    return CONFIG_INCORRECT_TYPE;
+  }
+  value = lookup.node->string;
+  return CONFIG_NO_ERR;
+}
+
+LuaConfig::CONFIG_ERR LuaConfig::GetBool(const string_view &path
+                                         , bool &value) const
+{
+  const Lookup lookup = Find(path);
+  if(!lookup.number && (!lookup.node || lookup.node->type == VALUE_NIL))
+  {
+    ErrMessage("No value found at: " + string(path) + " in file: "
+                + filePath, EC_LUA);
+    return CONFIG_INVALID_PATH;
+  }
+  if(!lookup.node || lookup.node->type != VALUE_BOOL)
+  {
+    ErrMessage("No bool found at: " + string(path) + " in file: "
+                + filePath, EC_LUA);
+    return CONFIG_INCORRECT_TYPE;
+  }
+  value = lookup.node->boolean;
+  return CONFIG_NO_ERR;
+}
+
+LuaConfig::CONFIG_ERR LuaConfig::GetLength(const string_view &path
+                                           , size_t &length) const
+{
+  const Lookup lookup = Find(path);
+  if(!lookup.node || lookup.node->type != VALUE_TABLE)
+  {
+    ErrMessage("No table found at: " + string(path) + " in file: "
+                + filePath, EC_LUA);
+    return lookup.node || lookup.number ? CONFIG_INCORRECT_TYPE
+                                        : CONFIG_INVALID_PATH;
+  }
+  // Only one of the two is ever filled
+  length = lookup.node->numbers.size() + lookup.node->elements.size();
+  return CONFIG_NO_ERR;
+}
+
+LuaConfig::CONFIG_ERR LuaConfig::GetKeys(const string_view &path
+                                         , vector<string> &keys) const
+{
+  const Lookup lookup = Find(path);
+  if(!lookup.node || lookup.node->type != VALUE_TABLE)
+  {
+    ErrMessage("No table found at: " + string(path) + " in file: "
+                + filePath, EC_LUA);
+    return lookup.node || lookup.number ? CONFIG_INCORRECT_TYPE
+                                        : CONFIG_INVALID_PATH;
+  }
+  keys.clear();
+  keys.reserve(lookup.node->fields.size());
+  for(const pair<string, uint32_t> &field : lookup.node->fields)
+  {
+    keys.push_back(field.first);
+  }
+  return CONFIG_NO_ERR;
+}
+
+LuaConfig::CONFIG_ERR LuaConfig::GetNumberArray(const string_view &path
+                                                , vector<float> &values) const
+{
+  const vector<double> *numbers = nullptr;
+  if(CONFIG_ERR err = GetSequence(path, numbers))
+  {
+    return err;
+  }
+  values.resize(numbers->size());
+  for(size_t i = 0; i < values.size(); ++i)
+  {
+    values[i] = static_cast<float>((*numbers)[i]);
+  }
+  return CONFIG_NO_ERR;
+}
+
+LuaConfig::CONFIG_ERR LuaConfig::GetNumberArray(const string_view &path
+                                                , vector<unsigned int> &values)
+                                                const
+{
+  const vector<double> *numbers = nullptr;
+  if(CONFIG_ERR err = GetSequence(path, numbers))
+  {
+    return err;
+  }
+  values.resize(numbers->size());
+  for(size_t i = 0; i < values.size(); ++i)
+  {
+    values[i] = static_cast<unsigned int>((*numbers)[i]);
+  }
+  return CONFIG_NO_ERR;
+}
+
+LuaConfig::CONFIG_ERR LuaConfig::GetVec2Array(const string_view &path
+                                              , vector<glm::vec2> &values)
+                                              const
+{
+  const vector<double> *numbers = nullptr;
+  if(CONFIG_ERR err = GetSequence(path, numbers))
+  {
+    return err;
+  }
+  if(numbers->size() % 2 != 0)
+  {
+    ErrMessage("Numbers at: " + string(path) + " in file: " + filePath
+                + " do not make whole vec2s", EC_LUA);
+    return CONFIG_INCORRECT_TYPE;
+  }
+  values.resize(numbers->size() / 2);
+  for(size_t i = 0; i < values.size(); ++i)
+  {
+    values[i] = glm::vec2((*numbers)[i * 2], (*numbers)[i * 2 + 1]);
+  }
+  return CONFIG_NO_ERR;
+}
+
+LuaConfig::CONFIG_ERR LuaConfig::GetVec3Array(const string_view &path
+                                              , vector<glm::vec3> &values)
+                                              const
+{
+  const vector<double> *numbers = nullptr;
+  if(CONFIG_ERR err = GetSequence(path, numbers))
+  {
+    return err;
+  }
+  if(numbers->size() % 3 != 0)
+  {
+    ErrMessage("Numbers at: " + string(path) + " in file: " + filePath
+                + " do not make whole vec3s", EC_LUA);
+    return CONFIG_INCORRECT_TYPE;
+  }
+  values.resize(numbers->size() / 3);
+  for(size_t i = 0; i < values.size(); ++i)
+  {
+    values[i] = glm::vec3((*numbers)[i * 3], (*numbers)[i * 3 + 1]
+                          , (*numbers)[i * 3 + 2]);
+  }
+  return CONFIG_NO_ERR;
+}
+
+const string &LuaConfig::GetFilePath() const
+{
+  return filePath;
+}
+
+//===================//
+//= Private Methods =//
+//===================//
+
+void LuaConfig::CopyRoot(lua_State *state, const int &index)
+{
+  nodes.assign(1, Node());
+  CopyTable(state, lua_absindex(state, index), 0u, 0);
+}
+
+void LuaConfig::CopyValue(lua_State *state, const int &index
+                          , const uint32_t &node, const int &depth)
+{
+  // Only reference nodes by index here as copying a table grows the vector
+  switch(lua_type(state, index))
+  {
+    case LUA_TBOOLEAN:
+      nodes[node].type = VALUE_BOOL;
+      nodes[node].boolean = lua_toboolean(state, index);
+      break;
+    case LUA_TNUMBER:
+      nodes[node].type = VALUE_NUMBER;
+      nodes[node].number = lua_tonumber(state, index);
+      break;
+    case LUA_TSTRING:
+      nodes[node].type = VALUE_STRING;
+      nodes[node].string = lua_tostring(state, index);
+      break;
+    case LUA_TTABLE:
+      if(depth < MAX_DEPTH)
+      {
+        CopyTable(state, index, node, depth + 1);
+      }
+      break;
+    default:
+      // Functions and userdata have no meaning outside of lua
+      break;
+  }
+}
+
+void LuaConfig::CopyTable(lua_State *state, const int &index
+                          , const uint32_t &node, const int &depth)
+{
+  nodes[node].type = VALUE_TABLE;
+  if(!lua_checkstack(state, 3))
+  {
+    return;
+  }
+
+  const lua_Integer length = static_cast<lua_Integer>(lua_rawlen(state
+                                                                 , index));
+
+  // Sequences of only numbers such as vertices are packed so reading them
+  // back is a single copy
+  vector<double> numbers;
+  numbers.reserve(static_cast<size_t>(length));
+  for(lua_Integer i = 1; i <= length; ++i)
+  {
+    lua_rawgeti(state, index, i);
+    const bool isNumber = lua_type(state, -1) == LUA_TNUMBER;
+    if(isNumber)
+    {
+      numbers.push_back(lua_tonumber(state, -1));
+    }
+    lua_pop(state, 1);
+    if(!isNumber)
+    {
+      break;
+    }
+  }
+
+  if(numbers.size() == static_cast<size_t>(length))
+  {
+    nodes[node].numbers = move(numbers);
+  }
+  else
+  {
+    vector<uint32_t> elements;
+    elements.reserve(static_cast<size_t>(length));
+    for(lua_Integer i = 1; i <= length; ++i)
+    {
+      lua_rawgeti(state, index, i);
+      const uint32_t child = static_cast<uint32_t>(nodes.size());
+      nodes.emplace_back();
+      CopyValue(state, lua_gettop(state), child, depth);
+      lua_pop(state, 1);
+      elements.push_back(child);
+    }
+    nodes[node].elements = move(elements);
+  }
+
+  vector<pair<string, uint32_t>> fields;
+  lua_pushnil(state);
+  while(lua_next(state, index))
+  {
+    const int keyType = lua_type(state, -2);
+    const bool isSequence = keyType == LUA_TNUMBER
+                            && lua_isinteger(state, -2)
+                            && lua_tointeger(state, -2) >= 1
+                            && lua_tointeger(state, -2) <= length;
+    if(!isSequence && (keyType == LUA_TSTRING || keyType == LUA_TNUMBER))
+    {
+      // Converting the key itself would confuse lua_next so use a copy
+      lua_pushvalue(state, -2);
+      string name = lua_tostring(state, -1);
+      lua_pop(state, 1);
+
+      const uint32_t child = static_cast<uint32_t>(nodes.size());
+      nodes.emplace_back();
+      CopyValue(state, lua_gettop(state), child, depth);
+      fields.emplace_back(move(name), child);
+    }
+    lua_pop(state, 1);
+  }
+
+  // Sorted so paths are found with a binary search
+  sort(fields.begin(), fields.end());
+  nodes[node].fields = move(fields);
+}
+
+LuaConfig::Lookup LuaConfig::Find(const string_view &path) const
+{
+  Lookup lookup;
+  lookup.node = &nodes[0];
+
+  size_t start = 0;
+  while(start <= path.size() && !path.empty())
+  {
+    size_t end = path.find('.', start);
+    if(end == string_view::npos)
+    {
+      end = path.size();
+    }
+    const string_view segment = path.substr(start, end - start);
+    start = end + 1;
+
+    // Only tables can be walked into
+    if(!lookup.node || lookup.node->type != VALUE_TABLE || segment.empty())
+    {
+      return Lookup();
+    }
+    const Node &parent = *lookup.node;
+
+    size_t index = 0;
+    const bool isIndex = all_of(segment.begin(), segment.end()
+                                , [](const char &c)
+                                { return c >= '0' && c <= '9'; });
+    if(isIndex)
+    {
+      for(const char &c : segment)
+      {
+        index = index * 10 + static_cast<size_t>(c - '0');
+      }
+    }
+
+    if(isIndex && index >= 1 && index <= parent.numbers.size())
+    {
+      lookup.node = nullptr;
+      lookup.number = &parent.numbers[index - 1];
+    }
+    else if(isIndex && index >= 1 && index <= parent.elements.size())
+    {
+      lookup.node = &nodes[parent.elements[index - 1]];
+    }
+    else
+    {
+      auto field = lower_bound(parent.fields.begin(), parent.fields.end()
+                               , segment
+                               , [](const pair<string, uint32_t> &lhs
+                                    , const string_view &rhs)
+                               { return string_view(lhs.first) < rhs; });
+      if(field == parent.fields.end() || field->first != segment)
+      {
+        return Lookup();
+      }
+      lookup.node = &nodes[field->second];
+    }
+  }
+
+  return lookup;
+}
+
+LuaConfig::CONFIG_ERR LuaConfig::GetSequence(const string_view &path
+                                             , const vector<double> *&numbers)
+                                             const
+{
+  const Lookup lookup = Find(path);
+  if(!lookup.node && !lookup.number)
+  {
+    ErrMessage("No value found at: " + string(path) + " in file: "
+                + filePath, EC_LUA);
+    return CONFIG_INVALID_PATH;
+  }
+  // A table holding anything other than numbers is never packed
+  if(!lookup.node || lookup.node->type != VALUE_TABLE
+     || !lookup.node->elements.empty())
+  {
+    ErrMessage("No number array found at: " + string(path) + " in file: "
+                + filePath, EC_LUA);
+    return CONFIG_INCORRECT_TYPE;
+  }
+  numbers = &lookup.node->numbers;
+  return CONFIG_NO_ERR;
+}
+}
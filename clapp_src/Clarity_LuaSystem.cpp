@@ -0,0 +1,174 @@
+/*!
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    Clarity_LuaSystem.cpp
+ *
+ *  \brief
+ *    The implementation file for systems whose update is written in lua
+ */
+
+#include "clapp_includes/pch.h"
+
+#include "clapp_includes/Clarity_LuaSystem.h"
+
+#include "clapp_includes/CPL_Transform.h"
+#include "clapp_includes/CPL_Physics.h"
+
+#include "clapp_includes/Clarity_ECS.h"
+#include "clapp_includes/Clarity_IO.h"
+#include "clapp_includes/Clarity_LUA.h"
+
+using namespace ClaPP;
+using namespace std;
+
+/*
+ * Copies a vector into three columns at the given batch index
+ */
+static void GatherVec3(LuaBatch &batch, const size_t &firstColumn
+                       , const size_t &index, const glm::vec3 &value)
+{
+  batch.GetColumn(firstColumn)[index] = value.x;
+  batch.GetColumn(firstColumn + 1)[index] = value.y;
+  batch.GetColumn(firstColumn + 2)[index] = value.z;
+}
+
+/*
+ * Copies three columns at the given batch index back into a vector
+ */
+static void ScatterVec3(LuaBatch &batch, const size_t &firstColumn
+                        , const size_t &index, glm::vec3 &value)
+{
+  value.x = batch.GetColumn(firstColumn)[index];
+  value.y = batch.GetColumn(firstColumn + 1)[index];
+  value.z = batch.GetColumn(firstColumn + 2)[index];
+}
+
+LuaSystem::LuaSystem(const std::string &_sysName
+                     , const std::string &_scriptPath)
+: Clarity_System(_sysName), scriptPath(_scriptPath), updateRef(LUA_NOREF)
+  , batch(), batchEntities(), batchRotations()
+{
+  systemSignature.set(Component::C_TRANSFORM);
+  systemSignature.set(Component::C_PHYSICS);
+
+  // Added in BATCH_COLUMN order
+  for(const char *vector : {"pos", "rot", "scale", "vel", "force"})
+  {
+    batch.AddColumn(string(vector) + "X");
+    batch.AddColumn(string(vector) + "Y");
+    batch.AddColumn(string(vector) + "Z");
+  }
+}
+
+LuaSystem::~LuaSystem()
+{
+
+}
+
+LuaSystem::SYS_ERR LuaSystem::Initialize()
+{
+  if(LuaState::GetInstance().LoadFunction(scriptPath, "update", updateRef)
+     != LuaState::LUA_NO_ERR)
+  {
+    ErrMessage(GetSysName() + " failed to load update from: " + scriptPath
+               , EC_LUA);
+    return SYS_FAILED_TO_INITIALIZE;
+  }
+
+  return SYS_NO_ERR;
+}
+
+LuaSystem::SYS_ERR LuaSystem::Load()
+{
+  return SYS_NO_ERR;
+}
+
+LuaSystem::SYS_ERR LuaSystem::Update(float deltaTime)
+{
+  if(systemEntites.empty())
+  {
+    return SYS_NO_ERR;
+  }
+
+  ECS *ecs = GetECSPtr();
+
+  batch.Resize(systemEntites.size());
+  batchEntities.assign(systemEntites.begin(), systemEntites.end());
+
+  batchRotations.resize(batchEntities.size());
+  for(size_t i = 0; i < batchEntities.size(); ++i)
+  {
+    Transform *transformComponent = ecs->GetComponent<Transform>(
+      batchEntities[i], Component::C_TRANSFORM);
+    Transform::TransformData &transform 
+      = transformComponent->GetTransformData();
+    Physics::PhysicsData &physics = ecs->GetComponent<Physics>(
+      batchEntities[i], Component::C_PHYSICS)->GetPhysicsData();
+
+    // Scripts work in Euler degrees
+    batchRotations[i] = transformComponent->GetEulerRotation();
+
+    GatherVec3(batch, COLUMN_POSITION, i, transform.worldPos);
+    GatherVec3(batch, COLUMN_ROTATION, i, batchRotations[i]);
+    GatherVec3(batch, COLUMN_SCALE, i, transform.scale);
+    GatherVec3(batch, COLUMN_VELOCITY, i, physics.veclotiy);
+    GatherVec3(batch, COLUMN_FORCE, i, physics.appliedForce);
+  }
+
+  // One call for the whole batch. A failing script is reported and its
+  // results are dropped for the frame rather than stopping the engine
+  if(LuaState::GetInstance().CallBatchFunction(updateRef, deltaTime, batch)
+     != LuaState::LUA_NO_ERR)
+  {
+    return SYS_NO_ERR;
+  }
+
+  for(size_t i = 0; i < batchEntities.size(); ++i)
+  {
+    Transform *transformComponent = ecs->GetComponent<Transform>(
+      batchEntities[i], Component::C_TRANSFORM);
+    Transform::TransformData &transform 
+      = transformComponent->GetTransformData();
+    Physics::PhysicsData &physics = ecs->GetComponent<Physics>(
+      batchEntities[i], Component::C_PHYSICS)->GetPhysicsData();
+
+    // Only a rotation the script changed is converted back so unchanged
+    // orientations do not drift through the Euler round trip
+    glm::vec3 rotation;
+    ScatterVec3(batch, COLUMN_ROTATION, i, rotation);
+    if(rotation != batchRotations[i])
+    {
+      transformComponent->SetEulerRotation(rotation);
+    }
+
+    ScatterVec3(batch, COLUMN_POSITION, i, transform.worldPos);
+    ScatterVec3(batch, COLUMN_SCALE, i, transform.scale);
+    ScatterVec3(batch, COLUMN_VELOCITY, i, physics.veclotiy);
+    ScatterVec3(batch, COLUMN_FORCE, i, physics.appliedForce);
+  }
+
+  return SYS_NO_ERR;
+}
+
+LuaSystem::SYS_ERR LuaSystem::Render()
+{
+  return SYS_NO_ERR;
+}
+
+LuaSystem::SYS_ERR LuaSystem::Unload()
+{
+  return SYS_NO_ERR;
+}
+
+LuaSystem::SYS_ERR LuaSystem::Terminate()
+{
+  if(updateRef != LUA_NOREF)
+  {
+    LuaState::GetInstance().ReleaseFunction(updateRef);
+  }
+
+  return SYS_NO_ERR;
+}
@@ -0,0 +1,202 @@
+/*
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    Clarity_ThreadPool.cpp
+ *
+ *  \brief
+ *    An implementation for a fixed pool of worker threads used to split
+ *    loops across every core
+*/
+
+#include "clapp_includes/pch.h"
+
+#include "clapp_includes/Clarity_ThreadPool.h"
+
+#include "clapp_includes/Clarity_IO.h"
+
+using namespace std;
+
+namespace ClaPP
+{
+// Set on pool threads and while the caller runs a loop so nested loops
+// run inline instead of waiting on themselves
+static thread_local bool isInsideLoop = false;
+
+//=================//
+//= CTOR and DTOR =//
+//=================//
+
+ThreadPool &ThreadPool::GetInstance()
+{
+  static ThreadPool instance;
+  return instance;
+}
+
+// The calling thread is one of the threads so only spawn the rest
+static size_t GetHardwareWorkerCount()
+{
+  const unsigned int hardwareThreads = thread::hardware_concurrency();
+  return hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+}
+
+ThreadPool::ThreadPool()
+: ThreadPool(GetHardwareWorkerCount())
+{
+
+}
+
+ThreadPool::ThreadPool(const size_t &workerCount)
+: workers(), loopMutex(), workMutex(), workCondition(), doneCondition()
+  , loopGeneration(0u), workersRunning(0u), isStopping(false)
+  , loopFunction(nullptr), loopCount(0u), loopBatchSize(1u), nextIndex(0u)
+{
+  StartWorkers(workerCount);
+}
+
+ThreadPool::~ThreadPool()
+{
+  StopWorkers();
+}
+
+//==================//
+//= Public Methods =//
+//==================//
+
+void ThreadPool::ParallelFor(const size_t &count, const RangeFunction &function
+                             , const size_t &batchSize)
+{
+  if(count == 0)
+  {
+    return;
+  }
+
+  const size_t batch = max<size_t>(batchSize, 1u);
+
+  // Small loops and nested loops are not worth waking the workers for
+  if(isInsideLoop || workers.empty() || count <= batch)
+  {
+    function(0, count, 0);
+    return;
+  }
+
+  lock_guard<mutex> loopLock(loopMutex);
+
+  {
+    lock_guard<mutex> lock(workMutex);
+    loopFunction = &function;
+    loopCount = count;
+    loopBatchSize = batch;
+    nextIndex.store(0u, memory_order_relaxed);
+    workersRunning = workers.size();
+    ++loopGeneration;
+  }
+  workCondition.notify_all();
+
+  isInsideLoop = true;
+  RunBatches(0);
+  isInsideLoop = false;
+
+  // The function must outlive every worker that could still be using it
+  unique_lock<mutex> lock(workMutex);
+  doneCondition.wait(lock, [this]() { return workersRunning == 0; });
+  loopFunction = nullptr;
+}
+
+void ThreadPool::SetWorkerCount(const size_t &workerCount)
+{
+  // Waits out any loop another thread is running
+  lock_guard<mutex> loopLock(loopMutex);
+  StopWorkers();
+  StartWorkers(workerCount);
+}
+
+size_t ThreadPool::GetThreadCount() const
+{
+  return workers.size() + 1;
+}
+
+//===================//
+//= Private Methods =//
+//===================//
+
+void ThreadPool::StartWorkers(const size_t &workerCount)
+{
+  workers.reserve(workerCount);
+  for(size_t i = 0; i < workerCount; ++i)
+  {
+    // Given the current generation so a worker that starts late still
+    // joins the first loop rather than waiting through it
+    workers.emplace_back(&ThreadPool::WorkerLoop, this, i + 1
+                         , loopGeneration);
+  }
+
+  Message("Started thread pool with " + to_string(workerCount) + " workers"
+          , SEVERITY_INFO);
+}
+
+void ThreadPool::StopWorkers()
+{
+  {
+    lock_guard<mutex> lock(workMutex);
+    isStopping = true;
+  }
+  workCondition.notify_all();
+
+  for(thread &worker : workers)
+  {
+    worker.join();
+  }
+  workers.clear();
+  isStopping = false;
+}
+
+void ThreadPool::WorkerLoop(const size_t &threadIndex
+                            , const uint64_t &startGeneration)
+{
+  isInsideLoop = true;
+  uint64_t seenGeneration = startGeneration;
+
+  while(true)
+  {
+    {
+      unique_lock<mutex> lock(workMutex);
+      workCondition.wait(lock, [this, &seenGeneration]()
+      {
+        return isStopping || loopGeneration != seenGeneration;
+      });
+
+      if(isStopping)
+      {
+        return;
+      }
+      seenGeneration = loopGeneration;
+    }
+
+    RunBatches(threadIndex);
+
+    {
+      lock_guard<mutex> lock(workMutex);
+      --workersRunning;
+    }
+    doneCondition.notify_one();
+  }
+}
+
+void ThreadPool::RunBatches(const size_t &threadIndex)
+{
+  while(true)
+  {
+    const size_t begin = nextIndex.fetch_add(loopBatchSize
+                                             , memory_order_relaxed);
+    if(begin >= loopCount)
+    {
+      return;
+    }
+    (*loopFunction)(begin, min(begin + loopBatchSize, loopCount)
+                    , threadIndex);
+  }
+}
+}
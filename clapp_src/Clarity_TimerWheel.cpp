@@ -0,0 +1,245 @@
+/*
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    Clarity_TimerWheel.cpp
+ *
+ *  \brief
+ *    An implementation for scheduling large numbers of timed callbacks with
+ *    a hierarchical timer wheel
+*/
+
+#include "clapp_includes/pch.h"
+
+#include "clapp_includes/Clarity_TimerWheel.h"
+
+#include <cmath>
+
+#include "clapp_includes/Clarity_IO.h"
+
+using namespace std;
+
+namespace ClaPP
+{
+//=================//
+//= CTOR and DTOR =//
+//=================//
+
+TimerWheel::TimerWheel(const float &_tickDuration)
+: tickDuration(_tickDuration > 0.f ? _tickDuration : DEFAULT_TICK_DURATION)
+  , tickAccumulator(0.f), currentTick(0u), pendingCount(0u), nodes()
+  , freeHead(NIL_NODE), slotHeads()
+{
+  slotHeads.fill(NIL_NODE);
+}
+
+TimerWheel::~TimerWheel()
+{
+
+}
+
+//==================//
+//= Public Methods =//
+//==================//
+
+TimerWheel::TIMER_ID TimerWheel::Schedule(const float &delay
+                                          , FireFunction fire
+                                          , const void *payload
+                                          , const size_t &payloadSize)
+{
+  if(!fire || payloadSize > PAYLOAD_SIZE)
+  {
+    ErrMessage("Invalid timer scheduled, payload size: "
+               + to_string(payloadSize), EC_EVENT);
+    return INVALID_TIMER;
+  }
+
+  // Reuse a released node when there is one
+  uint32_t nodeIndex = freeHead;
+  if(nodeIndex != NIL_NODE)
+  {
+    freeHead = nodes[nodeIndex].next;
+  }
+  else
+  {
+    nodeIndex = static_cast<uint32_t>(nodes.size());
+    nodes.emplace_back();
+  }
+
+  TimerNode &node = nodes[nodeIndex];
+  // Rounded up so a timer never fires early, and always at least a tick
+  // away so it can not fire during the frame that scheduled it
+  const double ticks = ceil(static_cast<double>(max(delay, 0.f))
+                            / tickDuration);
+  node.expireTick = currentTick + max<uint64_t>(static_cast<uint64_t>(ticks)
+                                                , 1u);
+  node.fire = fire;
+  if(payloadSize)
+  {
+    memcpy(node.payload, payload, payloadSize);
+  }
+
+  Insert(nodeIndex);
+  ++pendingCount;
+
+  return (static_cast<TIMER_ID>(node.generation) << 32) | nodeIndex;
+}
+
+bool TimerWheel::Cancel(const TIMER_ID &timerID)
+{
+  const uint32_t nodeIndex = static_cast<uint32_t>(timerID & UINT32_MAX);
+  const uint32_t generation = static_cast<uint32_t>(timerID >> 32);
+
+  if(nodeIndex >= nodes.size() || nodes[nodeIndex].generation != generation
+     || nodes[nodeIndex].slot == NIL_NODE)
+  {
+    return false;
+  }
+
+  Unlink(nodeIndex);
+  Release(nodeIndex);
+  --pendingCount;
+  return true;
+}
+
+void TimerWheel::Advance(const float &deltaTime)
+{
+  tickAccumulator += max(deltaTime, 0.f);
+  while(tickAccumulator >= tickDuration)
+  {
+    tickAccumulator -= tickDuration;
+    ProcessTick();
+  }
+}
+
+size_t TimerWheel::GetPendingCount() const
+{
+  return pendingCount;
+}
+
+const float &TimerWheel::GetTickDuration() const
+{
+  return tickDuration;
+}
+
+//===================//
+//= Private Methods =//
+//===================//
+
+void TimerWheel::Insert(const uint32_t &nodeIndex)
+{
+  TimerNode &node = nodes[nodeIndex];
+  const uint64_t expireTick = max(node.expireTick, currentTick);
+
+  // The lowest level where the expiry shares every higher slot with the
+  // current tick, its slot there is then always ahead of the wheel
+  uint32_t level = 0;
+  while(level < LEVEL_COUNT - 1
+        && (expireTick >> (LEVEL_BITS * (level + 1)))
+           != (currentTick >> (LEVEL_BITS * (level + 1))))
+  {
+    ++level;
+  }
+
+  // The top level may wrap around, but a timer a whole turn or more away
+  // is parked in the top slot reached last and placed again from there
+  const uint64_t currentSlotTick = currentTick >> (LEVEL_BITS * level);
+  uint64_t slotTick = expireTick >> (LEVEL_BITS * level);
+  if(slotTick - currentSlotTick > SLOT_MASK)
+  {
+    slotTick = currentSlotTick + SLOT_MASK;
+  }
+
+  const uint32_t slot = level * SLOT_COUNT
+                        + static_cast<uint32_t>(slotTick & SLOT_MASK);
+
+  node.slot = slot;
+  node.prev = NIL_NODE;
+  node.next = slotHeads[slot];
+  if(node.next != NIL_NODE)
+  {
+    nodes[node.next].prev = nodeIndex;
+  }
+  slotHeads[slot] = nodeIndex;
+}
+
+void TimerWheel::Unlink(const uint32_t &nodeIndex)
+{
+  TimerNode &node = nodes[nodeIndex];
+  if(node.prev != NIL_NODE)
+  {
+    nodes[node.prev].next = node.next;
+  }
+  else
+  {
+    slotHeads[node.slot] = node.next;
+  }
+  if(node.next != NIL_NODE)
+  {
+    nodes[node.next].prev = node.prev;
+  }
+  node.slot = NIL_NODE;
+}
+
+void TimerWheel::Release(const uint32_t &nodeIndex)
+{
+  TimerNode &node = nodes[nodeIndex];
+  // Invalidates every id handed out for this node
+  ++node.generation;
+  node.fire = nullptr;
+  node.next = freeHead;
+  freeHead = nodeIndex;
+}
+
+void TimerWheel::Cascade(const uint32_t &slot)
+{
+  uint32_t nodeIndex = slotHeads[slot];
+  slotHeads[slot] = NIL_NODE;
+
+  while(nodeIndex != NIL_NODE)
+  {
+    const uint32_t next = nodes[nodeIndex].next;
+    Insert(nodeIndex);
+    nodeIndex = next;
+  }
+}
+
+void TimerWheel::ProcessTick()
+{
+  ++currentTick;
+
+  // Higher levels go first as their nodes can land in the lower slot that
+  // is about to cascade
+  uint32_t topLevel = 0;
+  while(topLevel < LEVEL_COUNT - 1
+        && (currentTick & ((1ull << (LEVEL_BITS * (topLevel + 1))) - 1)) == 0)
+  {
+    ++topLevel;
+  }
+  for(uint32_t level = topLevel; level > 0; --level)
+  {
+    Cascade(level * SLOT_COUNT
+            + static_cast<uint32_t>((currentTick >> (LEVEL_BITS * level))
+                                    & SLOT_MASK));
+  }
+
+  // Every node left in the current bottom slot expires on this tick
+  const uint32_t slot = static_cast<uint32_t>(currentTick & SLOT_MASK);
+  while(slotHeads[slot] != NIL_NODE)
+  {
+    const uint32_t nodeIndex = slotHeads[slot];
+    Unlink(nodeIndex);
+
+    // Copied out first so the callback can schedule into the freed node
+    const FireFunction fire = nodes[nodeIndex].fire;
+    unsigned char payload[PAYLOAD_SIZE];
+    memcpy(payload, nodes[nodeIndex].payload, PAYLOAD_SIZE);
+    Release(nodeIndex);
+    --pendingCount;
+
+    fire(payload);
+  }
+}
+}
@@ -10,11 +10,13 @@
  *    The interface file for the base class identity of what a mesh
  *    is within the Clarity Graphics Library
 */
+#pragma once
 
 #include <vector>
 #include <string>
 
 #include "Clarity_Component.h"
+#include "CPL_Bounds.h"
 
 #include "../../external/glm/glm.hpp"
 
@@ -45,10 +47,14 @@ public:
     MeshType meshType;
     std::vector<Vertex> vertices;
     std::vector<unsigned int> indices;
+    // The box around every vertex, used to cull the mesh
+    AABB bounds;
     unsigned int vbo;
     unsigned int vao;
     unsigned int ebo;
     std::string name;
+    // The script the mesh was loaded from
+    std::string filePath;
   };
 
   /*!
@@ -58,6 +64,43 @@ public:
   *    The filepath to the lua file being used to create the mesh
     */
   static MeshData *AddMeshDataToLibrary(const std::string &filePath);
+  /*!
+  *  Adds the meshdata of many lua files to the library, running the
+  *  scripts in parallel on the thread pool
+  *
+  *  \param filePaths
+  *    The filepaths to the lua files being used to create the meshes
+  *
+  *  \returns
+  *    The meshdata created for each filepath in the same order, nullptr
+  *    for any that failed
+    */
+  static std::vector<MeshData *> AddMeshesToLibrary(
+    const std::vector<std::string> &filePaths);
+  /*!
+  *  Reloads meshdata already in the library from new meshdata parsed off
+  *  the main thread, reusing the mesh's existing vertex array and buffers
+  *
+  *  \param filePath
+  *    The filepath of the lua file that was changed
+  *  \param reloaded
+  *    The parsed meshdata, its vertices and indices are swapped out
+  *
+  *  \returns
+  *    If the mesh was found and reloaded
+    */
+  static bool ReloadMeshData(const std::string &filePath
+                             , MeshData &reloaded);
+  /*!
+  *  Reads a mesh's lua source into the given mesh data without touching
+  *  the graphics context, safe to call on any thread
+  *
+  *  \returns
+  *    If the source was a valid mesh
+    */
+  static bool ParseMeshData(const std::string &filePath
+                            , const std::string &luaSource
+                            , MeshData &meshData);
   
   /*!
    *  One of the mesh CTOR.
@@ -80,8 +123,16 @@ private:
   Mesh(const Mesh &other) = delete;
   Mesh &operator=(const Mesh &other);
 
+  // Loads and parses a mesh's lua file, safe to call on any thread
+  static MeshData *LoadMeshData(const std::string &filePath);
+  // Creates the buffers of parsed mesh data and adds it to the library,
+  // must be called on the thread owning the graphics context
+  static MeshData *RegisterMeshData(const std::string &filePath
+                                    , MeshData *meshData);
   // Create a new mesh data instance
   static void CreateMeshData(MeshData &meshData);
+  // Upload changed vertices and indices into the existing buffers
+  static void UpdateMeshData(MeshData &meshData);
 };
 
 }
@@ -31,8 +31,20 @@ public:
   ~CGL_Shader();
 
   bool CompileShader();
+  /*!
+   *  Compiles the shader from already loaded source. If the shader has
+   *  been compiled before its shader object is reused.
+   *
+   *  \param shaderSource
+   *    The glsl source of the shader
+   *
+   *  \returns
+   *    If the shader compiled successfully
+   */
+  bool CompileShaderSource(const std::string &shaderSource);
   void DeleteShader();
   const unsigned int &GetShaderID();
+  const std::string &GetShaderPath();
 
 private:
   friend class CGL_Program;
@@ -52,8 +64,26 @@ public:
   ~CGL_Program();
 
   bool LinkProgram();
+  /*!
+   *  Recompiles one of the program's shaders from new source and links it
+   *  into a new program, which replaces the old one and its id only once
+   *  it links. If the shader fails to compile or the program fails to link
+   *  the previously linked program is left in use.
+   *
+   *  \param type
+   *    Which of the program's shaders is being replaced
+   *  \param shaderSource
+   *    The new glsl source of the shader
+   *
+   *  \returns
+   *    If the program was successfully relinked
+   */
+  bool ReloadShader(const CGL_Shader::SHADERTYPE &type
+                    , const std::string &shaderSource);
   void DeleteProgram();
   const unsigned int &GetProgramID();
+  const std::string &GetVertexPath();
+  const std::string &GetFragmentPath();
 
   const unsigned int &GetColorLocation();
   const unsigned int &GetPositionLocation();
@@ -61,13 +91,22 @@ public:
   const unsigned int &GetObjMatrixLocation();
   const unsigned int &GetViewMatrixLocation();
   const unsigned int &GetPerspectiveMatrixLocation();
+  const unsigned int &GetTextureLayerLocation();
 
   inline static const uint64_t PROGRAMERR = 50505050;
+  // Vertex inputs are bound to these before linking so hot reloads never
+  // move them out from under the mesh vertex arrays
+  inline static const unsigned int COLOR_LOCATION = 0u;
+  inline static const unsigned int POSITION_LOCATION = 1u;
+  inline static const unsigned int TEXTURE_LOCATION = 2u;
 private:
   CGL_Shader vertex, fragment;
   unsigned int programID;
-  unsigned int objMatrix = 0u, inColor = 0u, inPos = 0u, inTex = 0u
-  , viewMatrix = 0u, perspectiveMatrix = 0u;
+  bool LinkAttachedShaders();
+
+  unsigned int objMatrix = 0u, inColor = COLOR_LOCATION
+  , inPos = POSITION_LOCATION, inTex = TEXTURE_LOCATION, viewMatrix = 0u
+  , perspectiveMatrix = 0u, textureLayer = 0u;
 
   CGL_Program(const CGL_Program &other) = delete;
   CGL_Program &operator=(const CGL_Program &other) = delete;
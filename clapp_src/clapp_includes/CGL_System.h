@@ -13,7 +13,11 @@
 */
 #pragma once
 
+#include <vector>
+
 #include "CGL_Shader.h"
+#include "CGL_TextureArray.h"
+#include "CPL_AABBTree.h"
 #include "Clarity_System.h"
 
 namespace ClaPP
@@ -63,6 +67,13 @@ private:
   WindowContainer *windowData = nullptr;
 
   CGL_Program *defaultShader;
+  // Every loaded texture packed by size so draws only bind per array
+  TextureArrayBuilder textureArrays;
+  // The world bounds of every entity drawn, so only those the camera can
+  // see are drawn. Each proxy's user data is its entity's index in the
+  // frame's draw list.
+  AABBTree cullingTree;
+  EntityProxies cullingProxies;
 
   // Remove ability to duplicate system as it could potential lead to errors
   // and is an unintended feature
@@ -71,6 +82,11 @@ private:
 
   SYS_ERR InitOpenGL();
   SYS_ERR ProcessWindowHints();
+  /*!
+   *  Applies any asset reloads prepared by the file watcher. Called at the
+   *  start of the frame so only the GPU side swap happens on this thread.
+   */
+  void ApplyHotReloads();
 };
 
 }
@@ -10,8 +10,11 @@
  *    The interface file for the base class identity of what a texture
  *    is within the Clarity Graphics Library
  */
+#pragma once
+
 #include <string>
 #include <stdint.h>
+#include <vector>
 
 #include "Clarity_Component.h"
 
@@ -24,10 +27,23 @@ class Texture : public Component
 public:
   struct TextureData
   {
-    unsigned int textureID;
     std::string filePath;
     glm::vec3 tintColor;
     float alpha;
+    // Size of the top mip level, 0 until the image has been loaded
+    int width = 0;
+    int height = 0;
+    // One of TextureCooker::COOKED_FORMAT and every mip level in that
+    // format, largest first. Kept so the TextureArrayBuilder can fill the
+    // texture's layer without reading anything back from the driver
+    uint32_t format = 0;
+    std::vector<std::vector<unsigned char>> levels;
+    // Changes whenever the levels are replaced
+    uint32_t revision = 0;
+    // The texture array this texture was packed into and its layer, set
+    // by the TextureArrayBuilder. An arrayID of 0 means it is not packed
+    unsigned int arrayID = 0;
+    int layer = 0;
   };
 
   // NOTE: Currently only allows for single type for each texture 
@@ -44,9 +60,43 @@ public:
 
   const TextureData &GetTextureData();
 
+  /*!
+   *  Replaces the levels of a texture already in the library with those of
+   *  a newly decoded image. Entities using it keep their texture data and
+   *  see the new image once its layer is refilled.
+   *
+   *  \param _filePath
+   *    The filepath the texture was loaded from
+   *  \param levels
+   *    The mip chain of the new image, largest first, moved from
+   *  \param width
+   *    The width of the new image
+   *  \param height
+   *    The height of the new image
+   *  \param channels
+   *    The number of channels in the new image, 3 or 4
+   *
+   *  \returns
+   *    If the texture was found and replaced
+  */
+  static bool ReloadTextureData(const std::string &_filePath
+                                , std::vector<std::vector<unsigned char>>
+                                  &levels
+                                , const int &width, const int &height
+                                , const int &channels);
+
+  /*!
+   *  \returns
+   *    A counter that changes whenever any texture's image is loaded, used
+   *    to know when packed texture arrays are out of date
+  */
+  static uint32_t GetTextureRevision();
+
 private:
   TextureData *textureData;
 
+  inline static uint32_t textureRevision = 0u;
+
   /*!
    *  Checks if a texture exists within the library, overriding the 
    *  texture data
@@ -60,5 +110,14 @@ private:
   bool CheckTextureExists(const std::string &_filePath);
   void BindTexture(const std::string &_filePath);
   void UnbindTexture();
+  // Builds the mip chain of a decoded image into the texture's levels
+  static bool LoadDecodedImage(const unsigned char *imageData
+                               , const int &width, const int &height
+                               , const int &channels, TextureData &data);
+  // Copies every precomputed level of a cooked texture into the texture's
+  // levels without decoding or generating mipmaps
+  static bool LoadCookedTexture(const std::string &_filePath
+                                , const std::string &cookedData
+                                , TextureData &data);
 };
 }
@@ -0,0 +1,109 @@
+/*!
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    CGL_TextureArray.h
+ *
+ *  \brief
+ *    The interface file for packing the loaded textures into texture arrays
+ *    so differently textured entities can be drawn without rebinding
+ */
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include "CGL_Texture.h"
+
+namespace ClaPP
+{
+/*!
+ *  \class TextureArrayBuilder
+ *
+ *  \brief
+ *    Packs every texture in the TextureData library into GL_TEXTURE_2D_ARRAY
+ *    textures, one array per texture size and format.
+ *
+ *  Each packed texture has its arrayID and layer written back into its
+ *  TextureData so the renderer only binds when the array changes and picks
+ *  the texture with the layer uniform. Layers are filled straight from the
+ *  levels kept on each TextureData in their own format, so cooked mips are
+ *  kept as they were authored and block compressed textures stay
+ *  compressed. Textures are never uploaded anywhere else.
+ */
+class TextureArrayBuilder
+{
+public:
+  TextureArrayBuilder();
+  ~TextureArrayBuilder();
+
+  /*!
+   *  \returns
+   *    If a texture was loaded or reloaded since the arrays were last built
+   */
+  bool IsStale() const;
+
+  /*!
+   *  Packs every loaded texture into arrays. A texture whose image was
+   *  replaced only has its own layer refilled, and only the arrays of a
+   *  size and format whose textures were added or removed are rebuilt.
+   *  Must be called with the graphics context current.
+   */
+  void Build();
+
+  /*!
+   *  Deletes the built arrays and clears the packed ids of every texture
+   */
+  void Clear();
+
+  /*!
+   *  \returns
+   *    The number of texture arrays currently built
+   */
+  size_t GetArrayCount() const;
+
+private:
+  // Textures can only share an array if every one of their levels matches
+  struct ArrayKey
+  {
+    int width;
+    int height;
+    uint32_t format;
+    size_t levelCount;
+
+    bool operator<(const ArrayKey &other) const;
+  };
+
+  struct ArrayGroup
+  {
+    // Textures past the driver's layer limit spill into another array
+    std::vector<unsigned int> arrayIDs;
+    std::vector<Texture::TextureData *> textures;
+    // The revision of each texture when its layer was last filled
+    std::vector<uint32_t> revisions;
+  };
+
+  std::map<ArrayKey, ArrayGroup> groups;
+  int maxLayers;
+  // The texture revision the arrays were built from
+  uint32_t builtRevision;
+  bool isBuilt;
+
+  // Deletes a group's arrays and packs every one of its textures again
+  void RebuildGroup(const ArrayKey &key, ArrayGroup &group);
+  static void DeleteArrays(ArrayGroup &group);
+  // Makes a bound array with storage for every level of layerCount layers
+  static unsigned int AllocateArray(const ArrayKey &key
+                                    , const size_t &layerCount);
+  // Uploads every level of a texture into a layer of the bound array
+  static void FillLayer(const ArrayKey &key
+                        , const Texture::TextureData &data
+                        , const int &layer);
+
+  TextureArrayBuilder(const TextureArrayBuilder &other) = delete;
+  TextureArrayBuilder &operator=(const TextureArrayBuilder &other) = delete;
+};
+}
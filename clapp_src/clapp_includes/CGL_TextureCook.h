@@ -0,0 +1,187 @@
+/*!
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    CGL_TextureCook.h
+ *
+ *  \brief
+ *    The interface file for cooking textures offline into a GPU ready
+ *    format with every mip level precomputed
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ClaPP
+{
+/*!
+ *  \class TextureCooker
+ *
+ *  \brief
+ *    Cooks images into .ctex files and parses them back for uploading.
+ *
+ *  A cooked texture is laid out as:
+ *  - CookedTextureHeader
+ *  - CookedMipLevel for each mip level, largest first
+ *  - The data of each mip level, aligned to 4 bytes as GL expects by default
+ *
+ *  Raw formats are tightly packed rows ready for glTexImage2D and block
+ *  compressed formats are ready for glCompressedTexImage2D.
+ */
+class TextureCooker
+{
+public:
+  enum COOK_ERR
+  {
+    COOK_NO_ERR = 0
+    , COOK_FILE_NOT_FOUND
+    , COOK_FAILED_TO_DECODE
+    , COOK_UNSUPPORTED_CHANNELS
+    , COOK_FAILED_TO_WRITE
+    , COOK_INVALID_FORMAT
+  };
+
+  enum COOKED_FORMAT
+  {
+    COOKED_RGB8 = 0
+    , COOKED_RGBA8
+    // S3TC/DXT1, 4x4 blocks of 8 bytes, no alpha
+    , COOKED_BC1
+    // S3TC/DXT5, 4x4 blocks of 16 bytes with interpolated alpha
+    , COOKED_BC3
+  };
+
+  struct CookedTextureHeader
+  {
+    char magic[4];
+    uint32_t version;
+    uint32_t width;
+    uint32_t height;
+    uint32_t format;
+    uint32_t mipCount;
+  };
+
+  struct CookedMipLevel
+  {
+    uint32_t width;
+    uint32_t height;
+    // Offset from the start of the file
+    uint32_t dataOffset;
+    uint32_t dataSize;
+  };
+
+  /*!
+   *  A parsed view into a cooked texture's bytes. The level data points
+   *  into the buffer that was parsed so it must outlive this view.
+   */
+  struct CookedTexture
+  {
+    CookedTextureHeader header;
+    std::vector<CookedMipLevel> levels;
+    const unsigned char *data = nullptr;
+  };
+
+  inline static const char COOKED_MAGIC[4] = {'C', 'T', 'E', 'X'};
+  inline static const uint32_t COOKED_VERSION = 1u;
+  inline static const std::string COOKED_EXTENSION = ".ctex";
+
+  /*!
+   *  Decodes an image, builds its full mip chain with a box filter, and
+   *  writes it as a cooked texture.
+   *
+   *  \param sourcePath
+   *    The path to the source image (any format stb_image can decode)
+   *  \param cookedPath
+   *    The path of the cooked texture being written
+   *  \param blockCompress
+   *    If the levels should be stored as BC1 (rgb) or BC3 (rgba) blocks
+   *
+   *  \returns
+   *    A cook error result. Will return COOK_NO_ERR if none is found
+   */
+  static COOK_ERR CookTexture(const std::string &sourcePath
+                              , const std::string &cookedPath
+                              , const bool &blockCompress);
+
+  /*!
+   *  Builds the mip chain of an image, level 0 being the image itself.
+   *
+   *  \param pixels
+   *    The tightly packed pixels of the image
+   *  \param width
+   *    The width of the image
+   *  \param height
+   *    The height of the image
+   *  \param channels
+   *    The number of 8 bit channels in each pixel
+   *  \param levels
+   *    Overwritten with the pixels of each level, largest first
+   */
+  static void BuildMipChain(const unsigned char *pixels
+                            , const uint32_t &width, const uint32_t &height
+                            , const uint32_t &channels
+                            , std::vector<std::vector<unsigned char>> &levels);
+
+  /*!
+   *  Compresses an image into BC1 or BC3 blocks. Edge blocks of images
+   *  that are not a multiple of 4 are padded by clamping to the last pixel.
+   *
+   *  \param pixels
+   *    The tightly packed pixels of the image
+   *  \param width
+   *    The width of the image
+   *  \param height
+   *    The height of the image
+   *  \param channels
+   *    3 for BC1 or 4 for BC3
+   *  \param blocks
+   *    Overwritten with the compressed blocks
+   */
+  static void CompressBlocks(const unsigned char *pixels
+                             , const uint32_t &width, const uint32_t &height
+                             , const uint32_t &channels
+                             , std::vector<unsigned char> &blocks);
+
+  /*!
+   *  Finds the exact number of bytes a level of the given size takes.
+   *
+   *  \param format
+   *    One of the COOKED_FORMAT values
+   *
+   *  \returns
+   *    The size of the level's data, 0 for an unknown format
+   */
+  static uint64_t GetLevelDataSize(const uint32_t &format
+                                   , const uint32_t &width
+                                   , const uint32_t &height);
+
+  /*!
+   *  Validates and parses a cooked texture already loaded into memory.
+   *  Every level must lie within the file, halve in size from the last,
+   *  and hold exactly the data its size and format need.
+   *
+   *  \param fileData
+   *    The bytes of the cooked texture
+   *  \param texture
+   *    Updated with the header and levels pointing into fileData
+   *
+   *  \returns
+   *    A cook error result. Will return COOK_NO_ERR if none is found
+   */
+  static COOK_ERR ParseCookedTexture(const std::string &fileData
+                                     , CookedTexture &texture);
+
+  /*!
+   *  \returns
+   *    If the path has the cooked texture extension
+   */
+  static bool IsCookedTexturePath(const std::string &filePath);
+
+private:
+  TextureCooker() = delete;
+};
+}
@@ -0,0 +1,158 @@
+/*
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    CIL_InputTrace.h
+ *
+ *  \brief
+ *    An interface for recording the input of every frame to a file and
+ *    playing it back in place of the window
+*/
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "CIL_Inputs.h"
+
+namespace ClaPP
+{
+/*!
+ * \class InputTrace
+ *
+ * \brief
+ *  Records the actions triggered each frame along with the frame's delta
+ *  time, and plays a recording back so a session runs the same way every
+ *  time it is replayed.
+ *
+ *  A trace starts with the names of every registered action so a replay
+ *  resolves them to whatever ids the current build gives them. Each frame
+ *  is a flag byte and its delta, followed by the action bits only when they
+ *  changed from the frame before, so a held key costs 5 bytes a frame.
+ *  Values are written in the byte order of the machine that recorded them.
+ *
+ *  While replaying the real time of every frame is measured so the same
+ *  trace can be used to compare frame times between builds.
+ */
+class InputTrace
+{
+public:
+  enum TRACE_ERR
+  {
+    TRACE_NO_ERR = 0
+    , TRACE_ALREADY_ACTIVE
+    , TRACE_FAILED_TO_OPEN
+    , TRACE_INVALID_FILE
+  };
+
+  enum TRACE_MODE
+  {
+    TRACE_OFF = 0
+    , TRACE_RECORDING
+    , TRACE_REPLAYING
+  };
+
+  static InputTrace &GetInstance();
+
+  /*!
+   *  Starts writing every frame to a file, replacing it if it exists
+   *
+   *  \returns
+   *    A trace error result. Will return TRACE_NO_ERR if none is found
+   */
+  TRACE_ERR StartRecording(const std::string &tracePath);
+  /*!
+   *  Starts reading frames from a recorded file instead of the window
+   *
+   *  \returns
+   *    A trace error result. Will return TRACE_NO_ERR if none is found
+   */
+  TRACE_ERR StartReplay(const std::string &tracePath);
+  /*!
+   *  Finishes the recording or replay and reports how many frames it held,
+   *  along with the measured frame times of a replay
+   */
+  void Stop();
+
+  /*!
+   *  Starts a frame, should be called once at the start of every frame
+   *
+   *  \param deltaTime
+   *    The measured delta of the frame. Replaced by the recorded delta when
+   *    replaying.
+   *
+   *  \returns
+   *    False once a replay has run out of frames
+   */
+  bool BeginFrame(float &deltaTime);
+  /*!
+   *  Writes the frame begun last with the actions it triggered
+   */
+  void RecordFrame(const KeyBindContainer::ActionState &actions);
+  /*!
+   *  \returns
+   *    The actions the frame being replayed triggered
+   */
+  const KeyBindContainer::ActionState &GetFrameActions() const;
+
+  const TRACE_MODE &GetMode() const;
+  bool IsRecording() const;
+  bool IsReplaying() const;
+  uint64_t GetFrameCount() const;
+
+private:
+  struct TraceHeader
+  {
+    char magic[4];
+    uint32_t version;
+    uint32_t actionCount;
+    uint32_t padding;
+  };
+
+  enum FRAME_FLAGS : uint8_t
+  {
+    FRAME_ACTIONS_CHANGED = 1u << 0
+  };
+
+  inline static const char TRACE_MAGIC[4] = {'C', 'I', 'T', 'R'};
+  inline static const uint32_t TRACE_VERSION = 1u;
+
+  InputTrace();
+  ~InputTrace();
+
+  InputTrace(const InputTrace &other) = delete;
+  InputTrace &operator=(const InputTrace &other) = delete;
+
+  /*!
+   *  Writes the header and action names, left until the first frame so
+   *  every system has registered its actions
+   */
+  void WriteHeader();
+  bool ReadHeader();
+  // Converts recorded action bits to the ids of this build
+  KeyBindContainer::ActionState RemapActions(const uint64_t &bits) const;
+
+  TRACE_MODE mode;
+  std::string tracePath;
+  std::ofstream recordFile;
+  std::ifstream replayFile;
+  bool isHeaderWritten;
+
+  uint64_t frameCount;
+  float frameDelta;
+  // Recorded as written so unchanged frames can leave them out
+  uint64_t previousBits;
+  KeyBindContainer::ActionState frameActions;
+  // The current id of each recorded action in recorded order
+  std::vector<KeyBindContainer::ACTION_ID> actionRemap;
+
+  // Real frame times measured during a replay
+  double replayTime;
+  uint64_t timedFrames;
+  float slowestFrame;
+};
+}
@@ -12,14 +12,19 @@
  */
 #pragma once
 
+#include <array>
+#include <bitset>
+#include <cstdint>
 #include <map>
 #include <string>
-#include <unordered_set>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "Clarity_Component.h"
 #include "Clarity_Entity.h"
 #include "Clarity_IO.h"
+#include "Clarity_LuaConfig.h"
 
 namespace ClaPP
 {
@@ -86,9 +91,26 @@ public:
     , KEY_RIGHT_SHIFT //= 344
     , KEY_RIGHT_CONTROL
     , KEY_RIGHT_ALT
+    , KEY_MOUSE_LEFT //= 0 mouse button
+    , KEY_MOUSE_RIGHT
+    , KEY_MOUSE_MIDDLE
     , KEY_COUNT
   };
 
+  // One bit per key so the whole keyboard's state is a single word
+  typedef std::bitset<KEY_COUNT> KeyState;
+  static_assert(KEY_COUNT <= 64, "Key state must fit in one word");
+
+  // A press or release reported by the window between frames
+  struct KeyTransition
+  {
+    KEYS key = KEY_COUNT;
+    bool isPressed = false;
+  };
+
+  // The most transitions held between frames, far more than a frame sees
+  inline static const size_t TRANSITION_CAPACITY = 128u;
+
   enum KEY_STATUS
   {
     KEY_STATUS_NONE = 0
@@ -101,6 +123,13 @@ public:
 
   typedef std::string KEY_EVENT;
 
+  // Actions are named by their event but resolved to a dense id when
+  // registered so checking one each frame is a single bit test
+  typedef uint32_t ACTION_ID;
+  inline static const ACTION_ID MAX_ACTIONS = 64u;
+  inline static const ACTION_ID INVALID_ACTION = MAX_ACTIONS;
+  typedef std::bitset<MAX_ACTIONS> ActionState;
+
   /*!
    *  \struct KeyBind
    *
@@ -117,6 +146,7 @@ public:
     KEY_STATUS currentStatus = KEY_STATUS_NONE;
     KEY_STATUS triggerStatus;
     KEY_EVENT keyEvent;
+    ACTION_ID actionID = INVALID_ACTION;
   };
 
   static KeyBindContainer *GetInstance()
@@ -141,16 +171,67 @@ public:
     }
 
     // Bind the key to the new event trigger
+    const ACTION_ID actionID = RegisterAction(event);
     auto emplaced = keyBinds.try_emplace(key
                                          , KeyBind{ KEY_STATUS_NONE
-                                          , statusTrigger, event});
+                                          , statusTrigger, event, actionID});
 
     // Check if the bind properly emplaced and report if an error occured
     if(!emplaced.second)
     {
       ErrMessage("Failed to create bind for key: " + std::to_string(key)
                  , EC_INPUT);
+      return;
+    }
+    // Map nodes never move so the bind can be found by key directly
+    keyBindLookup[key] = &emplaced.first->second;
+  }
+
+  /*!
+   *  Binds every entry of the Binds table of a lua script, where each entry
+   *  is a table such as { key = Keys.W, status = KeyStatus.Down,
+   *  action = "MovePositiveY" }
+   *
+   *  \param luaPath
+   *    The path of the bind script
+   *
+   *  \returns
+   *    If the script was read, binds that fail to read are skipped
+   */
+  bool LoadBinds(const std::string &luaPath)
+  {
+    LuaConfig config;
+    size_t bindCount = 0;
+    if(config.LoadFile(luaPath) 
+       || config.GetLength("Binds", bindCount))
+    {
+      ErrMessage("Failed to load key binds from: " + luaPath, EC_INPUT);
+      return false;
     }
+
+    for(size_t i = 1; i <= bindCount; ++i)
+    {
+      const std::string bindPath = "Binds." + std::to_string(i);
+      int key = KEY_COUNT;
+      int status = KEY_STATUS_NONE;
+      KEY_EVENT action;
+
+      if(config.GetNumber(bindPath + ".key", key)
+         || config.GetNumber(bindPath + ".status", status)
+         || config.GetString(bindPath + ".action", action)
+         || key < 0 || key >= KEY_COUNT
+         || status < KEY_STATUS_NONE || status > KEY_STATUS_RELEASED)
+      {
+        ErrMessage("Skipping invalid key bind: " + bindPath + " in file: "
+                   + luaPath, EC_INPUT);
+        continue;
+      }
+
+      BindKey(static_cast<KEYS>(key), static_cast<KEY_STATUS>(status)
+              , action);
+    }
+
+    return true;
   }
 
   void UnbindKey(const KEYS &key)
@@ -169,9 +250,88 @@ public:
     // Delete the item
     // NOTE: May want to check this value but im not sure how best to do
     // that right now
+    keyBindLookup[key] = nullptr;
     keyBinds.erase(it);
   }
 
+  /*!
+   *  \returns
+   *    The bind of a key or nullptr if it is not bound
+   */
+  KeyBind *GetKeyBind(const KEYS &key)
+  {
+    return key < KEY_COUNT ? keyBindLookup[key] : nullptr;
+  }
+
+  /*!
+   *  Records a key changing state, called from the window's input
+   *  callbacks so no press is missed even when it is released again before
+   *  the next frame
+   */
+  void QueueKeyTransition(const KEYS &key, const bool &isPressed)
+  {
+    if(key >= KEY_COUNT)
+    {
+      return;
+    }
+    if(transitionCount == TRANSITION_CAPACITY)
+    {
+      ErrMessage("Too many key transitions in one frame, dropping key: "
+                 + std::to_string(key), EC_INPUT);
+      return;
+    }
+    transitions[(transitionHead + transitionCount) % TRANSITION_CAPACITY] 
+      = KeyTransition{ key, isPressed };
+    ++transitionCount;
+  }
+
+  /*!
+   *  Folds the transitions queued since the last call into the key states,
+   *  called once per frame by the input system. The cost is the number of
+   *  transitions, not the number of keys or binds.
+   */
+  void ApplyKeyTransitions()
+  {
+    pressedKeys.reset();
+    releasedKeys.reset();
+
+    for(; transitionCount > 0; --transitionCount)
+    {
+      const KeyTransition &transition = transitions[transitionHead];
+      transitionHead = (transitionHead + 1) % TRANSITION_CAPACITY;
+
+      // A key pressed and released in one frame is in both sets
+      if(transition.isPressed)
+      {
+        pressedKeys.set(transition.key);
+        downKeys.set(transition.key);
+      }
+      else
+      {
+        releasedKeys.set(transition.key);
+        downKeys.reset(transition.key);
+      }
+    }
+  }
+
+  // Keys currently held down
+  const KeyState &GetDownKeys() const
+  {
+    return downKeys;
+  }
+
+  // Keys pressed since the last frame
+  const KeyState &GetPressedKeys() const
+  {
+    return pressedKeys;
+  }
+
+  // Keys released since the last frame
+  const KeyState &GetReleasedKeys() const
+  {
+    return releasedKeys;
+  }
+
   std::map<KEYS, KeyBind>::iterator GetKeyBindBegin()
   {
     return keyBinds.begin();
@@ -187,25 +347,118 @@ public:
     return keyBinds;
   }
 
+  /*!
+   *  Gets the id of an action, giving it the next free id if it has none.
+   *  Systems should resolve the actions they check once when initialized.
+   *
+   *  \returns
+   *    The action's id or INVALID_ACTION if every id is taken
+   */
+  ACTION_ID RegisterAction(const KEY_EVENT &event)
+  {
+    std::unordered_map<KEY_EVENT, ACTION_ID>::iterator it 
+      = actionIDs.find(event);
+    if(it != actionIDs.end())
+    {
+      return it->second;
+    }
+
+    if(actionNames.size() >= MAX_ACTIONS)
+    {
+      ErrMessage("Too many actions registered, failed to add: " + event
+                 , EC_INPUT);
+      return INVALID_ACTION;
+    }
+
+    const ACTION_ID actionID = static_cast<ACTION_ID>(actionNames.size());
+    actionNames.push_back(event);
+    actionIDs.emplace(event, actionID);
+    return actionID;
+  }
+
+  /*!
+   *  \returns
+   *    The id of an action or INVALID_ACTION if it was never registered
+   */
+  ACTION_ID GetActionID(const KEY_EVENT &event) const
+  {
+    std::unordered_map<KEY_EVENT, ACTION_ID>::const_iterator it 
+      = actionIDs.find(event);
+    return it != actionIDs.end() ? it->second : INVALID_ACTION;
+  }
+
+  const KEY_EVENT &GetActionName(const ACTION_ID &actionID) const
+  {
+    return actionNames[actionID];
+  }
+
+  // Ids are dense so every id below the count is registered
+  ACTION_ID GetActionCount() const
+  {
+    return static_cast<ACTION_ID>(actionNames.size());
+  }
+
+  void TriggerAction(const ACTION_ID &actionID)
+  {
+    if(actionID < MAX_ACTIONS)
+    {
+      actionState.set(actionID);
+    }
+  }
+
+  bool CheckAction(const ACTION_ID &actionID) const
+  {
+    return actionID < MAX_ACTIONS && actionState.test(actionID);
+  }
+
+  /*!
+   *  \returns
+   *    Every action triggered this frame with one bit per action id
+   */
+  const ActionState &GetActionState() const
+  {
+    return actionState;
+  }
+
+  /*!
+   *  Replaces every action triggered this frame, used when the actions
+   *  come from a recording instead of the keys
+   */
+  void SetActionState(const ActionState &_actionState)
+  {
+    actionState = _actionState;
+  }
+
+  // NOTE: The string versions hash the name on every call, prefer the
+  // action id versions in anything run per frame
   void TriggerEvent(const KEY_EVENT &event)
   {
-    // Will not duplicate an insert if it exists
-    triggeredEvents.insert(event);
+    TriggerAction(GetActionID(event));
   }
 
   bool CheckEvent(const KEY_EVENT& event)
   {
-    return static_cast<bool>(triggeredEvents.count(event));
+    return CheckAction(GetActionID(event));
   }
 
   void ClearTriggeredEvents()
   {
-    triggeredEvents.clear();
+    actionState.reset();
   }
 
   static int ConvertToGLFWKey(const KEYS &key)
   {
-    if(key >= KEY_RIGHT_SHIFT)
+    // Mouse buttons convert to their glfw button rather than a key
+    if(key >= KEY_COUNT)
+    {
+      ErrMessage("Failed to convert key to GLFW Code", EC_INPUT);
+      return 0;
+    }
+    else if(key >= KEY_MOUSE_LEFT)
+    {
+      return static_cast<int>(key) - static_cast<int>(KEY_MOUSE_LEFT);
+    }
+    else if(key >= KEY_RIGHT_SHIFT)
     {
       return static_cast<int>(key) - static_cast<int>(KEY_RIGHT_SHIFT) + 344;
     }
@@ -236,11 +489,70 @@ public:
     }
   }
 
+  /*!
+   *  \returns
+   *    The key matching a glfw key code or KEY_COUNT for keys the engine
+   *    does not use
+   */
+  static KEYS ConvertFromGLFWKey(const int &glfwKey)
+  {
+    if(glfwKey == 32)
+    {
+      return KEY_SPACE;
+    }
+    else if(glfwKey >= 48 && glfwKey <= 57)
+    {
+      return static_cast<KEYS>(KEY_0 + (glfwKey - 48));
+    }
+    else if(glfwKey >= 65 && glfwKey <= 90)
+    {
+      return static_cast<KEYS>(KEY_A + (glfwKey - 65));
+    }
+    else if(glfwKey >= 290 && glfwKey <= 301)
+    {
+      return static_cast<KEYS>(KEY_F1 + (glfwKey - 290));
+    }
+    else if(glfwKey >= 340 && glfwKey <= 342)
+    {
+      return static_cast<KEYS>(KEY_LEFT_SHIFT + (glfwKey - 340));
+    }
+    else if(glfwKey >= 344 && glfwKey <= 346)
+    {
+      return static_cast<KEYS>(KEY_RIGHT_SHIFT + (glfwKey - 344));
+    }
+    return KEY_COUNT;
+  }
+
+  /*!
+   *  \returns
+   *    The key matching a glfw mouse button or KEY_COUNT for unused buttons
+   */
+  static KEYS ConvertFromGLFWMouseButton(const int &glfwButton)
+  {
+    if(glfwButton >= 0 && glfwButton <= KEY_MOUSE_MIDDLE - KEY_MOUSE_LEFT)
+    {
+      return static_cast<KEYS>(KEY_MOUSE_LEFT + glfwButton);
+    }
+    return KEY_COUNT;
+  }
+
 private:
   // TODO: Add an array of maps that bind keys based on game "states"
   // such as editor, menu, playing, spectator, ect.
   std::map<KEYS, KeyBind> keyBinds;
-  std::unordered_set<KEY_EVENT> triggeredEvents;
+  std::array<KeyBind *, KEY_COUNT> keyBindLookup = {};
+
+  // Transitions queued by the window callbacks, drained each frame
+  std::array<KeyTransition, TRANSITION_CAPACITY> transitions;
+  size_t transitionHead = 0u;
+  size_t transitionCount = 0u;
+  KeyState downKeys;
+  KeyState pressedKeys;
+  KeyState releasedKeys;
+  // Registered action names indexed by their id and the reverse lookup
+  std::vector<KEY_EVENT> actionNames;
+  std::unordered_map<KEY_EVENT, ACTION_ID> actionIDs;
+  ActionState actionState;
   // TODO: Keep track of input type somehow and which binds match
   // to which
 
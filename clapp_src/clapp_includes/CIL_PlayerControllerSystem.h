@@ -13,8 +13,12 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "Clarity_System.h"
+#include "CIL_Inputs.h"
+
+#include "../../external/glm/vec3.hpp"
 
 namespace ClaPP
 {
@@ -32,6 +36,15 @@ public:
   SYS_ERR Terminate();
 
 private:
+  // The force an action adds to every controlled entity while triggered
+  struct ActionForce
+  {
+    KeyBindContainer::ACTION_ID actionID;
+    glm::vec3 appliedForce;
+    glm::vec3 rotationForce;
+  };
 
+  // Resolved once when initialized so updates only test bits
+  std::vector<ActionForce> actionForces;
 };
 }
@@ -15,12 +15,18 @@
 #include <cstdint>
 
 #include "Clarity_System.h"
+#include "CIL_Inputs.h"
+
+typedef struct GLFWwindow GLFWwindow;
 
 namespace ClaPP
 {
 class Input_System : public Clarity_System
 {
 public:
+  inline static const std::string PLAYER_BINDS_PATH
+    = "../clapp_scripts/PlayerBinds.lua";
+
   Input_System(const std::string &_sysName);
   ~Input_System();
 
@@ -32,5 +38,13 @@ public:
   SYS_ERR Terminate();
 
 private:
+  // Queue key and mouse changes as glfw reports them
+  static void KeyCallback(GLFWwindow *window, int key, int scancode
+                          , int action, int mods);
+  static void MouseButtonCallback(GLFWwindow *window, int button, int action
+                                  , int mods);
+
+  // Keys that were down or changed last frame
+  KeyBindContainer::KeyState previousActiveKeys;
 };
 }
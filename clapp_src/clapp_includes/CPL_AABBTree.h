@@ -0,0 +1,422 @@
+/*
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    CPL_AABBTree.h
+ *
+ *  \brief
+ *    An interface for a bounding volume hierarchy that is kept up to date
+ *    as bodies move, used for collision pairs, queries, and culling
+*/
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "Clarity_Entity.h"
+#include "CPL_Bounds.h"
+#include "CPL_Broadphase.h"
+
+namespace ClaPP
+{
+/*!
+ * \class AABBTree
+ *
+ * \brief
+ *  A binary tree of boxes where each leaf is a proxy for one body and
+ *  every other node holds the box around its two children.
+ *
+ *  A proxy's box is grown past the body's by a margin and stretched along
+ *  the way it is moving, so most moves stay inside it and leave the tree
+ *  untouched. Only a body that leaves its box is taken out and put back.
+ *  Leaves are put where they grow the surface area of the tree the least,
+ *  and nodes are rotated on the way back up whenever one child is more
+ *  than a level taller than the other, so the tree stays balanced however
+ *  bodies are added.
+ *
+ *  Nodes live in one array and are linked by index, with freed nodes kept
+ *  in a list to be reused. A proxy is the index of its leaf and stays the
+ *  same until the proxy is destroyed.
+ *
+ *  Queries take a callback so they can run on whatever the caller keeps for
+ *  each proxy, and keep the nodes left to visit on the call stack.
+ */
+class AABBTree
+{
+public:
+  inline static const int32_t NULL_NODE = -1;
+  // How far past the body a proxy's box reaches on every side
+  inline static const float DEFAULT_MARGIN = 0.1f;
+  // How many times its displacement a proxy's box is stretched by
+  inline static const float DISPLACEMENT_MULTIPLIER = 4.f;
+
+  AABBTree(const float &_margin = DEFAULT_MARGIN);
+  ~AABBTree();
+
+  /*!
+   *  Adds a body to the tree
+   *
+   *  \param userData
+   *    Whatever the caller uses to know the body by, given back by queries
+   *
+   *  \returns
+   *    The proxy of the body, used to move and destroy it
+   */
+  int32_t CreateProxy(const AABB &bounds, const uint32_t &userData);
+  void DestroyProxy(const int32_t &proxy);
+  /*!
+   *  Moves a body's proxy to its new bounds
+   *
+   *  \param displacement
+   *    How far the body moved since it was last moved, the proxy's box is
+   *    stretched this way so it may hold the next few moves
+   *
+   *  \returns
+   *    If the proxy had to be put back into the tree
+   */
+  bool MoveProxy(const int32_t &proxy, const AABB &bounds
+                 , const glm::vec3 &displacement);
+  /*!
+   *  Destroys every proxy
+   */
+  void Clear();
+
+  const AABB &GetFatBounds(const int32_t &proxy) const;
+  const uint32_t &GetUserData(const int32_t &proxy) const;
+  void SetUserData(const int32_t &proxy, const uint32_t &userData);
+  const size_t &GetProxyCount() const;
+  /*!
+   *  \returns
+   *    The most nodes from the root to a leaf, not counting the root
+   */
+  int32_t GetHeight() const;
+  /*!
+   *  Checks every link, height, and box in the tree
+   *
+   *  \returns
+   *    If the tree is well formed
+   */
+  bool Validate() const;
+
+  /*!
+   *  Finds every proxy whose box overlaps the given bounds
+   *
+   *  \param callback
+   *    Called as bool(int32_t proxy) for each proxy found, stops the query
+   *    by returning false
+   */
+  template<typename Callback>
+  void Query(const AABB &bounds, Callback &&callback) const
+  {
+    NodeStack stack;
+    if(root != NULL_NODE)
+    {
+      stack.Push(root);
+    }
+
+    while(!stack.IsEmpty())
+    {
+      const int32_t index = stack.Pop();
+      const Node &node = nodes[index];
+      if(!node.bounds.Overlaps(bounds))
+      {
+        continue;
+      }
+      if(node.IsLeaf())
+      {
+        if(!callback(index))
+        {
+          return;
+        }
+        continue;
+      }
+      stack.Push(node.left);
+      stack.Push(node.right);
+    }
+  }
+
+  /*!
+   *  Finds every proxy whose box may be inside a frustum
+   *
+   *  \param callback
+   *    Called as bool(int32_t proxy) for each proxy found, stops the query
+   *    by returning false
+   */
+  template<typename Callback>
+  void QueryFrustum(const Frustum &frustum, Callback &&callback) const
+  {
+    NodeStack stack;
+    if(root != NULL_NODE)
+    {
+      stack.Push(root);
+    }
+
+    while(!stack.IsEmpty())
+    {
+      const int32_t index = stack.Pop();
+      const Node &node = nodes[index];
+      if(!frustum.Intersects(node.bounds))
+      {
+        continue;
+      }
+      if(node.IsLeaf())
+      {
+        if(!callback(index))
+        {
+          return;
+        }
+        continue;
+      }
+      stack.Push(node.left);
+      stack.Push(node.right);
+    }
+  }
+
+  /*!
+   *  Casts a ray through the tree, only visiting proxies whose box the ray
+   *  hits before the closest hit found so far
+   *
+   *  \param direction
+   *    The direction of the ray, must be normalized
+   *  \param callback
+   *    Called as float(int32_t proxy, float maxDistance) for each proxy
+   *    whose box is hit. Returns how far along the ray the body itself is
+   *    hit, which becomes the new max distance if it is closer, or a
+   *    negative value if the body is missed.
+   */
+  template<typename Callback>
+  void Raycast(const glm::vec3 &origin, const glm::vec3 &direction
+               , const float &maxDistance, Callback &&callback) const
+  {
+    NodeStack stack;
+    if(root != NULL_NODE)
+    {
+      stack.Push(root);
+    }
+
+    float closest = maxDistance;
+    while(!stack.IsEmpty())
+    {
+      const int32_t index = stack.Pop();
+      const Node &node = nodes[index];
+      float distance = 0.f;
+      if(!RaycastAABB(node.bounds, origin, direction, closest, distance))
+      {
+        continue;
+      }
+      if(node.IsLeaf())
+      {
+        const float hit = callback(index, closest);
+        if(hit >= 0.f && hit < closest)
+        {
+          closest = hit;
+        }
+        continue;
+      }
+      stack.Push(node.left);
+      stack.Push(node.right);
+    }
+  }
+
+  /*!
+   *  Finds every pair of overlapping bodies by querying the tree with
+   *  each body's bounds
+   *
+   *  \param bounds
+   *    The bounds of every body, the user data of each proxy must be the
+   *    index of its body's bounds
+   *  \param pairs
+   *    Cleared then filled with the overlapping pairs in order of their
+   *    first body
+   */
+  void FindPairs(const std::vector<AABB> &bounds
+                 , std::vector<CollisionPair> &pairs) const;
+  /*!
+   *  Finds the overlapping pairs whose first body is from begin up to but
+   *  not including end, adding them to the end of pairs in order of their
+   *  first body. Only reads the tree so ranges can be searched at once.
+   */
+  void FindPairs(const std::vector<AABB> &bounds, const uint32_t &begin
+                 , const uint32_t &end
+                 , std::vector<CollisionPair> &pairs) const;
+
+private:
+  struct Node
+  {
+    // Fattened for leaves, holds both children otherwise
+    AABB bounds;
+    // The next free node while the node is free
+    int32_t parent;
+    int32_t left;
+    int32_t right;
+    // Leaves are 0 and free nodes are -1
+    int32_t height;
+    uint32_t userData;
+
+    bool IsLeaf() const
+    {
+      return left == NULL_NODE;
+    }
+  };
+
+  /*!
+   *  The nodes a query has left to visit, kept on the call stack unless
+   *  the query goes deeper than a balanced tree would
+   */
+  class NodeStack
+  {
+  public:
+    void Push(const int32_t &node)
+    {
+      if(count < LOCAL_SIZE)
+      {
+        local[count] = node;
+      }
+      else
+      {
+        overflow.push_back(node);
+      }
+      ++count;
+    }
+
+    int32_t Pop()
+    {
+      --count;
+      if(count < LOCAL_SIZE)
+      {
+        return local[count];
+      }
+      const int32_t node = overflow.back();
+      overflow.pop_back();
+      return node;
+    }
+
+    bool IsEmpty() const
+    {
+      return count == 0u;
+    }
+
+  private:
+    inline static const size_t LOCAL_SIZE = 64u;
+
+    std::array<int32_t, LOCAL_SIZE> local;
+    std::vector<int32_t> overflow;
+    size_t count = 0u;
+  };
+
+  int32_t AllocateNode();
+  void FreeNode(const int32_t &node);
+
+  void InsertLeaf(const int32_t &leaf);
+  void RemoveLeaf(const int32_t &leaf);
+  /*!
+   *  Rotates a child up in place of the node if the node is unbalanced
+   *
+   *  \returns
+   *    The node now where the given node was
+   */
+  int32_t Balance(const int32_t &node);
+  /*!
+   *  Refits the box and height of every node from the given node up
+   */
+  void RefitAncestors(int32_t node);
+  bool ValidateNode(const int32_t &node, size_t &leafCount) const;
+
+  float margin;
+  std::vector<Node> nodes;
+  int32_t root;
+  int32_t freeList;
+  size_t proxyCount;
+};
+
+/*!
+ * \class TreeBroadphase
+ *
+ * \brief
+ *  Finds pairs by querying a tree with each body's bounds, best when
+ *  bodies are of very different sizes.
+ *
+ *  The tree is kept by its owner so it can be used for other queries as
+ *  well, and must hold a proxy for every body given to each update with
+ *  the index of the body's bounds as its user data.
+ *
+ *  Pairs are in order of their first body, each range of bodies is
+ *  searched on its own thread.
+ */
+class TreeBroadphase : public Broadphase
+{
+public:
+  TreeBroadphase(const AABBTree &_tree);
+  ~TreeBroadphase();
+
+  void Update(const std::vector<AABB> &bounds);
+  const std::vector<CollisionPair> &GetPairs() const;
+  const char *GetName() const;
+
+private:
+  const AABBTree &tree;
+  std::vector<CollisionPair> pairs;
+};
+
+/*!
+ * \class EntityProxies
+ *
+ * \brief
+ *  Keeps a proxy in a tree for each entity a system updates every frame.
+ *
+ *  Entities get a proxy the first frame they are updated in, and lose it
+ *  at the end of the first frame they are not.
+ */
+class EntityProxies
+{
+public:
+  EntityProxies(AABBTree &_tree);
+  ~EntityProxies();
+
+  /*!
+   *  Creates or moves the proxy of an entity
+   *
+   *  \param userData
+   *    Given back for the entity's proxy by the tree's queries
+   *
+   *  \returns
+   *    The entity's proxy
+   */
+  int32_t Update(const ENTITY_ID &entity, const AABB &bounds
+                 , const glm::vec3 &displacement, const uint32_t &userData);
+  /*!
+   *  Keeps the proxy of an entity that has not moved without touching the
+   *  tree, only changing its user data
+   *
+   *  \returns
+   *    If the entity has a proxy, it must be updated to get one if not
+   */
+  bool Keep(const ENTITY_ID &entity, const uint32_t &userData);
+  /*!
+   *  Destroys the proxy of every entity not updated since the last call
+   */
+  void EndFrame();
+  /*!
+   *  Destroys every proxy
+   */
+  void Clear();
+
+private:
+  struct EntityProxy
+  {
+    int32_t proxy;
+    // The frame the entity was last updated in
+    uint32_t frame;
+  };
+
+  AABBTree &tree;
+  std::unordered_map<ENTITY_ID, EntityProxy> proxies;
+  uint32_t frame;
+  size_t updatedCount;
+};
+}
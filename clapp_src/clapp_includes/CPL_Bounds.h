@@ -0,0 +1,169 @@
+/*
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    CPL_Bounds.h
+ *
+ *  \brief
+ *    The bounding volumes and pairs of bodies shared by every broadphase,
+ *    along with the ray and frustum tests run against them
+ */
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+// glm include for vec info
+#include "../../external/glm/vec3.hpp"
+#include "../../external/glm/vec4.hpp"
+#include "../../external/glm/mat3x3.hpp"
+#include "../../external/glm/mat4x4.hpp"
+#include "../../external/glm/common.hpp"
+
+namespace ClaPP
+{
+/*!
+ *  A box aligned to the world axes
+ */
+struct AABB
+{
+  glm::vec3 min = {0.f, 0.f, 0.f};
+  glm::vec3 max = {0.f, 0.f, 0.f};
+
+  /*!
+   *  \returns
+   *    If the boxes touch or overlap
+   */
+  bool Overlaps(const AABB &other) const
+  {
+    return min.x <= other.max.x && other.min.x <= max.x
+           && min.y <= other.max.y && other.min.y <= max.y
+           && min.z <= other.max.z && other.min.z <= max.z;
+  }
+
+  /*!
+   *  \returns
+   *    If the other box is entirely inside this one
+   */
+  bool Contains(const AABB &other) const
+  {
+    return min.x <= other.min.x && min.y <= other.min.y
+           && min.z <= other.min.z && other.max.x <= max.x
+           && other.max.y <= max.y && other.max.z <= max.z;
+  }
+
+  float GetSurfaceArea() const
+  {
+    const glm::vec3 size = max - min;
+    return 2.f * (size.x * size.y + size.y * size.z + size.z * size.x);
+  }
+
+  /*!
+   *  \returns
+   *    The smallest box holding both boxes
+   */
+  static AABB Merge(const AABB &lhs, const AABB &rhs)
+  {
+    return {glm::min(lhs.min, rhs.min), glm::max(lhs.max, rhs.max)};
+  }
+};
+
+/*!
+ *  A box turned to any orientation
+ */
+struct OrientedBox
+{
+  glm::vec3 center = {0.f, 0.f, 0.f};
+  // The box's local axes in world space, one per column
+  glm::mat3 axes = glm::mat3(1.f);
+  glm::vec3 halfExtents = {0.f, 0.f, 0.f};
+
+  /*!
+   *  \returns
+   *    The smallest box aligned to the world axes holding this box
+   */
+  AABB GetBounds() const;
+};
+
+/*!
+ *  A ball around a point
+ */
+struct Sphere
+{
+  glm::vec3 center = {0.f, 0.f, 0.f};
+  float radius = 0.f;
+
+  AABB GetBounds() const
+  {
+    return {center - radius, center + radius};
+  }
+};
+
+/*!
+ *  The space a camera can see, bounded by 6 planes
+ */
+struct Frustum
+{
+  // Each plane as its normal facing into the frustum and its distance
+  // from the origin, so a point is inside a plane when
+  // dot(normal, point) + distance is not below 0
+  std::array<glm::vec4, 6> planes;
+
+  /*!
+   *  Finds the planes of the frustum a projection times view matrix
+   *  renders
+   */
+  static Frustum FromMatrix(const glm::mat4 &viewProjection);
+
+  /*!
+   *  \returns
+   *    If any of the box may be inside the frustum. Boxes near a corner of
+   *    the frustum can be kept when they are just outside it.
+   */
+  bool Intersects(const AABB &bounds) const;
+};
+
+/*!
+ *  Two bodies whose bounds overlap, given by their index in the bounds
+ *  the broadphase was updated with with first always the lower index
+ */
+struct CollisionPair
+{
+  uint32_t first;
+  uint32_t second;
+
+  bool operator==(const CollisionPair &other) const
+  {
+    return first == other.first && second == other.second;
+  }
+  bool operator<(const CollisionPair &other) const
+  {
+    return first < other.first
+           || (first == other.first && second < other.second);
+  }
+};
+
+/*!
+ *  Casts a ray against a box
+ *
+ *  \param direction
+ *    The direction of the ray, must be normalized
+ *  \param distance
+ *    Set to how far along the ray it enters the box when it hits, 0 when
+ *    the ray starts inside the box
+ *
+ *  \returns
+ *    If the ray hits the box within maxDistance
+ */
+bool RaycastAABB(const AABB &bounds, const glm::vec3 &origin
+                 , const glm::vec3 &direction, const float &maxDistance
+                 , float &distance);
+bool RaycastBox(const OrientedBox &box, const glm::vec3 &origin
+                , const glm::vec3 &direction, const float &maxDistance
+                , float &distance);
+bool RaycastSphere(const Sphere &sphere, const glm::vec3 &origin
+                   , const glm::vec3 &direction, const float &maxDistance
+                   , float &distance);
+}
@@ -0,0 +1,95 @@
+/*
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    CPL_Broadphase.h
+ *
+ *  \brief
+ *    The interface shared by every way of finding which bodies may be
+ *    touching
+ */
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+#include "CPL_Bounds.h"
+
+namespace ClaPP
+{
+class ThreadPool;
+
+/*!
+ * \class Broadphase
+ *
+ * \brief
+ *  Finds the pairs of bodies whose bounds overlap, so only those pairs
+ *  are tested to see if they touch.
+ *
+ *  Bodies are known by the index of their bounds. Broadphases that keep
+ *  state between updates take bounds at the same index to be the same body
+ *  as the last update, and start over when the number of bodies changes.
+ *
+ *  Broadphases that search each body on its own split the search into
+ *  ranges run across a ThreadPool, the shared one unless another is set.
+ *  Each range finds its pairs into its own list and the lists are joined
+ *  in range order, so the pairs come out the same on any number of
+ *  threads.
+ */
+class Broadphase
+{
+public:
+  // How many bodies, or grid entries, each thread searches at a time
+  inline static const size_t PAIR_RANGE_SIZE = 256u;
+
+  Broadphase();
+  virtual ~Broadphase();
+
+  /*!
+   *  Finds every overlapping pair of the given bounds
+   */
+  virtual void Update(const std::vector<AABB> &bounds) = 0;
+  /*!
+   *  \returns
+   *    Every pair overlapping as of the last update, with first always the
+   *    lower index but in no set order
+   */
+  virtual const std::vector<CollisionPair> &GetPairs() const = 0;
+  virtual const char *GetName() const = 0;
+
+  void SetThreadPool(ThreadPool &_threadPool);
+  ThreadPool &GetThreadPool() const;
+
+protected:
+  /*!
+   *  The function run over each range of a search
+   *
+   *  \param begin
+   *    The first index of the range
+   *  \param end
+   *    One past the last index of the range
+   *  \param rangePairs
+   *    Empty at the start of the range, filled with the pairs it finds
+   */
+  typedef std::function<void(const size_t &begin, const size_t &end
+                             , std::vector<CollisionPair> &rangePairs)>
+    PairRangeFunction;
+
+  /*!
+   *  Runs a search over ranges of count indices across the thread pool
+   *  and adds the pairs of every range to the end of pairs in range order
+   */
+  void FindPairsInRanges(const size_t &count
+                         , const PairRangeFunction &function
+                         , std::vector<CollisionPair> &pairs);
+
+  ThreadPool *threadPool;
+
+private:
+  // The pairs each range found, kept so their memory is reused
+  std::vector<std::vector<CollisionPair>> rangePairs;
+};
+}
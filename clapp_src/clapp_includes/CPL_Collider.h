@@ -0,0 +1,75 @@
+/*
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    CPL_Collider.h
+ *
+ *  \brief
+ *    The interface file that holds the collision shape of a given entity
+ */
+#pragma once
+
+#include "Clarity_Component.h"
+
+// glm include for vec info
+#include "../../external/glm/vec3.hpp"
+
+namespace ClaPP
+{
+/*!
+ * \class Collider
+ *
+ * \brief
+ *  A box or sphere around an entity, given in the entity's local space so
+ *  it turns and scales with the entity's transform. Only entities that
+ *  also have physics with collisionOn set take part in collision.
+ *
+ *  Spheres are scaled by the largest axis of the entity's scale so they
+ *  stay round.
+ */
+class Collider : public Component
+{
+public:
+  enum SHAPE
+  {
+    SHAPE_BOX = 0
+    , SHAPE_SPHERE
+  };
+
+  struct ColliderData
+  {
+    SHAPE shape = SHAPE_BOX;
+    // Half the size of the box along each local axis before scaling, the
+    // default fits the unit cube mesh
+    glm::vec3 halfExtents = {0.5f, 0.5f, 0.5f};
+    // Only used by spheres, the default fits inside the unit cube mesh
+    float radius = 0.5f;
+    // The center of the box from the entity's position in local space
+    glm::vec3 offset = {0.f, 0.f, 0.f};
+  };
+
+  Collider()
+  : colliderData()
+  {
+
+  }
+  Collider(const ColliderData &_colliderData)
+  : colliderData(_colliderData)
+  {
+
+  }
+  ~Collider()
+  {
+
+  }
+
+  ColliderData &GetColliderData()
+  {
+    return colliderData;
+  }
+private:
+  ColliderData colliderData;
+};
+}
@@ -0,0 +1,168 @@
+/*
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    CPL_ContactSolver.h
+ *
+ *  \brief
+ *    An interface for pushing touching bodies apart by changing their
+ *    velocities and positions
+*/
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "CPL_Narrowphase.h"
+
+namespace ClaPP
+{
+/*!
+ * \class ContactSolver
+ *
+ * \brief
+ *  Solves every contact as a constraint on the speed its bodies meet at,
+ *  applying impulses over a number of iterations until they agree.
+ *
+ *  Bodies only move, they are not turned by contacts, so each manifold is
+ *  one constraint along its normal at its deepest point along with two
+ *  for friction along the surface. Bodies meeting fast bounce by their
+ *  restitution.
+ *
+ *  Bodies sunk into each other are moved apart a share of the way by a
+ *  separate pass over their positions. Pushing them apart through their
+ *  velocities would leave bodies resting on each other moving.
+ *
+ *  Constraints are kept in one flat array sized once for the step. They are
+ *  colored so no two constraints of a color share a body that moves, and
+ *  sorted into a batch per color. The constraints of a batch can then be
+ *  solved in any order or on any thread with the same result. Bodies that
+ *  never move are shared freely as they are never written.
+ */
+class ContactSolver
+{
+public:
+  inline static const int DEFAULT_ITERATIONS = 8;
+  inline static const int DEFAULT_POSITION_ITERATIONS = 3;
+  // The share of the overlap past the slop moved out each position
+  // iteration
+  inline static const float BAUMGARTE = 0.2f;
+  // The furthest bodies are moved apart each position iteration, so deep
+  // overlaps are not undone all at once
+  inline static const float MAX_CORRECTION = 0.2f;
+  // How deep bodies may sink into each other before they are pushed out,
+  // keeps resting bodies from jittering
+  inline static const float PENETRATION_SLOP = 0.01f;
+  // Bodies meeting slower than this do not bounce
+  inline static const float RESTITUTION_THRESHOLD = 1.f;
+  // One bit per color is kept for each body, constraints that can not be
+  // given a color under this go in one last batch
+  inline static const uint32_t MAX_COLORS = 64u;
+
+  /*!
+   *  Where the solver finds the bodies named by the manifolds, which are
+   *  known by the index of their shape
+   */
+  struct Bodies
+  {
+    // Each shape's body in the velocity arrays
+    const uint32_t *indices;
+    // The inverse mass, friction, and restitution of each shape's body,
+    // an inverse mass of 0 is never moved
+    const float *inverseMasses;
+    const float *frictions;
+    const float *restitutions;
+    // The velocity and position of every body along each axis, read and
+    // written
+    std::array<float *, 3> velocities;
+    std::array<float *, 3> positions;
+    size_t bodyCount;
+  };
+
+  ContactSolver();
+  ~ContactSolver();
+
+  /*!
+   *  Builds a constraint for each manifold and sorts them into batches
+   *
+   *  \param bodies
+   *    Must stay valid until the step's solving is done
+   */
+  void Prepare(const ContactBuffer &contacts, const Bodies &bodies);
+  /*!
+   *  Solves the velocities of every batch in order, iterations times over
+   */
+  void Solve(const int &iterations);
+  /*!
+   *  Moves bodies apart that are sunk into each other, going over every
+   *  batch in order iterations times. Run after the velocities are solved.
+   */
+  void CorrectPositions(const int &iterations);
+  /*!
+   *  Solves the velocities or corrects the positions of a range of the
+   *  constraints once. Constraints in one batch share no moving body, so
+   *  ranges of it can be run at once.
+   */
+  void SolveRange(const size_t &begin, const size_t &end);
+  void CorrectRange(const size_t &begin, const size_t &end);
+
+  const size_t &GetConstraintCount() const;
+  size_t GetBatchCount() const;
+  /*!
+   *  Gives the range of the constraints in a batch
+   */
+  void GetBatch(const size_t &batch, size_t &begin, size_t &end) const;
+  /*!
+   *  \returns
+   *    If the last batch holds constraints that could not be colored,
+   *    which share bodies and must be solved in order on one thread
+   */
+  const bool &HasOverflowBatch() const;
+
+private:
+  struct Constraint
+  {
+    uint32_t first;
+    uint32_t second;
+    float inverseMassFirst;
+    float inverseMassSecond;
+    // One over the sum of the inverse masses, the same for every direction
+    // when bodies do not turn
+    float effectiveMass;
+    glm::vec3 normal;
+    glm::vec3 tangent;
+    glm::vec3 bitangent;
+    // The speed the bodies should part at along the normal
+    float bias;
+    // How far apart the bodies are along the normal, less how far apart
+    // their centers were along it when prepared. Negative when sunk in.
+    float separation;
+    float friction;
+    // The impulse applied so far along each direction
+    float normalImpulse;
+    float tangentImpulse;
+    float bitangentImpulse;
+  };
+
+  void SolveConstraint(Constraint &constraint);
+  void CorrectConstraint(const Constraint &constraint);
+
+  // In order of color once prepared
+  std::vector<Constraint> constraints;
+  // Scratch space for sorting constraints by color
+  std::vector<Constraint> unsorted;
+  std::vector<uint32_t> colors;
+  // The colors used by the constraints of each body so far
+  std::vector<uint64_t> bodyColors;
+  // Where each batch starts in constraints, with the end after the last
+  std::vector<size_t> batchStarts;
+  std::array<float *, 3> velocities;
+  std::array<float *, 3> positions;
+  size_t constraintCount;
+  bool hasOverflowBatch;
+};
+}
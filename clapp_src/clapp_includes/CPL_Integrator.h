@@ -0,0 +1,190 @@
+/*
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    CPL_Integrator.h
+ *
+ *  \brief
+ *    An interface for moving batches of bodies through time by their
+ *    velocity and acceleration
+*/
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../../external/glm/vec3.hpp"
+#include "../../external/glm/gtc/quaternion.hpp"
+
+namespace ClaPP
+{
+/*!
+ * \class BodyBatch
+ *
+ * \brief
+ *  The positions, velocities, and accelerations of many bodies with each
+ *  axis of each value in its own contiguous array.
+ *
+ *  Keeping axes apart lets the integrators run one straight loop per axis
+ *  that the compiler turns into vector instructions, rather than loading
+ *  and storing a vec3 at a time. Orientations are kept the same way with
+ *  one array per quaternion component.
+ *
+ *  Only the first active count bodies are moved by the integrators, so
+ *  bodies that should be left alone, such as those asleep, are kept at the
+ *  end of the batch.
+ */
+class BodyBatch
+{
+public:
+  enum AXIS
+  {
+    AXIS_X = 0
+    , AXIS_Y
+    , AXIS_Z
+    , AXIS_COUNT
+  };
+
+  // The components of an orientation in the order glm stores them
+  enum QUAT_COMPONENT
+  {
+    QUAT_X = 0
+    , QUAT_Y
+    , QUAT_Z
+    , QUAT_W
+    , QUAT_COUNT
+  };
+
+  BodyBatch();
+  ~BodyBatch();
+
+  /*!
+   *  Resizes every array to hold count bodies, keeping the bodies that fit
+   */
+  void Resize(const size_t &count);
+  const size_t &GetCount() const;
+  /*!
+   *  Sets how many bodies from the first the integrators move, Resize sets
+   *  it to every body
+   */
+  void SetActiveCount(const size_t &_activeCount);
+  const size_t &GetActiveCount() const;
+
+  /*!
+   *  Sets every value of a body
+   *
+   *  \param previousPosition
+   *    Where the body was a step ago, Verlet moves a body by how far it
+   *    moved since then
+   *  \param acceleration
+   *    The acceleration held through every step until it is set again
+   */
+  void SetBody(const size_t &index, const glm::vec3 &position
+               , const glm::vec3 &previousPosition
+               , const glm::vec3 &velocity, const glm::vec3 &acceleration);
+
+  /*!
+   *  Sets the orientation of a body
+   *
+   *  \param angularVelocity
+   *    The turn rate in radians a second about each world axis, held
+   *    through every step until it is set again
+   */
+  void SetOrientation(const size_t &index, const glm::quat &orientation
+                      , const glm::vec3 &angularVelocity);
+
+  glm::vec3 GetPosition(const size_t &index) const;
+  glm::vec3 GetPreviousPosition(const size_t &index) const;
+  glm::vec3 GetVelocity(const size_t &index) const;
+  glm::quat GetOrientation(const size_t &index) const;
+  glm::quat GetPreviousOrientation(const size_t &index) const;
+
+  float *GetPositions(const AXIS &axis);
+  float *GetPreviousPositions(const AXIS &axis);
+  float *GetVelocities(const AXIS &axis);
+  float *GetAccelerations(const AXIS &axis);
+  float *GetOrientations(const QUAT_COMPONENT &component);
+  float *GetPreviousOrientations(const QUAT_COMPONENT &component);
+  float *GetAngularVelocities(const AXIS &axis);
+
+private:
+  typedef std::array<std::vector<float>, AXIS_COUNT> AxisArrays;
+  typedef std::array<std::vector<float>, QUAT_COUNT> QuatArrays;
+
+  AxisArrays positions;
+  AxisArrays previousPositions;
+  AxisArrays velocities;
+  AxisArrays accelerations;
+  QuatArrays orientations;
+  QuatArrays previousOrientations;
+  AxisArrays angularVelocities;
+  size_t count;
+  size_t activeCount;
+};
+
+/*!
+ * \class Integrator
+ *
+ * \brief
+ *  Steps the active bodies of a batch forward at once.
+ *
+ *  Drag slows each axis in proportion to its speed. Both integrators keep
+ *  where each body was before the step so it can be blended for rendering.
+ *  Orientations are turned by their angular velocity the same way for
+ *  either integrator.
+ *
+ *  Every body is stepped on its own, so the active bodies can be split
+ *  into ranges stepped at once on different threads with the same result.
+ */
+class Integrator
+{
+public:
+  // The end of a range that runs to the batch's active count
+  inline static const size_t ALL_BODIES = SIZE_MAX;
+
+  enum INTEGRATOR
+  {
+    // Updates velocity first then moves by the new velocity, which keeps
+    // orbits and springs from gaining energy the way explicit Euler does
+    INTEGRATOR_SEMI_IMPLICIT_EULER = 0
+    // Moves by the distance moved last step, more accurate for constant
+    // forces but velocity is only known after the step
+    , INTEGRATOR_VERLET
+  };
+
+  /*!
+   *  Advances the active bodies from begin up to end by one step, every
+   *  active body by default
+   *
+   *  \param drag
+   *    How much of each axis of velocity is lost per second
+   *  \param timeStep
+   *    The time in seconds to advance by, should be the same every step
+   *    for Verlet
+   */
+  static void Integrate(BodyBatch &batch, const INTEGRATOR &integrator
+                        , const glm::vec3 &drag, const float &timeStep
+                        , const size_t &begin = 0u
+                        , const size_t &end = ALL_BODIES);
+
+  static void SemiImplicitEuler(BodyBatch &batch, const glm::vec3 &drag
+                                , const float &timeStep
+                                , const size_t &begin = 0u
+                                , const size_t &end = ALL_BODIES);
+  static void Verlet(BodyBatch &batch, const glm::vec3 &drag
+                     , const float &timeStep, const size_t &begin = 0u
+                     , const size_t &end = ALL_BODIES);
+  /*!
+   *  Turns every orientation by its angular velocity, adding the
+   *  quaternion derivative and renormalizing rather than building a
+   *  rotation from an axis and angle
+   */
+  static void IntegrateOrientations(BodyBatch &batch, const float &timeStep
+                                    , const size_t &begin = 0u
+                                    , const size_t &end = ALL_BODIES);
+};
+}
@@ -0,0 +1,79 @@
+/*
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    CPL_Islands.h
+ *
+ *  \brief
+ *    An interface for grouping bodies that touch, directly or through
+ *    other bodies, into islands
+*/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ClaPP
+{
+/*!
+ * \class Islands
+ *
+ * \brief
+ *  Groups bodies into islands by the contacts linking them, so a group of
+ *  bodies resting on each other can be put to sleep or woken as one.
+ *
+ *  Bodies are kept in a disjoint set forest. Linking two bodies joins the
+ *  smaller tree under the larger, and finding a body's root halves the
+ *  path to it on the way, so both cost next to nothing however many bodies
+ *  there are. Bodies that never move should not be linked, or everything
+ *  resting on the ground would be one island.
+ */
+class Islands
+{
+public:
+  Islands();
+  ~Islands();
+
+  /*!
+   *  Puts every one of bodyCount bodies in an island of its own
+   */
+  void Reset(const size_t &bodyCount);
+  /*!
+   *  Joins the islands of two bodies
+   */
+  void Link(const uint32_t &first, const uint32_t &second);
+  /*!
+   *  \returns
+   *    The body every body of the same island finds, which changes as
+   *    islands are linked
+   */
+  uint32_t FindRoot(const uint32_t &body);
+  /*!
+   *  Numbers the islands from 0 in order of their lowest body, so the
+   *  numbers only depend on the links and not the order they were made in
+   *
+   *  \returns
+   *    How many islands there are
+   */
+  size_t Label();
+
+  /*!
+   *  \returns
+   *    The number of a body's island as of the last label
+   */
+  const uint32_t &GetIsland(const uint32_t &body) const;
+  const size_t &GetIslandCount() const;
+
+private:
+  std::vector<uint32_t> parents;
+  // How many bodies are under each root
+  std::vector<uint32_t> sizes;
+  // The island of each root while labeling
+  std::vector<uint32_t> rootIslands;
+  std::vector<uint32_t> islands;
+  size_t islandCount;
+};
+}
@@ -0,0 +1,154 @@
+/*
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    CPL_Narrowphase.h
+ *
+ *  \brief
+ *    An interface for finding where the pairs of bodies the broadphase
+ *    found actually touch
+*/
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "CPL_Bounds.h"
+#include "CPL_Collider.h"
+
+namespace ClaPP
+{
+/*!
+ *  Where two bodies touch, as up to MAX_POINTS points sharing one normal
+ */
+struct ContactManifold
+{
+  inline static const uint32_t MAX_POINTS = 4u;
+
+  // The index of each body's shape as given to the narrowphase
+  uint32_t first = 0u;
+  uint32_t second = 0u;
+  // Points from the first body toward the second
+  glm::vec3 normal = {0.f, 1.f, 0.f};
+  uint32_t pointCount = 0u;
+  // Where the bodies touch in world space, midway between their surfaces
+  std::array<glm::vec3, MAX_POINTS> points;
+  // How deep the bodies overlap along the normal at each point
+  std::array<float, MAX_POINTS> penetrations;
+
+  float GetMaxPenetration() const;
+};
+
+/*!
+ * \class ContactBuffer
+ *
+ * \brief
+ *  Holds the manifolds found in a step in one array allocated up front.
+ *
+ *  Manifolds are copied into the array rather than allocated one by one,
+ *  and the array only grows when asked to. Manifolds that do not fit are
+ *  dropped and counted, so a buffer that is too small is noticed rather
+ *  than allocating in the middle of a step.
+ */
+class ContactBuffer
+{
+public:
+  ContactBuffer(const size_t &capacity = 0u);
+  ~ContactBuffer();
+
+  /*!
+   *  Makes room for at least capacity manifolds, keeping those already
+   *  added. The only call that allocates.
+   */
+  void Reserve(const size_t &capacity);
+  /*!
+   *  Removes every manifold and resets the dropped count
+   */
+  void Clear();
+  /*!
+   *  Copies a manifold into the buffer
+   *
+   *  \returns
+   *    If there was room for the manifold
+   */
+  bool Push(const ContactManifold &manifold);
+
+  const ContactManifold &operator[](const size_t &index) const;
+  const size_t &GetCount() const;
+  size_t GetCapacity() const;
+  /*!
+   *  \returns
+   *    How many manifolds did not fit since the buffer was last cleared
+   */
+  const size_t &GetDroppedCount() const;
+
+private:
+  std::vector<ContactManifold> manifolds;
+  size_t count;
+  size_t droppedCount;
+};
+
+/*!
+ * \class Narrowphase
+ *
+ * \brief
+ *  Tests pairs of shapes against each other, filling in where they touch.
+ *
+ *  Boxes are tested against boxes by the separating axis test over their
+ *  15 possible axes. When the least overlap is along a face the touching
+ *  face of the other box is clipped to the face's sides, giving up to 4
+ *  points so a box rests flat on another. When it is along two edges the
+ *  closest points of the edges give one point.
+ */
+class Narrowphase
+{
+public:
+  /*!
+   *  The shape of every body in the order of the bounds given to the
+   *  broadphase. Only the box or the sphere of each body is read, going by
+   *  its type.
+   */
+  struct Shapes
+  {
+    const Collider::SHAPE *types;
+    const OrientedBox *boxes;
+    const Sphere *spheres;
+  };
+
+  /*!
+   *  Tests every pair, clearing the contacts first and adding a manifold
+   *  for each pair that touches
+   */
+  static void Collide(const Shapes &shapes
+                      , const std::vector<CollisionPair> &pairs
+                      , ContactBuffer &contacts);
+  /*!
+   *  Tests one pair, touching nothing else so pairs can be tested at once
+   *  on different threads
+   *
+   *  \returns
+   *    If the pair touches, with the manifold filled in for the pair
+   */
+  static bool CollidePair(const Shapes &shapes, const CollisionPair &pair
+                          , ContactManifold &manifold);
+
+  /*!
+   *  Each test below fills in the normal, points, and penetrations of the
+   *  manifold, with the normal from the first shape given to the second
+   *
+   *  \returns
+   *    If the shapes touch, the manifold is left as it was when they do
+   *    not
+   */
+  static bool SphereSphere(const Sphere &first, const Sphere &second
+                           , ContactManifold &manifold);
+  static bool SphereBox(const Sphere &sphere, const OrientedBox &box
+                        , ContactManifold &manifold);
+  static bool BoxBox(const OrientedBox &first, const OrientedBox &second
+                     , ContactManifold &manifold);
+};
+}
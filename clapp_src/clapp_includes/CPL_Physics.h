@@ -36,10 +36,24 @@ public:
     // Character Details
     float speed = 0.05f;
     // Collision properties
-    
+    // A mass of 0 is never moved by collisions, for the ground and walls
+    float mass = 1.f;
+    // How much of the speed two bodies meet at is kept as they bounce apart
+    float restitution = 0.f;
+    // How hard bodies are to slide along each other
+    float friction = 0.5f;
+
     // Simple bools
     bool gravityOn = true;
     bool collisionOn = true;
+    // Lets the body stop being simulated once it comes to rest
+    bool sleepOn = true;
+
+    // Sleep state, kept by the physics system
+    // Asleep bodies are not moved until something wakes them
+    bool isAsleep = false;
+    // How long the body has been nearly still for
+    float restTime = 0.f;
   };
 
   Physics()
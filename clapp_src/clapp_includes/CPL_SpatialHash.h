@@ -0,0 +1,139 @@
+/*
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    CPL_SpatialHash.h
+ *
+ *  \brief
+ *    An interface for finding which bodies may be touching by dropping
+ *    their bounds into a uniform grid
+*/
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "CPL_Bounds.h"
+#include "CPL_Broadphase.h"
+
+namespace ClaPP
+{
+/*!
+ * \class SpatialHash
+ *
+ * \brief
+ *  Finds every pair of overlapping bounds by the grid cells they share.
+ *
+ *  Rather than keeping a bucket per cell, each body writes one entry per
+ *  cell it covers holding the cell's key and the body's index. The entries
+ *  are radix sorted by key so bodies in the same cell end up next to each
+ *  other, and pairs are found by scanning each run of equal keys. Keys are
+ *  cell coordinates from the corner of the bounds packed into as few bits
+ *  as the grid needs, so no two cells share a key and the sort only runs a
+ *  pass for each byte a key uses.
+ *
+ *  The grid is rebuilt every update into arrays that keep their memory, so
+ *  moving bodies cost the same as still ones and nothing is allocated once
+ *  the arrays have grown. A pair is only reported from the lowest cell both
+ *  bodies cover so it is never reported twice.
+ *
+ *  Bounds covering more than MAX_CELLS_PER_BODY cells are left out of the
+ *  grid and tested against every other body instead, the cell size should
+ *  be set near the size of the common bodies.
+ *
+ *  The runs and the oversized bodies are both searched a range at a time
+ *  across the thread pool, the pairs still come out in the order one
+ *  thread would find them.
+ */
+class SpatialHash : public Broadphase
+{
+public:
+  inline static const size_t MAX_CELLS_PER_BODY = 64u;
+
+  SpatialHash(const float &_cellSize = 2.f);
+  ~SpatialHash();
+
+  void SetCellSize(const float &_cellSize);
+  const float &GetCellSize() const;
+
+  /*!
+   *  Rebuilds the grid and finds every overlapping pair
+   *
+   *  \param bounds
+   *    The bounds of every body, a body is known by its index
+   */
+  void Update(const std::vector<AABB> &bounds);
+  /*!
+   *  \returns
+   *    The pairs found by the last update, ordered by the cell they were
+   *    found in
+   */
+  const std::vector<CollisionPair> &GetPairs() const;
+  const char *GetName() const;
+
+private:
+  struct CellEntry
+  {
+    uint64_t key;
+    uint32_t body;
+  };
+
+  // The most cells the grid holds along an axis, keeping a key in 64 bits
+  inline static const int64_t MAX_AXIS_CELLS = int64_t(1) << 21;
+  // Each sort pass orders the keys by this many bits, a cell grid up to
+  // 128 cells a side takes 2 passes
+  inline static const unsigned RADIX_BITS = 11u;
+  inline static const uint32_t RADIX_SIZE = 1u << RADIX_BITS;
+  inline static const uint64_t RADIX_MASK = RADIX_SIZE - 1u;
+
+  /*!
+   *  Sets the corner and packing of the grid from the bounds of every body
+   *
+   *  \returns
+   *    The number of bits a key uses
+   */
+  unsigned FitGrid(const std::vector<AABB> &bounds);
+  /*!
+   *  \returns
+   *    The cell a world coordinate is in along an axis, counted from the
+   *    grid's corner
+   */
+  uint32_t ToCell(const float &value, const int &axis) const;
+  uint64_t PackCell(const uint32_t &x, const uint32_t &y
+                    , const uint32_t &z) const;
+  /*!
+   *  \returns
+   *    The key of the lowest cell both bounds cover
+   */
+  uint64_t SharedCellKey(const AABB &first, const AABB &second) const;
+
+  void SortEntries(const unsigned &keyBits);
+  void FindGridPairs(const std::vector<AABB> &bounds);
+  /*!
+   *  Finds the pairs of every run of equal keys starting from begin up to
+   *  but not including end, a run may carry on past end
+   */
+  void FindRunPairs(const std::vector<AABB> &bounds, const size_t &begin
+                    , const size_t &end
+                    , std::vector<CollisionPair> &rangePairs) const;
+  void FindOversizedPairs(const std::vector<AABB> &bounds);
+
+  float cellSize;
+  float inverseCellSize;
+
+  std::array<int64_t, 3> gridCorner;
+  std::array<unsigned, 3> axisShift;
+
+  std::vector<CellEntry> entries;
+  // Where a sort pass scatters entries to before the two are swapped
+  std::vector<CellEntry> sortScratch;
+  // The entries holding each digit for every pass of the sort
+  std::vector<uint32_t> digitCounts;
+  std::vector<uint32_t> oversizedBodies;
+  std::vector<CollisionPair> pairs;
+};
+}
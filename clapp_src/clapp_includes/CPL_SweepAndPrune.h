@@ -0,0 +1,117 @@
+/*
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    CPL_SweepAndPrune.h
+ *
+ *  \brief
+ *    An interface for finding which bodies may be touching from the order
+ *    of their bounds along each axis, kept sorted between updates
+*/
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "CPL_Bounds.h"
+#include "CPL_Broadphase.h"
+
+namespace ClaPP
+{
+/*!
+ * \class SweepAndPrune
+ *
+ * \brief
+ *  Keeps the ends of every body's bounds sorted along each axis and the
+ *  pairs that overlap, changing them only as bodies move past each other.
+ *
+ *  Each update the ends are given their new values and insertion sorted
+ *  in place. Bodies rarely move far between steps so the ends are already
+ *  nearly in order and the sort costs little more than one pass. Every
+ *  swap of two ends is a body starting or stopping overlapping another
+ *  along that axis, so pairs are added and removed right there rather than
+ *  found again from nothing.
+ *
+ *  The pairs added and removed by an update are kept so whatever uses the
+ *  pairs can follow the changes alone. When the number of bodies changes
+ *  the ends are sorted from scratch and every old pair is reported removed.
+ *  Bodies teleporting or all moving at once cost far more than they do in
+ *  the other broadphases.
+ */
+class SweepAndPrune : public Broadphase
+{
+public:
+  SweepAndPrune();
+  ~SweepAndPrune();
+
+  void Update(const std::vector<AABB> &bounds);
+  const std::vector<CollisionPair> &GetPairs() const;
+  const char *GetName() const;
+
+  /*!
+   *  \returns
+   *    The pairs that started overlapping in the last update
+   */
+  const std::vector<CollisionPair> &GetAddedPairs() const;
+  /*!
+   *  \returns
+   *    The pairs that stopped overlapping in the last update
+   */
+  const std::vector<CollisionPair> &GetRemovedPairs() const;
+
+  /*!
+   *  \returns
+   *    How many times ends were swapped in the last update, shows how
+   *    coherent a scene is
+   */
+  const size_t &GetSwapCount() const;
+
+private:
+  struct Endpoint
+  {
+    float value;
+    // The body's index shifted up one, with the low bit set for the end
+    // of the body's bounds
+    uint32_t bodyAndEnd;
+
+    uint32_t GetBody() const
+    {
+      return bodyAndEnd >> 1u;
+    }
+    bool IsMax() const
+    {
+      return (bodyAndEnd & 1u) != 0u;
+    }
+  };
+
+  /*!
+   *  \returns
+   *    If the first end belongs before the second, starts are put before
+   *    ends of the same value so touching bounds count as overlapping
+   */
+  static bool IsBefore(const Endpoint &first, const Endpoint &second);
+  static uint64_t PairKey(const uint32_t &first, const uint32_t &second);
+
+  /*!
+   *  Sorts every axis from scratch and finds every pair with a sweep
+   */
+  void Rebuild(const std::vector<AABB> &bounds);
+  void SortAxis(const int &axis, const std::vector<AABB> &bounds);
+  void AddPair(const uint32_t &first, const uint32_t &second);
+  void RemovePair(const uint32_t &first, const uint32_t &second);
+
+  std::array<std::vector<Endpoint>, 3> axes;
+  std::vector<CollisionPair> pairs;
+  // Where each pair is in pairs so it can be removed without a search
+  std::unordered_map<uint64_t, uint32_t> pairIndices;
+  std::vector<CollisionPair> addedPairs;
+  std::vector<CollisionPair> removedPairs;
+  size_t bodyCount;
+  size_t swapCount;
+};
+}
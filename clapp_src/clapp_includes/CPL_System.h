@@ -11,7 +11,21 @@
  */
 #pragma once
 
+#include <array>
+#include <utility>
+#include <vector>
+
 #include "Clarity_System.h"
+#include "Clarity_Entity.h"
+#include "CPL_AABBTree.h"
+#include "CPL_Bounds.h"
+#include "CPL_Collider.h"
+#include "CPL_ContactSolver.h"
+#include "CPL_Integrator.h"
+#include "CPL_Islands.h"
+#include "CPL_Narrowphase.h"
+#include "CPL_SpatialHash.h"
+#include "CPL_SweepAndPrune.h"
 
 
 // glm include for vec info
@@ -23,9 +37,91 @@
 
 namespace ClaPP
 {
+class Physics;
+class ThreadPool;
+class Transform;
+
+/*!
+ * \class CPL_System
+ *
+ * \brief
+ *  Steps physics at a fixed rate no matter how fast frames are rendered.
+ *
+ *  Frame time is added to an accumulator and whole steps are taken out of
+ *  it, at most MAX_SUBSTEPS a frame so a slow frame can not cause ever
+ *  more steps the frame after. Whatever time is left over is used to blend
+ *  each entity's world matrix between its last two steps.
+ *
+ *  Applied forces are accelerations held for every step of the frame they
+ *  were applied in, and rotation forces are turn rates in degrees a second
+ *  about each world axis.
+ *
+ *  Bodies are copied into a BodyBatch at the start of a frame and every
+ *  step integrates the whole batch at once, the results are only written
+ *  back to the components once the frame's steps are done.
+ *
+ *  Bodies with a collider and collisionOn set have their world bounds
+ *  found after every step and given to the broadphase, giving the pairs of
+ *  entities that may be touching. The bounds are also kept in an AABB tree
+ *  every step whichever broadphase is used, so rays and overlaps can be
+ *  tested against the colliders at any time.
+ *
+ *  The narrowphase then finds where each pair touches and the contact
+ *  solver changes the velocities of the touching bodies so they part. The
+ *  new velocities move the bodies apart the next step.
+ *
+ *  Bodies touching each other are grouped into islands at the end of a
+ *  frame. Once every body of an island has moved slower than SLEEP_SPEED
+ *  for SLEEP_TIME the island falls asleep. Sleeping bodies are kept at the
+ *  end of the batch and are not integrated, their bounds and world
+ *  matrices are not rebuilt, and they act as bodies that never move to
+ *  those touching them. A body is woken the next frame when it is pushed,
+ *  turned, given a velocity, or moved, or when an awake body runs into it.
+ *
+ *  Integration, finding bounds, finding pairs, the narrowphase, solving,
+ *  and writing back are split into ranges run across a ThreadPool, the
+ *  shared one unless another is set. Each range only writes its own
+ *  bodies, pairs, or constraints, and pairs and contacts are joined in
+ *  range order, so a step comes out the same on any number of threads.
+ *  Contacts are solved a batch at a time as the constraints of a batch
+ *  share no body that moves. Updating the tree, sorting the spatial hash,
+ *  the sweep and prune, coloring contacts, and sleeping stay on the
+ *  calling thread.
+ */
 class CPL_System : public Clarity_System
 {
 public:
+  inline static const float FIXED_TIME_STEP = 1.f / 60.f;
+  inline static const int MAX_SUBSTEPS = 5;
+  // Bodies slower than this, in units a second, are resting
+  inline static const float SLEEP_SPEED = 0.05f;
+  // How long every body of an island must rest before it falls asleep
+  inline static const float SLEEP_TIME = 0.5f;
+  // How many bodies, and how many pairs or contacts, each thread takes at
+  // a time. Contacts cost far more each than a body does. Body ranges are
+  // a multiple of the SIMD width so the same bodies take the vector paths
+  // however the ranges are split.
+  inline static const size_t BODY_BATCH_SIZE = 256u;
+  inline static const size_t CONTACT_BATCH_SIZE = 32u;
+
+  enum BROADPHASE
+  {
+    // Best for many bodies of around the same size
+    BROADPHASE_SPATIAL_HASH = 0
+    // Best for bodies of very different sizes
+    , BROADPHASE_AABB_TREE
+    // Best for scenes where few bodies move far between steps
+    , BROADPHASE_SWEEP_AND_PRUNE
+    , BROADPHASE_COUNT
+  };
+
+  struct RaycastHit
+  {
+    ENTITY_ID entity;
+    float distance;
+    glm::vec3 point;
+  };
+
   CPL_System(const std::string &_sysName);
   ~CPL_System();
 
@@ -36,13 +132,206 @@ public:
   SYS_ERR Unload();
   SYS_ERR Terminate();
 
+  /*!
+   *  Changing gravity wakes every body
+   */
   void SetGravityVec(const glm::vec3 &_gravityVec);
   const glm::vec3 &GetGravityVec();
   void ResetGravityVec();
 
+  void SetIntegrator(const Integrator::INTEGRATOR &_integrator);
+  const Integrator::INTEGRATOR &GetIntegrator() const;
+
+  /*!
+   *  \returns
+   *    How far between the last two steps the world matrices are, from 0
+   *    at the previous step to 1 at the current step
+   */
+  float GetInterpolationAlpha() const;
+
+  /*!
+   *  \returns
+   *    The entities whose bounds overlapped after the last step, these
+   *    may not actually be touching
+   */
+  const std::vector<std::pair<ENTITY_ID, ENTITY_ID>> &
+    GetCandidatePairs() const;
+
+  /*!
+   *  \returns
+   *    Where the colliders touched after the last step, the bodies of each
+   *    manifold are given by their index in the colliders
+   */
+  const ContactBuffer &GetContacts() const;
+  /*!
+   *  \returns
+   *    The entity of a collider named by a contact manifold
+   */
+  const ENTITY_ID &GetColliderEntity(const uint32_t &collider) const;
+
+  void SetSolverIterations(const int &_solverIterations);
+  const int &GetSolverIterations() const;
+
+  SpatialHash &GetSpatialHash();
+  /*!
+   *  \returns
+   *    The sweep and prune broadphase, which also gives the pairs each
+   *    step added and removed while it is the one in use
+   */
+  SweepAndPrune &GetSweepAndPrune();
+
+  void SetBroadphase(const BROADPHASE &_broadphase);
+  const BROADPHASE &GetBroadphase() const;
+
+  /*!
+   *  Sets the pool the phases of a step are split across. The pool must
+   *  outlive the system or be replaced before it is destroyed.
+   */
+  void SetThreadPool(ThreadPool &_threadPool);
+  ThreadPool &GetThreadPool() const;
+
+  /*!
+   *  Finds the closest collider a ray hits, as of the last step
+   *
+   *  \param direction
+   *    The direction of the ray, does not need to be normalized
+   *  \param hit
+   *    Set to the entity hit and where, only when there was a hit
+   *
+   *  \returns
+   *    If any collider was hit within maxDistance
+   */
+  bool Raycast(const glm::vec3 &origin, const glm::vec3 &direction
+               , const float &maxDistance, RaycastHit &hit) const;
+  /*!
+   *  Finds every entity whose collider's bounds overlap the given bounds,
+   *  as of the last step
+   *
+   *  \param entities
+   *    Cleared then filled with the entities found
+   */
+  void QueryOverlaps(const AABB &bounds
+                     , std::vector<ENTITY_ID> &entities) const;
+
 private:
   inline const static glm::vec3 defaultGravityVec = {0.f, -9.81f, 0.f};
   glm::vec3 gravityVec;
+  Integrator::INTEGRATOR integrator;
+  BROADPHASE broadphase;
+  int solverIterations;
+  ThreadPool *threadPool;
+
+  struct Body
+  {
+    ENTITY_ID entity;
+    Transform *transform;
+    Physics *physics;
+    // Left as nullptr for bodies that do not collide
+    Collider *collider;
+  };
+
+  /*!
+   *  Gathers the components of every entity once a frame so the steps do
+   *  not look them up again, and copies their motion into the batch with
+   *  the awake bodies first
+   */
+  void GatherBodies();
+  /*!
+   *  Finds the shape and world bounds of a collider from where the batch
+   *  has moved its body to
+   */
+  void UpdateCollider(const size_t &collider);
+  void Step(const float &timeStep);
+  /*!
+   *  Finds the world bounds of every awake colliding body, sleeping bodies
+   *  have theirs found once when gathered
+   */
+  void UpdateBounds();
+  /*!
+   *  Moves every collider in the tree and finds the step's pairs with the
+   *  chosen broadphase
+   */
+  void UpdateBroadphase();
+  /*!
+   *  Finds where the step's pairs with an awake body touch and solves the
+   *  contacts, waking sleeping bodies hit by awake ones
+   */
+  void UpdateContacts(const float &timeStep);
+  /*!
+   *  Runs the contact solver's batches in order iterations times, with
+   *  each batch split across the threads
+   *
+   *  \param isCorrecting
+   *    If positions are corrected rather than velocities solved
+   */
+  void SolveContacts(const int &iterations, const bool &isCorrecting);
+  /*!
+   *  Groups the bodies into islands by the last step's contacts and puts
+   *  the islands that have rested long enough to sleep
+   *
+   *  \param frameTime
+   *    The time simulated this frame
+   */
+  void UpdateSleep(const float &frameTime);
+  /*!
+   *  Copies the batch's results back into each awake entity's components
+   */
+  void ScatterBodies();
+  /*!
+   *  Builds each awake world matrix from the state the given fraction of
+   *  the way from the previous step to the current step
+   */
+  void UpdateWorldMatrices(const float &alpha);
+
+  // Frame time not yet simulated, always less than a step after an update
+  float timeAccumulator;
+  std::vector<Body> bodies;
+  // The motion of every body, awake bodies first up to the active count
+  BodyBatch bodyBatch;
+  // The index in bodies of every body in the batch
+  std::vector<uint32_t> batchBodies;
+  // The index in the batch of every body that collides, in the same order
+  // as bodies so each collider keeps its index while bodies sleep and wake
+  std::vector<uint32_t> colliderBodies;
+  // The entity, shape, and world bounds of every body that collides as
+  // of the last step, in the same order. Spheres keep their turned box as
+  // well but only boxes use the box's extents.
+  std::vector<ENTITY_ID> colliderEntities;
+  std::vector<Collider::SHAPE> colliderShapes;
+  std::vector<OrientedBox> colliderBoxes;
+  std::vector<Sphere> colliderSpheres;
+  std::vector<AABB> colliderBounds;
+  // What the contact solver needs of every body that collides
+  std::vector<float> colliderInverseMasses;
+  std::vector<float> colliderFrictions;
+  std::vector<float> colliderRestitutions;
+  // Holds every collider with the index of its bounds as its user data
+  AABBTree colliderTree;
+  EntityProxies colliderProxies;
+  SpatialHash spatialHash;
+  TreeBroadphase treeBroadphase;
+  SweepAndPrune sweepAndPrune;
+  // Every broadphase by its BROADPHASE value
+  std::array<Broadphase *, BROADPHASE_COUNT> broadphases;
+  std::vector<std::pair<ENTITY_ID, ENTITY_ID>> candidatePairs;
+  // The broadphase pairs with a body the step can move
+  std::vector<CollisionPair> stepPairs;
+  // Where each step pair touches and if it does, filled by many threads
+  // before the touching pairs are added to the contacts in order
+  std::vector<ContactManifold> pairManifolds;
+  std::vector<uint8_t> pairTouching;
+  ContactBuffer contacts;
+  ContactSolver contactSolver;
+  // The bodies of the batch grouped by touch, and the least time any body
+  // of each island has rested for
+  Islands islands;
+  std::vector<float> islandRestTimes;
+  // Set when gravity changes so every body is woken the next frame
+  bool wakeAll;
+  // The blended position, scale, and orientation of every body with one
+  // array per component, given to the transform kernel
+  std::array<std::vector<float>, 10> matrixInputs;
+  std::vector<glm::mat4> worldMatrices;
   
   CPL_System(const CPL_System &other) = delete;
   CPL_System &operator=(const CPL_System &other) = delete;
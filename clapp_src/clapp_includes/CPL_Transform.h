@@ -19,6 +19,7 @@
 #include "../../external/glm/vec2.hpp"
 
 #include "../../external/glm/mat4x4.hpp"
+#include "../../external/glm/gtc/quaternion.hpp"
 
 namespace ClaPP
 {
@@ -29,15 +30,29 @@ public:
   {
     glm::vec3 worldPos;
     glm::vec3 scale;
-    glm::vec3 rotation;
+    // Stored as a unit quaternion so turning is a few multiply adds and
+    // never locks an axis, use the euler accessors to work in degrees
+    glm::quat orientation;
 
+    // Interpolated between the last two physics steps so movement is
+    // smooth at any frame rate
     glm::mat4 worldMatrix;
+
+    // The state before the last physics step
+    glm::vec3 previousPos;
+    glm::quat previousOrientation;
   };
 
+  /*!
+   *  \param rotation
+   *    Euler angles in degrees applied as Z * Y * X
+   */
   Transform(const glm::vec3 &worldPos = {0.f, 0.f, 0.f}
           , const glm::vec3 &scale = {1.f, 1.f, 1.f}
           , const glm::vec3 &rotation = {0.f, 0.f, 0.f})
-  : transformData({worldPos, scale, rotation})
+  : transformData({worldPos, scale, glm::quat(glm::radians(rotation))
+                   , glm::mat4(1.f), worldPos
+                   , glm::quat(glm::radians(rotation))})
   {
 
   }
@@ -50,6 +65,25 @@ public:
   {
     return transformData;
   }
+
+  /*!
+   *  \returns
+   *    The orientation as Euler angles in degrees applied as Z * Y * X
+   */
+  glm::vec3 GetEulerRotation() const
+  {
+    return glm::degrees(glm::eulerAngles(transformData.orientation));
+  }
+
+  /*!
+   *  Sets the orientation from Euler angles in degrees applied as
+   *  Z * Y * X. The previous orientation is left so the change is blended
+   *  the same as any other step.
+   */
+  void SetEulerRotation(const glm::vec3 &rotation)
+  {
+    transformData.orientation = glm::quat(glm::radians(rotation));
+  }
 private:
   TransformData transformData;
 };
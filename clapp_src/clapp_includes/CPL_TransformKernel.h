@@ -0,0 +1,91 @@
+/*
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    CPL_TransformKernel.h
+ *
+ *  \brief
+ *    An interface for building the world matrices of many transforms at
+ *    once with SIMD
+*/
+#pragma once
+
+#include <cstddef>
+
+#include "../../external/glm/mat4x4.hpp"
+
+namespace ClaPP
+{
+/*!
+ * \class TransformKernel
+ *
+ * \brief
+ *  Builds translate * rotate * scale matrices straight from each value
+ *  instead of multiplying a matrix per part.
+ *
+ *  Inputs are given one array per component so 4 transforms are built at
+ *  a time with SSE, including the sines and cosines of Euler angles which
+ *  are found with a polynomial rather than 3 calls to the standard trig
+ *  functions. Builds without SSE, and any transforms left over after the
+ *  last group of 4, use a scalar version giving the same matrices.
+ */
+class TransformKernel
+{
+public:
+  /*!
+   *  Transforms rotated by Euler angles in radians, applied as
+   *  Z * Y * X the same as the physics system always has
+   */
+  struct EulerTransforms
+  {
+    const float *position[3];
+    const float *rotation[3];
+    const float *scale[3];
+    size_t count;
+  };
+
+  /*!
+   *  Transforms rotated by unit quaternions given as x, y, z, w
+   */
+  struct QuaternionTransforms
+  {
+    const float *position[3];
+    const float *rotation[4];
+    const float *scale[3];
+    size_t count;
+  };
+
+  /*!
+   *  Builds the matrix of every transform
+   *
+   *  \param matrices
+   *    Filled with one matrix per transform, in order
+   */
+  static void ComposeEuler(const EulerTransforms &transforms
+                           , glm::mat4 *matrices);
+  static void ComposeQuaternion(const QuaternionTransforms &transforms
+                                , glm::mat4 *matrices);
+
+  /*!
+   *  The scalar versions, used for the leftovers of the SIMD versions and
+   *  to check them
+   *
+   *  \param first
+   *    The first transform built, those before it are left untouched
+   */
+  static void ComposeEulerScalar(const EulerTransforms &transforms
+                                 , glm::mat4 *matrices
+                                 , const size_t &first = 0u);
+  static void ComposeQuaternionScalar(const QuaternionTransforms &transforms
+                                      , glm::mat4 *matrices
+                                      , const size_t &first = 0u);
+
+  /*!
+   *  \returns
+   *    If this build composes with SIMD
+   */
+  static bool IsVectorized();
+};
+}
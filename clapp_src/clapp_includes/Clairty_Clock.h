@@ -25,6 +25,10 @@ public:
   Clock();
   ~Clock();
 
+  /*!
+   *  Measures the real time since the last update, should be called once
+   *  at the start of every frame
+   */
   void Update();
   const float &GetDeltaTime() const;
   const float &GetTotalRunTime() const;
@@ -34,15 +38,24 @@ private:
   float deltaTime = 0.f;
   // The total time from initialization
   float gameRunTime = 0.f;
-  // Keeps track of when the previous update call was made to 
-  // accuratly get deltaTime
-  float previousGameRunTime = 0.f;
+  // Keeps track of when the clock started and when the previous update call
+  // was made to accuratly get deltaTime
+  std::chrono::steady_clock::time_point startTime;
+  std::chrono::steady_clock::time_point previousTime;
 };
 
 // Default clock used by the system
 // NOTE: Must be created in c++ like a static variable;
 extern Clock systemClock;
 
+/*!
+ * \class Timer
+ *
+ * \brief
+ *  Measures time on a clock from when it was started. A timer only reads
+ *  its clock so it costs nothing while nobody checks it, use the event
+ *  manager's ScheduleEvent when something should happen once it finishes.
+ */
 class Timer
 {
 public:
@@ -50,8 +63,26 @@ public:
   // Allows user to use a custom clockc to override the default clock
   Timer(const Clock &clockOverride);
   ~Timer();
+
+  /*!
+   *  Starts or restarts the timer
+   *
+   *  \param duration
+   *    The time in seconds until the timer is finished
+   */
+  void Start(const float &duration);
+  // Restarts the timer with the duration it was last started with
+  void Restart();
+
+  float GetElapsed() const;
+  // The time left before finishing, never less than 0
+  float GetRemaining() const;
+  bool IsFinished() const;
+
 private:
   const Clock& clock;
+  float startTime;
+  float duration;
 };
 
 }
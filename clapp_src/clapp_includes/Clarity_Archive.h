@@ -0,0 +1,210 @@
+/*
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    Clarity_Archive.h
+ *
+ *  \brief
+ *    An interface for packing shaders, meshes, textures, and scripts into a
+ *    single memory mapped archive with a hashed table of contents
+*/
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Clarity_IO.h"
+
+namespace ClaPP
+{
+/*!
+ * \class AssetArchive
+ *
+ * \brief
+ *  A read only archive of engine assets which is memory mapped as a whole
+ *  so that resolving an asset costs a hash lookup instead of a file open.
+ *
+ *  Layout of a .cpak file:
+ *  - ArchiveHeader
+ *  - Entry data, each blob aligned to ENTRY_ALIGNMENT
+ *  - Entry names, null terminated
+ *  - Table of contents as an open addressed hash table of ArchiveEntry
+ *
+ *  Names are stored relative to the asset root (e.g.
+ *  "clapp_shaders/vertShader.txt") and lookups strip any leading "./" or
+ *  "../" so the existing relative paths used by the engine resolve as is.
+ */
+class AssetArchive
+{
+public:
+  enum ARCHIVE_ERR
+  {
+    ARCHIVE_NO_ERR = 0
+    , ARCHIVE_FILE_NOT_FOUND
+    , ARCHIVE_FAILED_TO_MAP
+    , ARCHIVE_INVALID_FORMAT
+    , ARCHIVE_ALREADY_MOUNTED
+    , ARCHIVE_NOT_MOUNTED
+    , ARCHIVE_ENTRY_NOT_FOUND
+    , ARCHIVE_CORRUPT_ENTRY
+    , ARCHIVE_FAILED_TO_WRITE
+  };
+
+  enum ENTRY_FLAGS
+  {
+    ENTRY_FLAG_NONE = 0
+    , ENTRY_FLAG_COMPRESSED = 1
+  };
+
+  struct ArchiveHeader
+  {
+    char magic[4];
+    uint32_t version;
+    uint32_t entryCount;
+    // Number of slots in the table of contents, always a power of two
+    uint32_t tableSize;
+    uint64_t tableOffset;
+    uint64_t namesOffset;
+  };
+
+  struct ArchiveEntry
+  {
+    // A hash of 0 marks an empty slot in the table
+    uint64_t pathHash;
+    uint64_t dataOffset;
+    uint32_t storedSize;
+    uint32_t rawSize;
+    uint32_t nameOffset;
+    uint32_t flags;
+  };
+
+  inline static const char ARCHIVE_MAGIC[4] = {'C', 'P', 'A', 'K'};
+  inline static const uint32_t ARCHIVE_VERSION = 1u;
+  inline static const uint64_t ENTRY_ALIGNMENT = 16u;
+
+  // NOTE: Initally doing this as a singleton as the engine only expects
+  // one packed archive to be mounted at a time
+  static AssetArchive &GetInstance();
+
+  /*!
+   *  Memory maps an archive and validates its header. The file is mapped
+   *  with read ahead so startup is one sequential read of the archive.
+   *
+   *  \param archivePath
+   *    The path to the .cpak file being mounted
+   *
+   *  \returns
+   *    An archive error result. Will return ARCHIVE_NO_ERR if none is found
+   */
+  ARCHIVE_ERR Mount(const std::string &archivePath);
+  /*!
+   *  Unmaps the currently mounted archive. Any views previously returned
+   *  by FindEntry are invalidated.
+   */
+  ARCHIVE_ERR Unmount();
+  bool IsMounted() const;
+
+  /*!
+   *  Checks if an entry exists for a given asset path
+   *
+   *  \param assetPath
+   *    The path of the asset, relative paths are normalized before lookup
+   */
+  bool Contains(const std::string &assetPath) const;
+
+  /*!
+   *  Returns a zero copy view into the mapped archive for an uncompressed
+   *  entry. Compressed entries must be read with ReadEntry instead.
+   *
+   *  \param assetPath
+   *    The path of the asset being located
+   *  \param view
+   *    Updated to point at the entry's bytes within the mapping
+   *
+   *  \returns
+   *    An archive error result. Will return ARCHIVE_CORRUPT_ENTRY if the
+   *    entry is compressed
+   */
+  ARCHIVE_ERR FindEntry(const std::string &assetPath
+                        , std::string_view &view) const;
+  /*!
+   *  Reads an entry into a string, decompressing it if needed
+   *
+   *  \param assetPath
+   *    The path of the asset being read
+   *  \param data
+   *    The string that will be updated with the entry's contents
+   *
+   *  \returns
+   *    An archive error result. Will return ARCHIVE_NO_ERR if none is found
+   */
+  ARCHIVE_ERR ReadEntry(const std::string &assetPath, std::string &data) const;
+
+  /*!
+   *  Packs a set of files into a new archive.
+   *
+   *  \param archivePath
+   *    The path of the .cpak file being written
+   *  \param rootDir
+   *    The directory all file paths are relative to
+   *  \param files
+   *    The file paths, relative to rootDir, being packed. These are the
+   *    names used for lookup
+   *  \param compress
+   *    If entries should be LZ4 compressed. Entries that do not shrink are
+   *    always stored raw
+   *
+   *  \returns
+   *    An archive error result. Will return ARCHIVE_NO_ERR if none is found
+   */
+  static ARCHIVE_ERR Build(const std::string &archivePath
+                           , const std::string &rootDir
+                           , const std::vector<std::string> &files
+                           , const bool &compress);
+
+  /*!
+   *  Strips leading "./" and "../" segments and converts '\\' to '/' so that
+   *  a runtime relative path matches the name stored in the archive
+   */
+  static std::string NormalizePath(const std::string &assetPath);
+  /*!
+   *  A 64 bit FNV-1a hash of a normalized path. Never returns 0 as that is
+   *  used to mark empty table slots.
+   */
+  static uint64_t HashPath(const std::string_view &normalizedPath);
+
+private:
+  AssetArchive();
+  ~AssetArchive();
+
+  AssetArchive(const AssetArchive &other) = delete;
+  AssetArchive &operator=(const AssetArchive &other) = delete;
+
+  const ArchiveEntry *LocateEntry(const std::string &assetPath) const;
+
+  const uint8_t *mappedData;
+  size_t mappedSize;
+  const ArchiveHeader *header;
+  const ArchiveEntry *table;
+  // Only used when the platform does not support memory mapping
+  std::vector<uint8_t> fallbackBuffer;
+};
+
+/*!
+ *  Loads an asset into a string. The mounted archive is checked first and
+ *  the loose file at assetPath is used if the archive does not contain it.
+ *
+ *  \param assetPath
+ *    The path of the asset being loaded
+ *  \param data
+ *    The string that will be updated with the asset's contents
+ *
+ *  \returns
+ *    A file error result. Will return FILE_NO_ERR if none is found
+ */
+FILE_ERR LoadAssetToString(const std::string &assetPath, std::string &data);
+}
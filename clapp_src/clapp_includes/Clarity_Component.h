@@ -44,6 +44,7 @@ public:
     , C_PHYSICS
     , C_INPUT
     , C_CONTROLLER
+    , C_COLLIDER
 
     , C_COUNT
     , C_INVALID
@@ -57,6 +58,7 @@ public:
     , "Physics"          // C_PHYSICS
     , "KeyBindContainer" // C_INPUT
     , "Controller"       // C_CONTROLLER
+    , "Collider"         // C_COLLIDER
   };
 
   Component();
@@ -0,0 +1,80 @@
+/*
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    Clarity_Compression.h
+ *
+ *  \brief
+ *    An interface for a small LZ4 style block compressor used by packed
+ *    asset archives
+*/
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace ClaPP
+{
+enum COMPRESSION_ERR
+{
+  COMPRESSION_NO_ERR = 0
+  , COMPRESSION_NULLPTR_PASSED
+  , COMPRESSION_NOT_SMALLER
+  , COMPRESSION_CORRUPT_DATA
+  , COMPRESSION_OUTPUT_TOO_SMALL
+};
+
+/*!
+ *  Returns the largest size a compressed block may be for a given input
+ *  size. Incompressible data grows slightly as literals still need tokens.
+ *
+ *  \param srcSize
+ *    The size of the uncompressed data in bytes
+ *
+ *  \returns
+ *    The worst case size of the compressed block in bytes
+ */
+size_t CompressBound(const size_t &srcSize);
+
+/*!
+ *  Compresses a block of data using an LZ4 style format (a token byte of
+ *  literal/match lengths, the literals, then a 2 byte match offset).
+ *
+ *  \param src
+ *    The data being compressed
+ *  \param srcSize
+ *    The size of the data being compressed in bytes
+ *  \param dst
+ *    The vector that will be overwritten with the compressed block
+ *
+ *  \returns
+ *    A compression error result. Will return COMPRESSION_NOT_SMALLER if the
+ *    compressed block is not smaller than the source so the caller can store
+ *    the data raw instead
+ */
+COMPRESSION_ERR CompressBlock(const uint8_t *src, const size_t &srcSize
+                              , std::vector<uint8_t> &dst);
+
+/*!
+ *  Decompresses a block created by CompressBlock. All reads and writes are
+ *  bounds checked so corrupt data is reported rather than overrunning.
+ *
+ *  \param src
+ *    The compressed block
+ *  \param srcSize
+ *    The size of the compressed block in bytes
+ *  \param dst
+ *    The buffer being written to, it must be able to hold dstSize bytes
+ *  \param dstSize
+ *    The exact size of the uncompressed data in bytes
+ *
+ *  \returns
+ *    A compression error result. Will return COMPRESSION_NO_ERR if none
+ *    is found
+ */
+COMPRESSION_ERR DecompressBlock(const uint8_t *src, const size_t &srcSize
+                                , uint8_t *dst, const size_t &dstSize);
+}
@@ -134,6 +134,15 @@ public:
   */
   void RemoveComponent(const ENTITY_ID &id
                        , const Component::COMPONENTS &componentType);
+  /*!
+  *  Checks for a component before getting it, as GetComponent throws for
+  *  components an entity does not have
+  *
+  *  \returns
+  *    If the given entity has a component of the given type
+  */
+  bool HasComponent(const ENTITY_ID &id
+                    , const Component::COMPONENTS &componentType) const;
 
   // Template Functions
   // TODO: look into removing enum and instead using typeid
@@ -27,6 +27,10 @@ public:
   bool Exit();
 
 private:
+  // NOTE: Relative to the build directory like all other asset paths
+  inline static const std::string DEFAULT_ARCHIVE_PATH 
+    = "../clapp_assets.cpak";
+
   ECS ecsManager;
 
   bool TerminateEngine();
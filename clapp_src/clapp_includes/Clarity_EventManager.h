@@ -11,9 +11,21 @@
 */
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <type_traits>
+#include <functional>
+#include <mutex>
 #include <vector>
 #include <string>
 
+#include "Clarity_IO.h"
+#include "Clarity_Entity.h"
+#include "Clarity_EventQueue.h"
+#include "Clarity_TimerWheel.h"
+
 namespace ClaPP
 {
 /*!
@@ -25,6 +37,13 @@ namespace ClaPP
  *  operations include:
  *  - Adding an event
  *  - Reading events
+ *
+ *  Typed events are structs naming their EVENT_TYPE with a static TYPE
+ *  member. Each type has its own bounded lock free queue found by indexing
+ *  with that type, so any thread can send without locking, searching, or
+ *  allocating. At the end of each frame the manager drains every queue on
+ *  the main thread, hands the events to their type's subscribers, and
+ *  keeps them readable through HasEvent and GetEvent for the next frame.
  */
 class EventManager
 {
@@ -41,6 +60,22 @@ public:
 
   };
 
+  // Every typed event, used to index its channel
+  enum EVENT_TYPE
+  {
+    EVENT_TERMINATE_ENGINE = 0
+    , EVENT_TIMER
+    , EVENT_TYPE_COUNT
+  };
+
+  typedef size_t SUBSCRIBER_ID;
+
+  // The number of events of one type that can be sent in a frame unless
+  // the channel is reserved larger
+  inline static const size_t DEFAULT_CHANNEL_CAPACITY = 64u;
+
+  // NOTE: String events are kept for older code, new events should be
+  // typed as matching a message is a linear string scan
   struct Event
   {
     Event(const EVENT_OBJ &_sender, const EVENT_OBJ &_reciever
@@ -60,9 +95,179 @@ public:
                                 , const EVENT_OBJ &_reciever
                                 , const std::string &_expectedMessage);
 
-  // Remove any events that are checked
+  // Remove any events that are checked, fire timed events whose delay has
+  // passed, and dispatch typed events
   void Update(float deltaTime);
 
+  // How close a channel has come to dropping events
+  struct ChannelStats
+  {
+    size_t capacity = 0u;
+    // Events refused because the channel was full
+    size_t droppedEvents = 0u;
+    // The most events sent to the channel in one frame
+    size_t highWaterMark = 0u;
+  };
+
+  /*!
+   *  Sizes the channel of an event type. Must be done on the main thread
+   *  while no other thread is sending events of the type, as replacing a
+   *  channel other threads are sending to is not safe. A channel that
+   *  already exists keeps its subscribers and the events sent to it, only
+   *  its stats start over.
+   *
+   *  \param capacity
+   *    The most events of the type that can be sent in a frame
+   */
+  template<typename T>
+  void ReserveChannel(const size_t &capacity)
+  {
+    std::lock_guard<std::mutex> lock(channelMutex);
+    Channel<T> *existing = static_cast<Channel<T> *>(
+      channels[T::TYPE].load(std::memory_order_acquire));
+    Channel<T> *resized = new Channel<T>(capacity);
+    if(existing)
+    {
+      // Subscriber ids are indices so the list is moved whole
+      resized->subscribers = std::move(existing->subscribers);
+      resized->expiredEvents = std::move(existing->expiredEvents);
+      resized->frameEvents.assign(existing->frameEvents.begin()
+                                  , existing->frameEvents.end());
+      T event;
+      while(existing->pending.TryPop(event))
+      {
+        if(!resized->pending.TryPush(event))
+        {
+          resized->droppedEvents.fetch_add(1u, std::memory_order_relaxed);
+        }
+      }
+    }
+    channels[T::TYPE].store(resized, std::memory_order_release);
+    delete existing;
+  }
+
+  /*!
+   *  Queues a typed event, safe to call from any thread without locking.
+   *  If the channel is full the event is dropped and counted rather than
+   *  growing the channel.
+   */
+  template<typename T>
+  void SendEvent(const T &event)
+  {
+    Channel<T> &channel = GetChannel<T>();
+    if(!channel.pending.TryPush(event))
+    {
+      channel.droppedEvents.fetch_add(1u, std::memory_order_relaxed);
+    }
+  }
+
+  /*!
+   *  Sends a typed event once a delay of real time has passed. Must be
+   *  called from the main thread, the event is copied into the timer so it
+   *  must be small and trivially copyable. Expired events skip the
+   *  channel's queue, so any number expiring at once are all delivered.
+   *
+   *  \param delay
+   *    The time in seconds before the event is sent, rounded up to the
+   *    timer resolution
+   *
+   *  \returns
+   *    The id used to cancel the event
+   */
+  template<typename T>
+  TimerWheel::TIMER_ID ScheduleEvent(const float &delay, const T &event)
+  {
+    static_assert(std::is_trivially_copyable_v<T>
+                  , "Scheduled events must be trivially copyable");
+    static_assert(sizeof(T) <= TimerWheel::PAYLOAD_SIZE
+                  , "Scheduled event is too large");
+    return timerWheel.Schedule(delay, &SendScheduledEvent<T>, &event
+                               , sizeof(T));
+  }
+
+  /*!
+   *  \returns
+   *    If the scheduled event had not yet been sent
+   */
+  bool CancelEvent(const TimerWheel::TIMER_ID &timerID);
+
+  /*!
+   *  \returns
+   *    If any event of the type was sent during the last frame
+   */
+  template<typename T>
+  bool HasEvent() const
+  {
+    return GetEventCount<T>() != 0;
+  }
+
+  /*!
+   *  \returns
+   *    The number of events of the type sent during the last frame
+   */
+  template<typename T>
+  size_t GetEventCount() const
+  {
+    const ChannelBase *channel 
+      = channels[T::TYPE].load(std::memory_order_acquire);
+    return channel 
+           ? static_cast<const Channel<T> *>(channel)->frameEvents.size() 
+           : 0u;
+  }
+
+  /*!
+   *  \param index
+   *    The event to get from 0, the oldest event, to GetEventCount - 1
+   */
+  template<typename T>
+  const T &GetEvent(const size_t &index) const
+  {
+    const Channel<T> *channel = static_cast<const Channel<T> *>(
+      channels[T::TYPE].load(std::memory_order_acquire));
+    return channel->frameEvents[index];
+  }
+
+  template<typename T>
+  ChannelStats GetChannelStats() const
+  {
+    ChannelStats stats;
+    const Channel<T> *channel = static_cast<const Channel<T> *>(
+      channels[T::TYPE].load(std::memory_order_acquire));
+    if(channel)
+    {
+      stats.capacity = channel->pending.GetCapacity();
+      stats.droppedEvents = channel->totalDropped;
+      stats.highWaterMark = channel->highWaterMark;
+    }
+    return stats;
+  }
+
+  /*!
+   *  Calls a function with every event of the type at the end of the frame
+   *  it was sent in. Must be called from the main thread.
+   *
+   *  \returns
+   *    The id used to unsubscribe
+   */
+  template<typename T>
+  SUBSCRIBER_ID Subscribe(const std::function<void(const T &)> &subscriber)
+  {
+    Channel<T> &channel = GetChannel<T>();
+    channel.subscribers.push_back(subscriber);
+    return channel.subscribers.size() - 1;
+  }
+
+  template<typename T>
+  void Unsubscribe(const SUBSCRIBER_ID &subscriberID)
+  {
+    Channel<T> &channel = GetChannel<T>();
+    // Cleared rather than erased so other ids stay valid
+    if(subscriberID < channel.subscribers.size())
+    {
+      channel.subscribers[subscriberID] = nullptr;
+    }
+  }
+
 private:
   EventManager();
   ~EventManager();
@@ -70,8 +275,136 @@ private:
   EventManager(const EventManager &other) = delete;
   EventManager &operator=(const EventManager &other) = delete;
 
+  struct ChannelBase
+  {
+    virtual ~ChannelBase() {}
+    // Moves the frame's events out of the queue and hands them to
+    // subscribers
+    virtual void Drain() = 0;
+  };
+
+  template<typename T>
+  struct Channel : public ChannelBase
+  {
+    Channel(const size_t &capacity)
+    : pending(capacity > 0 ? capacity : 1), expiredEvents(), frameEvents()
+      , subscribers()
+      , droppedEvents(0u), totalDropped(0u), highWaterMark(0u)
+    {
+      // Reserved once so draining never allocates
+      frameEvents.reserve(pending.GetCapacity());
+    }
+
+    void Drain() override
+    {
+      frameEvents.clear();
+      T event;
+      while(pending.TryPop(event))
+      {
+        frameEvents.push_back(event);
+      }
+      frameEvents.insert(frameEvents.end(), expiredEvents.begin()
+                         , expiredEvents.end());
+      expiredEvents.clear();
+
+      // The queue only fills between drains so the drained count is the
+      // peak for the frame
+      highWaterMark = std::max(highWaterMark, frameEvents.size());
+      const size_t dropped 
+        = droppedEvents.exchange(0u, std::memory_order_relaxed);
+      if(dropped)
+      {
+        totalDropped += dropped;
+        ErrMessage("Event channel full, dropped " + std::to_string(dropped)
+                   + " events of type: " + std::to_string(T::TYPE)
+                   , EC_EVENT);
+      }
+
+      for(const T &frameEvent : frameEvents)
+      {
+        for(const std::function<void(const T &)> &subscriber : subscribers)
+        {
+          if(subscriber)
+          {
+            subscriber(frameEvent);
+          }
+        }
+      }
+    }
+
+    // Written by any thread during the frame
+    MPSCQueue<T> pending;
+    // Sent by expired timers on the main thread. Not bounded like pending
+    // as any number of timers can expire on the same tick
+    std::vector<T> expiredEvents;
+    // Read on the main thread during the next frame
+    std::vector<T> frameEvents;
+    std::vector<std::function<void(const T &)>> subscribers;
+    std::atomic<size_t> droppedEvents;
+    size_t totalDropped;
+    size_t highWaterMark;
+  };
+
+  template<typename T>
+  static void SendScheduledEvent(const void *payload)
+  {
+    T event;
+    memcpy(static_cast<void *>(&event), payload, sizeof(T));
+    GetInstance().GetChannel<T>().expiredEvents.push_back(event);
+  }
+
+  template<typename T>
+  Channel<T> &GetChannel()
+  {
+    static_assert(T::TYPE < EVENT_TYPE_COUNT, "Invalid event type");
+    ChannelBase *channel = channels[T::TYPE].load(std::memory_order_acquire);
+    // Channels are made once the first time their type is used, only that
+    // first use takes the lock
+    if(!channel)
+    {
+      std::lock_guard<std::mutex> lock(channelMutex);
+      channel = channels[T::TYPE].load(std::memory_order_acquire);
+      if(!channel)
+      {
+        channel = new Channel<T>(DEFAULT_CHANNEL_CAPACITY);
+        channels[T::TYPE].store(channel, std::memory_order_release);
+      }
+    }
+    return *static_cast<Channel<T> *>(channel);
+  }
+
+  // Guards the string events which may be added from any thread
+  std::mutex eventMutex;
   std::vector<Event> events;
 
+  // Owned by the manager, only created under the lock
+  std::mutex channelMutex;
+  std::array<std::atomic<ChannelBase *>, EVENT_TYPE_COUNT> channels;
+
+  // Delayed events, only touched from the main thread
+  TimerWheel timerWheel;
+
   inline static const std::string EMPTY_STRING = "";
 };
+
+//=================//
+//= Typed Events  =//
+//=================//
+
+// Sent when the window is closed to stop the engine
+struct TerminateEngineEvent
+{
+  static constexpr EventManager::EVENT_TYPE TYPE 
+    = EventManager::EVENT_TERMINATE_ENGINE;
+};
+
+// A generic delayed trigger such as a cooldown ending, the tag says which
+struct TimerEvent
+{
+  static constexpr EventManager::EVENT_TYPE TYPE 
+    = EventManager::EVENT_TIMER;
+
+  uint32_t timerTag = 0u;
+  ENTITY_ID entity = 0u;
+};
 }
@@ -0,0 +1,147 @@
+/*
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    Clarity_EventQueue.h
+ *
+ *  \brief
+ *    A bounded lock free queue many threads can push to and one thread
+ *    drains
+*/
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace ClaPP
+{
+/*!
+ * \class MPSCQueue
+ *
+ * \brief
+ *  A fixed size ring of cells that any number of threads push to and a
+ *  single thread pops from, without locks.
+ *
+ *  Each cell holds a sequence number saying whose turn it is. A producer
+ *  claims a slot by advancing the shared write position and publishes its
+ *  value by bumping the cell's sequence, so the consumer never sees a value
+ *  that is half written. A full queue refuses the push instead of waiting.
+ */
+template<typename T>
+class MPSCQueue
+{
+public:
+  /*!
+   *  \param capacity
+   *    The most values held at once, rounded up to a power of two
+   */
+  MPSCQueue(const size_t &capacity)
+  : cells(), mask(0u), writePosition(0u), readPosition(0u)
+  {
+    size_t size = 1u;
+    while(size < capacity)
+    {
+      size <<= 1;
+    }
+    mask = size - 1;
+
+    cells = std::make_unique<Cell[]>(size);
+    for(size_t i = 0; i < size; ++i)
+    {
+      cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  /*!
+   *  Pushes a value, safe to call from any thread
+   *
+   *  \returns
+   *    If the value was pushed, false when the queue is full
+   */
+  bool TryPush(const T &value)
+  {
+    size_t position = writePosition.load(std::memory_order_relaxed);
+    Cell *cell = nullptr;
+
+    while(true)
+    {
+      cell = &cells[position & mask];
+      const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+      const intptr_t difference = static_cast<intptr_t>(sequence)
+                                  - static_cast<intptr_t>(position);
+      if(difference == 0)
+      {
+        // The cell is free for this position, claim it if no other producer
+        // got there first
+        if(writePosition.compare_exchange_weak(position, position + 1
+                                               , std::memory_order_relaxed))
+        {
+          break;
+        }
+      }
+      else if(difference < 0)
+      {
+        // The consumer has not freed this cell yet so the queue is full
+        return false;
+      }
+      else
+      {
+        position = writePosition.load(std::memory_order_relaxed);
+      }
+    }
+
+    cell->value = value;
+    cell->sequence.store(position + 1, std::memory_order_release);
+    return true;
+  }
+
+  /*!
+   *  Pops the oldest value, must only be called from the consuming thread
+   *
+   *  \returns
+   *    If a value was popped, false when the queue is empty
+   */
+  bool TryPop(T &value)
+  {
+    Cell &cell = cells[readPosition & mask];
+    const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+    if(sequence != readPosition + 1)
+    {
+      return false;
+    }
+
+    value = std::move(cell.value);
+    // Hand the cell to the producer one lap ahead
+    cell.sequence.store(readPosition + mask + 1, std::memory_order_release);
+    ++readPosition;
+    return true;
+  }
+
+  size_t GetCapacity() const
+  {
+    return mask + 1;
+  }
+
+private:
+  struct Cell
+  {
+    std::atomic<size_t> sequence;
+    T value;
+  };
+
+  std::unique_ptr<Cell[]> cells;
+  size_t mask;
+
+  // Kept on separate cache lines so producers and the consumer do not
+  // fight over one line
+  alignas(64) std::atomic<size_t> writePosition;
+  alignas(64) size_t readPosition;
+
+  MPSCQueue(const MPSCQueue &other) = delete;
+  MPSCQueue &operator=(const MPSCQueue &other) = delete;
+};
+}
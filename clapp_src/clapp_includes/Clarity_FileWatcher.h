@@ -0,0 +1,145 @@
+/*
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    Clarity_FileWatcher.h
+ *
+ *  \brief
+ *    An interface for watching asset files and preparing hot reloads on a
+ *    background thread
+*/
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "CGL_Mesh.h"
+
+namespace ClaPP
+{
+/*!
+ * \class FileWatcher
+ *
+ * \brief
+ *  Watches asset files for changes using inotify on a background thread.
+ *
+ *  When a watched file is written the watcher thread reads it, decoding
+ *  textures and building their mips and running mesh scripts on its own
+ *  lua state, so that the only work left for the main thread is the GPU
+ *  upload. Prepared reloads are queued until TakeReloads is called at a
+ *  frame boundary by the graphics system.
+ *
+ *  On platforms without inotify watching is a no-op.
+ */
+class FileWatcher
+{
+public:
+  enum WATCH_TYPE
+  {
+    WATCH_SHADER = 0
+    , WATCH_MESH
+    , WATCH_TEXTURE
+  };
+
+  enum WATCH_ERR
+  {
+    WATCH_NO_ERR = 0
+    , WATCH_NOT_SUPPORTED
+    , WATCH_FAILED_TO_START
+    , WATCH_ALREADY_RUNNING
+    , WATCH_FAILED_TO_WATCH
+  };
+
+  /*!
+   *  A reload that has been read and prepared off the main thread
+   */
+  struct Reload
+  {
+    WATCH_TYPE type;
+    std::string filePath;
+    // The file contents for shaders
+    std::string source;
+    // The parsed mesh for meshes
+    Mesh::MeshData mesh;
+    // The mip chain of the decoded image for textures
+    std::vector<std::vector<unsigned char>> levels;
+    int width = 0;
+    int height = 0;
+    int channels = 0;
+  };
+
+  // NOTE: Singleton as every loader registers the files it loaded and
+  // there is only ever one graphics system applying reloads
+  static FileWatcher &GetInstance();
+
+  /*!
+   *  Starts the watcher thread. Files registered before starting are
+   *  watched once it is running.
+   */
+  WATCH_ERR Start();
+  /*!
+   *  Stops and joins the watcher thread
+   */
+  void Stop();
+
+  /*!
+   *  Registers a file to be watched for changes
+   *
+   *  \param filePath
+   *    The path of the file, the same path used to load the asset
+   *  \param type
+   *    What kind of asset the file is which decides how it is prepared
+   */
+  WATCH_ERR Watch(const std::string &filePath, const WATCH_TYPE &type);
+
+  /*!
+   *  Moves all prepared reloads into the given vector. Should be called
+   *  once per frame by the thread owning the graphics context.
+   *
+   *  \param reloads
+   *    The vector that will be overwritten with the pending reloads
+   */
+  void TakeReloads(std::vector<Reload> &reloads);
+
+private:
+  struct WatchedFile
+  {
+    // The path the asset was registered with, used to find the asset
+    std::string filePath;
+    WATCH_TYPE type;
+  };
+
+  FileWatcher();
+  ~FileWatcher();
+
+  FileWatcher(const FileWatcher &other) = delete;
+  FileWatcher &operator=(const FileWatcher &other) = delete;
+
+  void WatchLoop();
+  void AddDirectoryWatch(const std::string &directory);
+  void PrepareReload(const WatchedFile &watchedFile);
+
+  int notifyFD;
+  std::atomic<bool> isRunning;
+  std::thread watchThread;
+
+  // Guards the watched files and directories
+  std::mutex watchMutex;
+  // Keyed by the watched directory joined with the file name as that is
+  // what inotify reports
+  std::unordered_map<std::string, WatchedFile> watchedFiles;
+  // inotify watches directories so editors that save by renaming a new
+  // file over the old one are still detected
+  std::unordered_map<int, std::string> watchedDirectories;
+
+  // Guards the prepared reloads
+  std::mutex reloadMutex;
+  std::vector<Reload> pendingReloads;
+};
+}
@@ -231,6 +231,8 @@ enum ERRORCODE
   , EC_GENERICSHADER = 34 //! A shader related error
   , EC_ECS //! An error with the ECS system
   , EC_PHYSICS //! An error with the physics system
+  , EC_ASSET //! An asset or archive related error
+  , EC_EVENT //! An event related error
 };
 
 /*!
@@ -18,7 +18,14 @@ extern "C"
   #include <lauxlib.h>
 }
 
+#include <span>
+
 #include "Clarity_IO.h"
+#include "Clarity_LuaCache.h"
+#include "Clarity_LuaBatch.h"
+#include "Clarity_LuaConfig.h"
+
+#include "../../external/glm/glm.hpp"
 
 namespace ClaPP
 {
@@ -40,6 +47,9 @@ namespace ClaPP
  *  Whenever you are done doing any operations you must pop the stack as any
  *  "get" operation will add to your stack
  *
+ *  NOTE: New code should prefer ExecuteConfig through LuaConfig, which reads
+ *  by path and can not leave the stack unbalanced
+ *
  *  Lua stacks all its get operations where the stack starts at -1 and goes 
  *  down (-2, -3, -4, ...). When you pop an item the (1) value indicates the 
  *  numbers of items to pop from the top of the stack. If you get an item
@@ -48,9 +58,12 @@ namespace ClaPP
 class LuaState
 {
 public:
-  // NOTE: Starting with a singleton but most likly should change it to be 
-  // for each thread later to ensure that all threads have their own access
-  // and can simultanously access lua script data
+  /*!
+   *  \returns
+   *    The lua state of the calling thread. Each thread has its own state
+   *    so scripts can run on every thread at once without locking, engine
+   *    enums made with CreateEnum are shared by every state.
+   */
   static LuaState &GetInstance();
 
   enum LUA_ERR
@@ -73,6 +86,17 @@ public:
   };
 
   LUA_ERR ExecuteFile(const std::string &luaPath);
+  /*!
+   *  Executes already loaded lua source and selects it as the current file
+   *  in the same way as ExecuteFile
+   *
+   *  \param luaSource
+   *    The lua source being executed
+   *  \param luaPath
+   *    The path the source was loaded from, used for error messages
+   */
+  LUA_ERR ExecuteBuffer(const std::string &luaSource
+                        , const std::string &luaPath);
   LUA_ERR GetGlobal(const std::string &globalName);
   LUA_ERR GetField(const std::string &fieldName);
   LUA_ERR GetFieldLength(int &fieldSize);
@@ -80,22 +104,163 @@ public:
   LUA_ERR GetNumber(double &ptr, const int &index);
   LUA_ERR GetNumber(int &ptr, const int &index);
   LUA_ERR GetNumber(unsigned int &ptr, const int &index = 0);
+  /*!
+   *  Reads the first values of the current field into a preallocated
+   *  buffer. The field is validated once instead of once per value so
+   *  large tables are read in a single tight loop.
+   *
+   *  \param values
+   *    The buffer being filled, the field must hold at least this many
+   *    numbers
+   *
+   *  \returns
+   *    A lua error result. Will return LUA_NO_ERR if none is found
+   */
+  LUA_ERR GetNumberArray(std::span<float> values);
+  LUA_ERR GetNumberArray(std::span<unsigned int> values);
+  /*!
+   *  Reads the whole current field as packed vectors, overwriting the
+   *  given vector. A field whose numbers do not fill a whole number of
+   *  vectors is an invalid field.
+   *
+   *  \param values
+   *    Resized to the number of whole vectors in the field and filled
+   *
+   *  \returns
+   *    A lua error result. Will return LUA_NO_ERR if none is found
+   */
+  LUA_ERR GetVec2Array(std::vector<glm::vec2> &values);
+  LUA_ERR GetVec3Array(std::vector<glm::vec3> &values);
   LUA_ERR GetString(std::string &ptr, const int &index = 0);
   LUA_ERR GetBool(bool &ptr, const int &index = 0);
+  /*!
+   *  Creates a global table of named integers in every thread's state,
+   *  states made later or on other threads get it before they next run a
+   *  script
+   *
+   *  \param luaEnum
+   *    The name of the global table
+   *  \param enumPairs
+   *    The names and values placed in the table
+   */
   LUA_ERR CreateEnum(std::string luaEnum
                      , const std::vector<EnumPair>  &enumPairs);
   LUA_ERR Pop();
+
+  /*!
+   *  Runs a script and keeps one of the functions it defines so it can be
+   *  called later. The function's global is cleared so scripts defining
+   *  the same name do not overwrite each other.
+   *
+   *  \param luaPath
+   *    The script defining the function
+   *  \param functionName
+   *    The name of the global function being kept
+   *  \param functionRef
+   *    Set to the reference used to call the function
+   *
+   *  \returns
+   *    A lua error result. Will return LUA_NO_ERR if none is found
+   */
+  LUA_ERR LoadFunction(const std::string &luaPath
+                       , const std::string &functionName, int &functionRef);
+  /*!
+   *  Calls a kept function as function(dt, batch) where batch exposes the
+   *  batch's columns. Only one lua call is made for the whole batch.
+   *
+   *  \param functionRef
+   *    The reference given by LoadFunction
+   *  \param deltaTime
+   *    The first argument of the function
+   *  \param batch
+   *    The batch given as the second argument
+   *
+   *  \returns
+   *    A lua error result. Will return LUA_NO_ERR if none is found
+   */
+  LUA_ERR CallBatchFunction(const int &functionRef, const float &deltaTime
+                            , LuaBatch &batch);
+  /*!
+   *  Releases a function kept by LoadFunction
+   */
+  void ReleaseFunction(int &functionRef);
+  /*!
+   *  Runs a script in its own environment and copies what it defines into
+   *  a config. Does not select a current file so it can be used while
+   *  another file is in use, and always leaves the stack as it found it.
+   *
+   *  \param luaPath
+   *    The path of the script
+   *  \param luaSource
+   *    The script's source if it is already loaded, otherwise nullptr
+   *  \param config
+   *    Filled with the script's globals
+   *
+   *  \returns
+   *    A lua error result. Will return LUA_NO_ERR if none is found
+   */
+  LUA_ERR ExecuteConfig(const std::string &luaPath
+                        , const std::string *luaSource, LuaConfig &config);
 private:
   LuaState();
   ~LuaState();
+  /*!
+   *  Pushes a script's compiled chunk onto the top of the stack, from the
+   *  bytecode cache when it is up to date
+   *
+   *  \param luaPath
+   *    The path of the script
+   *  \param luaSource
+   *    The script's source if it is already loaded, otherwise nullptr to
+   *    load it from the path only when the cache misses
+   */
+  LUA_ERR LoadChunk(const std::string &luaPath
+                    , const std::string *luaSource);
+  /*!
+   *  Compiles lua source onto the top of the stack and stores the compiled
+   *  chunk in the bytecode cache
+   */
+  LUA_ERR CompileChunk(const std::string &luaSource
+                       , const std::string &luaPath
+                       , const LuaBytecodeCache::SourceStamp &stamp);
+  /*!
+   *  Runs the chunk on the top of the stack and selects it as the current
+   *  file
+   */
+  LUA_ERR RunChunk(const std::string &luaPath);
   LUA_ERR CheckFileStatus();
   LUA_ERR NumberChecks(const int &index);
+  /*!
+   *  Validates once that a field is selected and holds at least count
+   *  values before any are read by the bulk getters
+   */
+  LUA_ERR ArrayChecks(const size_t &count);
+  template<typename T>
+  LUA_ERR ReadNumberArray(T *values, const size_t &count);
 
   lua_State *luaState;
   std::string currentFile;
   std::string currentGlobal;
   std::string currentField;
   uint8_t currentPopLayer;
-  std::mutex luaMutex;
+  // The revision of the shared enums this state has created
+  uint64_t enumRevision;
+
+  struct SharedEnum
+  {
+    std::string luaEnum;
+    std::vector<EnumPair> enumPairs;
+  };
+  // Every enum made through CreateEnum, shared by all thread's states
+  inline static std::mutex enumMutex;
+  inline static std::vector<SharedEnum> sharedEnums;
+  inline static uint64_t sharedEnumRevision = 0u;
+
+  /*!
+   *  Creates any shared enums this state is missing
+   */
+  void SyncEnums();
+  void PushEnum(const std::string &luaEnum
+                , const std::vector<EnumPair> &enumPairs);
 };
 }
@@ -116,6 +116,22 @@ public:
     return it->second.get();
   }
 
+  /*!
+   *  Calls the given function with the name and item of everything on the
+   *  shelf in name order.
+   *
+   *  \param function
+   *    A callable taking (const std::string &, T *)
+  */
+  template<typename Function>
+  void ForEachItem(Function function)
+  {
+    for(std::pair<const std::string, std::unique_ptr<T>> &item : shelf)
+    {
+      function(item.first, item.second.get());
+    }
+  }
+
 private:
   std::map<std::string, std::unique_ptr<T>> shelf;
 
@@ -0,0 +1,110 @@
+/*
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    Clarity_LuaBatch.h
+ *
+ *  \brief
+ *    An interface for handing lua scripts contiguous arrays of component
+ *    data so a whole batch of entities is processed in one lua call
+*/
+#pragma once
+
+extern "C"
+{
+  #include <lua.h>
+}
+
+#include <string>
+#include <vector>
+
+namespace ClaPP
+{
+/*!
+ * \class LuaBatch
+ *
+ * \brief
+ *  A set of named float columns holding one value per entity.
+ *
+ *  When pushed to lua the batch is a table with a count and one userdata
+ *  per column that indexes straight into the column's memory, so a script
+ *  reads and writes batch.posX[i] without any copying. The userdata are
+ *  invalidated after the call so a script that keeps a column can never
+ *  touch memory the batch has since reallocated.
+ */
+class LuaBatch
+{
+public:
+  inline static const std::string FLOAT_ARRAY_METATABLE = "ClaPP.FloatArray";
+
+  LuaBatch();
+  ~LuaBatch();
+
+  /*!
+   *  Adds a column, should only be called while setting up the batch
+   *
+   *  \param columnName
+   *    The name the column is accessed with from lua
+   *
+   *  \returns
+   *    The index of the column used with GetColumn
+   */
+  size_t AddColumn(const std::string &columnName);
+
+  /*!
+   *  Resizes every column to hold count values
+   */
+  void Resize(const size_t &count);
+
+  /*!
+   *  \returns
+   *    The values of the column at the given index
+   */
+  float *GetColumn(const size_t &columnIndex);
+
+  /*!
+   *  \returns
+   *    The number of values in each column
+   */
+  const size_t &GetCount() const;
+
+  /*!
+   *  Pushes the batch as a table onto the top of the lua stack. The table
+   *  is kept alive until Invalidate is called.
+   */
+  void Push(lua_State *state);
+
+  /*!
+   *  Detaches every column pushed by the last Push from the batch's memory
+   *  and releases the table. Must be called once the script returns and
+   *  before the batch is resized or destroyed.
+   */
+  void Invalidate();
+
+private:
+  // The userdata a column is exposed through
+  struct FloatArray
+  {
+    float *data;
+    lua_Integer size;
+  };
+
+  static int FloatArrayIndex(lua_State *state);
+  static int FloatArrayNewIndex(lua_State *state);
+  static int FloatArrayLength(lua_State *state);
+
+  std::vector<std::string> columnNames;
+  std::vector<std::vector<float>> columns;
+  size_t count;
+
+  // The state, anchored table, and userdata made by the last Push
+  lua_State *pushedState;
+  int pushedTableRef;
+  std::vector<FloatArray *> pushedArrays;
+
+  LuaBatch(const LuaBatch &other) = delete;
+  LuaBatch &operator=(const LuaBatch &other) = delete;
+};
+}
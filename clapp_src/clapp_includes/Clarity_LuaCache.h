@@ -0,0 +1,139 @@
+/*
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    Clarity_LuaCache.h
+ *
+ *  \brief
+ *    An interface for caching compiled lua bytecode on disk so scripts are
+ *    only lexed and parsed when they change
+*/
+#pragma once
+
+extern "C"
+{
+  #include <lua.h>
+}
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+namespace ClaPP
+{
+/*!
+ * \class LuaBytecodeCache
+ *
+ * \brief
+ *  Stores the lua_dump output of compiled scripts in a cache directory,
+ *  one file per script, and loads it back with luaL_loadbufferx.
+ *
+ *  Each cached chunk is stamped with what it was compiled from. Loose files
+ *  are stamped with their modification time and size so a hit never reads
+ *  the source, scripts from the archive or given as source are stamped with
+ *  a hash of their contents. A stale or unreadable cache file is treated as
+ *  a miss and rewritten.
+ */
+class LuaBytecodeCache
+{
+public:
+  /*!
+   *  Identifies the source a chunk was compiled from
+   */
+  struct SourceStamp
+  {
+    int64_t modifiedTime = 0;
+    uint64_t sourceSize = 0;
+    uint64_t sourceHash = 0;
+
+    bool operator==(const SourceStamp &other) const = default;
+  };
+
+  inline static const std::string DEFAULT_CACHE_PATH = "../clapp_cache/lua";
+
+  static LuaBytecodeCache &GetInstance();
+
+  /*!
+   *  Sets the directory cached chunks are read from and written to
+   */
+  void SetCacheDirectory(const std::string &cacheDirectory);
+
+  /*!
+   *  Enables or disables the cache, when disabled every load is a miss and
+   *  nothing is written
+   */
+  void SetEnabled(const bool &enabled);
+
+  /*!
+   *  Creates a stamp for a loose file without reading it
+   *
+   *  \returns
+   *    If the file exists and could be stamped
+   */
+  static bool StampFile(const std::string &luaPath, SourceStamp &stamp);
+  /*!
+   *  Creates a stamp from the contents of a script
+   */
+  static SourceStamp StampSource(const std::string &luaSource);
+
+  /*!
+   *  Loads a cached chunk onto the top of the lua stack as a function
+   *
+   *  \param state
+   *    The lua state the chunk is loaded into
+   *  \param luaPath
+   *    The path of the script, also used as the chunk name
+   *  \param stamp
+   *    The stamp of the current source, a cached chunk with a different
+   *    stamp is a miss
+   *
+   *  \returns
+   *    If the chunk was loaded, nothing is pushed on a miss
+   */
+  bool Load(lua_State *state, const std::string &luaPath
+            , const SourceStamp &stamp);
+
+  /*!
+   *  Dumps the function on the top of the lua stack into the cache. The
+   *  function is left on the stack.
+   *
+   *  \param state
+   *    The lua state holding the compiled chunk
+   *  \param luaPath
+   *    The path of the script the chunk was compiled from
+   *  \param stamp
+   *    The stamp of the source the chunk was compiled from
+   */
+  void Store(lua_State *state, const std::string &luaPath
+             , const SourceStamp &stamp);
+
+private:
+  struct CacheHeader
+  {
+    char magic[4];
+    uint32_t version;
+    // Bytecode is only valid for the lua version that dumped it
+    uint32_t luaVersion;
+    uint32_t padding;
+    SourceStamp stamp;
+  };
+
+  inline static const char CACHE_MAGIC[4] = {'C', 'L', 'B', 'C'};
+  inline static const uint32_t CACHE_VERSION = 1u;
+
+  LuaBytecodeCache();
+  ~LuaBytecodeCache();
+
+  LuaBytecodeCache(const LuaBytecodeCache &other) = delete;
+  LuaBytecodeCache &operator=(const LuaBytecodeCache &other) = delete;
+
+  std::string GetCachePath(const std::string &luaPath) const;
+
+  std::string cacheDirectory;
+  bool isEnabled;
+  // Guards the settings as states on other threads may share the cache
+  mutable std::mutex cacheMutex;
+};
+}
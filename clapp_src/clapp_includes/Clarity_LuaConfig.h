@@ -0,0 +1,182 @@
+/*
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    Clarity_LuaConfig.h
+ *
+ *  \brief
+ *    An interface for reading lua config scripts into an immutable tree
+ *    queried by path
+*/
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../../external/glm/glm.hpp"
+
+struct lua_State;
+
+namespace ClaPP
+{
+/*!
+ * \class LuaConfig
+ *
+ * \brief
+ *  A lua script's globals copied into a tree once it has run.
+ *
+ *  Values are found with dotted paths such as "Mesh.vertices" where number
+ *  segments index sequences from 1, e.g. "Mesh.type.1". Once loaded the
+ *  tree never changes and never touches lua, so any number of threads can
+ *  read the same config at once and a failed query can not leave anything
+ *  unbalanced.
+ *
+ *  Scripts run in their own environment that falls back to the globals of
+ *  the loading thread's LuaState, so engine enums are usable but only what
+ *  the script defines ends up in the tree.
+ */
+class LuaConfig
+{
+public:
+  enum CONFIG_ERR
+  {
+    CONFIG_NO_ERR = 0
+    , CONFIG_FILE_NOT_FOUND
+    , CONFIG_INVALID_FILE
+    , CONFIG_INVALID_PATH
+    , CONFIG_INCORRECT_TYPE
+  };
+
+  enum VALUE_TYPE
+  {
+    VALUE_NIL = 0
+    , VALUE_BOOL
+    , VALUE_NUMBER
+    , VALUE_STRING
+    , VALUE_TABLE
+  };
+
+  LuaConfig();
+  ~LuaConfig();
+
+  /*!
+   *  Runs a script on the calling thread's LuaState and copies its globals
+   *  into this config, replacing anything loaded before
+   *
+   *  \param luaPath
+   *    The path of the script, loaded through the archive when mounted
+   *
+   *  \returns
+   *    A config error result. Will return CONFIG_NO_ERR if none is found
+   */
+  CONFIG_ERR LoadFile(const std::string &luaPath);
+  /*!
+   *  The same as LoadFile for a script already in memory
+   *
+   *  \param luaSource
+   *    The source of the script
+   *  \param luaPath
+   *    The path the source came from, used for errors and caching
+   */
+  CONFIG_ERR LoadBuffer(const std::string &luaSource
+                        , const std::string &luaPath);
+
+  /*!
+   *  \returns
+   *    The type of the value at the path, VALUE_NIL if there is none
+   */
+  VALUE_TYPE GetType(const std::string_view &path) const;
+  /*!
+   *  \returns
+   *    If there is a value at the path
+   */
+  bool Has(const std::string_view &path) const;
+
+  CONFIG_ERR GetNumber(const std::string_view &path, float &value) const;
+  CONFIG_ERR GetNumber(const std::string_view &path, double &value) const;
+  CONFIG_ERR GetNumber(const std::string_view &path, int &value) const;
+  CONFIG_ERR GetString(const std::string_view &path
+                       , std::string &value) const;
+  CONFIG_ERR GetBool(const std::string_view &path, bool &value) const;
+
+  /*!
+   *  Gets the length of the sequence part of the table at the path
+   */
+  CONFIG_ERR GetLength(const std::string_view &path, size_t &length) const;
+  /*!
+   *  Gets the names of the named fields of the table at the path in
+   *  sorted order
+   */
+  CONFIG_ERR GetKeys(const std::string_view &path
+                     , std::vector<std::string> &keys) const;
+
+  /*!
+   *  Copies a sequence of numbers into the given vector, overwriting it.
+   *  The vec getters refuse a sequence that does not fill whole vectors.
+   */
+  CONFIG_ERR GetNumberArray(const std::string_view &path
+                            , std::vector<float> &values) const;
+  CONFIG_ERR GetNumberArray(const std::string_view &path
+                            , std::vector<unsigned int> &values) const;
+  CONFIG_ERR GetVec2Array(const std::string_view &path
+                          , std::vector<glm::vec2> &values) const;
+  CONFIG_ERR GetVec3Array(const std::string_view &path
+                          , std::vector<glm::vec3> &values) const;
+
+  /*!
+   *  \returns
+   *    The path of the script this config was loaded from
+   */
+  const std::string &GetFilePath() const;
+
+private:
+  // Tables nested deeper than this are not copied, guarding against cycles
+  inline static const int MAX_DEPTH = 32;
+
+  struct Node
+  {
+    VALUE_TYPE type = VALUE_NIL;
+    bool boolean = false;
+    double number = 0.0;
+    std::string string;
+    // A sequence of only numbers is packed here instead of as nodes
+    std::vector<double> numbers;
+    // The node index of each element of any other sequence
+    std::vector<uint32_t> elements;
+    // Named fields sorted by name with their node index
+    std::vector<std::pair<std::string, uint32_t>> fields;
+  };
+
+  // Every node with the root at index 0
+  std::vector<Node> nodes;
+  std::string filePath;
+
+  // What a path resolves to, either a node or a number packed in its
+  // parent's sequence
+  struct Lookup
+  {
+    const Node *node = nullptr;
+    const double *number = nullptr;
+  };
+
+  // Fills the tree while a script's environment is on the lua stack
+  friend class LuaState;
+
+  /*!
+   *  Replaces the tree with a copy of the table at the given stack index
+   */
+  void CopyRoot(lua_State *state, const int &index);
+  void CopyValue(lua_State *state, const int &index, const uint32_t &node
+                 , const int &depth);
+  void CopyTable(lua_State *state, const int &index, const uint32_t &node
+                 , const int &depth);
+
+  Lookup Find(const std::string_view &path) const;
+  CONFIG_ERR GetSequence(const std::string_view &path
+                         , const std::vector<double> *&numbers) const;
+};
+}
@@ -0,0 +1,80 @@
+/*!
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    Clarity_LuaSystem.h
+ *
+ *  \brief
+ *    The interface file for systems whose update is written in lua
+ */
+#pragma once
+
+#include "Clarity_System.h"
+#include "Clarity_LuaBatch.h"
+
+#include "../../external/glm/vec3.hpp"
+
+#include <vector>
+
+namespace ClaPP
+{
+/*!
+ *  \class LuaSystem
+ *  \paragraph
+ *    Runs a script's update(dt, batch) function once per frame over every
+ *    entity with a transform and physics component.
+ *
+ *  The components are gathered into contiguous columns before the call and
+ *  written back after it, so the script loops over the whole batch itself
+ *  and only one lua call is made per frame no matter the entity count.
+ *
+ *  The batch holds count and the columns posX/Y/Z, rotX/Y/Z, scaleX/Y/Z,
+ *  velX/Y/Z, and forceX/Y/Z indexed from 1 to count. Rotations are Euler
+ *  angles in degrees.
+ */
+class LuaSystem : public Clarity_System
+{
+public:
+  /*!
+   *  \param _sysName
+   *    The name of the system
+   *  \param _scriptPath
+   *    The script defining a global update(dt, batch) function
+   */
+  LuaSystem(const std::string &_sysName, const std::string &_scriptPath);
+  ~LuaSystem();
+
+  SYS_ERR Initialize();
+  SYS_ERR Load();
+  SYS_ERR Update(float deltaTime);
+  SYS_ERR Render();
+  SYS_ERR Unload();
+  SYS_ERR Terminate();
+
+private:
+  // Index of the first of each vector's x, y, and z columns
+  enum BATCH_COLUMN
+  {
+    COLUMN_POSITION = 0
+    , COLUMN_ROTATION = 3
+    , COLUMN_SCALE = 6
+    , COLUMN_VELOCITY = 9
+    , COLUMN_FORCE = 12
+    , COLUMN_COUNT = 15
+  };
+
+  std::string scriptPath;
+  int updateRef;
+  LuaBatch batch;
+  // The entity each batch index was gathered from
+  std::vector<ENTITY_ID> batchEntities;
+  // The Euler rotation each entity was gathered with, used to tell if the
+  // script changed it
+  std::vector<glm::vec3> batchRotations;
+
+  LuaSystem(const LuaSystem &other) = delete;
+  LuaSystem &operator=(const LuaSystem &other) = delete;
+};
+}
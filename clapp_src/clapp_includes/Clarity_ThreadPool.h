@@ -0,0 +1,130 @@
+/*
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    Clarity_ThreadPool.h
+ *
+ *  \brief
+ *    An interface for a fixed pool of worker threads used to split loops
+ *    across every core
+*/
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ClaPP
+{
+/*!
+ * \class ThreadPool
+ *
+ * \brief
+ *  A fixed set of worker threads that run ParallelFor loops.
+ *
+ *  The calling thread takes part in every loop so a pool with no workers
+ *  runs everything inline. Only one loop runs at a time and a ParallelFor
+ *  called from inside a loop runs inline on the thread that called it.
+ *
+ *  Workers live for the life of the pool, so anything thread local such
+ *  as each thread's LuaState stays alive between loops. The shared pool
+ *  has one worker per extra core, pools of any size can be made to run
+ *  loops on a set number of threads, such as to check a result does not
+ *  depend on how the loop was split.
+ */
+class ThreadPool
+{
+public:
+  /*!
+   *  The function run over each range of a loop
+   *
+   *  \param begin
+   *    The first index of the range
+   *  \param end
+   *    One past the last index of the range
+   *  \param threadIndex
+   *    0 for the calling thread and 1 to GetThreadCount() - 1 for workers,
+   *    used to index per thread scratch data
+   */
+  typedef std::function<void(const size_t &begin, const size_t &end
+                             , const size_t &threadIndex)> RangeFunction;
+
+  // NOTE: Singleton as the pool should match the core count and be shared
+  // by every system rather than oversubscribing the cpu
+  static ThreadPool &GetInstance();
+
+  /*!
+   *  \param workerCount
+   *    The number of threads started alongside the calling thread, 0 runs
+   *    every loop inline
+   */
+  ThreadPool(const size_t &workerCount);
+  ~ThreadPool();
+
+  /*!
+   *  Stops the workers and starts workerCount new ones. Must not be called
+   *  from inside one of the pool's loops.
+   */
+  void SetWorkerCount(const size_t &workerCount);
+
+  /*!
+   *  Splits [0, count) into batches and runs them on every thread,
+   *  returning once all have finished
+   *
+   *  \param count
+   *    The number of indices in the loop
+   *  \param function
+   *    Called with each batch's range
+   *  \param batchSize
+   *    The number of indices each thread takes at a time, larger batches
+   *    lower scheduling cost but balance worse
+   */
+  void ParallelFor(const size_t &count, const RangeFunction &function
+                   , const size_t &batchSize = 1);
+
+  /*!
+   *  \returns
+   *    The number of threads loops are split across, including the caller
+   */
+  size_t GetThreadCount() const;
+
+private:
+  ThreadPool();
+
+  ThreadPool(const ThreadPool &other) = delete;
+  ThreadPool &operator=(const ThreadPool &other) = delete;
+
+  void StartWorkers(const size_t &workerCount);
+  void StopWorkers();
+  // Runs every loop started after startGeneration until stopped
+  void WorkerLoop(const size_t &threadIndex, const uint64_t &startGeneration);
+  // Takes batches from the current loop until none are left
+  void RunBatches(const size_t &threadIndex);
+
+  std::vector<std::thread> workers;
+
+  // Only one loop can be in flight at a time
+  std::mutex loopMutex;
+
+  // Guards handing a loop to the workers
+  std::mutex workMutex;
+  std::condition_variable workCondition;
+  std::condition_variable doneCondition;
+  // Bumped for every loop so workers know a new one has started
+  uint64_t loopGeneration;
+  size_t workersRunning;
+  bool isStopping;
+
+  // The loop currently being run
+  const RangeFunction *loopFunction;
+  size_t loopCount;
+  size_t loopBatchSize;
+  std::atomic<size_t> nextIndex;
+};
+}
@@ -0,0 +1,137 @@
+/*
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    Clarity_TimerWheel.h
+ *
+ *  \brief
+ *    An interface for scheduling large numbers of timed callbacks with a
+ *    hierarchical timer wheel
+*/
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ClaPP
+{
+/*!
+ * \class TimerWheel
+ *
+ * \brief
+ *  Fires callbacks once a delay has passed, at a fixed tick resolution.
+ *
+ *  Timers are kept in levels of slots where each level covers 64 times the
+ *  time of the level below. A timer goes into the lowest level that can
+ *  hold its expiry and is moved down a level each time the wheel reaches
+ *  its slot, so scheduling, cancelling, and expiring are all constant time
+ *  no matter how many timers are pending.
+ *
+ *  Timers live in a pool of nodes linked into their slot by index, so
+ *  scheduling does not allocate once the pool has grown to the peak number
+ *  of pending timers. Not thread safe, the wheel is advanced on the main
+ *  thread by the event manager.
+ */
+class TimerWheel
+{
+public:
+  // Calls whatever the timer was scheduled for with its stored payload
+  typedef void (*FireFunction)(const void *payload);
+
+  // The generation of the node in the high bits and its index in the low
+  // bits, so the id of a fired or cancelled timer is never valid again
+  typedef uint64_t TIMER_ID;
+  inline static const TIMER_ID INVALID_TIMER = 0u;
+
+  // The largest payload a timer can carry
+  inline static const size_t PAYLOAD_SIZE = 32u;
+  inline static const float DEFAULT_TICK_DURATION = 0.01f;
+
+  /*!
+   *  \param tickDuration
+   *    The resolution of the wheel in seconds, timers fire on the first
+   *    tick at or after their delay
+   */
+  TimerWheel(const float &tickDuration = DEFAULT_TICK_DURATION);
+  ~TimerWheel();
+
+  /*!
+   *  Schedules a function to be called once a delay has passed
+   *
+   *  \param delay
+   *    The time in seconds until the timer fires, at least one tick
+   *  \param fire
+   *    The function called with a copy of the payload
+   *  \param payload
+   *    The data handed to the function, copied into the timer
+   *  \param payloadSize
+   *    The size of the payload, at most PAYLOAD_SIZE
+   *
+   *  \returns
+   *    The id used to cancel the timer, INVALID_TIMER if it was not
+   *    scheduled
+   */
+  TIMER_ID Schedule(const float &delay, FireFunction fire
+                    , const void *payload, const size_t &payloadSize);
+
+  /*!
+   *  Stops a timer from firing
+   *
+   *  \returns
+   *    If the timer was still pending
+   */
+  bool Cancel(const TIMER_ID &timerID);
+
+  /*!
+   *  Moves the wheel forward by real time, firing every timer whose delay
+   *  has passed in the order they expire
+   */
+  void Advance(const float &deltaTime);
+
+  size_t GetPendingCount() const;
+  const float &GetTickDuration() const;
+
+private:
+  inline static const uint32_t LEVEL_BITS = 6u;
+  inline static const uint32_t SLOT_COUNT = 1u << LEVEL_BITS;
+  inline static const uint32_t SLOT_MASK = SLOT_COUNT - 1u;
+  // 4 levels of 64 slots covers 2^24 ticks, around 46 hours at 10ms ticks
+  inline static const uint32_t LEVEL_COUNT = 4u;
+  inline static const uint32_t NIL_NODE = UINT32_MAX;
+
+  struct TimerNode
+  {
+    uint64_t expireTick = 0u;
+    // Links within the slot the node is in
+    uint32_t next = NIL_NODE;
+    uint32_t prev = NIL_NODE;
+    // The slot the node is in so it can be unlinked, NIL_NODE when free
+    uint32_t slot = NIL_NODE;
+    uint32_t generation = 1u;
+    FireFunction fire = nullptr;
+    alignas(std::max_align_t) unsigned char payload[PAYLOAD_SIZE];
+  };
+
+  void Insert(const uint32_t &nodeIndex);
+  void Unlink(const uint32_t &nodeIndex);
+  void Release(const uint32_t &nodeIndex);
+  // Moves every node in a slot down to the level that now fits it
+  void Cascade(const uint32_t &slot);
+  void ProcessTick();
+
+  float tickDuration;
+  // Time that has passed but not yet made a whole tick
+  float tickAccumulator;
+  uint64_t currentTick;
+  size_t pendingCount;
+
+  std::vector<TimerNode> nodes;
+  uint32_t freeHead;
+  // The first node of each slot, level by level
+  std::array<uint32_t, LEVEL_COUNT * SLOT_COUNT> slotHeads;
+};
+}
@@ -12,6 +12,14 @@
 #pragma once
 
 #include "clapp_ut_file.h"
+#include "clapp_ut_archive.h"
+#include "clapp_ut_texture.h"
+#include "clapp_ut_luacache.h"
+#include "clapp_ut_lua.h"
+#include "clapp_ut_input.h"
+#include "clapp_ut_event.h"
+#include "clapp_ut_timer.h"
+#include "clapp_ut_physics.h"
 
 namespace ClaPP_UnitTests
 {
@@ -0,0 +1,183 @@
+/*
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    clapp_ut_archive.cpp
+ *
+ *  \brief
+ *    An implementation file used to define what asset archive unit tests
+ *    are like
+*/
+
+#include "../clapp_includes/pch.h"
+
+#include "clapp_ut_archive.h"
+
+#include "../clapp_includes/Clarity_IO.h"
+#include "../clapp_includes/Clarity_Archive.h"
+#include "../clapp_includes/Clarity_Compression.h"
+
+namespace ClaPP_UnitTests
+{
+UNIT_TEST_STATUS TestCompression_RoundTrip()
+{
+  std::string text;
+  for(int i = 0; i < 200; ++i)
+  {
+    text += "vertices = { -0.5, 0.5, 0.0 }, -- " + std::to_string(i % 7) + "\n";
+  }
+
+  std::vector<uint8_t> compressed;
+  assert(ClaPP::CompressBlock(reinterpret_cast<const uint8_t *>(text.data())
+                              , text.size(), compressed)
+         == ClaPP::COMPRESSION_NO_ERR);
+  assert(compressed.size() < text.size());
+
+  std::string result(text.size(), '\0');
+  assert(ClaPP::DecompressBlock(compressed.data(), compressed.size()
+                                , reinterpret_cast<uint8_t *>(result.data())
+                                , result.size()) == ClaPP::COMPRESSION_NO_ERR);
+  assert(result == text);
+
+  // Random bytes should not shrink and must be stored raw by the caller
+  std::mt19937 rng(42);
+  std::vector<uint8_t> noise(4096);
+  for(uint8_t &byte : noise)
+  {
+    byte = static_cast<uint8_t>(rng());
+  }
+  assert(ClaPP::CompressBlock(noise.data(), noise.size(), compressed)
+         == ClaPP::COMPRESSION_NOT_SMALLER);
+
+  // A truncated block must be reported instead of overrunning
+  assert(ClaPP::DecompressBlock(compressed.data(), compressed.size() / 2
+                                , noise.data(), noise.size())
+         != ClaPP::COMPRESSION_NO_ERR);
+
+  return true;
+}
+UNIT_TEST_STATUS TestArchive_BuildMountRead()
+{
+  std::string shaderText = "#version 330 core\nvoid main() {}\n";
+  std::string scriptText;
+  for(int i = 0; i < 100; ++i)
+  {
+    scriptText += "Mesh = { type = \"CubeMesh\" }\n";
+  }
+
+  std::ofstream("clapput_shader.txt", std::ios::binary) << shaderText;
+  std::ofstream("clapput_script.lua", std::ios::binary) << scriptText;
+
+  std::vector<std::string> files = {"clapput_shader.txt", "clapput_script.lua"};
+  assert(ClaPP::AssetArchive::Build("clapput.cpak", ".", files, true)
+         == ClaPP::AssetArchive::ARCHIVE_NO_ERR);
+
+  ClaPP::AssetArchive &archive = ClaPP::AssetArchive::GetInstance();
+  assert(archive.Mount("clapput.cpak") == ClaPP::AssetArchive::ARCHIVE_NO_ERR);
+
+  std::string data;
+  assert(archive.ReadEntry("clapput_shader.txt", data)
+         == ClaPP::AssetArchive::ARCHIVE_NO_ERR);
+  assert(data == shaderText);
+  assert(archive.ReadEntry("clapput_script.lua", data)
+         == ClaPP::AssetArchive::ARCHIVE_NO_ERR);
+  assert(data == scriptText);
+
+  // The script is repetitive so it is compressed and has no raw view
+  std::string_view view;
+  assert(archive.FindEntry("clapput_script.lua", view)
+         == ClaPP::AssetArchive::ARCHIVE_CORRUPT_ENTRY);
+  assert(archive.FindEntry("clapput_shader.txt", view)
+         == ClaPP::AssetArchive::ARCHIVE_NO_ERR);
+  assert(view == shaderText);
+
+  assert(archive.Unmount() == ClaPP::AssetArchive::ARCHIVE_NO_ERR);
+
+  // An uncompressed entry is read by its raw size, so one claiming more
+  // than was stored must be refused rather than read past the file
+  std::ifstream packed("clapput.cpak", std::ios::binary);
+  std::string bytes((std::istreambuf_iterator<char>(packed))
+                    , std::istreambuf_iterator<char>());
+  packed.close();
+  ClaPP::AssetArchive::ArchiveHeader header;
+  std::memcpy(&header, bytes.data(), sizeof(header));
+  for(uint32_t slot = 0; slot < header.tableSize; ++slot)
+  {
+    const size_t offset = header.tableOffset
+                          + slot * sizeof(ClaPP::AssetArchive::ArchiveEntry);
+    ClaPP::AssetArchive::ArchiveEntry entry;
+    std::memcpy(&entry, bytes.data() + offset, sizeof(entry));
+    if(entry.pathHash != 0u
+       && !(entry.flags & ClaPP::AssetArchive::ENTRY_FLAG_COMPRESSED))
+    {
+      entry.rawSize = 1u << 30;
+      std::memcpy(bytes.data() + offset, &entry, sizeof(entry));
+    }
+  }
+  std::ofstream("clapput.cpak", std::ios::binary) << bytes;
+
+  assert(archive.Mount("clapput.cpak") == ClaPP::AssetArchive::ARCHIVE_NO_ERR);
+  assert(archive.ReadEntry("clapput_shader.txt", data)
+         == ClaPP::AssetArchive::ARCHIVE_ENTRY_NOT_FOUND);
+  assert(archive.FindEntry("clapput_shader.txt", view)
+         == ClaPP::AssetArchive::ARCHIVE_ENTRY_NOT_FOUND);
+  // The compressed entry is untouched
+  assert(archive.ReadEntry("clapput_script.lua", data)
+         == ClaPP::AssetArchive::ARCHIVE_NO_ERR);
+  assert(archive.Unmount() == ClaPP::AssetArchive::ARCHIVE_NO_ERR);
+
+  return true;
+}
+UNIT_TEST_STATUS TestArchive_PathLookup()
+{
+  assert(ClaPP::AssetArchive::NormalizePath("../clapp_shaders/vertShader.txt")
+         == "clapp_shaders/vertShader.txt");
+  assert(ClaPP::AssetArchive::NormalizePath("./../a\\b.lua") == "a/b.lua");
+
+  std::ofstream("clapput_shader.txt", std::ios::binary) << "shader";
+  std::vector<std::string> files = {"clapput_shader.txt"};
+  assert(ClaPP::AssetArchive::Build("clapput.cpak", ".", files, false)
+         == ClaPP::AssetArchive::ARCHIVE_NO_ERR);
+
+  ClaPP::AssetArchive &archive = ClaPP::AssetArchive::GetInstance();
+  assert(archive.Mount("clapput.cpak") == ClaPP::AssetArchive::ARCHIVE_NO_ERR);
+
+  assert(archive.Contains("../clapput_shader.txt"));
+  assert(!archive.Contains("clapput_missing.txt"));
+
+  std::string data;
+  assert(archive.ReadEntry("clapput_missing.txt", data)
+         == ClaPP::AssetArchive::ARCHIVE_ENTRY_NOT_FOUND);
+
+  archive.Unmount();
+
+  // A table with no empty slot would never end a failed lookup, so it is
+  // refused even though its header claims room to spare
+  std::ifstream packed("clapput.cpak", std::ios::binary);
+  std::string bytes((std::istreambuf_iterator<char>(packed))
+                    , std::istreambuf_iterator<char>());
+  packed.close();
+  ClaPP::AssetArchive::ArchiveHeader header;
+  std::memcpy(&header, bytes.data(), sizeof(header));
+  for(uint32_t slot = 0; slot < header.tableSize; ++slot)
+  {
+    const size_t offset = header.tableOffset
+                          + slot * sizeof(ClaPP::AssetArchive::ArchiveEntry);
+    uint64_t pathHash = 0u;
+    std::memcpy(&pathHash, bytes.data() + offset, sizeof(pathHash));
+    if(pathHash == 0u)
+    {
+      pathHash = slot + 1u;
+      std::memcpy(bytes.data() + offset, &pathHash, sizeof(pathHash));
+    }
+  }
+  std::ofstream("clapput.cpak", std::ios::binary) << bytes;
+  assert(archive.Mount("clapput.cpak")
+         == ClaPP::AssetArchive::ARCHIVE_INVALID_FORMAT);
+  assert(!archive.Contains("clapput_missing.txt"));
+
+  return true;
+}
+}
@@ -0,0 +1,35 @@
+/*
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    clapp_ut_archive.h
+ *
+ *  \brief
+ *    An interface used to store all asset archive unit tests for ClaPP
+*/
+#pragma once
+
+namespace ClaPP_UnitTests
+{
+typedef bool UNIT_TEST_STATUS;
+
+/*!
+ *  Compress and decompress repetitive and random data to ensure the data
+ *  is unchanged and that random data is reported as not compressible.
+ */
+UNIT_TEST_STATUS TestCompression_RoundTrip();
+/*!
+ *  Build an archive from a few written files, mount it, and read each
+ *  entry back both raw and compressed. An uncompressed entry whose raw
+ *  size no longer matches its stored size must not be found.
+ */
+UNIT_TEST_STATUS TestArchive_BuildMountRead();
+/*!
+ *  Ensure that relative runtime paths resolve to packed names, that
+ *  missing entries are reported, and that a table with no empty slot is
+ *  refused.
+ */
+UNIT_TEST_STATUS TestArchive_PathLookup();
+}
@@ -0,0 +1,155 @@
+/*
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    clapp_ut_event.cpp
+ *
+ *  \brief
+ *    An implementation file used to define what event manager unit tests
+ *    are like
+*/
+
+#include "../clapp_includes/pch.h"
+
+#include "clapp_ut_event.h"
+
+#include <thread>
+
+#include "../clapp_includes/Clarity_EventManager.h"
+#include "../clapp_includes/Clarity_EventQueue.h"
+
+using ClaPP::EventManager;
+using ClaPP::TerminateEngineEvent;
+
+namespace ClaPP_UnitTests
+{
+UNIT_TEST_STATUS TestEvent_TypedChannels()
+{
+  EventManager &manager = EventManager::GetInstance();
+  manager.ReserveChannel<TerminateEngineEvent>(2);
+
+  size_t received = 0;
+  const EventManager::SUBSCRIBER_ID subscriber 
+    = manager.Subscribe<TerminateEngineEvent>(
+      [&received](const TerminateEngineEvent &) { ++received; });
+
+  manager.SendEvent(TerminateEngineEvent());
+  manager.SendEvent(TerminateEngineEvent());
+  // The channel is full so the third is dropped
+  manager.SendEvent(TerminateEngineEvent());
+  // Nothing is readable until the frame ends
+  assert(!manager.HasEvent<TerminateEngineEvent>());
+  assert(received == 0);
+
+  manager.Update(0.f);
+  assert(received == 2);
+  assert(manager.GetEventCount<TerminateEngineEvent>() == 2);
+
+  EventManager::ChannelStats stats 
+    = manager.GetChannelStats<TerminateEngineEvent>();
+  assert(stats.capacity == 2 && stats.droppedEvents == 1);
+  assert(stats.highWaterMark == 2);
+
+  // Unsubscribed functions are no longer called and the last frame's
+  // events are gone after the next update
+  manager.Unsubscribe<TerminateEngineEvent>(subscriber);
+  manager.SendEvent(TerminateEngineEvent());
+  manager.Update(0.f);
+  assert(received == 2);
+  assert(manager.GetEventCount<TerminateEngineEvent>() == 1);
+  manager.Update(0.f);
+  assert(!manager.HasEvent<TerminateEngineEvent>());
+
+  // Resizing a channel in use keeps its subscribers and what was sent
+  const EventManager::SUBSCRIBER_ID resizedSubscriber
+    = manager.Subscribe<TerminateEngineEvent>(
+      [&received](const TerminateEngineEvent &) { ++received; });
+  manager.SendEvent(TerminateEngineEvent());
+  manager.ReserveChannel<TerminateEngineEvent>(
+    EventManager::DEFAULT_CHANNEL_CAPACITY);
+  manager.SendEvent(TerminateEngineEvent());
+  manager.Update(0.f);
+  assert(received == 4);
+  assert(manager.GetEventCount<TerminateEngineEvent>() == 2);
+  manager.Unsubscribe<TerminateEngineEvent>(resizedSubscriber);
+  manager.Update(0.f);
+
+  return true;
+}
+
+UNIT_TEST_STATUS TestEvent_QueueProducers()
+{
+  const size_t producerCount = 4;
+  const size_t pushCount = 10000;
+  ClaPP::MPSCQueue<size_t> queue(64);
+
+  // Producers retry when full while this thread drains, every value must
+  // come out exactly once and in order per producer
+  std::vector<std::thread> producers;
+  for(size_t p = 0; p < producerCount; ++p)
+  {
+    producers.emplace_back([&queue, p, pushCount]()
+    {
+      for(size_t i = 0; i < pushCount; ++i)
+      {
+        while(!queue.TryPush(p * pushCount + i))
+        {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  std::vector<size_t> nextValue(producerCount, 0);
+  size_t popped = 0;
+  size_t value = 0;
+  while(popped < producerCount * pushCount)
+  {
+    if(queue.TryPop(value))
+    {
+      const size_t producer = value / pushCount;
+      assert(value % pushCount == nextValue[producer]);
+      ++nextValue[producer];
+      ++popped;
+    }
+  }
+
+  for(std::thread &producer : producers)
+  {
+    producer.join();
+  }
+  assert(!queue.TryPop(value));
+
+  return true;
+}
+
+UNIT_TEST_STATUS TestEvent_RemoveChecked()
+{
+  EventManager &manager = EventManager::GetInstance();
+  manager.AddEvent(EventManager::Event(EventManager::USER_SYSTEM
+                                       , EventManager::USER_ENTITY, "First"));
+  manager.AddEvent(EventManager::Event(EventManager::USER_SYSTEM
+                                       , EventManager::USER_ENTITY, "Second"));
+  manager.AddEvent(EventManager::Event(EventManager::USER_SYSTEM
+                                       , EventManager::USER_ENTITY, "Third"));
+
+  assert(manager.CheckEvent(EventManager::USER_SYSTEM
+                            , EventManager::USER_ENTITY, "First"));
+  assert(manager.CheckEvent(EventManager::USER_SYSTEM
+                            , EventManager::USER_ENTITY, "Second"));
+  manager.Update(0.f);
+
+  // Adjacent checked events are both removed and the unchecked one stays
+  assert(!manager.CheckEvent(EventManager::USER_SYSTEM
+                             , EventManager::USER_ENTITY, "First"));
+  assert(!manager.CheckEvent(EventManager::USER_SYSTEM
+                             , EventManager::USER_ENTITY, "Second"));
+  assert(manager.CheckEvent(EventManager::USER_SYSTEM
+                            , EventManager::USER_ENTITY, "Third"));
+  manager.Update(0.f);
+
+  return true;
+}
+}
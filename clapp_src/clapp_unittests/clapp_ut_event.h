@@ -0,0 +1,35 @@
+/*
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    clapp_ut_event.h
+ *
+ *  \brief
+ *    An interface used to store all event manager unit tests for ClaPP
+*/
+#pragma once
+
+namespace ClaPP_UnitTests
+{
+typedef bool UNIT_TEST_STATUS;
+
+/*!
+ *  Send typed events into a small channel, ensuring a full channel drops
+ *  and counts rather than grows, that events are readable for the frame
+ *  after they are sent, that subscribers get each event once, and that
+ *  resizing a channel in use keeps its subscribers and events.
+ */
+UNIT_TEST_STATUS TestEvent_TypedChannels();
+/*!
+ *  Push from several threads while one thread pops, ensuring every value
+ *  arrives once and in the order each producer pushed it.
+ */
+UNIT_TEST_STATUS TestEvent_QueueProducers();
+/*!
+ *  Check several string events in one frame and ensure the update removes
+ *  every checked event while keeping unchecked ones.
+ */
+UNIT_TEST_STATUS TestEvent_RemoveChecked();
+}
@@ -0,0 +1,168 @@
+/*
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    clapp_ut_input.cpp
+ *
+ *  \brief
+ *    An implementation file used to define what input unit tests are like
+*/
+
+#include "../clapp_includes/pch.h"
+
+#include "clapp_ut_input.h"
+
+#include <filesystem>
+
+#include "../clapp_includes/CIL_Inputs.h"
+#include "../clapp_includes/CIL_InputTrace.h"
+
+using ClaPP::KeyBindContainer;
+using ClaPP::InputTrace;
+
+namespace ClaPP_UnitTests
+{
+UNIT_TEST_STATUS TestInput_ActionIDs()
+{
+  KeyBindContainer *container = KeyBindContainer::GetInstance();
+
+  const KeyBindContainer::ACTION_ID jump 
+    = container->RegisterAction("UT_Jump");
+  const KeyBindContainer::ACTION_ID crouch 
+    = container->RegisterAction("UT_Crouch");
+  assert(jump != KeyBindContainer::INVALID_ACTION);
+  assert(crouch == jump + 1);
+
+  // Registering again is only a lookup
+  assert(container->RegisterAction("UT_Jump") == jump);
+  assert(container->GetActionID("UT_Crouch") == crouch);
+  assert(container->GetActionID("UT_Missing")
+         == KeyBindContainer::INVALID_ACTION);
+  assert(container->GetActionName(jump) == "UT_Jump");
+
+  container->ClearTriggeredEvents();
+  container->TriggerAction(crouch);
+  assert(container->CheckAction(crouch) && !container->CheckAction(jump));
+  assert(container->CheckEvent("UT_Crouch"));
+  assert(container->GetActionState().count() == 1);
+
+  // Unknown actions are never triggered
+  container->TriggerAction(KeyBindContainer::INVALID_ACTION);
+  assert(!container->CheckAction(KeyBindContainer::INVALID_ACTION));
+
+  container->ClearTriggeredEvents();
+  assert(container->GetActionState().none());
+
+  return true;
+}
+
+UNIT_TEST_STATUS TestInput_KeyTransitions()
+{
+  KeyBindContainer *container = KeyBindContainer::GetInstance();
+  container->ApplyKeyTransitions();
+
+  // A tap between frames and a key that stays down
+  container->QueueKeyTransition(KeyBindContainer::KEY_F12, true);
+  container->QueueKeyTransition(KeyBindContainer::KEY_F12, false);
+  container->QueueKeyTransition(KeyBindContainer::KEY_F11, true);
+  container->ApplyKeyTransitions();
+
+  assert(container->GetPressedKeys().test(KeyBindContainer::KEY_F12));
+  assert(container->GetReleasedKeys().test(KeyBindContainer::KEY_F12));
+  assert(!container->GetDownKeys().test(KeyBindContainer::KEY_F12));
+  assert(container->GetDownKeys().test(KeyBindContainer::KEY_F11));
+
+  // The next frame only keeps what is still held
+  container->QueueKeyTransition(KeyBindContainer::KEY_F11, false);
+  container->ApplyKeyTransitions();
+  assert(container->GetPressedKeys().none());
+  assert(container->GetReleasedKeys().count() == 1);
+  container->ApplyKeyTransitions();
+  assert(container->GetDownKeys().none());
+  assert(container->GetReleasedKeys().none());
+
+  for(int key = KeyBindContainer::KEY_SPACE
+      ; key < KeyBindContainer::KEY_MOUSE_LEFT; ++key)
+  {
+    const KeyBindContainer::KEYS engineKey 
+      = static_cast<KeyBindContainer::KEYS>(key);
+    assert(KeyBindContainer::ConvertFromGLFWKey(
+      KeyBindContainer::ConvertToGLFWKey(engineKey)) == engineKey);
+  }
+  assert(KeyBindContainer::ConvertFromGLFWMouseButton(1)
+         == KeyBindContainer::KEY_MOUSE_RIGHT);
+  assert(KeyBindContainer::ConvertFromGLFWKey(343) 
+         == KeyBindContainer::KEY_COUNT);
+
+  return true;
+}
+
+UNIT_TEST_STATUS TestInput_TraceReplay()
+{
+  const std::string tracePath = "../clapput_input.trace";
+  KeyBindContainer *container = KeyBindContainer::GetInstance();
+  InputTrace &trace = InputTrace::GetInstance();
+
+  const KeyBindContainer::ACTION_ID left 
+    = container->RegisterAction("UT_TraceLeft");
+  const KeyBindContainer::ACTION_ID right 
+    = container->RegisterAction("UT_TraceRight");
+
+  // Held, held, changed, released, so frames with and without action bits
+  KeyBindContainer::ActionState frames[4];
+  frames[0].set(left);
+  frames[1].set(left);
+  frames[2].set(right);
+  const float deltas[4] = {0.016f, 0.017f, 0.015f, 0.033f};
+
+  assert(trace.StartRecording(tracePath) == InputTrace::TRACE_NO_ERR);
+  assert(trace.StartReplay(tracePath) == InputTrace::TRACE_ALREADY_ACTIVE);
+  for(int i = 0; i < 4; ++i)
+  {
+    float deltaTime = deltas[i];
+    assert(trace.BeginFrame(deltaTime) && deltaTime == deltas[i]);
+    trace.RecordFrame(frames[i]);
+  }
+  assert(trace.GetFrameCount() == 4u);
+  trace.Stop();
+  assert(!trace.IsRecording());
+
+  // The header and a length prefixed name per action, then 4 frames of 5
+  // bytes where only the 3 frames that changed carry action bits
+  size_t traceSize = 16u + 4u * 5u + 3u * 8u;
+  for(KeyBindContainer::ACTION_ID i = 0; i < container->GetActionCount(); ++i)
+  {
+    traceSize += 1u + container->GetActionName(i).size();
+  }
+  assert(std::filesystem::file_size(tracePath) == traceSize);
+
+  assert(trace.StartReplay(tracePath) == InputTrace::TRACE_NO_ERR);
+  for(int i = 0; i < 4; ++i)
+  {
+    // The measured delta is replaced by the recorded one
+    float deltaTime = 1.f;
+    assert(trace.BeginFrame(deltaTime));
+    assert(deltaTime == deltas[i]);
+    assert(trace.GetFrameActions() == frames[i]);
+  }
+  float deltaTime = 1.f;
+  assert(!trace.BeginFrame(deltaTime));
+  trace.Stop();
+
+  // Anything but a trace is rejected
+  assert(trace.StartReplay("../clapput_missing.trace") 
+         == InputTrace::TRACE_FAILED_TO_OPEN);
+  {
+    std::ofstream invalid(tracePath, std::ios::binary | std::ios::trunc);
+    invalid << "not a trace file";
+  }
+  assert(trace.StartReplay(tracePath) == InputTrace::TRACE_INVALID_FILE);
+  assert(!trace.IsReplaying());
+
+  std::filesystem::remove(tracePath);
+
+  return true;
+}
+}
@@ -0,0 +1,36 @@
+/*
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    clapp_ut_input.h
+ *
+ *  \brief
+ *    An interface used to store all input unit tests for ClaPP
+*/
+#pragma once
+
+namespace ClaPP_UnitTests
+{
+typedef bool UNIT_TEST_STATUS;
+
+/*!
+ *  Register actions and ensure names resolve to the same dense id every
+ *  time, that triggered actions show in the action state, and that
+ *  clearing the frame resets every bit.
+ */
+UNIT_TEST_STATUS TestInput_ActionIDs();
+/*!
+ *  Queue key transitions the way the window callbacks do and ensure a key
+ *  pressed and released within one frame is seen as both, and that every
+ *  key converts to its glfw code and back.
+ */
+UNIT_TEST_STATUS TestInput_KeyTransitions();
+/*!
+ *  Record a few frames of actions to a trace and replay it, ensuring each
+ *  frame comes back with the same delta and actions, and that the replay
+ *  ends after the last recorded frame.
+ */
+UNIT_TEST_STATUS TestInput_TraceReplay();
+}
@@ -0,0 +1,293 @@
+/*
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    clapp_ut_lua.cpp
+ *
+ *  \brief
+ *    An implementation file used to define what lua state unit tests are
+ *    like
+*/
+
+#include "../clapp_includes/pch.h"
+
+#include "clapp_ut_lua.h"
+
+#include <filesystem>
+
+#include "../clapp_includes/CGL_Mesh.h"
+#include "../clapp_includes/Clarity_LUA.h"
+#include "../clapp_includes/Clarity_LuaConfig.h"
+#include "../clapp_includes/Clarity_ThreadPool.h"
+
+using ClaPP::LuaState;
+using ClaPP::LuaConfig;
+using ClaPP::Mesh;
+using ClaPP::ThreadPool;
+
+namespace ClaPP_UnitTests
+{
+UNIT_TEST_STATUS TestLua_BulkArrays()
+{
+  const std::string luaSource =
+    "Data = {\n"
+    "  points = { 1, 2, 3, 4, 5, 6 },\n"
+    "  odd = { 1, 2, 3, 4, 5, 6, 7 },\n"
+    "  indices = { 0, 1, 2 },\n"
+    "  broken = { 1, 'two', 3 },\n"
+    "}\n";
+
+  LuaState &lua = LuaState::GetInstance();
+  assert(lua.ExecuteBuffer(luaSource, "clapp_ut_bulk.lua")
+         == LuaState::LUA_NO_ERR);
+  assert(lua.GetGlobal("Data") == LuaState::LUA_NO_ERR);
+
+  // 6 values make 2 whole vec3s or 3 whole vec2s
+  std::vector<glm::vec3> vec3s;
+  assert(lua.GetField("points") == LuaState::LUA_NO_ERR);
+  assert(lua.GetVec3Array(vec3s) == LuaState::LUA_NO_ERR);
+  assert(vec3s.size() == 2);
+  assert(vec3s[1] == glm::vec3(4.f, 5.f, 6.f));
+
+  std::vector<glm::vec2> vec2s;
+  assert(lua.GetVec2Array(vec2s) == LuaState::LUA_NO_ERR);
+  assert(vec2s.size() == 3 && vec2s[2] == glm::vec2(5.f, 6.f));
+
+  // Asking for more values than the table holds must not read past it
+  float values[8];
+  assert(lua.GetNumberArray(std::span<float>(values, 8))
+         == LuaState::LUA_INVALID_FIELD);
+  assert(lua.Pop() == LuaState::LUA_NO_ERR);
+
+  // 7 values make neither so nothing is silently dropped
+  assert(lua.GetField("odd") == LuaState::LUA_NO_ERR);
+  assert(lua.GetVec3Array(vec3s) == LuaState::LUA_INVALID_FIELD);
+  assert(lua.GetVec2Array(vec2s) == LuaState::LUA_INVALID_FIELD);
+  assert(lua.Pop() == LuaState::LUA_NO_ERR);
+
+  unsigned int indices[3];
+  assert(lua.GetField("indices") == LuaState::LUA_NO_ERR);
+  assert(lua.GetNumberArray(std::span<unsigned int>(indices))
+         == LuaState::LUA_NO_ERR);
+  assert(indices[0] == 0 && indices[2] == 2);
+  assert(lua.Pop() == LuaState::LUA_NO_ERR);
+
+  assert(lua.GetField("broken") == LuaState::LUA_NO_ERR);
+  assert(lua.GetNumberArray(std::span<float>(values, 3))
+         == LuaState::LUA_INCORRECT_TYPE);
+  assert(lua.Pop() == LuaState::LUA_NO_ERR);
+
+  // Leave the global then the file
+  assert(lua.Pop() == LuaState::LUA_NO_ERR);
+  assert(lua.Pop() == LuaState::LUA_NO_ERR);
+
+  return true;
+}
+
+UNIT_TEST_STATUS TestLua_BatchFunction()
+{
+  const std::string luaPath = "clapp_ut_batch.lua";
+  {
+    std::ofstream script(luaPath);
+    script << "function update(dt, batch)\n"
+              "  for i = 1, batch.count do\n"
+              "    batch.posX[i] = batch.posX[i] + batch.velX[i] * dt\n"
+              "  end\n"
+              "end\n"
+              "function overrun(dt, batch)\n"
+              "  batch.posX[batch.count + 1] = 0\n"
+              "end\n";
+  }
+
+  LuaState &lua = LuaState::GetInstance();
+  int updateRef = LUA_NOREF;
+  int overrunRef = LUA_NOREF;
+  assert(lua.LoadFunction(luaPath, "update", updateRef)
+         == LuaState::LUA_NO_ERR);
+  assert(lua.LoadFunction(luaPath, "overrun", overrunRef)
+         == LuaState::LUA_NO_ERR);
+
+  ClaPP::LuaBatch batch;
+  const size_t posX = batch.AddColumn("posX");
+  const size_t velX = batch.AddColumn("velX");
+  batch.Resize(1000);
+  for(size_t i = 0; i < batch.GetCount(); ++i)
+  {
+    batch.GetColumn(posX)[i] = static_cast<float>(i);
+    batch.GetColumn(velX)[i] = 2.f;
+  }
+
+  assert(lua.CallBatchFunction(updateRef, 0.5f, batch)
+         == LuaState::LUA_NO_ERR);
+  assert(batch.GetColumn(posX)[0] == 1.f);
+  assert(batch.GetColumn(posX)[999] == 1000.f);
+
+  assert(lua.CallBatchFunction(overrunRef, 0.f, batch)
+         != LuaState::LUA_NO_ERR);
+
+  lua.ReleaseFunction(updateRef);
+  lua.ReleaseFunction(overrunRef);
+  std::filesystem::remove(luaPath);
+
+  return true;
+}
+
+UNIT_TEST_STATUS TestLua_ConfigPaths()
+{
+  const std::string luaSource =
+    "Config = {\n"
+    "  name = 'player',\n"
+    "  enabled = true,\n"
+    "  points = { 1, 2, 3, 4, 5, 6 },\n"
+    "  odd = { 1, 2, 3, 4 },\n"
+    "  mixed = { 'a', { speed = 2.5 } },\n"
+    "}\n";
+
+  LuaConfig config;
+  assert(config.LoadBuffer(luaSource, "clapp_ut_config.lua")
+         == LuaConfig::CONFIG_NO_ERR);
+
+  std::string name;
+  bool enabled = false;
+  assert(config.GetString("Config.name", name) == LuaConfig::CONFIG_NO_ERR);
+  assert(name == "player");
+  assert(config.GetBool("Config.enabled", enabled)
+         == LuaConfig::CONFIG_NO_ERR && enabled);
+
+  // Packed numbers can be read whole or one at a time
+  std::vector<glm::vec3> points;
+  float second = 0.f;
+  assert(config.GetVec3Array("Config.points", points)
+         == LuaConfig::CONFIG_NO_ERR);
+  assert(points.size() == 2 && points[1] == glm::vec3(4.f, 5.f, 6.f));
+  assert(config.GetVec3Array("Config.odd", points)
+         == LuaConfig::CONFIG_INCORRECT_TYPE);
+  assert(config.GetNumber("Config.points.2", second)
+         == LuaConfig::CONFIG_NO_ERR && second == 2.f);
+
+  float speed = 0.f;
+  size_t length = 0;
+  assert(config.GetNumber("Config.mixed.2.speed", speed)
+         == LuaConfig::CONFIG_NO_ERR && speed == 2.5f);
+  assert(config.GetLength("Config.mixed", length)
+         == LuaConfig::CONFIG_NO_ERR && length == 2);
+
+  // A sequence holding anything but numbers is not a number array
+  std::vector<float> values;
+  assert(config.GetNumberArray("Config.mixed", values)
+         == LuaConfig::CONFIG_INCORRECT_TYPE);
+  assert(config.GetString("Config.points.7", name)
+         == LuaConfig::CONFIG_INVALID_PATH);
+  assert(config.GetType("Config.missing.value") == LuaConfig::VALUE_NIL);
+
+  // The script ran in its own environment so nothing was left behind
+  assert(config.GetType("Config") == LuaConfig::VALUE_TABLE);
+  LuaState &lua = LuaState::GetInstance();
+  const std::string leakSource = "Leak = { check = { Config == nil } }\n";
+  bool isClean = false;
+  assert(lua.ExecuteBuffer(leakSource, "clapp_ut_leak.lua")
+         == LuaState::LUA_NO_ERR);
+  assert(lua.GetGlobal("Leak") == LuaState::LUA_NO_ERR);
+  assert(lua.GetField("check") == LuaState::LUA_NO_ERR);
+  assert(lua.GetBool(isClean) == LuaState::LUA_NO_ERR && isClean);
+  assert(lua.Pop() == LuaState::LUA_NO_ERR);
+  assert(lua.Pop() == LuaState::LUA_NO_ERR);
+  assert(lua.Pop() == LuaState::LUA_NO_ERR);
+
+  return true;
+}
+
+UNIT_TEST_STATUS TestLua_ThreadedStates()
+{
+  // Made on this thread before any pool thread has a state of its own
+  LuaState::GetInstance().CreateEnum("ClapputShade", {{"RED", 2}});
+
+  const std::string enumSource = "Shade = { value = { ClapputShade.RED } }\n";
+  const std::string meshSource =
+    "Mesh = {\n"
+    "  vertices = { -0.5, -0.5, 0, 0.5, -0.5, 0, 0, 0.5, 0 },\n"
+    "  uv = { 0, 0, 1, 0, 0.5, 1 },\n"
+    "  indices = { 0, 1, 2 },\n"
+    "  color = { ClapputShade.RED, 0, 1 },\n"
+    "  type = { 'ClapputThreadedMesh' },\n"
+    "}\n";
+
+  ThreadPool threadPool(3u);
+  const size_t runCount = 32u;
+  std::vector<const LuaState *> states(threadPool.GetThreadCount(), nullptr);
+  std::vector<unsigned int> shades(runCount, 0u);
+  std::vector<Mesh::MeshData> meshes(runCount);
+  std::vector<uint8_t> isParsed(runCount, 0u);
+
+  const auto runScripts = [&]()
+  {
+    threadPool.ParallelFor(runCount
+      , [&](const size_t &begin, const size_t &end
+            , const size_t &threadIndex)
+      {
+        LuaState &lua = LuaState::GetInstance();
+        // Every thread keeps the one state it was first given
+        assert(!states[threadIndex] || states[threadIndex] == &lua);
+        states[threadIndex] = &lua;
+
+        for(size_t i = begin; i < end; ++i)
+        {
+          assert(lua.ExecuteBuffer(enumSource, "clapp_ut_shade.lua")
+                 == LuaState::LUA_NO_ERR);
+          assert(lua.GetGlobal("Shade") == LuaState::LUA_NO_ERR);
+          assert(lua.GetField("value") == LuaState::LUA_NO_ERR);
+          assert(lua.GetNumber(shades[i]) == LuaState::LUA_NO_ERR);
+          assert(lua.Pop() == LuaState::LUA_NO_ERR);
+          assert(lua.Pop() == LuaState::LUA_NO_ERR);
+          assert(lua.Pop() == LuaState::LUA_NO_ERR);
+
+          meshes[i] = Mesh::MeshData();
+          isParsed[i] = Mesh::ParseMeshData("clapp_ut_mesh.lua", meshSource
+                                            , meshes[i]);
+        }
+      });
+  };
+
+  runScripts();
+
+  // Each thread ran on its own state
+  for(size_t i = 0; i < states.size(); ++i)
+  {
+    for(size_t j = i + 1; j < states.size(); ++j)
+    {
+      assert(!states[i] || states[i] != states[j]);
+    }
+  }
+
+  const Mesh::MeshData &first = meshes.front();
+  assert(isParsed[0] && first.name == "ClapputThreadedMesh");
+  assert(first.vertices.size() == 3 && first.indices.size() == 3);
+  assert(first.vertices[0].color == glm::vec3(2.f, 0.f, 1.f));
+  for(size_t i = 0; i < runCount; ++i)
+  {
+    assert(shades[i] == 2u && isParsed[i]);
+    assert(meshes[i].name == first.name);
+    assert(meshes[i].indices == first.indices);
+    assert(meshes[i].vertices.size() == first.vertices.size());
+    for(size_t v = 0; v < first.vertices.size(); ++v)
+    {
+      assert(meshes[i].vertices[v].pos == first.vertices[v].pos);
+      assert(meshes[i].vertices[v].tex == first.vertices[v].tex);
+      assert(meshes[i].vertices[v].color == first.vertices[v].color);
+    }
+  }
+
+  // A replaced enum reaches states that already synced the old one
+  LuaState::GetInstance().CreateEnum("ClapputShade", {{"RED", 5}});
+  runScripts();
+  for(size_t i = 0; i < runCount; ++i)
+  {
+    assert(shades[i] == 5u && isParsed[i]);
+    assert(meshes[i].vertices[0].color == glm::vec3(5.f, 0.f, 1.f));
+  }
+
+  return true;
+}
+}
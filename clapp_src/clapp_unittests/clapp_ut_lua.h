@@ -0,0 +1,43 @@
+/*
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    clapp_ut_lua.h
+ *
+ *  \brief
+ *    An interface used to store all lua state unit tests for ClaPP
+*/
+#pragma once
+
+namespace ClaPP_UnitTests
+{
+typedef bool UNIT_TEST_STATUS;
+
+/*!
+ *  Read number, vec2, and vec3 tables with the bulk getters and ensure
+ *  short tables, tables that do not fill whole vectors, and non number
+ *  values are reported.
+ */
+UNIT_TEST_STATUS TestLua_BulkArrays();
+/*!
+ *  Load a script's update function and call it once over a batch, ensuring
+ *  the script's writes land in the columns and that indexing past the
+ *  batch is reported instead of touching memory.
+ */
+UNIT_TEST_STATUS TestLua_BatchFunction();
+/*!
+ *  Load a config and query it by path, ensuring sequences, nested tables,
+ *  and missing paths resolve correctly and that the script's globals do
+ *  not leak into the lua state.
+ */
+UNIT_TEST_STATUS TestLua_ConfigPaths();
+/*!
+ *  Create an enum on this thread then run a script reading it and parse a
+ *  mesh using it across a pool, ensuring each thread has its own state,
+ *  every thread sees the enum and its replacement, and every thread parses
+ *  the same mesh data.
+ */
+UNIT_TEST_STATUS TestLua_ThreadedStates();
+}
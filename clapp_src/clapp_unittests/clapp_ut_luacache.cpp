@@ -0,0 +1,71 @@
+/*
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    clapp_ut_luacache.cpp
+ *
+ *  \brief
+ *    An implementation file used to define what lua bytecode cache unit
+ *    tests are like
+*/
+
+#include "../clapp_includes/pch.h"
+
+#include "clapp_ut_luacache.h"
+
+#include <filesystem>
+
+extern "C"
+{
+  #include <lualib.h>
+  #include <lauxlib.h>
+}
+
+#include "../clapp_includes/Clarity_LuaCache.h"
+
+using ClaPP::LuaBytecodeCache;
+
+namespace ClaPP_UnitTests
+{
+UNIT_TEST_STATUS TestLuaCache_StoreLoad()
+{
+  const std::string cacheDirectory = "clapp_ut_luacache";
+  const std::string luaPath = "clapp_ut_script.lua";
+  const std::string luaSource = "Value = 40 + 2";
+
+  LuaBytecodeCache &cache = LuaBytecodeCache::GetInstance();
+  cache.SetCacheDirectory(cacheDirectory);
+
+  lua_State *state = luaL_newstate();
+  const LuaBytecodeCache::SourceStamp stamp
+    = LuaBytecodeCache::StampSource(luaSource);
+
+  // Nothing has been stored yet
+  assert(!cache.Load(state, luaPath, stamp));
+  assert(lua_gettop(state) == 0);
+
+  assert(luaL_loadbuffer(state, luaSource.data(), luaSource.size()
+                         , luaPath.c_str()) == LUA_OK);
+  cache.Store(state, luaPath, stamp);
+  lua_pop(state, 1);
+
+  // An edited source must not load the old chunk
+  assert(!cache.Load(state, luaPath
+                     , LuaBytecodeCache::StampSource("Value = 0")));
+
+  assert(cache.Load(state, luaPath, stamp));
+  assert(lua_pcall(state, 0, 0, 0) == LUA_OK);
+  lua_getglobal(state, "Value");
+  assert(lua_tonumber(state, -1) == 42.0);
+  lua_pop(state, 1);
+
+  lua_close(state);
+
+  cache.SetCacheDirectory(LuaBytecodeCache::DEFAULT_CACHE_PATH);
+  std::filesystem::remove_all(cacheDirectory);
+
+  return true;
+}
+}
@@ -0,0 +1,23 @@
+/*
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    clapp_ut_luacache.h
+ *
+ *  \brief
+ *    An interface used to store all lua bytecode cache unit tests for ClaPP
+*/
+#pragma once
+
+namespace ClaPP_UnitTests
+{
+typedef bool UNIT_TEST_STATUS;
+
+/*!
+ *  Compile a chunk, store it, and load it back with the same stamp. Ensure
+ *  a different stamp is a miss and that the cached chunk still runs.
+ */
+UNIT_TEST_STATUS TestLuaCache_StoreLoad();
+}
@@ -0,0 +1,1165 @@
+/*
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    clapp_ut_physics.cpp
+ *
+ *  \brief
+ *    An implementation file used to define what physics unit tests are like
+*/
+
+#include "../clapp_includes/pch.h"
+
+#include "clapp_ut_physics.h"
+
+#include <cmath>
+#include <numeric>
+
+#include "../clapp_includes/CPL_Integrator.h"
+#include "../clapp_includes/CPL_TransformKernel.h"
+#include "../clapp_includes/CPL_Transform.h"
+#include "../clapp_includes/CPL_SpatialHash.h"
+#include "../clapp_includes/CPL_AABBTree.h"
+#include "../clapp_includes/CPL_ContactSolver.h"
+#include "../clapp_includes/CPL_Islands.h"
+#include "../clapp_includes/CPL_Narrowphase.h"
+#include "../clapp_includes/CPL_SweepAndPrune.h"
+#include "../clapp_includes/Clarity_ThreadPool.h"
+
+#include "../../external/glm/gtc/matrix_transform.hpp"
+#include "../../external/glm/gtc/quaternion.hpp"
+
+using ClaPP::AABB;
+using ClaPP::AABBTree;
+using ClaPP::BodyBatch;
+using ClaPP::Collider;
+using ClaPP::CollisionPair;
+using ClaPP::ContactBuffer;
+using ClaPP::ContactManifold;
+using ClaPP::ContactSolver;
+using ClaPP::Frustum;
+using ClaPP::OrientedBox;
+using ClaPP::Integrator;
+using ClaPP::Islands;
+using ClaPP::Narrowphase;
+using ClaPP::Sphere;
+using ClaPP::SpatialHash;
+using ClaPP::SweepAndPrune;
+using ClaPP::ThreadPool;
+using ClaPP::TransformKernel;
+using ClaPP::Transform;
+using ClaPP::TreeBroadphase;
+
+namespace ClaPP_UnitTests
+{
+// Verlet finds velocity from the difference of two positions so it is
+// only as precise as the positions are near 10
+static bool IsClose(const float &value, const float &expected)
+{
+  return std::fabs(value - expected) <= 1e-3f * std::max(1.f
+                                                         , std::fabs(expected));
+}
+
+UNIT_TEST_STATUS TestPhysics_Integrators()
+{
+  const float timeStep = 1.f / 60.f;
+  const glm::vec3 gravity = {0.f, -9.81f, 0.f};
+  const glm::vec3 noDrag = {0.f, 0.f, 0.f};
+
+  // Enough bodies that the loops run their vector and leftover parts
+  const Integrator::INTEGRATOR integrators[2] = 
+  {
+    Integrator::INTEGRATOR_SEMI_IMPLICIT_EULER
+    , Integrator::INTEGRATOR_VERLET
+  };
+  for(const Integrator::INTEGRATOR &integrator : integrators)
+  {
+    BodyBatch batch;
+    batch.Resize(37);
+    for(size_t i = 0; i < batch.GetCount(); ++i)
+    {
+      const glm::vec3 start = {static_cast<float>(i), 10.f, 0.f};
+      batch.SetBody(i, start, start, {0.f, 0.f, 0.f}, gravity);
+    }
+
+    // From rest both integrators fall g * dt^2 * n(n+1)/2 after n steps
+    const int steps = 30;
+    for(int step = 0; step < steps; ++step)
+    {
+      Integrator::Integrate(batch, integrator, noDrag, timeStep);
+    }
+    const float fallen = gravity.y * timeStep * timeStep
+                         * (steps * (steps + 1) / 2);
+    for(size_t i = 0; i < batch.GetCount(); ++i)
+    {
+      const glm::vec3 position = batch.GetPosition(i);
+      assert(position.x == static_cast<float>(i) && position.z == 0.f);
+      assert(IsClose(position.y, 10.f + fallen));
+      assert(IsClose(batch.GetVelocity(i).y, gravity.y * timeStep * steps));
+      // The step before the last is kept for interpolation
+      assert(IsClose(batch.GetPreviousPosition(i).y
+                     , position.y - batch.GetVelocity(i).y * timeStep));
+    }
+  }
+
+  // Drag balances a constant push at acceleration / drag
+  const glm::vec3 drag = {3.f, 3.f, 3.f};
+  BodyBatch pushed;
+  pushed.Resize(1);
+  pushed.SetBody(0, {0.f, 0.f, 0.f}, {0.f, 0.f, 0.f}, {0.f, 0.f, 0.f}
+                 , {5.4f, 0.f, -5.4f});
+  for(int step = 0; step < 600; ++step)
+  {
+    Integrator::SemiImplicitEuler(pushed, drag, timeStep);
+  }
+  assert(IsClose(pushed.GetVelocity(0).x, 1.8f));
+  assert(IsClose(pushed.GetVelocity(0).z, -1.8f));
+  assert(pushed.GetVelocity(0).y == 0.f);
+
+  return true;
+}
+
+/*
+ * Compares two matrices element by element
+ */
+static bool MatricesMatch(const glm::mat4 &lhs, const glm::mat4 &rhs)
+{
+  for(int column = 0; column < 4; ++column)
+  {
+    for(int row = 0; row < 4; ++row)
+    {
+      if(std::fabs(lhs[column][row] - rhs[column][row]) > 1e-5f)
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+UNIT_TEST_STATUS TestPhysics_TransformKernel()
+{
+  // Not a multiple of 4 so the scalar leftovers are checked as well
+  const size_t count = 103;
+  std::mt19937 generator(42u);
+  std::uniform_real_distribution<float> positions(-50.f, 50.f);
+  std::uniform_real_distribution<float> angles(-720.f, 720.f);
+  std::uniform_real_distribution<float> scales(0.1f, 4.f);
+
+  std::vector<float> columns[13];
+  for(std::vector<float> &column : columns)
+  {
+    column.resize(count);
+  }
+  std::vector<glm::mat4> expectedEuler(count);
+  std::vector<glm::mat4> expectedQuaternion(count);
+  const glm::mat4 identity = glm::identity<glm::mat4>();
+
+  for(size_t i = 0; i < count; ++i)
+  {
+    const glm::vec3 position = {positions(generator), positions(generator)
+                                , positions(generator)};
+    const glm::vec3 degrees = {angles(generator), angles(generator)
+                               , angles(generator)};
+    const glm::vec3 scale = {scales(generator), scales(generator)
+                             , scales(generator)};
+    const glm::quat rotation = glm::quat(glm::radians(degrees));
+
+    for(int axis = 0; axis < 3; ++axis)
+    {
+      columns[axis][i] = position[axis];
+      columns[3 + axis][i] = glm::radians(degrees[axis]);
+      columns[6 + axis][i] = scale[axis];
+    }
+    columns[9][i] = rotation.x;
+    columns[10][i] = rotation.y;
+    columns[11][i] = rotation.z;
+    columns[12][i] = rotation.w;
+
+    // The matrix as the physics system built it before the kernel
+    const glm::mat4 translate = glm::translate(identity, position);
+    const glm::mat4 scaling = glm::scale(identity, scale);
+    const glm::mat4 rotateX = glm::rotate(identity, glm::radians(degrees.x)
+                                          , {1.f, 0.f, 0.f});
+    const glm::mat4 rotateY = glm::rotate(identity, glm::radians(degrees.y)
+                                          , {0.f, 1.f, 0.f});
+    const glm::mat4 rotateZ = glm::rotate(identity, glm::radians(degrees.z)
+                                          , {0.f, 0.f, 1.f});
+    expectedEuler[i] = translate * rotateZ * rotateY * rotateX * scaling;
+    expectedQuaternion[i] = translate * glm::mat4_cast(rotation) * scaling;
+  }
+
+  const TransformKernel::EulerTransforms euler =
+  {
+    {columns[0].data(), columns[1].data(), columns[2].data()}
+    , {columns[3].data(), columns[4].data(), columns[5].data()}
+    , {columns[6].data(), columns[7].data(), columns[8].data()}
+    , count
+  };
+  const TransformKernel::QuaternionTransforms quaternion =
+  {
+    {columns[0].data(), columns[1].data(), columns[2].data()}
+    , {columns[9].data(), columns[10].data(), columns[11].data()
+       , columns[12].data()}
+    , {columns[6].data(), columns[7].data(), columns[8].data()}
+    , count
+  };
+
+  std::vector<glm::mat4> matrices(count);
+  std::vector<glm::mat4> scalarMatrices(count);
+
+  TransformKernel::ComposeEuler(euler, matrices.data());
+  TransformKernel::ComposeEulerScalar(euler, scalarMatrices.data());
+  for(size_t i = 0; i < count; ++i)
+  {
+    assert(MatricesMatch(matrices[i], expectedEuler[i]));
+    assert(MatricesMatch(scalarMatrices[i], expectedEuler[i]));
+  }
+
+  TransformKernel::ComposeQuaternion(quaternion, matrices.data());
+  TransformKernel::ComposeQuaternionScalar(quaternion
+                                           , scalarMatrices.data());
+  for(size_t i = 0; i < count; ++i)
+  {
+    assert(MatricesMatch(matrices[i], expectedQuaternion[i]));
+    assert(MatricesMatch(scalarMatrices[i], expectedQuaternion[i]));
+    // Both rotations describe the same orientation
+    assert(MatricesMatch(matrices[i], expectedEuler[i]));
+  }
+
+  return true;
+}
+
+UNIT_TEST_STATUS TestPhysics_Orientations()
+{
+  const float timeStep = 1.f / 60.f;
+  const float quarterTurn = glm::radians(90.f);
+  const glm::vec3 axes[3] = {{1.f, 0.f, 0.f}, {0.f, 1.f, 0.f}
+                             , {0.f, 0.f, 1.f}};
+
+  BodyBatch batch;
+  batch.Resize(3);
+  for(size_t i = 0; i < 3; ++i)
+  {
+    batch.SetBody(i, {0.f, 0.f, 0.f}, {0.f, 0.f, 0.f}, {0.f, 0.f, 0.f}
+                  , {0.f, 0.f, 0.f});
+    batch.SetOrientation(i, glm::identity<glm::quat>()
+                         , axes[i] * quarterTurn);
+  }
+
+  // A quarter turn a second for a second about each axis
+  for(int step = 0; step < 60; ++step)
+  {
+    Integrator::IntegrateOrientations(batch, timeStep);
+  }
+  for(size_t i = 0; i < 3; ++i)
+  {
+    const glm::quat expected = glm::angleAxis(quarterTurn, axes[i]);
+    const glm::quat orientation = batch.GetOrientation(i);
+    assert(std::fabs(glm::length(orientation) - 1.f) < 1e-5f);
+    assert(std::fabs(glm::dot(orientation, expected)) > 0.9999f);
+    // The step before is kept for blending
+    assert(glm::dot(batch.GetPreviousOrientation(i), orientation) < 1.f);
+  }
+
+  Transform transform({0.f, 0.f, 0.f}, {1.f, 1.f, 1.f}, {10.f, 20.f, 30.f});
+  glm::vec3 rotation = transform.GetEulerRotation();
+  assert(IsClose(rotation.x, 10.f) && IsClose(rotation.y, 20.f)
+         && IsClose(rotation.z, 30.f));
+  transform.SetEulerRotation({-45.f, 5.f, 170.f});
+  rotation = transform.GetEulerRotation();
+  assert(IsClose(rotation.x, -45.f) && IsClose(rotation.y, 5.f)
+         && IsClose(rotation.z, 170.f));
+
+  return true;
+}
+
+/*
+ * Bounds of random sizes spread through a box, with a few far larger than
+ * the rest
+ */
+static std::vector<AABB> RandomBounds(const size_t &count
+                                      , const unsigned &seed)
+{
+  std::mt19937 generator(seed);
+  std::uniform_real_distribution<float> position(-20.f, 20.f);
+  std::uniform_real_distribution<float> size(0.1f, 2.f);
+
+  std::vector<AABB> bounds(count);
+  for(size_t i = 0; i < count; ++i)
+  {
+    const glm::vec3 center = {position(generator), position(generator)
+                              , position(generator)};
+    glm::vec3 halfSize = {size(generator), size(generator), size(generator)};
+    if(i % 97u == 0u)
+    {
+      halfSize *= 8.f;
+    }
+    bounds[i] = {center - halfSize, center + halfSize};
+  }
+  return bounds;
+}
+
+/*
+ * Every overlapping pair found by testing each body against every other
+ */
+static std::vector<CollisionPair> BruteForcePairs(
+  const std::vector<AABB> &bounds)
+{
+  std::vector<CollisionPair> pairs;
+  for(uint32_t i = 0; i < bounds.size(); ++i)
+  {
+    for(uint32_t j = i + 1u; j < bounds.size(); ++j)
+    {
+      if(bounds[i].Overlaps(bounds[j]))
+      {
+        pairs.push_back({i, j});
+      }
+    }
+  }
+  return pairs;
+}
+
+/*
+ * Steps spheres resting on a ground box at the first body the way the
+ * physics system does, with each phase split across the given pool or run
+ * whole on this thread when there is none. Returns the contact count of
+ * the last step.
+ */
+static size_t StepOnGround(BodyBatch &batch, ThreadPool *threadPool
+                           , const int &steps)
+{
+  const auto runRanges = [&](const size_t &count, const size_t &batchSize
+                             , const ThreadPool::RangeFunction &function)
+  {
+    // Each thread runs its ranges back to front, so the result can not
+    // lean on the order of the ranges even with one thread
+    if(threadPool)
+    {
+      const size_t rangeCount = (count + batchSize - 1u) / batchSize;
+      threadPool->ParallelFor(rangeCount
+        , [&](const size_t &begin, const size_t &end
+              , const size_t &threadIndex)
+        {
+          for(size_t range = end; range > begin; --range)
+          {
+            function((range - 1u) * batchSize
+                     , std::min(range * batchSize, count), threadIndex);
+          }
+        });
+    }
+    else
+    {
+      function(0u, count, 0u);
+    }
+  };
+
+  const size_t count = batch.GetCount();
+  std::vector<Collider::SHAPE> types(count, Collider::SHAPE_SPHERE);
+  types[0] = Collider::SHAPE_BOX;
+  std::vector<OrientedBox> boxes(count);
+  boxes[0].halfExtents = {50.f, 0.5f, 50.f};
+  std::vector<Sphere> spheres(count);
+  std::vector<AABB> bounds(count);
+  std::vector<uint32_t> indices(count);
+  std::iota(indices.begin(), indices.end(), 0u);
+  std::vector<float> inverseMasses(count, 1.f);
+  inverseMasses[0] = 0.f;
+  const std::vector<float> frictions(count, 0.5f);
+  const std::vector<float> bounces(count, 0.2f);
+  const ContactSolver::Bodies bodies = {indices.data()
+    , inverseMasses.data(), frictions.data(), bounces.data()
+    , {batch.GetVelocities(BodyBatch::AXIS_X)
+       , batch.GetVelocities(BodyBatch::AXIS_Y)
+       , batch.GetVelocities(BodyBatch::AXIS_Z)}
+    , {batch.GetPositions(BodyBatch::AXIS_X)
+       , batch.GetPositions(BodyBatch::AXIS_Y)
+       , batch.GetPositions(BodyBatch::AXIS_Z)}
+    , count};
+
+  std::vector<ContactManifold> manifolds;
+  std::vector<uint8_t> touching;
+  ContactBuffer contacts;
+  ContactSolver solver;
+  for(int step = 0; step < steps; ++step)
+  {
+    runRanges(count, 64u, [&](const size_t &begin, const size_t &end
+                              , const size_t &)
+    {
+      Integrator::Integrate(batch, Integrator::INTEGRATOR_SEMI_IMPLICIT_EULER
+                            , {1.f, 1.f, 1.f}, 1.f / 60.f, begin, end);
+    });
+
+    for(size_t i = 0; i < count; ++i)
+    {
+      boxes[i].center = batch.GetPosition(i);
+      spheres[i] = {batch.GetPosition(i), 0.5f};
+      bounds[i] = i == 0u ? boxes[i].GetBounds() : spheres[i].GetBounds();
+    }
+    const std::vector<CollisionPair> pairs = BruteForcePairs(bounds);
+
+    // Pairs are tested on any thread and added in order afterwards
+    manifolds.resize(pairs.size());
+    touching.resize(pairs.size());
+    runRanges(pairs.size(), 16u, [&](const size_t &begin, const size_t &end
+                                     , const size_t &)
+    {
+      for(size_t i = begin; i < end; ++i)
+      {
+        touching[i] = Narrowphase::CollidePair({types.data(), boxes.data()
+                                                , spheres.data()}
+                                               , pairs[i], manifolds[i]);
+      }
+    });
+    contacts.Clear();
+    contacts.Reserve(pairs.size());
+    for(size_t i = 0; i < pairs.size(); ++i)
+    {
+      if(touching[i])
+      {
+        contacts.Push(manifolds[i]);
+      }
+    }
+
+    solver.Prepare(contacts, bodies);
+    assert(!solver.HasOverflowBatch());
+    for(int pass = 0; pass < 2; ++pass)
+    {
+      const int iterations = pass == 0 
+                             ? ContactSolver::DEFAULT_ITERATIONS
+                             : ContactSolver::DEFAULT_POSITION_ITERATIONS;
+      for(int iteration = 0; iteration < iterations; ++iteration)
+      {
+        for(size_t i = 0; i < solver.GetBatchCount(); ++i)
+        {
+          size_t batchBegin = 0u;
+          size_t batchEnd = 0u;
+          solver.GetBatch(i, batchBegin, batchEnd);
+          runRanges(batchEnd - batchBegin, 8u
+            , [&](const size_t &begin, const size_t &end, const size_t &)
+            {
+              if(pass == 0)
+              {
+                solver.SolveRange(batchBegin + begin, batchBegin + end);
+              }
+              else
+              {
+                solver.CorrectRange(batchBegin + begin, batchBegin + end);
+              }
+            });
+        }
+      }
+    }
+  }
+
+  return contacts.GetCount();
+}
+
+UNIT_TEST_STATUS TestPhysics_SpatialHash()
+{
+  std::vector<AABB> bounds = RandomBounds(1000u, 42u);
+  // Two boxes touching along a face still count as overlapping
+  bounds.push_back({{100.f, 100.f, 100.f}, {101.f, 101.f, 101.f}});
+  bounds.push_back({{101.f, 100.f, 100.f}, {102.f, 101.f, 101.f}});
+  const std::vector<CollisionPair> expected = BruteForcePairs(bounds);
+
+  // Cells smaller and larger than the bodies both find the same pairs
+  const float cellSizes[3] = {0.5f, 2.f, 16.f};
+  for(const float &cellSize : cellSizes)
+  {
+    SpatialHash spatialHash(cellSize);
+    spatialHash.Update(bounds);
+
+    std::vector<CollisionPair> pairs = spatialHash.GetPairs();
+    for(const CollisionPair &pair : pairs)
+    {
+      assert(pair.first < pair.second);
+    }
+    std::sort(pairs.begin(), pairs.end());
+    // Found once each, even when bodies share many cells
+    assert(std::adjacent_find(pairs.begin(), pairs.end()) == pairs.end());
+    assert(pairs == expected);
+  }
+
+  // Split across threads the pairs come out in the order one thread finds
+  // them, small cells leave many bodies out of the grid to split as well
+  ThreadPool serialPool(0u);
+  ThreadPool threadPool(3u);
+  for(const float &cellSize : cellSizes)
+  {
+    SpatialHash serial(cellSize);
+    serial.SetThreadPool(serialPool);
+    serial.Update(bounds);
+    SpatialHash parallel(cellSize);
+    parallel.SetThreadPool(threadPool);
+    parallel.Update(bounds);
+    assert(parallel.GetPairs() == serial.GetPairs());
+  }
+
+  // Moving every body and updating again finds the new pairs
+  SpatialHash spatialHash;
+  spatialHash.Update(bounds);
+  for(AABB &bound : bounds)
+  {
+    bound.min.x += 3.f;
+    bound.max.x += 3.f;
+  }
+  bounds.front().max.y += 30.f;
+  spatialHash.Update(bounds);
+  std::vector<CollisionPair> pairs = spatialHash.GetPairs();
+  std::sort(pairs.begin(), pairs.end());
+  assert(pairs == BruteForcePairs(bounds));
+
+  spatialHash.Update({});
+  assert(spatialHash.GetPairs().empty());
+
+  return true;
+}
+
+UNIT_TEST_STATUS TestPhysics_AABBTree()
+{
+  std::vector<AABB> bounds = RandomBounds(1000u, 7u);
+  AABBTree tree;
+  std::vector<int32_t> proxies(bounds.size());
+  for(uint32_t i = 0; i < bounds.size(); ++i)
+  {
+    proxies[i] = tree.CreateProxy(bounds[i], i);
+  }
+  assert(tree.Validate() && tree.GetProxyCount() == bounds.size());
+
+  std::vector<CollisionPair> pairs;
+  tree.FindPairs(bounds, pairs);
+
+  // Split across threads the pairs stay in order of their first body
+  ThreadPool threadPool(3u);
+  TreeBroadphase treeBroadphase(tree);
+  treeBroadphase.SetThreadPool(threadPool);
+  treeBroadphase.Update(bounds);
+  assert(treeBroadphase.GetPairs() == pairs);
+
+  std::sort(pairs.begin(), pairs.end());
+  assert(pairs == BruteForcePairs(bounds));
+
+  // Small moves stay in each proxy's fattened box
+  int reinserted = 0;
+  for(uint32_t i = 0; i < bounds.size(); ++i)
+  {
+    bounds[i].min.y += 0.05f;
+    bounds[i].max.y += 0.05f;
+    reinserted += tree.MoveProxy(proxies[i], bounds[i], {0.f, 0.05f, 0.f});
+  }
+  assert(reinserted == 0);
+  // Large moves do not, and the tree stays well formed
+  for(uint32_t i = 0; i < bounds.size(); i += 2u)
+  {
+    bounds[i].min.x -= 5.f;
+    bounds[i].max.x -= 5.f;
+    assert(tree.MoveProxy(proxies[i], bounds[i], {-5.f, 0.f, 0.f}));
+  }
+  assert(tree.Validate());
+  tree.FindPairs(bounds, pairs);
+  std::sort(pairs.begin(), pairs.end());
+  assert(pairs == BruteForcePairs(bounds));
+
+  // Destroyed proxies are no longer found and their nodes are reused
+  for(uint32_t i = 0; i < bounds.size(); i += 3u)
+  {
+    tree.DestroyProxy(proxies[i]);
+  }
+  assert(tree.Validate());
+  const AABB query = {{-5.f, -5.f, -5.f}, {5.f, 5.f, 5.f}};
+  std::vector<uint32_t> found;
+  tree.Query(query, [&](const int32_t &proxy)
+  {
+    const uint32_t body = tree.GetUserData(proxy);
+    if(bounds[body].Overlaps(query))
+    {
+      found.push_back(body);
+    }
+    return true;
+  });
+  std::sort(found.begin(), found.end());
+  std::vector<uint32_t> expected;
+  for(uint32_t i = 0; i < bounds.size(); ++i)
+  {
+    if(i % 3u != 0u && bounds[i].Overlaps(query))
+    {
+      expected.push_back(i);
+    }
+  }
+  assert(found == expected);
+
+  // A ray finds the same closest body as testing every body
+  const glm::vec3 origin = {-40.f, 1.f, 2.f};
+  const glm::vec3 direction = glm::normalize(glm::vec3(1.f, 0.1f, -0.05f));
+  uint32_t closestBody = 0u;
+  float closest = 100.f;
+  for(uint32_t i = 0; i < bounds.size(); ++i)
+  {
+    float distance = 0.f;
+    if(i % 3u != 0u && ClaPP::RaycastAABB(bounds[i], origin, direction
+                                          , closest, distance))
+    {
+      closest = distance;
+      closestBody = i;
+    }
+  }
+  assert(closest < 100.f);
+  uint32_t hitBody = 0u;
+  float hitDistance = -1.f;
+  tree.Raycast(origin, direction, 100.f
+    , [&](const int32_t &proxy, const float &maxDistance)
+    {
+      const uint32_t body = tree.GetUserData(proxy);
+      float distance = 0.f;
+      if(!ClaPP::RaycastAABB(bounds[body], origin, direction, maxDistance
+                             , distance))
+      {
+        return -1.f;
+      }
+      hitBody = body;
+      hitDistance = distance;
+      return distance;
+    });
+  assert(hitBody == closestBody && IsClose(hitDistance, closest));
+
+  // A camera at the origin looking down -z sees only what is in front
+  const Frustum frustum = Frustum::FromMatrix(
+    glm::perspective(glm::radians(70.f), 1.f, 0.1f, 100.f));
+  assert(frustum.Intersects({{-1.f, -1.f, -11.f}, {1.f, 1.f, -9.f}}));
+  assert(!frustum.Intersects({{-1.f, -1.f, 9.f}, {1.f, 1.f, 11.f}}));
+  assert(!frustum.Intersects({{40.f, -1.f, -11.f}, {42.f, 1.f, -9.f}}));
+  size_t visibleCount = 0u;
+  tree.QueryFrustum(frustum, [&](const int32_t &proxy)
+  {
+    visibleCount += frustum.Intersects(bounds[tree.GetUserData(proxy)]);
+    return true;
+  });
+  size_t expectedVisible = 0u;
+  for(uint32_t i = 0; i < bounds.size(); ++i)
+  {
+    expectedVisible += i % 3u != 0u && frustum.Intersects(bounds[i]);
+  }
+  assert(visibleCount == expectedVisible);
+
+  // Boxes added in a line would make a list without rotations
+  AABBTree line;
+  for(uint32_t i = 0; i < 1024u; ++i)
+  {
+    const float x = static_cast<float>(i) * 2.f;
+    line.CreateProxy({{x, 0.f, 0.f}, {x + 1.f, 1.f, 1.f}}, i);
+  }
+  assert(line.Validate() && line.GetHeight() <= 20);
+
+  // A box turned 45 degrees about y reaches further along x
+  OrientedBox box;
+  box.axes = glm::mat3_cast(glm::angleAxis(glm::radians(45.f)
+                                           , glm::vec3(0.f, 1.f, 0.f)));
+  box.halfExtents = {1.f, 1.f, 1.f};
+  float distance = 0.f;
+  assert(ClaPP::RaycastBox(box, {-5.f, 0.f, 0.f}, {1.f, 0.f, 0.f}, 10.f
+                           , distance));
+  assert(IsClose(distance, 5.f - std::sqrt(2.f)));
+  assert(IsClose(box.GetBounds().max.x, std::sqrt(2.f)));
+  assert(!ClaPP::RaycastBox(box, {-5.f, 2.f, 0.f}, {1.f, 0.f, 0.f}, 10.f
+                            , distance));
+
+  return true;
+}
+
+UNIT_TEST_STATUS TestPhysics_SweepAndPrune()
+{
+  std::vector<AABB> bounds = RandomBounds(1000u, 11u);
+  SweepAndPrune sweepAndPrune;
+  sweepAndPrune.Update(bounds);
+
+  std::vector<CollisionPair> pairs = sweepAndPrune.GetPairs();
+  std::sort(pairs.begin(), pairs.end());
+  assert(pairs == BruteForcePairs(bounds));
+  assert(sweepAndPrune.GetAddedPairs().size() == pairs.size());
+
+  std::mt19937 generator(3u);
+  std::uniform_real_distribution<float> offset(-0.5f, 0.5f);
+  for(int step = 0; step < 10; ++step)
+  {
+    for(AABB &bound : bounds)
+    {
+      const glm::vec3 move = {offset(generator), offset(generator)
+                              , offset(generator)};
+      bound.min += move;
+      bound.max += move;
+    }
+    sweepAndPrune.Update(bounds);
+
+    std::vector<CollisionPair> current = sweepAndPrune.GetPairs();
+    std::sort(current.begin(), current.end());
+    assert(std::adjacent_find(current.begin(), current.end())
+           == current.end());
+    assert(current == BruteForcePairs(bounds));
+
+    // The old pairs less those removed plus those added are the new pairs
+    std::vector<CollisionPair> removed = sweepAndPrune.GetRemovedPairs();
+    std::sort(removed.begin(), removed.end());
+    std::vector<CollisionPair> kept;
+    std::set_difference(pairs.begin(), pairs.end(), removed.begin()
+                        , removed.end(), std::back_inserter(kept));
+    assert(kept.size() + removed.size() == pairs.size());
+    kept.insert(kept.end(), sweepAndPrune.GetAddedPairs().begin()
+                , sweepAndPrune.GetAddedPairs().end());
+    std::sort(kept.begin(), kept.end());
+    assert(kept == current);
+    pairs = current;
+  }
+
+  // A body leaving starts over and reports every old pair removed
+  bounds.pop_back();
+  sweepAndPrune.Update(bounds);
+  assert(sweepAndPrune.GetRemovedPairs().size() == pairs.size());
+  pairs = sweepAndPrune.GetPairs();
+  std::sort(pairs.begin(), pairs.end());
+  assert(pairs == BruteForcePairs(bounds));
+
+  // Nothing moving swaps nothing and changes no pairs
+  sweepAndPrune.Update(bounds);
+  assert(sweepAndPrune.GetSwapCount() == 0u);
+  assert(sweepAndPrune.GetAddedPairs().empty()
+         && sweepAndPrune.GetRemovedPairs().empty());
+
+  return true;
+}
+
+UNIT_TEST_STATUS TestPhysics_Narrowphase()
+{
+  ContactManifold manifold;
+
+  // Spheres overlapping by half a unit along x
+  assert(Narrowphase::SphereSphere({{0.f, 0.f, 0.f}, 1.f}
+                                   , {{1.5f, 0.f, 0.f}, 1.f}, manifold));
+  assert(manifold.pointCount == 1u && IsClose(manifold.normal.x, 1.f));
+  assert(IsClose(manifold.penetrations[0], 0.5f));
+  assert(IsClose(manifold.points[0].x, 0.75f));
+  assert(!Narrowphase::SphereSphere({{0.f, 0.f, 0.f}, 1.f}
+                                    , {{2.5f, 0.f, 0.f}, 1.f}, manifold));
+
+  // A sphere resting on top of a box points down into it
+  OrientedBox ground;
+  ground.halfExtents = {10.f, 1.f, 10.f};
+  assert(Narrowphase::SphereBox({{2.f, 1.9f, 3.f}, 1.f}, ground, manifold));
+  assert(IsClose(manifold.normal.y, -1.f));
+  assert(IsClose(manifold.penetrations[0], 0.1f));
+  assert(IsClose(manifold.points[0].y, 0.95f));
+  assert(!Narrowphase::SphereBox({{2.f, 2.1f, 3.f}, 1.f}, ground
+                                 , manifold));
+  // A sphere sunk inside is pushed out the nearest face
+  assert(Narrowphase::SphereBox({{9.5f, 0.f, 0.f}, 1.f}, ground, manifold));
+  assert(IsClose(manifold.normal.x, -1.f));
+  assert(IsClose(manifold.penetrations[0], 1.5f));
+
+  // A box resting flat on another touches at its 4 corners
+  OrientedBox box;
+  box.center = {1.f, 1.4f, -2.f};
+  box.halfExtents = {0.5f, 0.5f, 0.5f};
+  assert(Narrowphase::BoxBox(ground, box, manifold));
+  assert(IsClose(manifold.normal.y, 1.f));
+  assert(manifold.pointCount == 4u);
+  for(uint32_t i = 0; i < manifold.pointCount; ++i)
+  {
+    assert(IsClose(manifold.penetrations[i], 0.1f));
+    assert(IsClose(manifold.points[i].y, 0.95f));
+    assert(std::fabs(manifold.points[i].x - 1.f) <= 0.5001f);
+  }
+  // Either way around the normal points from the first to the second
+  assert(Narrowphase::BoxBox(box, ground, manifold));
+  assert(IsClose(manifold.normal.y, -1.f) && manifold.pointCount == 4u);
+
+  // A box turned 45 degrees about y and x lands on a corner
+  box.axes = glm::mat3_cast(glm::angleAxis(glm::radians(45.f)
+                                           , glm::vec3(0.f, 1.f, 0.f))
+                            * glm::angleAxis(glm::radians(45.f)
+                                             , glm::vec3(1.f, 0.f, 0.f)));
+  box.center.y = 1.f + box.GetBounds().max.y - box.center.y - 0.05f;
+  assert(Narrowphase::BoxBox(ground, box, manifold));
+  assert(IsClose(manifold.normal.y, 1.f));
+  assert(IsClose(manifold.GetMaxPenetration(), 0.05f));
+
+  // Two boxes turned so their edges cross meet at one point
+  OrientedBox crossed;
+  crossed.halfExtents = {1.f, 1.f, 1.f};
+  crossed.axes = glm::mat3_cast(glm::angleAxis(glm::radians(45.f)
+                                               , glm::vec3(1.f, 0.f, 0.f)));
+  OrientedBox other = crossed;
+  other.axes = glm::mat3_cast(glm::angleAxis(glm::radians(45.f)
+                                             , glm::vec3(0.f, 0.f, 1.f)));
+  other.center = {0.f, 2.f * std::sqrt(2.f) - 0.1f, 0.f};
+  assert(Narrowphase::BoxBox(crossed, other, manifold));
+  assert(manifold.pointCount == 1u && IsClose(manifold.normal.y, 1.f));
+  assert(IsClose(manifold.penetrations[0], 0.1f));
+  assert(IsClose(manifold.points[0].y + 1.f, std::sqrt(2.f) - 0.05f + 1.f));
+  other.center.y += 0.2f;
+  assert(!Narrowphase::BoxBox(crossed, other, manifold));
+
+  // Pairs of mixed shapes keep the normal from first to second, and a
+  // buffer that is too small drops what does not fit
+  const Collider::SHAPE types[3] = {Collider::SHAPE_BOX
+                                    , Collider::SHAPE_SPHERE
+                                    , Collider::SHAPE_SPHERE};
+  const OrientedBox boxes[3] = {ground, OrientedBox(), OrientedBox()};
+  const Sphere spheres[3] = {Sphere(), {{0.f, 1.5f, 0.f}, 1.f}
+                             , {{0.f, 3.f, 0.f}, 1.f}};
+  const std::vector<CollisionPair> pairs = {{0u, 1u}, {1u, 2u}, {0u, 2u}};
+  ContactBuffer contacts(1u);
+  Narrowphase::Collide({types, boxes, spheres}, pairs, contacts);
+  assert(contacts.GetCount() == 1u && contacts.GetDroppedCount() == 1u);
+  assert(contacts[0].first == 0u && contacts[0].second == 1u);
+  assert(IsClose(contacts[0].normal.y, 1.f));
+  contacts.Reserve(pairs.size());
+  Narrowphase::Collide({types, boxes, spheres}, pairs, contacts);
+  assert(contacts.GetCount() == 2u && contacts.GetDroppedCount() == 0u);
+  assert(contacts[1].first == 1u && IsClose(contacts[1].normal.y, 1.f));
+
+  return true;
+}
+
+UNIT_TEST_STATUS TestPhysics_ContactSolver()
+{
+  const float timeStep = 1.f / 60.f;
+
+  // Equal spheres meeting head on swap velocities when fully elastic, and
+  // stop dead when not
+  const float restitutions[2] = {1.f, 0.f};
+  for(const float &restitution : restitutions)
+  {
+    std::vector<float> velocities[3] = {{4.f, -4.f}, {0.f, 0.f}
+                                        , {0.f, 0.f}};
+    std::vector<float> positions[3] = {{0.f, 1.995f}, {0.f, 0.f}
+                                       , {0.f, 0.f}};
+    const uint32_t indices[2] = {0u, 1u};
+    const float inverseMasses[2] = {1.f, 1.f};
+    const float frictions[2] = {0.5f, 0.5f};
+    const float bounces[2] = {restitution, restitution};
+
+    ContactBuffer contacts(1u);
+    ContactManifold manifold;
+    Narrowphase::SphereSphere({{0.f, 0.f, 0.f}, 1.f}
+                              , {{1.995f, 0.f, 0.f}, 1.f}, manifold);
+    manifold.first = 0u;
+    manifold.second = 1u;
+    contacts.Push(manifold);
+
+    ContactSolver solver;
+    solver.Prepare(contacts, {indices, inverseMasses, frictions, bounces
+                              , {velocities[0].data(), velocities[1].data()
+                                 , velocities[2].data()}
+                              , {positions[0].data(), positions[1].data()
+                                 , positions[2].data()}, 2u});
+    solver.Solve(ContactSolver::DEFAULT_ITERATIONS);
+    solver.CorrectPositions(ContactSolver::DEFAULT_POSITION_ITERATIONS);
+    assert(IsClose(velocities[0][0], -4.f * restitution));
+    assert(IsClose(velocities[0][1], 4.f * restitution));
+    // Sunk in less than the slop so neither is moved
+    assert(positions[0][0] == 0.f && positions[0][1] == 1.995f);
+  }
+
+  // A box dropped on the ground comes to rest on it, touching it
+  BodyBatch batch;
+  batch.Resize(2u);
+  batch.SetBody(0u, {0.f, 0.f, 0.f}, {0.f, 0.f, 0.f}, {0.f, 0.f, 0.f}
+                , {0.f, 0.f, 0.f});
+  batch.SetBody(1u, {0.f, 2.f, 0.f}, {0.f, 2.f, 0.f}, {0.f, 0.f, 0.f}
+                , {0.f, -9.81f, 0.f});
+  batch.SetOrientation(0u, glm::identity<glm::quat>(), {0.f, 0.f, 0.f});
+  batch.SetOrientation(1u, glm::identity<glm::quat>(), {0.f, 0.f, 0.f});
+
+  const Collider::SHAPE types[2] = {Collider::SHAPE_BOX
+                                    , Collider::SHAPE_BOX};
+  OrientedBox boxes[2];
+  boxes[0].halfExtents = {10.f, 0.5f, 10.f};
+  boxes[1].halfExtents = {0.5f, 0.5f, 0.5f};
+  const Sphere spheres[2];
+  const uint32_t indices[2] = {0u, 1u};
+  const float inverseMasses[2] = {0.f, 1.f};
+  const float frictions[2] = {0.5f, 0.5f};
+  const float bounces[2] = {0.f, 0.f};
+  const ContactSolver::Bodies bodies = {indices, inverseMasses, frictions
+    , bounces
+    , {batch.GetVelocities(BodyBatch::AXIS_X)
+       , batch.GetVelocities(BodyBatch::AXIS_Y)
+       , batch.GetVelocities(BodyBatch::AXIS_Z)}
+    , {batch.GetPositions(BodyBatch::AXIS_X)
+       , batch.GetPositions(BodyBatch::AXIS_Y)
+       , batch.GetPositions(BodyBatch::AXIS_Z)}
+    , 2u};
+  const std::vector<CollisionPair> pairs = {{0u, 1u}};
+  ContactBuffer contacts(1u);
+  ContactSolver solver;
+  for(int step = 0; step < 180; ++step)
+  {
+    Integrator::Integrate(batch, Integrator::INTEGRATOR_SEMI_IMPLICIT_EULER
+                          , {0.f, 0.f, 0.f}, timeStep);
+    boxes[0].center = batch.GetPosition(0u);
+    boxes[1].center = batch.GetPosition(1u);
+    Narrowphase::Collide({types, boxes, spheres}, pairs, contacts);
+    solver.Prepare(contacts, bodies);
+    solver.Solve(ContactSolver::DEFAULT_ITERATIONS);
+    solver.CorrectPositions(ContactSolver::DEFAULT_POSITION_ITERATIONS);
+  }
+  // The ground never moves, and the box rests sunk in about the slop
+  // without moving
+  assert(batch.GetPosition(0u) == glm::vec3(0.f, 0.f, 0.f));
+  assert(std::fabs(batch.GetPosition(1u).y - 1.f) < 0.02f);
+  assert(std::fabs(batch.GetVelocity(1u).y) < 1e-3f);
+
+  // A row of touching spheres on the ground, each contact sharing a body
+  // with the next, is split into batches that share no moving body
+  const size_t sphereCount = 20u;
+  std::vector<uint32_t> rowIndices(sphereCount + 1u);
+  std::vector<float> rowMasses(sphereCount + 1u, 1.f);
+  std::vector<float> rowFrictions(sphereCount + 1u, 0.5f);
+  std::vector<float> rowBounces(sphereCount + 1u, 0.f);
+  std::vector<float> rowVelocities[3];
+  std::vector<float> rowPositions[3];
+  for(int axis = 0; axis < 3; ++axis)
+  {
+    rowVelocities[axis].assign(sphereCount + 1u, 0.f);
+    rowPositions[axis].assign(sphereCount + 1u, 0.f);
+  }
+  rowMasses[0] = 0.f;
+  ContactBuffer rowContacts(sphereCount * 2u);
+  for(uint32_t i = 0; i <= sphereCount; ++i)
+  {
+    rowIndices[i] = i;
+    rowVelocities[0][i] = static_cast<float>(i % 3u) - 1.f;
+    rowVelocities[1][i] = i == 0u ? 0.f : -1.f;
+    rowPositions[0][i] = static_cast<float>(i) * 1.9f;
+    rowPositions[1][i] = i == 0u ? -1.f : 0.9f;
+  }
+  for(uint32_t i = 1; i <= sphereCount; ++i)
+  {
+    ContactManifold touching;
+    touching.normal = {0.f, 1.f, 0.f};
+    touching.pointCount = 1u;
+    touching.penetrations[0] = 0.1f;
+    touching.first = 0u;
+    touching.second = i;
+    rowContacts.Push(touching);
+    if(i < sphereCount)
+    {
+      touching.normal = {1.f, 0.f, 0.f};
+      touching.first = i;
+      touching.second = i + 1u;
+      rowContacts.Push(touching);
+    }
+  }
+  std::vector<float> reversedVelocities[3] = {rowVelocities[0]
+                                              , rowVelocities[1]
+                                              , rowVelocities[2]};
+  std::vector<float> reversedPositions[3] = {rowPositions[0]
+                                             , rowPositions[1]
+                                             , rowPositions[2]};
+  const ContactSolver::Bodies rowBodies = {rowIndices.data()
+    , rowMasses.data(), rowFrictions.data(), rowBounces.data()
+    , {rowVelocities[0].data(), rowVelocities[1].data()
+       , rowVelocities[2].data()}
+    , {rowPositions[0].data(), rowPositions[1].data()
+       , rowPositions[2].data()}
+    , sphereCount + 1u};
+  solver.Prepare(rowContacts, rowBodies);
+  assert(solver.GetConstraintCount() == sphereCount * 2u - 1u);
+  assert(!solver.HasOverflowBatch() && solver.GetBatchCount() <= 3u);
+  solver.Solve(ContactSolver::DEFAULT_ITERATIONS);
+  solver.CorrectPositions(ContactSolver::DEFAULT_POSITION_ITERATIONS);
+  for(uint32_t i = 1; i <= sphereCount; ++i)
+  {
+    assert(rowVelocities[1][i] > -1e-3f && rowPositions[1][i] > 0.9f);
+  }
+
+  // Running each batch backwards gives the exact same result, as nothing
+  // in a batch depends on anything else in it
+  ContactSolver::Bodies reversedBodies = rowBodies;
+  reversedBodies.velocities = {reversedVelocities[0].data()
+                               , reversedVelocities[1].data()
+                               , reversedVelocities[2].data()};
+  reversedBodies.positions = {reversedPositions[0].data()
+                              , reversedPositions[1].data()
+                              , reversedPositions[2].data()};
+  solver.Prepare(rowContacts, reversedBodies);
+  for(int iteration = 0; iteration < ContactSolver::DEFAULT_ITERATIONS
+      ; ++iteration)
+  {
+    for(size_t i = 0; i < solver.GetBatchCount(); ++i)
+    {
+      size_t begin = 0u;
+      size_t end = 0u;
+      solver.GetBatch(i, begin, end);
+      for(size_t constraint = end; constraint > begin; --constraint)
+      {
+        solver.SolveRange(constraint - 1u, constraint);
+      }
+    }
+  }
+  for(int iteration = 0
+      ; iteration < ContactSolver::DEFAULT_POSITION_ITERATIONS; ++iteration)
+  {
+    for(size_t i = 0; i < solver.GetBatchCount(); ++i)
+    {
+      size_t begin = 0u;
+      size_t end = 0u;
+      solver.GetBatch(i, begin, end);
+      for(size_t constraint = end; constraint > begin; --constraint)
+      {
+        solver.CorrectRange(constraint - 1u, constraint);
+      }
+    }
+  }
+  for(int axis = 0; axis < 3; ++axis)
+  {
+    assert(reversedVelocities[axis] == rowVelocities[axis]);
+    assert(reversedPositions[axis] == rowPositions[axis]);
+  }
+
+  return true;
+}
+
+UNIT_TEST_STATUS TestPhysics_Islands()
+{
+  const std::vector<CollisionPair> links = {{3u, 7u}, {7u, 1u}, {5u, 6u}
+                                            , {9u, 9u}, {1u, 3u}};
+  const std::vector<uint32_t> expected = {0u, 1u, 2u, 1u, 3u, 4u, 4u, 1u, 5u
+                                          , 6u};
+
+  Islands islands;
+  islands.Reset(expected.size());
+  for(const CollisionPair &link : links)
+  {
+    islands.Link(link.first, link.second);
+  }
+  assert(islands.Label() == 7u);
+  for(uint32_t body = 0; body < expected.size(); ++body)
+  {
+    assert(islands.GetIsland(body) == expected[body]);
+  }
+
+  // The same links made backwards and flipped give the same numbers
+  islands.Reset(expected.size());
+  for(auto link = links.rbegin(); link != links.rend(); ++link)
+  {
+    islands.Link(link->second, link->first);
+  }
+  assert(islands.Label() == islands.GetIslandCount());
+  assert(islands.GetIslandCount() == 7u);
+  for(uint32_t body = 0; body < expected.size(); ++body)
+  {
+    assert(islands.GetIsland(body) == expected[body]);
+  }
+
+  // A long chain linked in a shuffled order is still one island
+  const uint32_t chainCount = 1000u;
+  std::vector<uint32_t> order(chainCount - 1u);
+  std::iota(order.begin(), order.end(), 0u);
+  std::shuffle(order.begin(), order.end(), std::mt19937(5u));
+  islands.Reset(chainCount);
+  for(const uint32_t &body : order)
+  {
+    islands.Link(body + 1u, body);
+  }
+  assert(islands.Label() == 1u);
+  assert(islands.FindRoot(0u) == islands.FindRoot(chainCount - 1u));
+
+  // Bodies past the active count, as sleeping bodies are, do not move
+  BodyBatch batch;
+  batch.Resize(2u);
+  for(size_t i = 0; i < 2u; ++i)
+  {
+    batch.SetBody(i, {0.f, 0.f, 0.f}, {0.f, 0.f, 0.f}, {1.f, 0.f, 0.f}
+                  , {0.f, -10.f, 0.f});
+    batch.SetOrientation(i, glm::quat(1.f, 0.f, 0.f, 0.f)
+                         , {0.f, 1.f, 0.f});
+  }
+  batch.SetActiveCount(1u);
+  Integrator::Integrate(batch, Integrator::INTEGRATOR_SEMI_IMPLICIT_EULER
+                        , {0.f, 0.f, 0.f}, 0.1f);
+  Integrator::Integrate(batch, Integrator::INTEGRATOR_VERLET
+                        , {0.f, 0.f, 0.f}, 0.1f);
+  assert(batch.GetPosition(0u) != glm::vec3(0.f));
+  assert(batch.GetOrientation(0u) != glm::quat(1.f, 0.f, 0.f, 0.f));
+  assert(batch.GetPosition(1u) == glm::vec3(0.f));
+  assert(batch.GetVelocity(1u) == glm::vec3(1.f, 0.f, 0.f));
+  assert(batch.GetOrientation(1u) == glm::quat(1.f, 0.f, 0.f, 0.f));
+
+  // Resizing makes every body active again
+  batch.Resize(2u);
+  assert(batch.GetActiveCount() == 2u);
+
+  return true;
+}
+
+UNIT_TEST_STATUS TestPhysics_ParallelStep()
+{
+  // Spheres dropped in a tight grid on the ground, touching the ground and
+  // their neighbors, with random velocities and turn rates
+  const size_t side = 24u;
+  const size_t count = side * side + 1u;
+  std::mt19937 generator(9u);
+  std::uniform_real_distribution<float> random(-1.f, 1.f);
+
+  BodyBatch serial;
+  serial.Resize(count);
+  serial.SetBody(0u, {0.f, -0.5f, 0.f}, {0.f, -0.5f, 0.f}, {0.f, 0.f, 0.f}
+                 , {0.f, 0.f, 0.f});
+  serial.SetOrientation(0u, glm::identity<glm::quat>(), {0.f, 0.f, 0.f});
+  for(size_t i = 1; i < count; ++i)
+  {
+    const glm::vec3 position = {((i - 1u) % side) * 0.98f, 0.49f
+                                , ((i - 1u) / side) * 0.98f};
+    serial.SetBody(i, position, position
+                   , {random(generator), random(generator)
+                      , random(generator)}
+                   , {0.f, -9.81f, 0.f});
+    serial.SetOrientation(i, glm::identity<glm::quat>()
+                          , {random(generator), random(generator)
+                             , random(generator)});
+  }
+  const BodyBatch start = serial;
+
+  const size_t serialContacts = StepOnGround(serial, nullptr, 20);
+  assert(serialContacts > count);
+
+  // The same pool is resized for each run, N being at least one more
+  // worker than the cores so threads really do interleave
+  const size_t hardwareThreads = std::thread::hardware_concurrency();
+  const size_t workerCounts[] = { 0u, 1u, 2u
+                                  , std::max<size_t>(hardwareThreads, 3u) };
+  ThreadPool threadPool(0u);
+  for(const size_t &workerCount : workerCounts)
+  {
+    threadPool.SetWorkerCount(workerCount);
+    assert(threadPool.GetThreadCount() == workerCount + 1u);
+
+    BodyBatch parallel = start;
+    assert(StepOnGround(parallel, &threadPool, 20) == serialContacts);
+
+    for(int axis = 0; axis < BodyBatch::AXIS_COUNT; ++axis)
+    {
+      const BodyBatch::AXIS batchAxis = static_cast<BodyBatch::AXIS>(axis);
+      assert(std::equal(serial.GetPositions(batchAxis)
+                        , serial.GetPositions(batchAxis) + count
+                        , parallel.GetPositions(batchAxis)));
+      assert(std::equal(serial.GetVelocities(batchAxis)
+                        , serial.GetVelocities(batchAxis) + count
+                        , parallel.GetVelocities(batchAxis)));
+    }
+    for(int component = 0; component < BodyBatch::QUAT_COUNT; ++component)
+    {
+      const BodyBatch::QUAT_COMPONENT batchComponent 
+        = static_cast<BodyBatch::QUAT_COMPONENT>(component);
+      assert(std::equal(serial.GetOrientations(batchComponent)
+                        , serial.GetOrientations(batchComponent) + count
+                        , parallel.GetOrientations(batchComponent)));
+    }
+  }
+
+  return true;
+}
+}
@@ -0,0 +1,79 @@
+/*
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    clapp_ut_physics.h
+ *
+ *  \brief
+ *    An interface used to store all physics unit tests for ClaPP
+*/
+#pragma once
+
+namespace ClaPP_UnitTests
+{
+typedef bool UNIT_TEST_STATUS;
+
+/*!
+ *  Drop a batch of bodies from rest with both integrators and ensure they
+ *  fall the exact distance each step should give, and that drag settles
+ *  a pushed body at its top speed.
+ */
+UNIT_TEST_STATUS TestPhysics_Integrators();
+/*!
+ *  Build random transforms with the transform kernel, both its SIMD and
+ *  scalar versions, and ensure they match the matrices glm builds one part
+ *  at a time.
+ */
+UNIT_TEST_STATUS TestPhysics_TransformKernel();
+/*!
+ *  Turn bodies by an angular velocity for a second and ensure they end at
+ *  the orientation the turn should give, and that a transform's Euler
+ *  accessors give back the angles they were set with.
+ */
+UNIT_TEST_STATUS TestPhysics_Orientations();
+/*!
+ *  Find the overlapping pairs of many bounds of mixed sizes with spatial
+ *  hashes of different cell sizes and ensure each finds every pair a test
+ *  of every body against every other does, once each, and in the same
+ *  order on any number of threads.
+ */
+UNIT_TEST_STATUS TestPhysics_SpatialHash();
+/*!
+ *  Add, move, and remove many bounds in an AABB tree, ensuring it stays
+ *  well formed and balanced, and that its pairs, queries, rays, and
+ *  frustum tests find the same bodies as testing every body. The tree
+ *  broadphase must find its pairs in the same order on many threads.
+ */
+UNIT_TEST_STATUS TestPhysics_AABBTree();
+/*!
+ *  Move many bounds a little at a time through a sweep and prune,
+ *  ensuring its pairs match testing every body after each move and that
+ *  the pairs it reports added and removed turn the old pairs into the new.
+ */
+UNIT_TEST_STATUS TestPhysics_SweepAndPrune();
+/*!
+ *  Test spheres and boxes against each other, resting, turned, apart, and
+ *  sunk inside, ensuring each gives the right normal, points, and depth.
+ */
+UNIT_TEST_STATUS TestPhysics_Narrowphase();
+/*!
+ *  Solve bodies meeting head on, resting on the ground, and sharing
+ *  contacts, ensuring they part as their restitution says, come to rest,
+ *  and that no batch holds two contacts on one moving body.
+ */
+UNIT_TEST_STATUS TestPhysics_ContactSolver();
+/*!
+ *  Link bodies into islands in different orders, ensuring the islands are
+ *  numbered the same whatever the order, and that bodies past a batch's
+ *  active count are left where they are.
+ */
+UNIT_TEST_STATUS TestPhysics_Islands();
+/*!
+ *  Step a grid of spheres on the ground with each phase split across pools
+ *  of 0, 1, 2, and many workers, ensuring every body ends exactly where it
+ *  does when the phases run on one thread.
+ */
+UNIT_TEST_STATUS TestPhysics_ParallelStep();
+}
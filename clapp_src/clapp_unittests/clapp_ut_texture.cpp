@@ -0,0 +1,181 @@
+/*
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    clapp_ut_texture.cpp
+ *
+ *  \brief
+ *    An implementation file used to define what texture cooking unit tests
+ *    are like
+*/
+
+#include "../clapp_includes/pch.h"
+
+#include "clapp_ut_texture.h"
+
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+
+#include "../clapp_includes/CGL_TextureCook.h"
+
+using ClaPP::TextureCooker;
+
+namespace ClaPP_UnitTests
+{
+UNIT_TEST_STATUS TestTextureCook_MipChain()
+{
+  // 5x3 RGB where each pixel's red channel is its x * 50
+  const uint32_t width = 5, height = 3, channels = 3;
+  std::vector<unsigned char> pixels(width * height * channels, 0);
+  for(uint32_t y = 0; y < height; ++y)
+  {
+    for(uint32_t x = 0; x < width; ++x)
+    {
+      pixels[(y * width + x) * channels] = static_cast<unsigned char>(x * 50);
+    }
+  }
+
+  std::vector<std::vector<unsigned char>> levels;
+  TextureCooker::BuildMipChain(pixels.data(), width, height, channels, levels);
+
+  // 5x3 -> 2x1 -> 1x1
+  assert(levels.size() == 3);
+  assert(levels[0] == pixels);
+  assert(levels[1].size() == 2 * 1 * channels);
+  assert(levels[2].size() == 1 * 1 * channels);
+
+  // The first texel of level 1 averages x = 0 and 1 -> (0 + 50) / 2
+  assert(levels[1][0] == 25);
+  assert(levels[1][channels] == 125);
+  assert(levels[2][0] == 75);
+
+  return true;
+}
+
+UNIT_TEST_STATUS TestTextureCook_BlockCompress()
+{
+  // 6x6 needs 2x2 blocks as edges are padded
+  const uint32_t width = 6, height = 6;
+  std::vector<unsigned char> rgb(width * height * 3);
+  std::vector<unsigned char> rgba(width * height * 4);
+  for(uint32_t i = 0; i < width * height; ++i)
+  {
+    rgb[i * 3 + 0] = rgba[i * 4 + 0] = 255;
+    rgb[i * 3 + 1] = rgba[i * 4 + 1] = 0;
+    rgb[i * 3 + 2] = rgba[i * 4 + 2] = 0;
+    rgba[i * 4 + 3] = 128;
+  }
+
+  std::vector<unsigned char> blocks;
+  TextureCooker::CompressBlocks(rgb.data(), width, height, 3, blocks);
+  assert(blocks.size() == 4 * 8);
+  // Solid red packs into 565 as 0xF800 with every index pointing at it
+  assert(blocks[0] == 0x00 && blocks[1] == 0xF8);
+  assert(blocks[4] == 0 && blocks[5] == 0 && blocks[6] == 0 && blocks[7] == 0);
+
+  TextureCooker::CompressBlocks(rgba.data(), width, height, 4, blocks);
+  assert(blocks.size() == 4 * 16);
+  // BC3 leads each block with the two alpha endpoints
+  assert(blocks[0] == 128 && blocks[1] == 128);
+  assert(blocks[8] == 0x00 && blocks[9] == 0xF8);
+
+  return true;
+}
+
+UNIT_TEST_STATUS TestTextureCook_ParseValidation()
+{
+  const std::string sourcePath = "clapp_ut_texture.ppm";
+  const std::string cookedPath = "clapp_ut_texture.ctex";
+
+  // A binary PPM is the simplest image stb_image can decode
+  {
+    std::ofstream source(sourcePath, std::ios::binary);
+    source << "P6\n8 4\n255\n";
+    for(int i = 0; i < 8 * 4; ++i)
+    {
+      source.put(static_cast<char>(i * 8)).put(0).put(static_cast<char>(255));
+    }
+  }
+
+  for(const bool blockCompress : {false, true})
+  {
+    assert(TextureCooker::CookTexture(sourcePath, cookedPath, blockCompress)
+           == TextureCooker::COOK_NO_ERR);
+
+    std::ifstream cookedFile(cookedPath, std::ios::binary);
+    std::stringstream stream;
+    stream << cookedFile.rdbuf();
+    const std::string cookedData = stream.str();
+
+    TextureCooker::CookedTexture cooked;
+    assert(TextureCooker::ParseCookedTexture(cookedData, cooked)
+           == TextureCooker::COOK_NO_ERR);
+    // 8x4 -> 4x2 -> 2x1 -> 1x1
+    assert(cooked.header.mipCount == 4);
+    assert(cooked.header.format == (blockCompress ? TextureCooker::COOKED_BC1
+                                    : TextureCooker::COOKED_RGB8));
+    assert(cooked.levels[0].dataSize
+           == (blockCompress ? 2u * 8u : 8u * 4u * 3u));
+    assert(cooked.levels[3].width == 1 && cooked.levels[3].height == 1);
+    for(const TextureCooker::CookedMipLevel &level : cooked.levels)
+    {
+      assert(level.dataOffset % 4 == 0);
+    }
+
+    // Cutting off the last level must be caught
+    assert(TextureCooker::ParseCookedTexture(
+             cookedData.substr(0, cookedData.size() - 1), cooked)
+           == TextureCooker::COOK_INVALID_FORMAT);
+
+    std::string corrupted = cookedData;
+    corrupted[0] = 'X';
+    assert(TextureCooker::ParseCookedTexture(corrupted, cooked)
+           == TextureCooker::COOK_INVALID_FORMAT);
+
+    // A level claiming to be larger than its data would have the driver
+    // read past the file
+    TextureCooker::CookedMipLevel level;
+    const size_t levelOffset = sizeof(TextureCooker::CookedTextureHeader);
+    corrupted = cookedData;
+    std::memcpy(&level, corrupted.data() + levelOffset, sizeof(level));
+    level.width = 4096u;
+    level.height = 4096u;
+    std::memcpy(corrupted.data() + levelOffset, &level, sizeof(level));
+    std::memcpy(corrupted.data() + offsetof(
+                  TextureCooker::CookedTextureHeader, width)
+                , &level.width, sizeof(level.width));
+    std::memcpy(corrupted.data() + offsetof(
+                  TextureCooker::CookedTextureHeader, height)
+                , &level.height, sizeof(level.height));
+    assert(TextureCooker::ParseCookedTexture(corrupted, cooked)
+           == TextureCooker::COOK_INVALID_FORMAT);
+
+    // As would a level cut short or one that does not halve the last
+    corrupted = cookedData;
+    std::memcpy(&level, corrupted.data() + levelOffset, sizeof(level));
+    level.dataSize -= 1u;
+    std::memcpy(corrupted.data() + levelOffset, &level, sizeof(level));
+    assert(TextureCooker::ParseCookedTexture(corrupted, cooked)
+           == TextureCooker::COOK_INVALID_FORMAT);
+
+    corrupted = cookedData;
+    const size_t secondOffset = levelOffset + sizeof(level);
+    std::memcpy(&level, corrupted.data() + secondOffset, sizeof(level));
+    level.width *= 2u;
+    level.height *= 2u;
+    level.dataSize = static_cast<uint32_t>(TextureCooker::GetLevelDataSize(
+      cooked.header.format, level.width, level.height));
+    std::memcpy(corrupted.data() + secondOffset, &level, sizeof(level));
+    assert(TextureCooker::ParseCookedTexture(corrupted, cooked)
+           == TextureCooker::COOK_INVALID_FORMAT);
+  }
+
+  std::filesystem::remove(sourcePath);
+  std::filesystem::remove(cookedPath);
+
+  return true;
+}
+}
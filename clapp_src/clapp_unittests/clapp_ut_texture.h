@@ -0,0 +1,34 @@
+/*
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    clapp_ut_texture.h
+ *
+ *  \brief
+ *    An interface used to store all texture cooking unit tests for ClaPP
+*/
+#pragma once
+
+namespace ClaPP_UnitTests
+{
+typedef bool UNIT_TEST_STATUS;
+
+/*!
+ *  Build the mip chain of a non power of two image and ensure every level
+ *  halves down to 1x1 and averages its source pixels.
+ */
+UNIT_TEST_STATUS TestTextureCook_MipChain();
+/*!
+ *  Compress a solid image into BC1 and BC3 blocks and ensure the block
+ *  count, endpoints, and alpha are what the decoder expects.
+ */
+UNIT_TEST_STATUS TestTextureCook_BlockCompress();
+/*!
+ *  Ensure that truncated and corrupted cooked textures, including levels
+ *  whose data or size does not match the chain, are rejected before any
+ *  level is read.
+ */
+UNIT_TEST_STATUS TestTextureCook_ParseValidation();
+}
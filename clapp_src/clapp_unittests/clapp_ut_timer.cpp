@@ -0,0 +1,158 @@
+/*
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    clapp_ut_timer.cpp
+ *
+ *  \brief
+ *    An implementation file used to define what timer unit tests are like
+*/
+
+#include "../clapp_includes/pch.h"
+
+#include "clapp_ut_timer.h"
+
+#include <random>
+
+#include "../clapp_includes/Clarity_TimerWheel.h"
+#include "../clapp_includes/Clarity_EventManager.h"
+
+using ClaPP::TimerWheel;
+using ClaPP::EventManager;
+using ClaPP::TimerEvent;
+
+namespace ClaPP_UnitTests
+{
+// Expiry ticks in the order timers fired
+static std::vector<uint64_t> firedTicks;
+
+static void RecordFire(const void *payload)
+{
+  uint64_t expireTick = 0;
+  memcpy(&expireTick, payload, sizeof(expireTick));
+  firedTicks.push_back(expireTick);
+}
+
+UNIT_TEST_STATUS TestTimer_WheelExpiry()
+{
+  // One second ticks so delays are whole ticks
+  TimerWheel wheel(1.f);
+  firedTicks.clear();
+
+  std::mt19937 random(7u);
+  std::uniform_int_distribution<uint64_t> delays(1u, 300000u);
+
+  std::vector<uint64_t> expected;
+  std::vector<TimerWheel::TIMER_ID> cancelled;
+  for(size_t i = 0; i < 5000; ++i)
+  {
+    uint64_t delay = delays(random);
+    // A few past the range of the wheel
+    if(i % 1000 == 0)
+    {
+      delay = 20000000u + i * 2;
+    }
+
+    const TimerWheel::TIMER_ID id = wheel.Schedule(static_cast<float>(delay)
+                                                   , RecordFire, &delay
+                                                   , sizeof(delay));
+    assert(id != TimerWheel::INVALID_TIMER);
+    if(i % 7 == 0)
+    {
+      cancelled.push_back(id);
+    }
+    else
+    {
+      expected.push_back(delay);
+    }
+  }
+
+  for(const TimerWheel::TIMER_ID &id : cancelled)
+  {
+    assert(wheel.Cancel(id));
+    // An id is only valid once
+    assert(!wheel.Cancel(id));
+  }
+  assert(wheel.GetPendingCount() == expected.size());
+  std::sort(expected.begin(), expected.end());
+
+  // Advance in uneven steps checking nothing fires early or late
+  uint64_t tick = 0;
+  const uint64_t steps[] = { 1u, 63u, 64u, 4095u, 1u, 70000u };
+  size_t step = 0;
+  while(wheel.GetPendingCount())
+  {
+    const uint64_t advance = steps[step++ % 6];
+    wheel.Advance(static_cast<float>(advance));
+    tick += advance;
+
+    const size_t due = std::upper_bound(expected.begin(), expected.end()
+                                        , tick) - expected.begin();
+    assert(firedTicks.size() == due);
+  }
+
+  // Fired in the order they expired
+  assert(firedTicks == expected);
+
+  return true;
+}
+
+UNIT_TEST_STATUS TestTimer_ScheduledEvents()
+{
+  EventManager &manager = EventManager::GetInstance();
+
+  TimerEvent cooldown;
+  cooldown.timerTag = 3u;
+  manager.ScheduleEvent(0.5f, cooldown);
+  TimerEvent cancelled;
+  cancelled.timerTag = 4u;
+  assert(manager.CancelEvent(manager.ScheduleEvent(0.25f, cancelled)));
+
+  // Not enough time has passed
+  manager.Update(0.3f);
+  assert(!manager.HasEvent<TimerEvent>());
+
+  // Sent once the delay passes and readable through the next frame
+  manager.Update(0.3f);
+  assert(manager.GetEventCount<TimerEvent>() == 1);
+  assert(manager.GetEvent<TimerEvent>(0).timerTag == 3u);
+
+  manager.Update(0.3f);
+  assert(!manager.HasEvent<TimerEvent>());
+
+  return true;
+}
+
+UNIT_TEST_STATUS TestTimer_SimultaneousExpiry()
+{
+  EventManager &manager = EventManager::GetInstance();
+
+  // Far more than the channel holds, all expiring on the same tick
+  const uint32_t timerCount = 1000u;
+  assert(timerCount > EventManager::DEFAULT_CHANNEL_CAPACITY);
+  for(uint32_t i = 0; i < timerCount; ++i)
+  {
+    TimerEvent timer;
+    timer.timerTag = i;
+    manager.ScheduleEvent(0.1f, timer);
+  }
+
+  manager.Update(0.2f);
+  assert(manager.GetEventCount<TimerEvent>() == timerCount);
+  std::vector<bool> delivered(timerCount, false);
+  for(size_t i = 0; i < timerCount; ++i)
+  {
+    const uint32_t tag = manager.GetEvent<TimerEvent>(i).timerTag;
+    assert(tag < timerCount && !delivered[tag]);
+    delivered[tag] = true;
+  }
+  assert(manager.GetChannelStats<TimerEvent>().droppedEvents == 0u);
+
+  manager.Update(0.2f);
+  assert(!manager.HasEvent<TimerEvent>());
+
+  return true;
+}
+}
@@ -0,0 +1,35 @@
+/*
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    clapp_ut_timer.h
+ *
+ *  \brief
+ *    An interface used to store all timer unit tests for ClaPP
+*/
+#pragma once
+
+namespace ClaPP_UnitTests
+{
+typedef bool UNIT_TEST_STATUS;
+
+/*!
+ *  Schedule timers spread over every level of the wheel and beyond it,
+ *  cancel some, and ensure the rest fire in order on the tick they expire
+ *  and never early.
+ */
+UNIT_TEST_STATUS TestTimer_WheelExpiry();
+/*!
+ *  Schedule typed events through the event manager and ensure they are
+ *  only readable once enough time has passed, and that cancelled events
+ *  are never sent.
+ */
+UNIT_TEST_STATUS TestTimer_ScheduledEvents();
+/*!
+ *  Schedule more events than a channel holds to expire on the same tick
+ *  and ensure every one of them is delivered and none are dropped.
+ */
+UNIT_TEST_STATUS TestTimer_SimultaneousExpiry();
+}
@@ -13,13 +13,36 @@
 #include "clapp_includes/pch.h"
 
 #include "clapp_includes/Clarity_Engine.h"
+#include "clapp_includes/CIL_InputTrace.h"
+#include "clapp_includes/Clarity_IO.h"
 
 using namespace std;
 
 using namespace ClaPP;
 
-int main()
+int main(int argc, char **argv)
 {
+  // --record <file> writes every frame's input to a trace and
+  // --replay <file> plays one back in place of the keyboard
+  for(int i = 1; i < argc; ++i)
+  {
+    const string argument = argv[i];
+    if((argument == "--record" || argument == "--replay") && i + 1 < argc)
+    {
+      InputTrace &trace = InputTrace::GetInstance();
+      const InputTrace::TRACE_ERR result = argument == "--record"
+        ? trace.StartRecording(argv[++i]) : trace.StartReplay(argv[++i]);
+      if(result != InputTrace::TRACE_NO_ERR)
+      {
+        return 1;
+      }
+    }
+    else
+    {
+      Message("Unknown argument ignored: " + argument, SEVERITY_WARNING);
+    }
+  }
+
   Engine engine;
 
   engine.Startup();
@@ -0,0 +1,91 @@
+/*!
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    clapp_pack.cpp
+ *
+ *  \brief
+ *    An offline tool that packs the engine's shaders, scripts, and assets
+ *    into a single .cpak archive
+ *
+ *    Usage: ClarityPacker <archive.cpak> <rootDir> [--compress] [files...]
+ *    If no files are given every file in the default asset directories
+ *    under rootDir is packed.
+*/
+#include "../clapp_src/clapp_includes/pch.h"
+
+#include <filesystem>
+
+#include "../clapp_src/clapp_includes/Clarity_Archive.h"
+#include "../clapp_src/clapp_includes/Clarity_IO.h"
+
+using namespace std;
+using namespace ClaPP;
+
+// The directories packed by default, relative to the root directory
+static const array<string, 3> DEFAULT_ASSET_DIRS =
+{
+  "clapp_shaders"
+  , "clapp_scripts"
+  , "clapp_assets"
+};
+
+int main(int argc, char **argv)
+{
+  if(argc < 3)
+  {
+    Message("Usage: ClarityPacker <archive.cpak> <rootDir> [--compress]"
+            " [files...]", SEVERITY_INFO);
+    return 1;
+  }
+
+  const string archivePath = argv[1];
+  const string rootDir = argv[2];
+  bool compress = false;
+  vector<string> files;
+
+  for(int i = 3; i < argc; ++i)
+  {
+    if(strcmp(argv[i], "--compress") == 0)
+    {
+      compress = true;
+    }
+    else
+    {
+      files.push_back(argv[i]);
+    }
+  }
+
+  if(files.empty())
+  {
+    for(const string &dir : DEFAULT_ASSET_DIRS)
+    {
+      const filesystem::path dirPath = filesystem::path(rootDir) / dir;
+      if(!filesystem::exists(dirPath))
+      {
+        continue;
+      }
+      for(const filesystem::directory_entry &entry
+          : filesystem::recursive_directory_iterator(dirPath))
+      {
+        if(entry.is_regular_file())
+        {
+          files.push_back(filesystem::relative(entry.path(), rootDir)
+                          .generic_string());
+        }
+      }
+    }
+    // Sort so that archives are reproducible between runs
+    sort(files.begin(), files.end());
+  }
+
+  if(AssetArchive::Build(archivePath, rootDir, files, compress)
+     != AssetArchive::ARCHIVE_NO_ERR)
+  {
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,316 @@
+/*!
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    clapp_physbench.cpp
+ *
+ *  \brief
+ *    An offline tool that times the physics kernels over large numbers of
+ *    bodies so their cost can be compared between builds
+ *
+ *    Usage: ClarityPhysicsBench [body count] [step count]
+ *    Defaults to 1000000 bodies over 600 steps, build in release for
+ *    numbers that mean anything. World matrices are built once a step.
+ *    Each broadphase is timed over at most 60 of the steps in a few kinds
+ *    of scene, with the fastest for each reported to help pick one.
+*/
+#include "../clapp_src/clapp_includes/pch.h"
+
+#include "../clapp_src/clapp_includes/CPL_AABBTree.h"
+#include "../clapp_src/clapp_includes/CPL_Integrator.h"
+#include "../clapp_src/clapp_includes/CPL_SpatialHash.h"
+#include "../clapp_src/clapp_includes/CPL_SweepAndPrune.h"
+#include "../clapp_src/clapp_includes/CPL_TransformKernel.h"
+#include "../clapp_src/clapp_includes/Clarity_IO.h"
+
+#include "../external/glm/gtc/matrix_transform.hpp"
+
+using namespace std;
+using namespace ClaPP;
+
+/*
+ * Fills a batch with bodies spread out and moving in random directions
+ */
+static void FillBatch(BodyBatch &batch, const size_t &bodyCount
+                      , const float &timeStep, const float &speed = 0.1f)
+{
+  mt19937 generator(1234u);
+  uniform_real_distribution<float> distribution(-100.f, 100.f);
+
+  batch.Resize(bodyCount);
+  for(size_t i = 0; i < bodyCount; ++i)
+  {
+    const glm::vec3 position = {distribution(generator)
+                                , distribution(generator)
+                                , distribution(generator)};
+    const glm::vec3 velocity = {distribution(generator) * speed
+                                , distribution(generator) * speed
+                                , distribution(generator) * speed};
+    batch.SetBody(i, position, position - velocity * timeStep, velocity
+                  , {0.f, -9.81f, 0.f});
+    batch.SetOrientation(i, glm::identity<glm::quat>(), velocity * 0.1f);
+  }
+}
+
+/*
+ * Times a number of steps of one integrator and reports the cost per body
+ */
+static void RunBenchmark(const string &name
+                         , const Integrator::INTEGRATOR &integrator
+                         , const size_t &bodyCount, const int &stepCount)
+{
+  const float timeStep = 1.f / 60.f;
+  const glm::vec3 drag = {3.f, 3.f, 3.f};
+
+  BodyBatch batch;
+  FillBatch(batch, bodyCount, timeStep);
+
+  // One step first so the arrays are in cache the same as later steps
+  Integrator::Integrate(batch, integrator, drag, timeStep);
+
+  const chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  for(int step = 0; step < stepCount; ++step)
+  {
+    Integrator::Integrate(batch, integrator, drag, timeStep);
+  }
+  const chrono::duration<double> elapsed 
+    = chrono::steady_clock::now() - start;
+
+  const double stepTime = elapsed.count() / stepCount;
+  const double bodyTime = stepTime / static_cast<double>(bodyCount);
+  // Summed so the work can not be optimized away
+  float checksum = 0.f;
+  for(size_t i = 0; i < bodyCount; i += 997u)
+  {
+    checksum += batch.GetPosition(i).y;
+  }
+
+  Message(name + ": " + to_string(stepTime * 1000.0) + "ms a step, "
+          + to_string(bodyTime * 1e9) + "ns a body, checksum "
+          + to_string(checksum), SEVERITY_INFO);
+}
+
+/*
+ * Times building a world matrix for every body from glm matrices one part
+ * at a time against the transform kernel
+ */
+static void RunMatrixBenchmark(const size_t &bodyCount, const int &stepCount)
+{
+  mt19937 generator(1234u);
+  uniform_real_distribution<float> distribution(-100.f, 100.f);
+
+  vector<float> inputs[9];
+  for(vector<float> &column : inputs)
+  {
+    column.resize(bodyCount);
+    for(float &value : column)
+    {
+      value = distribution(generator);
+    }
+  }
+  vector<glm::mat4> matrices(bodyCount);
+
+  const glm::mat4 identity = glm::identity<glm::mat4>();
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  for(int step = 0; step < stepCount; ++step)
+  {
+    for(size_t i = 0; i < bodyCount; ++i)
+    {
+      const glm::mat4 translate = glm::translate(identity
+        , {inputs[0][i], inputs[1][i], inputs[2][i]});
+      const glm::mat4 scale = glm::scale(identity
+        , {inputs[6][i], inputs[7][i], inputs[8][i]});
+      const glm::mat4 rotateX = glm::rotate(identity, inputs[3][i]
+                                            , {1.f, 0.f, 0.f});
+      const glm::mat4 rotateY = glm::rotate(identity, inputs[4][i]
+                                            , {0.f, 1.f, 0.f});
+      const glm::mat4 rotateZ = glm::rotate(identity, inputs[5][i]
+                                            , {0.f, 0.f, 1.f});
+      matrices[i] = translate * rotateZ * rotateY * rotateX * scale;
+    }
+  }
+  const chrono::duration<double> glmElapsed 
+    = chrono::steady_clock::now() - start;
+  const float glmChecksum = matrices[bodyCount / 2][1][2];
+
+  const TransformKernel::EulerTransforms transforms =
+  {
+    {inputs[0].data(), inputs[1].data(), inputs[2].data()}
+    , {inputs[3].data(), inputs[4].data(), inputs[5].data()}
+    , {inputs[6].data(), inputs[7].data(), inputs[8].data()}
+    , bodyCount
+  };
+  start = chrono::steady_clock::now();
+  for(int step = 0; step < stepCount; ++step)
+  {
+    TransformKernel::ComposeEuler(transforms, matrices.data());
+  }
+  const chrono::duration<double> kernelElapsed 
+    = chrono::steady_clock::now() - start;
+  const float kernelChecksum = matrices[bodyCount / 2][1][2];
+
+  const double glmStep = glmElapsed.count() / stepCount;
+  const double kernelStep = kernelElapsed.count() / stepCount;
+  Message("glm matrices: " + to_string(glmStep * 1000.0) + "ms a step, "
+          + "checksum " + to_string(glmChecksum), SEVERITY_INFO);
+  Message(string("Transform kernel") 
+          + (TransformKernel::IsVectorized() ? " (SSE): " : " (scalar): ")
+          + to_string(kernelStep * 1000.0) + "ms a step, "
+          + to_string(glmStep / kernelStep) + "x faster, checksum "
+          + to_string(kernelChecksum), SEVERITY_INFO);
+}
+
+/*
+ * A way of placing and moving bodies to time the broadphases over
+ */
+struct BroadphaseScene
+{
+  const char *name;
+  // How fast bodies move as a fraction of how far apart they start
+  float speed;
+  // Every this many bodies is made much larger, none if 0
+  size_t largeInterval;
+};
+
+/*
+ * Times one broadphase over moving bodies each step. The tree is moved to
+ * the new bounds before the pairs are found, which is timed as part of the
+ * tree's cost.
+ */
+static void RunBroadphaseScene(Broadphase &broadphase, AABBTree *tree
+                               , const BroadphaseScene &scene
+                               , const size_t &bodyCount
+                               , const int &stepCount, double &stepTime)
+{
+  const float timeStep = 1.f / 60.f;
+  const glm::vec3 drag = {3.f, 3.f, 3.f};
+  const glm::vec3 halfExtents = {0.5f, 0.5f, 0.5f};
+
+  BodyBatch batch;
+  FillBatch(batch, bodyCount, timeStep, scene.speed);
+  vector<AABB> bounds(bodyCount);
+  vector<int32_t> proxies;
+
+  double elapsed = 0.0;
+  size_t pairCount = 0u;
+  for(int step = 0; step < stepCount; ++step)
+  {
+    Integrator::Integrate(batch, Integrator::INTEGRATOR_SEMI_IMPLICIT_EULER
+                          , drag, timeStep);
+    for(size_t i = 0; i < bodyCount; ++i)
+    {
+      const glm::vec3 position = batch.GetPosition(i);
+      const bool isLarge = scene.largeInterval != 0u 
+                           && i % scene.largeInterval == 0u;
+      const glm::vec3 extents = isLarge ? halfExtents * 16.f : halfExtents;
+      bounds[i] = {position - extents, position + extents};
+    }
+
+    const chrono::steady_clock::time_point start 
+      = chrono::steady_clock::now();
+    if(tree && proxies.empty())
+    {
+      for(size_t i = 0; i < bodyCount; ++i)
+      {
+        proxies.push_back(tree->CreateProxy(bounds[i]
+                                            , static_cast<uint32_t>(i)));
+      }
+    }
+    else if(tree)
+    {
+      for(size_t i = 0; i < bodyCount; ++i)
+      {
+        tree->MoveProxy(proxies[i], bounds[i], batch.GetPosition(i) 
+                        - batch.GetPreviousPosition(i));
+      }
+    }
+    broadphase.Update(bounds);
+    const chrono::duration<double> stepElapsed 
+      = chrono::steady_clock::now() - start;
+
+    elapsed += stepElapsed.count();
+    pairCount += broadphase.GetPairs().size();
+  }
+
+  stepTime = elapsed / stepCount;
+  Message(string("  ") + broadphase.GetName() + ": " 
+          + to_string(stepTime * 1000.0) + "ms a step, "
+          + to_string(stepTime / static_cast<double>(bodyCount) * 1e9)
+          + "ns a body, " + to_string(pairCount / stepCount)
+          + " pairs a step", SEVERITY_INFO);
+}
+
+/*
+ * Times every broadphase over a few kinds of scene and reports which is
+ * fastest for each
+ */
+static void RunBroadphaseBenchmark(const size_t &bodyCount
+                                   , const int &stepCount)
+{
+  const int broadphaseSteps = min(stepCount, 60);
+  const BroadphaseScene scenes[] = {
+    {"Scattered unit cubes", 0.1f, 0u}
+    , {"Mixed sizes", 0.1f, 50u}
+    , {"Nearly still", 0.001f, 0u}
+  };
+
+  for(const BroadphaseScene &scene : scenes)
+  {
+    Message(string(scene.name) + ":", SEVERITY_INFO);
+
+    SpatialHash spatialHash;
+    AABBTree tree;
+    TreeBroadphase treeBroadphase(tree);
+    SweepAndPrune sweepAndPrune;
+
+    double stepTimes[3] = {0.0, 0.0, 0.0};
+    RunBroadphaseScene(spatialHash, nullptr, scene, bodyCount
+                       , broadphaseSteps, stepTimes[0]);
+    RunBroadphaseScene(treeBroadphase, &tree, scene, bodyCount
+                       , broadphaseSteps, stepTimes[1]);
+    RunBroadphaseScene(sweepAndPrune, nullptr, scene, bodyCount
+                       , broadphaseSteps, stepTimes[2]);
+
+    const Broadphase *broadphases[3] = {&spatialHash, &treeBroadphase
+                                        , &sweepAndPrune};
+    const size_t best = min_element(begin(stepTimes), end(stepTimes)) 
+                        - begin(stepTimes);
+    Message(string("  Best: ") + broadphases[best]->GetName()
+            , SEVERITY_INFO);
+  }
+}
+
+int main(int argc, char **argv)
+{
+  size_t bodyCount = 1000000u;
+  int stepCount = 600;
+
+  if(argc > 1)
+  {
+    bodyCount = strtoull(argv[1], nullptr, 10);
+  }
+  if(argc > 2)
+  {
+    stepCount = atoi(argv[2]);
+  }
+  if(bodyCount == 0u || stepCount <= 0)
+  {
+    Message("Usage: ClarityPhysicsBench [body count] [step count]"
+            , SEVERITY_INFO);
+    return 1;
+  }
+
+  Message("Integrating " + to_string(bodyCount) + " bodies over "
+          + to_string(stepCount) + " steps", SEVERITY_INFO);
+  RunBenchmark("Semi-implicit Euler"
+               , Integrator::INTEGRATOR_SEMI_IMPLICIT_EULER, bodyCount
+               , stepCount);
+  RunBenchmark("Verlet", Integrator::INTEGRATOR_VERLET, bodyCount
+               , stepCount);
+  RunMatrixBenchmark(bodyCount, stepCount);
+  RunBroadphaseBenchmark(bodyCount, stepCount);
+
+  return 0;
+}
@@ -0,0 +1,58 @@
+/*!
+ *  \author  Manoel McCadden
+ *  \date    10-19-2026
+ *  \par     manoel.mccadden@gmail.com
+ *  \par     github.com/mvmccadden
+ *
+ *  \file    clapp_texcook.cpp
+ *
+ *  \brief
+ *    An offline tool that cooks images into .ctex textures with every mip
+ *    level precomputed so the engine can upload them without decoding
+ *
+ *    Usage: ClarityTextureCooker <source image> <cooked.ctex> [--bc]
+ *    --bc stores the levels as BC1 (rgb) or BC3 (rgba) blocks
+*/
+#include "../clapp_src/clapp_includes/pch.h"
+
+#include "../clapp_src/clapp_includes/CGL_TextureCook.h"
+#include "../clapp_src/clapp_includes/Clarity_IO.h"
+
+using namespace std;
+using namespace ClaPP;
+
+int main(int argc, char **argv)
+{
+  if(argc < 3)
+  {
+    Message("Usage: ClarityTextureCooker <source image> <cooked.ctex> [--bc]"
+            , SEVERITY_INFO);
+    return 1;
+  }
+
+  const string sourcePath = argv[1];
+  const string cookedPath = argv[2];
+  bool blockCompress = false;
+
+  for(int i = 3; i < argc; ++i)
+  {
+    if(strcmp(argv[i], "--bc") == 0)
+    {
+      blockCompress = true;
+    }
+  }
+
+  if(!TextureCooker::IsCookedTexturePath(cookedPath))
+  {
+    Message("Cooked textures must use the " + TextureCooker::COOKED_EXTENSION
+            + " extension to be recognized by the engine", SEVERITY_WARNING);
+  }
+
+  if(TextureCooker::CookTexture(sourcePath, cookedPath, blockCompress)
+     != TextureCooker::COOK_NO_ERR)
+  {
+    return 1;
+  }
+
+  return 0;
+}